@@ -0,0 +1,60 @@
+/******************************************************
+ * @file MemoryBenchmarks/MemoryBench.cpp
+ * @brief 临时小块分配: 全局堆 vs 定长块线程缓存 vs 帧分配器, 多线程下对比
+ *****************************************************/
+
+#include "Memory/FixedBlockAllocator.hpp"
+#include "Memory/LinearAllocator.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+namespace {
+constexpr int BatchSize = 256;
+constexpr int BlockSize = 64;
+
+void BM_Malloc(benchmark::State &State) {
+    void *Blocks[BatchSize];
+    for (auto _: State) {
+        for (void *&Block: Blocks) {
+            Block = std::malloc(BlockSize);
+            benchmark::DoNotOptimize(Block);
+        }
+        for (void *Block: Blocks) {
+            std::free(Block);
+        }
+    }
+    State.SetItemsProcessed(State.iterations() * BatchSize);
+}
+BENCHMARK(BM_Malloc)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_FixedBlock(benchmark::State &State) {
+    using FAllocator = TFixedBlockAllocator<BlockSize>;
+    void *Blocks[BatchSize];
+    for (auto _: State) {
+        for (void *&Block: Blocks) {
+            Block = FAllocator::Allocate();
+            benchmark::DoNotOptimize(Block);
+        }
+        for (void *Block: Blocks) {
+            FAllocator::Free(Block);
+        }
+    }
+    State.SetItemsProcessed(State.iterations() * BatchSize);
+}
+BENCHMARK(BM_FixedBlock)->ThreadRange(1, 8)->UseRealTime();
+
+// 每轮迭代相当于一帧: 分配一批后整体丢弃
+void BM_FrameAllocator(benchmark::State &State) {
+    FLinearAllocator Arena;
+    for (auto _: State) {
+        for (int Index = 0; Index < BatchSize; ++Index) {
+            benchmark::DoNotOptimize(Arena.Allocate(BlockSize));
+        }
+        Arena.Reset();
+    }
+    State.SetItemsProcessed(State.iterations() * BatchSize);
+}
+BENCHMARK(BM_FrameAllocator)->ThreadRange(1, 8)->UseRealTime();
+} // namespace
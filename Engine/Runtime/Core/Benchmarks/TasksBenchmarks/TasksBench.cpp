@@ -0,0 +1,121 @@
+/******************************************************
+ * @file TasksBenchmarks/TasksBench.cpp
+ * @brief 任务系统基准: 发起吞吐、空任务往返、扇出/扇入图、并行循环
+ *****************************************************/
+
+#include "Tasks/ParallelFor.hpp"
+#include "Tasks/Tasks.hpp"
+#include "Thread/ThreadPool.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+using namespace TE;
+
+namespace {
+// 任务系统固定使用全局线程池, 把线程数作为计数器写进输出, 便于对比不同机器的结果
+void ReportThreads(benchmark::State &State) {
+    State.counters["threads"] = ThreadPool::global().threadCount();
+}
+
+// 发起一批独立的空任务并全部等待
+void BM_LaunchThroughput(benchmark::State &State) {
+    const int                       TaskCount = int(State.range(0));
+    std::vector<Tasks::TTask<void>> Batch;
+    Batch.reserve(TaskCount);
+    for (auto _: State) {
+        for (int Index = 0; Index < TaskCount; ++Index) {
+            Batch.push_back(Tasks::Launch(TEXT("Empty"), [] {}));
+        }
+        Tasks::Wait(Batch);
+        Batch.clear();
+    }
+    State.SetItemsProcessed(State.iterations() * TaskCount);
+    ReportThreads(State);
+}
+BENCHMARK(BM_LaunchThroughput)->ArgName("tasks")->Arg(1000)->Arg(10000)->UseRealTime();
+
+// 单个空任务: 创建 + 调度 + 执行 + 等待完成的往返延迟
+void BM_EmptyTaskRoundTrip(benchmark::State &State) {
+    for (auto _: State) {
+        Tasks::Launch(TEXT("Empty"), [] {}).Wait();
+    }
+    State.SetItemsProcessed(State.iterations());
+    ReportThreads(State);
+}
+BENCHMARK(BM_EmptyTaskRoundTrip)->UseRealTime();
+
+// 带返回值的任务, 额外覆盖结果的存取
+void BM_ResultRoundTrip(benchmark::State &State) {
+    int Value = 0;
+    for (auto _: State) {
+        Value = Tasks::Launch(TEXT("Result"), [Value] { return Value + 1; }).GetResult();
+    }
+    benchmark::DoNotOptimize(Value);
+    ReportThreads(State);
+}
+BENCHMARK(BM_ResultRoundTrip)->UseRealTime();
+
+// 一个根任务 -> Width 个并行任务 -> 一个汇合任务, 衡量依赖图的建立与解除
+void BM_FanOutFanIn(benchmark::State &State) {
+    const int                       Width = int(State.range(0));
+    std::vector<Tasks::TTask<void>> Middle;
+    Middle.reserve(Width);
+    for (auto _: State) {
+        Tasks::TTask<void> Root = Tasks::Launch(TEXT("Root"), [] {});
+        for (int Index = 0; Index < Width; ++Index) {
+            Middle.push_back(Tasks::Launch(TEXT("Middle"), [] {}, Tasks::Prerequisites(Root)));
+        }
+        Tasks::Launch(TEXT("Join"), [] {}, Middle).Wait();
+        Middle.clear();
+    }
+    State.SetItemsProcessed(State.iterations() * (Width + 2));
+    ReportThreads(State);
+}
+BENCHMARK(BM_FanOutFanIn)->ArgName("width")->RangeMultiplier(8)->Range(8, 4096)->UseRealTime();
+
+// Depth 个任务串成一条链, 每一步都要等待前一个完成后才能被调度
+void BM_DependencyChain(benchmark::State &State) {
+    const int Depth = int(State.range(0));
+    for (auto _: State) {
+        Tasks::TTask<void> Previous = Tasks::Launch(TEXT("Chain"), [] {});
+        for (int Index = 1; Index < Depth; ++Index) {
+            Previous = Tasks::Launch(TEXT("Chain"), [] {}, Tasks::Prerequisites(Previous));
+        }
+        Previous.Wait();
+    }
+    State.SetItemsProcessed(State.iterations() * Depth);
+    ReportThreads(State);
+}
+BENCHMARK(BM_DependencyChain)->ArgName("depth")->Arg(64)->Arg(1024)->UseRealTime();
+
+// 对一百万个元素做轻量运算: 比较不同最小批大小下的拆分开销
+void BM_ParallelFor(benchmark::State &State) {
+    constexpr int32    Num      = 1 << 20;
+    const int32        MinBatch = int32(State.range(0));
+    std::vector<float> Values(Num, 1.0f);
+    for (auto _: State) {
+        Tasks::ParallelFor(
+            Num, [&Values](int32 Index) { Values[Index] = Values[Index] * 0.5f + 1.0f; },
+            MinBatch);
+        benchmark::DoNotOptimize(Values.data());
+    }
+    State.SetItemsProcessed(State.iterations() * Num);
+    ReportThreads(State);
+}
+BENCHMARK(BM_ParallelFor)->ArgName("batch")->Arg(64)->Arg(1024)->Arg(16384)->UseRealTime();
+
+void BM_ParallelReduce(benchmark::State &State) {
+    constexpr int32 Num = 1 << 20;
+    for (auto _: State) {
+        int64 Sum = Tasks::ParallelReduce(
+            Num, int64(0), [](int32 Index) { return int64(Index & 7); },
+            [](int64 A, int64 B) { return A + B; }, 4096);
+        benchmark::DoNotOptimize(Sum);
+    }
+    State.SetItemsProcessed(State.iterations() * Num);
+    ReportThreads(State);
+}
+BENCHMARK(BM_ParallelReduce)->UseRealTime();
+} // namespace
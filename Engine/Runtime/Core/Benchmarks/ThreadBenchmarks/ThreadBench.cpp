@@ -0,0 +1,95 @@
+/******************************************************
+ * @file ThreadBenchmarks/ThreadBench.cpp
+ * @brief 线程池基准: 提交吞吐、往返延迟、waitAll 延迟
+ *****************************************************/
+
+#include "Async/ManualResetEvent.hpp"
+#include "Thread/ThreadPool.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+// 以线程数为参数: 1, 2, 4, ... 直到硬件线程数
+void ThreadCounts(benchmark::internal::Benchmark *Bench) {
+    const int MaxThreads = int(std::max(1u, std::thread::hardware_concurrency()));
+    Bench->ArgName("threads");
+    for (int Threads = 1; Threads < MaxThreads; Threads *= 2) {
+        Bench->Arg(Threads);
+    }
+    Bench->Arg(MaxThreads);
+    Bench->UseRealTime();
+}
+
+constexpr int TasksPerBatch = 10000;
+
+// 连续提交一批空任务并等待完成, 统计每秒完成的任务数
+void BM_SubmitThroughput(benchmark::State &State) {
+    ThreadPool       Pool(int(State.range(0)));
+    std::atomic<int> Counter{ 0 };
+    for (auto _: State) {
+        for (int Index = 0; Index < TasksPerBatch; ++Index) {
+            Pool.submit([&Counter] { Counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        Pool.waitAll();
+    }
+    State.SetItemsProcessed(State.iterations() * TasksPerBatch);
+    benchmark::DoNotOptimize(Counter.load());
+}
+BENCHMARK(BM_SubmitThroughput)->Apply(ThreadCounts);
+
+// 提交一个空任务并等它执行完: 唤醒工作线程 + 通知提交者的完整往返
+void BM_RoundTrip(benchmark::State &State) {
+    ThreadPool Pool(int(State.range(0)));
+    for (auto _: State) {
+        TE::FManualResetEvent Done;
+        Pool.submit([&Done] { Done.Notify(); });
+        Done.Wait();
+    }
+    State.SetItemsProcessed(State.iterations());
+}
+BENCHMARK(BM_RoundTrip)->Apply(ThreadCounts);
+
+// 每个工作线程一个空任务后立即 waitAll, 衡量 waitAll 本身的唤醒延迟
+void BM_WaitAllLatency(benchmark::State &State) {
+    const int  Threads = int(State.range(0));
+    ThreadPool Pool(Threads);
+    for (auto _: State) {
+        for (int Index = 0; Index < Threads; ++Index) {
+            Pool.submit([] {});
+        }
+        Pool.waitAll();
+    }
+}
+BENCHMARK(BM_WaitAllLatency)->Apply(ThreadCounts);
+
+// 池空闲时的 waitAll, 应当只是一次原子读取
+void BM_WaitAllIdle(benchmark::State &State) {
+    ThreadPool Pool(int(State.range(0)));
+    for (auto _: State) {
+        Pool.waitAll();
+    }
+}
+BENCHMARK(BM_WaitAllIdle)->Apply(ThreadCounts);
+
+// 从工作线程内部再提交任务 (嵌套提交), 覆盖本地队列路径
+void BM_NestedSubmit(benchmark::State &State) {
+    ThreadPool Pool(int(State.range(0)));
+    for (auto _: State) {
+        for (int Index = 0; Index < TasksPerBatch / 100; ++Index) {
+            Pool.submit([&Pool] {
+                for (int Child = 0; Child < 100; ++Child) {
+                    Pool.submit([] {});
+                }
+            });
+        }
+        Pool.waitAll();
+    }
+    State.SetItemsProcessed(State.iterations() * (TasksPerBatch + TasksPerBatch / 100));
+}
+BENCHMARK(BM_NestedSubmit)->Apply(ThreadCounts);
+} // namespace
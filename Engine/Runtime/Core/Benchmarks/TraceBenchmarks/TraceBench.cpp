@@ -0,0 +1,32 @@
+/******************************************************
+ * @file TraceBenchmarks/TraceBench.cpp
+ * @brief 追踪开销: 每个作用域事件在记录 / 未记录时的代价
+ *****************************************************/
+
+#include "Trace/Trace.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace TE;
+
+namespace {
+void BM_TraceScopeDisabled(benchmark::State &State) {
+    Trace::StopTracing();
+    for (auto _: State) {
+        TRACE_SCOPE("Disabled");
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TraceScopeDisabled);
+
+// 记录时: 两次读时间戳 + 一次写环形缓冲区
+void BM_TraceScopeEnabled(benchmark::State &State) {
+    Trace::StartTracing();
+    for (auto _: State) {
+        TRACE_SCOPE("Enabled");
+        benchmark::ClobberMemory();
+    }
+    Trace::StopTracing();
+}
+BENCHMARK(BM_TraceScopeEnabled);
+} // namespace
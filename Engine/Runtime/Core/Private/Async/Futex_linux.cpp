@@ -0,0 +1,61 @@
+/******************************************************
+ * @file Async/Futex_linux.cpp
+ * @brief
+ *****************************************************/
+
+#include "Async/Futex.hpp"
+
+#ifdef ENGINE_PLATFORM_LINUX
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <ctime>
+
+namespace TE::FutexInternal {
+namespace {
+uint32 *WordAddress(const std::atomic<uint32> &Word) {
+    static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32));
+    return reinterpret_cast<uint32 *>(const_cast<std::atomic<uint32> *>(&Word));
+}
+
+long Futex(uint32 *Address, int Op, uint32 Value, const timespec *Timeout, uint32 Mask) {
+    return syscall(SYS_futex, Address, Op, Value, Timeout, nullptr, Mask);
+}
+} // namespace
+
+void FutexWait(const std::atomic<uint32> &Word, uint32 Expected) {
+    Futex(WordAddress(Word), FUTEX_WAIT_PRIVATE, Expected, nullptr, 0);
+}
+
+bool FutexWaitUntil(const std::atomic<uint32> &Word, uint32 Expected,
+                    FClock::time_point Deadline) {
+    // FUTEX_WAIT_BITSET 使用绝对时间, steady_clock 在 Linux 上对应 CLOCK_MONOTONIC
+    auto SinceEpoch = Deadline.time_since_epoch();
+    if (SinceEpoch.count() < 0) {
+        SinceEpoch = FClock::duration::zero();
+    }
+    auto     Seconds = std::chrono::duration_cast<std::chrono::seconds>(SinceEpoch);
+    timespec Timeout;
+    Timeout.tv_sec  = static_cast<time_t>(Seconds.count());
+    Timeout.tv_nsec = static_cast<long>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(SinceEpoch - Seconds).count());
+
+    long Result = Futex(WordAddress(Word), FUTEX_WAIT_BITSET_PRIVATE, Expected, &Timeout,
+                        FUTEX_BITSET_MATCH_ANY);
+    return !(Result == -1 && errno == ETIMEDOUT);
+}
+
+void FutexWakeOne(const std::atomic<uint32> &Word) {
+    Futex(WordAddress(Word), FUTEX_WAKE_PRIVATE, 1, nullptr, 0);
+}
+
+void FutexWakeAll(const std::atomic<uint32> &Word) {
+    Futex(WordAddress(Word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, 0);
+}
+} // namespace TE::FutexInternal
+
+#endif // ENGINE_PLATFORM_LINUX
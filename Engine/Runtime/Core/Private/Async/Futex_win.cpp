@@ -0,0 +1,47 @@
+/******************************************************
+ * @file Async/Futex_win.cpp
+ * @brief
+ *****************************************************/
+
+#include "Async/Futex.hpp"
+
+#ifdef ENGINE_PLATFORM_WINDOWS
+
+#include <windows.h>
+
+namespace TE::FutexInternal {
+namespace {
+volatile VOID *WordAddress(const std::atomic<uint32> &Word) {
+    return const_cast<std::atomic<uint32> *>(&Word);
+}
+} // namespace
+
+void FutexWait(const std::atomic<uint32> &Word, uint32 Expected) {
+    WaitOnAddress(WordAddress(Word), &Expected, sizeof(uint32), INFINITE);
+}
+
+bool FutexWaitUntil(const std::atomic<uint32> &Word, uint32 Expected,
+                    FClock::time_point Deadline) {
+    auto Remaining = Deadline - FClock::now();
+    if (Remaining <= FClock::duration::zero()) {
+        return false;
+    }
+    // 向上取整到毫秒, 避免忙等
+    DWORD Milliseconds = static_cast<DWORD>(
+        std::chrono::ceil<std::chrono::milliseconds>(Remaining).count());
+    if (WaitOnAddress(WordAddress(Word), &Expected, sizeof(uint32), Milliseconds)) {
+        return true;
+    }
+    return GetLastError() != ERROR_TIMEOUT;
+}
+
+void FutexWakeOne(const std::atomic<uint32> &Word) {
+    WakeByAddressSingle(const_cast<std::atomic<uint32> *>(&Word));
+}
+
+void FutexWakeAll(const std::atomic<uint32> &Word) {
+    WakeByAddressAll(const_cast<std::atomic<uint32> *>(&Word));
+}
+} // namespace TE::FutexInternal
+
+#endif // ENGINE_PLATFORM_WINDOWS
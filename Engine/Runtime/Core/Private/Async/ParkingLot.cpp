@@ -0,0 +1,433 @@
+/******************************************************
+ * @file Async/ParkingLot.cpp
+ * @brief
+ *****************************************************/
+
+#include "Async/ParkingLot.hpp"
+#include "Async/WordMutex.hpp"
+#include "Memory/FixedBlockAllocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <new>
+#include <thread>
+
+namespace TE::ParkingLot::Private {
+// 每个使用过 ParkingLot 的线程对应一个 FThread, 在自己的 32 位字上休眠
+// 唤醒方出队后、发出唤醒前可能与线程退出交错, 因此用引用计数管理生命周期
+// Engine/Source/Runtime/Core/Private/Async/ParkingLot.cpp:40
+class FThread {
+  public:
+    static FThread *New() { return new (TObjectAllocator<FThread>::Malloc()) FThread(); }
+
+    void AddRef() { RefCount.fetch_add(1, std::memory_order_relaxed); }
+
+    void Release() {
+        if (RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            this->~FThread();
+            TObjectAllocator<FThread>::Free(this);
+        }
+    }
+
+    void PrepareWait(const void *Address) {
+        WaitAddress = Address;
+        WakeToken   = 0;
+        WakeFlag.store(0, std::memory_order_relaxed);
+    }
+
+    bool IsWoken() const { return WakeFlag.load(std::memory_order_acquire) != 0; }
+
+    void WaitForWake() {
+        while (!IsWoken()) {
+            FutexInternal::FutexWait(WakeFlag, 0);
+        }
+    }
+
+    // 超时返回 false
+    bool WaitForWakeUntil(FutexInternal::FClock::time_point Deadline) {
+        while (!IsWoken()) {
+            if (!FutexInternal::FutexWaitUntil(WakeFlag, 0, Deadline)) {
+                return IsWoken();
+            }
+        }
+        return true;
+    }
+
+    // 已经从队列中取出之后调用, 不能持有桶锁以外的任何锁
+    void Wake(uint64 InWakeToken) {
+        WakeToken = InWakeToken;
+        WakeFlag.store(1, std::memory_order_release);
+        FutexInternal::FutexWakeOne(WakeFlag);
+    }
+
+    FThread            *Next        = nullptr;
+    const void         *WaitAddress = nullptr;
+    uint64              WakeToken   = 0;
+    std::atomic<uint32> WakeFlag{ 0 };
+
+  private:
+    FThread() = default;
+
+    std::atomic<uint32> RefCount{ 1 };
+};
+
+// 哈希桶: 一把不依赖 ParkingLot 的字锁 + 一条 FIFO 等待队列
+class FBucket {
+  public:
+    static FBucket *New() { return new (TObjectAllocator<FBucket>::Malloc()) FBucket(); }
+
+    void Lock() { Mutex.Lock(); }
+    void Unlock() { Mutex.Unlock(); }
+
+    void Enqueue(FThread *Thread) {
+        Thread->Next = nullptr;
+        if (Tail) {
+            Tail->Next = Thread;
+        } else {
+            Head = Thread;
+        }
+        Tail = Thread;
+    }
+
+    FThread *Dequeue() {
+        FThread *Thread = Head;
+        if (Thread) {
+            Head = Thread->Next;
+            if (!Head) {
+                Tail = nullptr;
+            }
+            Thread->Next = nullptr;
+        }
+        return Thread;
+    }
+
+    enum class EDequeueAction { Keep, Remove, RemoveAndStop, Stop };
+
+    // 按顺序访问队列, 根据 Visitor 的返回值决定是否出队/是否继续
+    // 返回出队的线程, 按原顺序用 Next 串成链表
+    template <typename VisitorType> FThread *DequeueIf(VisitorType &&Visitor) {
+        FThread  *RemovedHead = nullptr;
+        FThread **RemovedLink = &RemovedHead;
+        FThread **Link        = &Head;
+        FThread  *Prev        = nullptr;
+        while (FThread *Thread = *Link) {
+            EDequeueAction Action = Visitor(Thread);
+            if (Action == EDequeueAction::Stop) {
+                break;
+            }
+            if (Action == EDequeueAction::Keep) {
+                Prev = Thread;
+                Link = &Thread->Next;
+                continue;
+            }
+            *Link = Thread->Next;
+            if (Tail == Thread) {
+                Tail = Prev;
+            }
+            Thread->Next = nullptr;
+            *RemovedLink = Thread;
+            RemovedLink  = &Thread->Next;
+            if (Action == EDequeueAction::RemoveAndStop) {
+                break;
+            }
+        }
+        return RemovedHead;
+    }
+
+    // 队列中是否还有等待 Address 的线程
+    bool HasWaiter(const void *Address) const {
+        for (FThread *Thread = Head; Thread; Thread = Thread->Next) {
+            if (Thread->WaitAddress == Address) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    FBucket() = default;
+
+    FWordMutex Mutex;
+    FThread   *Head = nullptr;
+    FThread   *Tail = nullptr;
+};
+
+// 桶数组, 按需创建桶; 扩容时整体替换. 其他线程可能还在读旧表, 所以旧表从不释放,
+// 而是挂在新表的 Replaced 上保持可达 (表只会按线程数翻倍, 总量不超过当前表的大小)
+// Engine/Source/Runtime/Core/Private/Async/ParkingLot.cpp:120
+class FTable {
+  public:
+    // 每个线程平均对应的桶数, 降低不同地址落入同一桶的概率
+    static constexpr uint32 BucketsPerThread = 4;
+    static constexpr uint32 MinBucketCount   = 64;
+
+    // 锁住 Address 所在的桶
+    // 唤醒方也必须经过 "加锁 + 复查表" 这一步, 否则可能在旧表上漏掉正在迁移的等待者
+    static FBucket *LockBucket(const void *Address) {
+        while (true) {
+            FTable  *Table  = GetOrCreate();
+            FBucket *Bucket = Table->FindBucket(Address);
+            Bucket->Lock();
+            // 扩容时旧表的所有桶都被锁住, 拿到锁后表仍未变化才是有效的桶
+            if (LIKELY(GlobalTable.load(std::memory_order_acquire) == Table)) {
+                return Bucket;
+            }
+            Bucket->Unlock();
+        }
+    }
+
+    static void Reserve(uint32 ThreadCount) {
+        const uint32 TargetCount =
+            std::bit_ceil(std::max(ThreadCount * BucketsPerThread, MinBucketCount));
+        while (true) {
+            FTable *Table = GlobalTable.load(std::memory_order_acquire);
+            if (!Table) {
+                FTable *NewTable = Create(TargetCount);
+                if (!GlobalTable.compare_exchange_strong(Table, NewTable,
+                                                         std::memory_order_acq_rel)) {
+                    Destroy(NewTable);
+                }
+                continue;
+            }
+            if (Table->BucketCount >= TargetCount) {
+                return;
+            }
+
+            // 按下标顺序锁住旧表的所有桶, 多个扩容者之间不会死锁
+            for (uint32 Index = 0; Index < Table->BucketCount; ++Index) {
+                Table->GetOrCreateBucketAt(Index)->Lock();
+            }
+            if (GlobalTable.load(std::memory_order_acquire) != Table) {
+                Table->UnlockAll();
+                continue;
+            }
+
+            // 新表尚未发布, 独占访问, 无需加锁
+            FTable *NewTable   = Create(TargetCount);
+            NewTable->Replaced = Table;
+            for (uint32 Index = 0; Index < Table->BucketCount; ++Index) {
+                FBucket *Bucket = Table->Buckets[Index].load(std::memory_order_relaxed);
+                while (FThread *Thread = Bucket->Dequeue()) {
+                    NewTable->FindBucket(Thread->WaitAddress)->Enqueue(Thread);
+                }
+            }
+            GlobalTable.store(NewTable, std::memory_order_release);
+            Table->UnlockAll();
+            return;
+        }
+    }
+
+  private:
+    static FTable *GetOrCreate() {
+        FTable *Table = GlobalTable.load(std::memory_order_acquire);
+        if (LIKELY(Table)) {
+            return Table;
+        }
+        Reserve(std::max(1u, std::thread::hardware_concurrency()));
+        return GlobalTable.load(std::memory_order_acquire);
+    }
+
+    static FTable *Create(uint32 BucketCount) {
+        FTable *Table      = new FTable();
+        Table->BucketCount = BucketCount;
+        Table->Shift       = 64 - std::countr_zero(BucketCount);
+        Table->Buckets     = new std::atomic<FBucket *>[BucketCount]();
+        return Table;
+    }
+
+    // 只用于从未发布过的表
+    static void Destroy(FTable *Table) {
+        for (uint32 Index = 0; Index < Table->BucketCount; ++Index) {
+            if (FBucket *Bucket = Table->Buckets[Index].load(std::memory_order_relaxed)) {
+                Bucket->~FBucket();
+                TObjectAllocator<FBucket>::Free(Bucket);
+            }
+        }
+        delete[] Table->Buckets;
+        delete Table;
+    }
+
+    uint32 IndexOf(const void *Address) const {
+        // Fibonacci 哈希, 取高位
+        return static_cast<uint32>((reinterpret_cast<uintptr_t>(Address) * 0x9E3779B97F4A7C15ull) >>
+                                   Shift);
+    }
+
+    FBucket *FindBucket(const void *Address) { return GetOrCreateBucketAt(IndexOf(Address)); }
+
+    FBucket *GetOrCreateBucketAt(uint32 Index) {
+        FBucket *Bucket = Buckets[Index].load(std::memory_order_acquire);
+        if (LIKELY(Bucket)) {
+            return Bucket;
+        }
+        FBucket *NewBucket = FBucket::New();
+        if (Buckets[Index].compare_exchange_strong(Bucket, NewBucket, std::memory_order_acq_rel)) {
+            return NewBucket;
+        }
+        NewBucket->~FBucket();
+        TObjectAllocator<FBucket>::Free(NewBucket);
+        return Bucket;
+    }
+
+    void UnlockAll() {
+        for (uint32 Index = 0; Index < BucketCount; ++Index) {
+            Buckets[Index].load(std::memory_order_relaxed)->Unlock();
+        }
+    }
+
+    uint32                  BucketCount = 0;
+    uint32                  Shift       = 0;
+    std::atomic<FBucket *> *Buckets     = nullptr;
+    FTable                 *Replaced    = nullptr;
+
+    static inline std::atomic<FTable *> GlobalTable{ nullptr };
+};
+
+// 线程第一次等待时创建 FThread, 并按当前线程数扩容哈希表
+class FThreadLocalData {
+  public:
+    static FThread *Get() {
+        static thread_local FThreadLocalData Data;
+        return Data.Thread;
+    }
+
+  private:
+    FThreadLocalData() : Thread(FThread::New()) {
+        FTable::Reserve(ThreadCount.fetch_add(1, std::memory_order_relaxed) + 1);
+    }
+
+    ~FThreadLocalData() {
+        ThreadCount.fetch_sub(1, std::memory_order_relaxed);
+        Thread->Release();
+    }
+
+    FThread *Thread;
+
+    static inline std::atomic<uint32> ThreadCount{ 0 };
+};
+
+static FWaitState WaitImpl(const void *Address, TFunctionRef<bool()> CanWait,
+                           TFunctionRef<void()> BeforeWait,
+                           const FutexInternal::FClock::time_point *Deadline) {
+    FThread *Self = FThreadLocalData::Get();
+    {
+        FBucket *Bucket = FTable::LockBucket(Address);
+        if (!CanWait()) {
+            Bucket->Unlock();
+            return {};
+        }
+        Self->PrepareWait(Address);
+        Bucket->Enqueue(Self);
+        Bucket->Unlock();
+    }
+
+    BeforeWait();
+
+    FWaitState State;
+    State.bDidWait = true;
+    if (!Deadline || Self->WaitForWakeUntil(*Deadline)) {
+        Self->WaitForWake();
+        State.bDidWake  = true;
+        State.WakeToken = Self->WakeToken;
+        return State;
+    }
+
+    // 超时: 自己从队列中摘除; 如果已经不在队列中, 说明唤醒方正在唤醒自己, 必须等它完成
+    FBucket   *Bucket   = FTable::LockBucket(Address);
+    const bool bRemoved = Bucket->DequeueIf([Self](FThread *Thread) {
+        return Thread == Self ? FBucket::EDequeueAction::RemoveAndStop
+                              : FBucket::EDequeueAction::Keep;
+    }) != nullptr;
+    Bucket->Unlock();
+    if (!bRemoved) {
+        Self->WaitForWake();
+        State.bDidWake  = true;
+        State.WakeToken = Self->WakeToken;
+    }
+    return State;
+}
+} // namespace TE::ParkingLot::Private
+
+namespace TE::ParkingLot {
+using namespace Private;
+
+FWaitState Wait(const void *Address, TFunctionRef<bool()> CanWait,
+                TFunctionRef<void()> BeforeWait) {
+    return WaitImpl(Address, CanWait, BeforeWait, nullptr);
+}
+
+FWaitState WaitUntil(const void *Address, TFunctionRef<bool()> CanWait,
+                     TFunctionRef<void()> BeforeWait, FutexInternal::FClock::time_point Deadline) {
+    return WaitImpl(Address, CanWait, BeforeWait, &Deadline);
+}
+
+FWakeState WakeOne(const void *Address, TFunctionRef<uint64(FWakeState)> OnWakeState) {
+    FBucket *Bucket = FTable::LockBucket(Address);
+
+    FThread *Woken = Bucket->DequeueIf([Address](FThread *Thread) {
+        return Thread->WaitAddress == Address ? FBucket::EDequeueAction::RemoveAndStop
+                                              : FBucket::EDequeueAction::Keep;
+    });
+
+    FWakeState State;
+    State.bDidWake           = Woken != nullptr;
+    State.bHasWaitingThreads = Woken && Bucket->HasWaiter(Address);
+    const uint64 WakeToken   = OnWakeState(State);
+
+    // 释放桶锁之后线程随时可能超时返回并退出, 先持有一份引用
+    if (Woken) {
+        Woken->AddRef();
+    }
+    Bucket->Unlock();
+    if (Woken) {
+        Woken->Wake(WakeToken);
+        Woken->Release();
+    }
+    return State;
+}
+
+FWakeState WakeOne(const void *Address) {
+    return WakeOne(Address, [](FWakeState) -> uint64 { return 0; });
+}
+
+uint32 WakeMultiple(const void *Address, uint32 WakeCount) {
+    if (WakeCount == 0) {
+        return 0;
+    }
+    FBucket *Bucket = FTable::LockBucket(Address);
+
+    // 先在桶锁内摘出一条私有链表, 解锁后再逐个唤醒
+    uint32   Count    = 0;
+    FThread *WakeList = Bucket->DequeueIf([Address, WakeCount, &Count](FThread *Thread) {
+        if (Count == WakeCount) {
+            return FBucket::EDequeueAction::Stop;
+        }
+        if (Thread->WaitAddress != Address) {
+            return FBucket::EDequeueAction::Keep;
+        }
+        Thread->AddRef();
+        ++Count;
+        return FBucket::EDequeueAction::Remove;
+    });
+    Bucket->Unlock();
+
+    while (WakeList) {
+        FThread *Thread = WakeList;
+        WakeList        = Thread->Next;
+        Thread->Next    = nullptr;
+        Thread->Wake(0);
+        Thread->Release();
+    }
+    return Count;
+}
+
+void WakeAll(const void *Address) {
+    WakeMultiple(Address, ~0u);
+}
+
+void Reserve(uint32 ThreadCount) {
+    FTable::Reserve(ThreadCount);
+}
+} // namespace TE::ParkingLot
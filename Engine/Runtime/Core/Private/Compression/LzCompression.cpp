@@ -0,0 +1,187 @@
+/******************************************************
+ * @file Compression/LzCompression.cpp
+ * @brief
+ *****************************************************/
+
+#include "Compression/LzCompression.hpp"
+
+#include <cstring>
+
+namespace TE::Compression {
+namespace {
+constexpr std::size_t MinMatch  = 4;
+constexpr std::size_t MaxOffset = 65535;
+constexpr uint32      HashBits  = 14;
+
+uint32 Read32(const uint8 *Ptr) {
+    uint32 Value;
+    std::memcpy(&Value, Ptr, sizeof(Value));
+    return Value;
+}
+
+uint32 Hash(uint32 Sequence) {
+    return (Sequence * 2654435761u) >> (32 - HashBits);
+}
+
+// 写入长度扩展字节; 容量不足时返回 nullptr
+uint8 *WriteLength(uint8 *Out, const uint8 *OutEnd, std::size_t Length) {
+    for (; Length >= 255; Length -= 255) {
+        if (Out == OutEnd) {
+            return nullptr;
+        }
+        *Out++ = 255;
+    }
+    if (Out == OutEnd) {
+        return nullptr;
+    }
+    *Out++ = uint8(Length);
+    return Out;
+}
+
+// 写入一个序列; Match 为 0 表示最后一个只含字面量的序列
+uint8 *WriteSequence(uint8 *Out, const uint8 *OutEnd, const uint8 *Literals,
+                     std::size_t NumLiterals, std::size_t Offset, std::size_t MatchLength) {
+    if (Out == OutEnd) {
+        return nullptr;
+    }
+    const std::size_t ExtraMatch = MatchLength ? MatchLength - MinMatch : 0;
+    uint8            *Token      = Out++;
+    *Token = uint8((NumLiterals < 15 ? NumLiterals : 15) << 4) |
+             uint8(ExtraMatch < 15 ? ExtraMatch : 15);
+    if (NumLiterals >= 15 && !(Out = WriteLength(Out, OutEnd, NumLiterals - 15))) {
+        return nullptr;
+    }
+    if (std::size_t(OutEnd - Out) < NumLiterals) {
+        return nullptr;
+    }
+    if (NumLiterals > 0) {
+        std::memcpy(Out, Literals, NumLiterals);
+        Out += NumLiterals;
+    }
+    if (MatchLength == 0) {
+        return Out;
+    }
+    if (OutEnd - Out < 2) {
+        return nullptr;
+    }
+    *Out++ = uint8(Offset);
+    *Out++ = uint8(Offset >> 8);
+    if (ExtraMatch >= 15 && !(Out = WriteLength(Out, OutEnd, ExtraMatch - 15))) {
+        return nullptr;
+    }
+    return Out;
+}
+
+// 读取长度扩展字节, 越界时返回 false
+bool ReadLength(const uint8 *&In, const uint8 *InEnd, std::size_t &Length) {
+    uint8 Byte;
+    do {
+        if (In == InEnd) {
+            return false;
+        }
+        Byte = *In++;
+        Length += Byte;
+    } while (Byte == 255);
+    return true;
+}
+} // namespace
+
+std::size_t LzCompress(const void *Source, std::size_t SourceSize, void *Dest,
+                       std::size_t DestCapacity) {
+    const uint8 *In       = static_cast<const uint8 *>(Source);
+    const uint8 *InEnd    = In + SourceSize;
+    uint8       *Out      = static_cast<uint8 *>(Dest);
+    uint8       *OutEnd   = Out + DestCapacity;
+    const uint8 *Anchor   = In; // 尚未输出的字面量起点
+    const uint8 *Cursor   = In;
+
+    // 记录每个 4 字节序列最后出现的位置 (相对 Source 的偏移 + 1, 0 表示空)
+    uint32 Table[1u << HashBits] = {};
+    if (SourceSize >= MinMatch) {
+        const uint8 *MatchLimit = InEnd - MinMatch;
+        while (Cursor <= MatchLimit) {
+            const uint32 Sequence  = Read32(Cursor);
+            uint32      &Slot      = Table[Hash(Sequence)];
+            const uint8 *Candidate = Slot ? In + (Slot - 1) : nullptr;
+            Slot                   = uint32(Cursor - In + 1);
+            if (!Candidate || std::size_t(Cursor - Candidate) > MaxOffset ||
+                Read32(Candidate) != Sequence) {
+                ++Cursor;
+                continue;
+            }
+            // 向后延伸匹配; 匹配可以与 Cursor 重叠
+            std::size_t MatchLength = MinMatch;
+            while (Cursor + MatchLength < InEnd && Candidate[MatchLength] == Cursor[MatchLength]) {
+                ++MatchLength;
+            }
+            Out = WriteSequence(Out, OutEnd, Anchor, std::size_t(Cursor - Anchor),
+                                std::size_t(Cursor - Candidate), MatchLength);
+            if (!Out) {
+                return 0;
+            }
+            Cursor += MatchLength;
+            Anchor = Cursor;
+            // 让匹配末尾附近的位置也进入表中
+            if (Cursor <= MatchLimit + 2) {
+                Table[Hash(Read32(Cursor - 2))] = uint32(Cursor - 2 - In + 1);
+            }
+        }
+    }
+    Out = WriteSequence(Out, OutEnd, Anchor, std::size_t(InEnd - Anchor), 0, 0);
+    return Out ? std::size_t(Out - static_cast<uint8 *>(Dest)) : 0;
+}
+
+bool LzDecompress(const void *Source, std::size_t SourceSize, void *Dest, std::size_t DestSize) {
+    const uint8 *In      = static_cast<const uint8 *>(Source);
+    const uint8 *InEnd   = In + SourceSize;
+    uint8       *Out     = static_cast<uint8 *>(Dest);
+    uint8       *OutBase = Out;
+    uint8       *OutEnd  = Out + DestSize;
+
+    while (In < InEnd) {
+        const uint8 Token       = *In++;
+        std::size_t NumLiterals = Token >> 4;
+        if (NumLiterals == 15 && !ReadLength(In, InEnd, NumLiterals)) {
+            return false;
+        }
+        if (std::size_t(InEnd - In) < NumLiterals || std::size_t(OutEnd - Out) < NumLiterals) {
+            return false;
+        }
+        if (NumLiterals > 0) {
+            std::memcpy(Out, In, NumLiterals);
+            In += NumLiterals;
+            Out += NumLiterals;
+        }
+        if (In == InEnd) {
+            // 最后一个序列
+            break;
+        }
+
+        if (InEnd - In < 2) {
+            return false;
+        }
+        const std::size_t Offset = std::size_t(In[0]) | (std::size_t(In[1]) << 8);
+        In += 2;
+        std::size_t MatchLength = Token & 15;
+        if (MatchLength == 15 && !ReadLength(In, InEnd, MatchLength)) {
+            return false;
+        }
+        MatchLength += MinMatch;
+        if (Offset == 0 || std::size_t(Out - OutBase) < Offset ||
+            std::size_t(OutEnd - Out) < MatchLength) {
+            return false;
+        }
+        const uint8 *Match = Out - Offset;
+        if (Offset >= MatchLength) {
+            std::memcpy(Out, Match, MatchLength);
+            Out += MatchLength;
+        } else {
+            // 与输出重叠, 必须逐字节复制
+            for (std::size_t Index = 0; Index < MatchLength; ++Index) {
+                *Out++ = Match[Index];
+            }
+        }
+    }
+    return Out == OutEnd;
+}
+} // namespace TE::Compression
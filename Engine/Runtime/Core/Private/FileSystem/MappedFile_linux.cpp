@@ -0,0 +1,104 @@
+/******************************************************
+ * @file FileSystem/MappedFile_linux.cpp
+ * @brief
+ *****************************************************/
+
+#include "FileSystem/MappedFile.hpp"
+
+#ifdef ENGINE_PLATFORM_LINUX
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+
+namespace TE {
+std::unique_ptr<FMappedFile> FMappedFile::Map(const std::string &Path) {
+    const int Fd = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (Fd < 0) {
+        return nullptr;
+    }
+    struct stat Stat;
+    if (fstat(Fd, &Stat) != 0) {
+        close(Fd);
+        return nullptr;
+    }
+    std::unique_ptr<FMappedFile> File(new FMappedFile());
+    File->Size = uint64(Stat.st_size);
+    if (File->Size > 0) {
+        void *Address = mmap(nullptr, File->Size, PROT_READ, MAP_SHARED, Fd, 0);
+        if (Address == MAP_FAILED) {
+            close(Fd);
+            return nullptr;
+        }
+        // 读取模式以随机访问为主, 关闭预读
+        madvise(Address, File->Size, MADV_RANDOM);
+        File->Data = static_cast<const uint8 *>(Address);
+    }
+    // 映射不依赖 fd 存活
+    close(Fd);
+    return File;
+}
+
+FMappedFile::~FMappedFile() {
+    if (Data) {
+        munmap(const_cast<uint8 *>(Data), Size);
+    }
+}
+
+std::unique_ptr<FWritableFile> FWritableFile::Open(const std::string &Path, bool bTruncate) {
+    const int Fd = open(Path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (bTruncate ? O_TRUNC : 0),
+                        0644);
+    if (Fd < 0) {
+        return nullptr;
+    }
+    std::unique_ptr<FWritableFile> File(new FWritableFile());
+    File->NativeHandle = Fd;
+    return File;
+}
+
+FWritableFile::~FWritableFile() {
+    if (NativeHandle >= 0) {
+        close(int(NativeHandle));
+    }
+}
+
+bool FWritableFile::Write(uint64 Offset, const void *Buffer, std::size_t Size) {
+    const char *Bytes = static_cast<const char *>(Buffer);
+    while (Size > 0) {
+        const ssize_t Written = pwrite(int(NativeHandle), Bytes, Size, off_t(Offset));
+        if (Written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        Bytes += Written;
+        Offset += uint64(Written);
+        Size -= std::size_t(Written);
+    }
+    return true;
+}
+
+uint64 FWritableFile::GetSize() const {
+    struct stat Stat;
+    return fstat(int(NativeHandle), &Stat) == 0 ? uint64(Stat.st_size) : 0;
+}
+
+bool FWritableFile::Flush() {
+    return fdatasync(int(NativeHandle)) == 0;
+}
+
+bool AtomicReplaceFile(const std::string &From, const std::string &To) {
+    return std::rename(From.c_str(), To.c_str()) == 0;
+}
+
+bool RemoveFile(const std::string &Path) {
+    return unlink(Path.c_str()) == 0;
+}
+} // namespace TE
+
+#endif
@@ -0,0 +1,129 @@
+/******************************************************
+ * @file FileSystem/MappedFile_win.cpp
+ * @brief
+ *****************************************************/
+
+#include "FileSystem/MappedFile.hpp"
+
+#ifdef ENGINE_PLATFORM_WINDOWS
+
+#include <windows.h>
+
+namespace TE {
+namespace {
+std::wstring ToWide(const std::string &Path) {
+    const int Length = MultiByteToWideChar(CP_UTF8, 0, Path.c_str(), -1, nullptr, 0);
+    std::wstring Wide(Length > 0 ? Length - 1 : 0, L'\0');
+    if (Length > 1) {
+        MultiByteToWideChar(CP_UTF8, 0, Path.c_str(), -1, Wide.data(), Length);
+    }
+    return Wide;
+}
+} // namespace
+
+std::unique_ptr<FMappedFile> FMappedFile::Map(const std::string &Path) {
+    // 允许其他句柄继续写入/重命名, 写入方只会追加
+    const HANDLE File = CreateFileW(ToWide(Path).c_str(), GENERIC_READ,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (File == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(File, &FileSize)) {
+        CloseHandle(File);
+        return nullptr;
+    }
+    std::unique_ptr<FMappedFile> Mapped(new FMappedFile());
+    Mapped->Size = uint64(FileSize.QuadPart);
+    if (Mapped->Size > 0) {
+        const HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!Mapping) {
+            CloseHandle(File);
+            return nullptr;
+        }
+        const void *Address = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!Address) {
+            CloseHandle(Mapping);
+            CloseHandle(File);
+            return nullptr;
+        }
+        Mapped->Data          = static_cast<const uint8 *>(Address);
+        Mapped->NativeMapping = Mapping;
+    }
+    // 视图与 mapping 对象各自持有文件引用
+    CloseHandle(File);
+    return Mapped;
+}
+
+FMappedFile::~FMappedFile() {
+    if (Data) {
+        UnmapViewOfFile(Data);
+    }
+    if (NativeMapping) {
+        CloseHandle(NativeMapping);
+    }
+}
+
+std::unique_ptr<FWritableFile> FWritableFile::Open(const std::string &Path, bool bTruncate) {
+    const HANDLE File = CreateFileW(ToWide(Path).c_str(), GENERIC_READ | GENERIC_WRITE,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, bTruncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (File == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    std::unique_ptr<FWritableFile> Writable(new FWritableFile());
+    Writable->NativeHandle = reinterpret_cast<intptr_t>(File);
+    return Writable;
+}
+
+FWritableFile::~FWritableFile() {
+    if (NativeHandle != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(NativeHandle));
+    }
+}
+
+bool FWritableFile::Write(uint64 Offset, const void *Buffer, std::size_t Size) {
+    const HANDLE File  = reinterpret_cast<HANDLE>(NativeHandle);
+    const char  *Bytes = static_cast<const char *>(Buffer);
+    while (Size > 0) {
+        // 通过 OVERLAPPED 指定偏移, 不依赖也不修改共享的文件指针
+        OVERLAPPED Overlapped = {};
+        Overlapped.Offset     = DWORD(Offset);
+        Overlapped.OffsetHigh = DWORD(Offset >> 32);
+        const DWORD ToWrite   = Size > 0x40000000 ? 0x40000000 : DWORD(Size);
+        DWORD       Written   = 0;
+        if (!WriteFile(File, Bytes, ToWrite, &Written, &Overlapped)) {
+            return false;
+        }
+        Bytes += Written;
+        Offset += Written;
+        Size -= Written;
+    }
+    return true;
+}
+
+uint64 FWritableFile::GetSize() const {
+    LARGE_INTEGER FileSize;
+    return GetFileSizeEx(reinterpret_cast<HANDLE>(NativeHandle), &FileSize)
+               ? uint64(FileSize.QuadPart)
+               : 0;
+}
+
+bool FWritableFile::Flush() {
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(NativeHandle)) != 0;
+}
+
+bool AtomicReplaceFile(const std::string &From, const std::string &To) {
+    // 目标文件仍被映射时会失败, 调用方需要先释放旧映射或稍后重试
+    return MoveFileExW(ToWide(From).c_str(), ToWide(To).c_str(),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+bool RemoveFile(const std::string &Path) {
+    return DeleteFileW(ToWide(Path).c_str()) != 0;
+}
+} // namespace TE
+
+#endif
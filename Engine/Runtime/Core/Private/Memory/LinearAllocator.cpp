@@ -0,0 +1,142 @@
+/******************************************************
+ * @file Memory/LinearAllocator.cpp
+ * @brief
+ *****************************************************/
+
+#include "Memory/LinearAllocator.hpp"
+
+#include <atomic>
+
+namespace {
+// 页头之后紧跟数据区, 页头按 max_align_t 对齐, 数据区起点因此也是 max_align_t 对齐
+constexpr std::size_t PageAlign = alignof(std::max_align_t);
+} // namespace
+
+FLinearAllocator::~FLinearAllocator() {
+    Release();
+}
+
+FLinearAllocator::FPage *FLinearAllocator::AllocatePage(std::size_t Capacity, bool bOversized) {
+    static_assert(sizeof(FPage) % PageAlign == 0);
+    void  *Memory     = ::operator new(sizeof(FPage) + Capacity, std::align_val_t(PageAlign));
+    FPage *Page       = static_cast<FPage *>(Memory);
+    Page->Next        = nullptr;
+    Page->Capacity    = Capacity;
+    Page->bOversized  = bOversized;
+    return Page;
+}
+
+void *FLinearAllocator::AllocateSlow(std::size_t Size, std::size_t Align) {
+    // 超过数据区起点对齐的部分需要额外留出填充空间
+    const std::size_t Needed = Size + (Align > PageAlign ? Align - PageAlign : 0);
+    FPage            *Page   = nullptr;
+    if (Needed > PageSize) {
+        Page = AllocatePage(Needed, true);
+    } else if (FreePages) {
+        Page       = FreePages;
+        FreePages  = Page->Next;
+        Page->Next = nullptr;
+    } else {
+        Page = AllocatePage(PageSize, false);
+    }
+
+    if (Current) {
+        Current->Next = Page;
+    } else {
+        First = Page;
+    }
+    Current = Page;
+    Offset  = 0;
+    return Allocate(Size, Align);
+}
+
+void FLinearAllocator::Rewind(const FMarker &Marker) {
+    FPage *Page = Marker.Page ? Marker.Page->Next : First;
+    if (Marker.Page) {
+        Marker.Page->Next = nullptr;
+    } else {
+        First = nullptr;
+    }
+    while (Page) {
+        FPage *Next = Page->Next;
+        if (Page->bOversized) {
+            ::operator delete(Page, std::align_val_t(PageAlign));
+        } else {
+            Page->Next = FreePages;
+            FreePages  = Page;
+        }
+        Page = Next;
+    }
+    Current = Marker.Page;
+    Offset  = Marker.Offset;
+}
+
+void FLinearAllocator::Release() {
+    Reset();
+    while (FreePages) {
+        FPage *Next = FreePages->Next;
+        ::operator delete(FreePages, std::align_val_t(PageAlign));
+        FreePages = Next;
+    }
+}
+
+std::size_t FLinearAllocator::GetBytesUsed() const {
+    std::size_t Bytes = 0;
+    for (FPage *Page = First; Page; Page = Page->Next) {
+        Bytes += Page == Current ? Offset : Page->Capacity;
+    }
+    return Bytes;
+}
+
+std::size_t FLinearAllocator::GetBytesReserved() const {
+    std::size_t Bytes = 0;
+    for (FPage *Page = First; Page; Page = Page->Next) {
+        Bytes += Page->Capacity;
+    }
+    for (FPage *Page = FreePages; Page; Page = Page->Next) {
+        Bytes += Page->Capacity;
+    }
+    return Bytes;
+}
+
+// ============== FFrameAllocator =============
+
+namespace {
+std::atomic<uint64> GFrameNumber{ 0 };
+
+struct FThreadFrameAllocator {
+    FLinearAllocator Allocator;
+    uint64           FrameNumber = 0;
+
+    // 帧号变化后第一次使用时才重置, 上一帧的内存此时已经不再有效
+    FLinearAllocator &Get() {
+        const uint64 CurrentFrame = GFrameNumber.load(std::memory_order_relaxed);
+        if (UNLIKELY(FrameNumber != CurrentFrame)) {
+            Allocator.Reset();
+            FrameNumber = CurrentFrame;
+        }
+        return Allocator;
+    }
+};
+
+FThreadFrameAllocator &GetThreadFrameAllocator() {
+    static thread_local FThreadFrameAllocator Allocator;
+    return Allocator;
+}
+} // namespace
+
+void FFrameAllocator::BeginFrame() {
+    GFrameNumber.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64 FFrameAllocator::GetFrameNumber() {
+    return GFrameNumber.load(std::memory_order_relaxed);
+}
+
+void *FFrameAllocator::Allocate(std::size_t Size, std::size_t Align) {
+    return GetThreadFrameAllocator().Get().Allocate(Size, Align);
+}
+
+std::size_t FFrameAllocator::GetThreadBytesUsed() {
+    return GetThreadFrameAllocator().Get().GetBytesUsed();
+}
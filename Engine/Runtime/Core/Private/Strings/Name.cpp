@@ -0,0 +1,110 @@
+/******************************************************
+ * @file Strings/Name.cpp
+ * @brief
+ *****************************************************/
+
+#include "Strings/Name.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+#include "DebugUtils/CoreDebug.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+namespace {
+using TE::FMutex;
+using TE::TUniqueLock;
+
+// 下标 = 块号 << 16 | 块内偏移 (以 TCHAR 为单位)
+// 每个条目是 [长度][字符 ...], 长度占一个码元, 不以 0 结尾
+constexpr uint32 OffsetBits = 16;
+constexpr uint32 BlockUnits = 1u << OffsetBits;
+constexpr uint32 MaxBlocks  = 4096;
+constexpr uint32 NumShards  = 64;
+
+class FNamePool {
+  public:
+    FNamePool() {
+        // 块 0 偏移 0 是长度为 0 的 None
+        AllocateEntry(FName::ViewType());
+    }
+
+    uint32 FindOrAdd(FName::ViewType Str, bool bAdd) {
+        if (Str.empty()) {
+            return 0;
+        }
+        const std::size_t Hash  = std::hash<FName::ViewType>()(Str);
+        FShard           &Shard = Shards[Hash % NumShards];
+        TUniqueLock       Lock(Shard.Mutex);
+        const auto        It = Shard.Entries.find(Str);
+        if (It != Shard.Entries.end()) {
+            return It->second;
+        }
+        if (!bAdd) {
+            return 0;
+        }
+        const uint32 Index = AllocateEntry(Str);
+        // 键指向名字表中的拷贝, 而不是调用方的字符串
+        Shard.Entries.emplace(Resolve(Index), Index);
+        return Index;
+    }
+
+    FName::ViewType Resolve(uint32 Index) const {
+        const TCHAR *Block = Blocks[Index >> OffsetBits].load(std::memory_order_acquire);
+        const TCHAR *Entry = Block + (Index & (BlockUnits - 1));
+        return FName::ViewType(Entry + 1, std::size_t(Entry[0]));
+    }
+
+  private:
+    uint32 AllocateEntry(FName::ViewType Str) {
+        const uint32 Units = uint32(Str.size()) + 1;
+        TUniqueLock  Lock(AllocMutex);
+        if (!CurrentBlock || CurrentOffset + Units > BlockUnits) {
+            check(NumBlocks < MaxBlocks);
+            CurrentBlock  = new TCHAR[BlockUnits];
+            CurrentOffset = 0;
+            Blocks[NumBlocks++].store(CurrentBlock, std::memory_order_release);
+        }
+        TCHAR *Entry = CurrentBlock + CurrentOffset;
+        Entry[0]     = TCHAR(Str.size());
+        std::copy(Str.begin(), Str.end(), Entry + 1);
+        const uint32 Index = ((NumBlocks - 1) << OffsetBits) | CurrentOffset;
+        CurrentOffset += Units;
+        return Index;
+    }
+
+    struct FShard {
+        FMutex                                      Mutex;
+        std::unordered_map<FName::ViewType, uint32> Entries;
+    };
+
+    FShard Shards[NumShards];
+
+    FMutex               AllocMutex;
+    std::atomic<TCHAR *> Blocks[MaxBlocks] = {};
+    uint32               NumBlocks          = 0;
+    TCHAR               *CurrentBlock       = nullptr;
+    uint32               CurrentOffset      = 0;
+};
+
+FNamePool &GetNamePool() {
+    // 进程退出时其他线程可能仍在使用名字, 故意不析构
+    static FNamePool *Pool = new FNamePool();
+    return *Pool;
+}
+
+FName::ViewType ClampLength(FName::ViewType Str) {
+    return Str.substr(0, std::size_t(FName::MaxLength));
+}
+} // namespace
+
+FName::FName(ViewType Str) : Index(GetNamePool().FindOrAdd(ClampLength(Str), true)) {}
+
+FName FName::Find(ViewType Str) {
+    return FName(GetNamePool().FindOrAdd(ClampLength(Str), false));
+}
+
+FName::ViewType FName::GetPlainView() const {
+    return GetNamePool().Resolve(Index);
+}
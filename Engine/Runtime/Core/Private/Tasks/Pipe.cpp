@@ -0,0 +1,69 @@
+/******************************************************
+ * @file Tasks/Pipe.cpp
+ * @brief
+ *****************************************************/
+
+#include "Tasks/Pipe.hpp"
+#include "Async/ParkingLot.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace TE::Tasks {
+namespace {
+// 当前线程正在执行的管道, 嵌套时 (例如在管道任务里等待并帮忙执行其他任务) 会有多个
+thread_local std::vector<const FPipe *> GPipeCallStack;
+} // namespace
+
+FPipe::~FPipe() {
+    check(!HasWork());
+    if (Private::FTaskBase *Last = LastTask.exchange(nullptr, std::memory_order_acquire)) {
+        Last->Release();
+    }
+}
+
+void FPipe::WaitUntilEmpty() {
+    while (HasWork()) {
+        ParkingLot::Wait(&TaskCount, [this] { return HasWork(); }, [] {});
+    }
+}
+
+bool FPipe::WaitUntilEmpty(FutexInternal::FClock::time_point Deadline) {
+    while (HasWork()) {
+        const ParkingLot::FWaitState State =
+            ParkingLot::WaitUntil(&TaskCount, [this] { return HasWork(); }, [] {}, Deadline);
+        if (State.bDidWait && !State.bDidWake) {
+            return !HasWork();
+        }
+    }
+    return true;
+}
+
+bool FPipe::IsInContext() const {
+    return std::find(GPipeCallStack.begin(), GPipeCallStack.end(), this) != GPipeCallStack.end();
+}
+
+void FPipe::PushIntoPipe(Private::FTaskBase &Task) {
+    Task.AddRef();
+    Private::FTaskBase *Previous = LastTask.exchange(&Task, std::memory_order_acq_rel);
+    if (Previous) {
+        // Previous 已经完成时不会添加依赖
+        Task.AddPrerequisite(Previous);
+        Previous->Release();
+    }
+}
+
+FPipe::FPipeScope::FPipeScope(FPipe &InPipe) : Pipe(InPipe) {
+    GPipeCallStack.push_back(&Pipe);
+}
+
+FPipe::FPipeScope::~FPipeScope() {
+    check(GPipeCallStack.back() == &Pipe);
+    GPipeCallStack.pop_back();
+    // 计数归零后管道可能马上被析构; ParkingLot 只用地址做键, 不访问管道本身, 因此唤醒是安全的
+    const void *Address = &Pipe.TaskCount;
+    if (Pipe.TaskCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ParkingLot::WakeAll(Address);
+    }
+}
+} // namespace TE::Tasks
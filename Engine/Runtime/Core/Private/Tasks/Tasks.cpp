@@ -0,0 +1,208 @@
+/******************************************************
+ * @file Tasks/Tasks.cpp
+ * @brief
+ *****************************************************/
+
+#include "Tasks/Tasks.hpp"
+#include "Async/EventCount.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "Trace/Trace.hpp"
+
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace TE::Tasks::Private {
+// 投递给命名线程的任务队列 (多生产者, 单消费者)
+class FNamedThreadQueue {
+  public:
+    void Push(FTaskBase *Task) {
+        {
+            TUniqueLock Lock(Mutex);
+            Queue.push_back(Task);
+        }
+        WorkAvailable.NotifyAll();
+    }
+
+    // 整批取出并执行, 返回执行的任务数
+    // 任务内部可能再次等待 (从而重入 ProcessAll), 因此批次放在局部变量中
+    uint32 ProcessAll() {
+        std::vector<FTaskBase *> Batch;
+        {
+            TUniqueLock Lock(Mutex);
+            Batch.swap(Queue);
+        }
+        // 执行过程中投递的新任务进入 Queue, 由下一轮处理
+        // 已被等待方撤回执行的任务只释放队列的引用, 不计入执行数
+        uint32 NumExecuted = 0;
+        for (FTaskBase *Task: Batch) {
+            NumExecuted += Task->TryExecuteTask() ? 1 : 0;
+            Task->Release();
+        }
+        return NumExecuted;
+    }
+
+    bool IsEmpty() {
+        TUniqueLock Lock(Mutex);
+        return Queue.empty();
+    }
+
+    FEventCount WorkAvailable;
+
+  private:
+    FMutex                   Mutex;
+    std::vector<FTaskBase *> Queue;
+};
+
+namespace {
+FNamedThreadQueue &GetNamedThreadQueue(ENamedThread Thread) {
+    static FNamedThreadQueue Queues[int(ENamedThread::Count)];
+    return Queues[int(Thread)];
+}
+
+thread_local ENamedThread GCurrentNamedThread = ENamedThread::Count;
+
+struct FNoopTaskBody {
+    void operator()() const {}
+};
+} // namespace
+
+void FTaskBase::Schedule() {
+    // 队列持有一份引用: 任务可能先被等待方撤回执行并释放, 队列里的条目之后只是空跑一次
+    AddRef();
+    bScheduled.store(true, std::memory_order_release);
+    if (ExtendedPriority == EExtendedTaskPriority::Inline) {
+        TryExecuteTask();
+        Release();
+    } else if (IsNamedThreadPriority(ExtendedPriority)) {
+        GetNamedThreadQueue(ToNamedThread(ExtendedPriority)).Push(this);
+    } else {
+        ThreadPool::global().submit(
+            [this]() {
+                TryExecuteTask();
+                Release();
+            },
+            ToThreadPoolPriority(Priority));
+    }
+}
+
+bool FTaskBase::TryRetractAndExecute() {
+    if (IsCompleted()) {
+        return true;
+    }
+    // 命名线程的任务只能在该线程上执行
+    if (IsNamedThreadPriority(ExtendedPriority) &&
+        ToNamedThread(ExtendedPriority) != GCurrentNamedThread) {
+        return false;
+    }
+
+    // 前置任务全部完成时, 最后一个完成的前置任务会调度本任务
+    for (std::size_t Index = 0; FTaskBase *Prerequisite = Prerequisites.AddRefAt(Index); ++Index) {
+        const bool bCompleted = Prerequisite->TryRetractAndExecute();
+        Prerequisite->Release();
+        if (!bCompleted) {
+            // 前置任务正在其他线程上执行
+            return false;
+        }
+    }
+
+    // 尚未发射, 或者前置任务刚完成、调度还没走完
+    if (!bScheduled.load(std::memory_order_acquire)) {
+        return IsCompleted();
+    }
+    TryExecuteTask();
+    return IsCompleted();
+}
+
+bool FTaskBase::BusyWaitUntil(FutexInternal::FClock::time_point Deadline) {
+    const bool         bNoDeadline = Deadline == FutexInternal::FClock::time_point::max();
+    const ENamedThread Thread      = GCurrentNamedThread;
+    while (!TryRetractAndExecute()) {
+        if (!bNoDeadline && FutexInternal::FClock::now() >= Deadline) {
+            return false;
+        }
+        if (Thread != ENamedThread::Count && GetNamedThreadQueue(Thread).ProcessAll() != 0) {
+            continue;
+        }
+        if (!ThreadPool::global().tryExecuteOne()) {
+            std::this_thread::yield();
+        }
+    }
+    return true;
+}
+
+bool FTaskBase::WaitUntil(FutexInternal::FClock::time_point Deadline) {
+    const bool         bNoDeadline = Deadline == FutexInternal::FClock::time_point::max();
+    const ENamedThread Thread      = GCurrentNamedThread;
+    if (Thread == ENamedThread::Count) {
+        if (bNoDeadline) {
+            CompletionEvent.Wait();
+            return true;
+        }
+        return CompletionEvent.WaitUntil(Deadline);
+    }
+
+    // 命名线程: 本任务完成时往本线程的队列投递一个空任务把自己唤醒, 期间执行队列里的任务
+    FNamedThreadQueue &Queue  = GetNamedThreadQueue(Thread);
+    auto              *WakeUp = TExecutableTask<FNoopTaskBody>::Create(
+        TEXT("WakeUpNamedThread"), ETaskPriority::High, ToExtendedPriority(Thread),
+        FNoopTaskBody());
+    WakeUp->AddPrerequisite(this);
+    WakeUp->TryLaunch();
+    while (!IsCompleted()) {
+        if (Queue.ProcessAll() != 0) {
+            continue;
+        }
+        FEventCountToken Token = Queue.WorkAvailable.PrepareWait();
+        if (IsCompleted() || !Queue.IsEmpty()) {
+            Queue.WorkAvailable.CancelWait();
+            continue;
+        }
+        if (bNoDeadline) {
+            Queue.WorkAvailable.Wait(Token);
+        } else if (!Queue.WorkAvailable.WaitUntil(Token, Deadline)) {
+            break;
+        }
+    }
+    // 本任务已完成时唤醒任务也已入队, 就地执行掉, 免得之后被 ProcessNamedThreadUntilIdle 计数.
+    // 超时返回时不能撤回: 撤回会沿前置任务把本任务拉到这里执行, 超出等待期限;
+    // 唤醒任务仍留在依赖图中, 之后在本线程上作为空任务执行掉
+    const bool bCompleted = IsCompleted();
+    if (bCompleted) {
+        WakeUp->TryRetractAndExecute();
+    }
+    WakeUp->Release();
+    return bCompleted;
+}
+} // namespace TE::Tasks::Private
+
+namespace TE::Tasks {
+void AttachToNamedThread(ENamedThread Thread) {
+    check(Thread != ENamedThread::Count);
+    check(GetCurrentNamedThread() == ENamedThread::Count);
+    Private::GCurrentNamedThread = Thread;
+    static const char *const ThreadNames[] = { "GameThread", "RenderThread" };
+    static_assert(std::size(ThreadNames) == std::size_t(ENamedThread::Count));
+    Trace::SetCurrentThreadName(ThreadNames[int(Thread)]);
+}
+
+void DetachFromNamedThread() {
+    Private::GCurrentNamedThread = ENamedThread::Count;
+}
+
+ENamedThread GetCurrentNamedThread() {
+    return Private::GCurrentNamedThread;
+}
+
+uint32 ProcessNamedThreadUntilIdle(ENamedThread Thread) {
+    check(GetCurrentNamedThread() == Thread);
+    Private::FNamedThreadQueue &Queue = Private::GetNamedThreadQueue(Thread);
+    uint32                      Count = 0;
+    while (!Queue.IsEmpty()) {
+        Count += Queue.ProcessAll();
+    }
+    return Count;
+}
+} // namespace TE::Tasks
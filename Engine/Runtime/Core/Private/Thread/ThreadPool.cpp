@@ -0,0 +1,15 @@
+/******************************************************
+ * @file Thread/ThreadPool.cpp
+ * @brief 平台无关部分
+ *****************************************************/
+
+#include "Thread/ThreadPool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+ThreadPool &ThreadPool::global() {
+    // 留出一个硬件线程给调用方 (游戏线程)
+    static ThreadPool pool(std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1));
+    return pool;
+}
@@ -3,7 +3,14 @@
  * @brief
  *****************************************************/
 
+#include "Async/EventCount.hpp"
+#include "Async/Futex.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+#include "Memory/FixedBlockAllocator.hpp"
 #include "Thread/ThreadPool.hpp"
+#include "Thread/WorkStealingDeque.hpp"
+#include "Trace/Trace.hpp"
 #include "TypeUtils/CoreType.hpp"
 
 #ifdef ENGINE_PLATFORM_LINUX
@@ -12,153 +19,375 @@
 #include <unistd.h>
 
 #include <atomic>
-#include <functional>
-#include <queue>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+namespace {
+// 任务节点从定长块分配器中复用, 稳定状态下提交任务不会触发 malloc
+struct TaskNode {
+    TUniqueFunction<void()> func;
+    TaskNode               *next = nullptr;
+
+    static void *operator new(std::size_t) { return TObjectAllocator<TaskNode>::Malloc(); }
+    static void  operator delete(void *ptr) { TObjectAllocator<TaskNode>::Free(ptr); }
+};
+} // namespace
+
+// 调度结构:
+// - 每个工作线程拥有一个 Chase-Lev 队列, 工作线程内部提交的任务直接进本地队列
+// - 外部线程提交的任务进入无锁注入队列, 由空闲的工作线程整批取走
+// - 本地队列和注入队列都为空时, 随机选择受害者窃取
+// - 外部线程帮忙执行时从注入队列整批取走, 剩下的放进积压链表, 之后逐个取用
+// - 以上队列按优先级各有一份; 找任务时先把高优先级的三种来源都找遍, 再看下一档
+// 空闲的工作线程先自旋, 再停在 FEventCount 上; 只有存在休眠者时提交方才会发起 futex 唤醒,
+// 任务繁忙时提交与执行全程无锁、无系统调用
 struct ThreadPool::ThreadPoolImpl {
-  int threadCount;
-  std::vector<pthread_t> threads;
-  std::queue<std::function<void()>> tasks;
-
-  pthread_mutex_t mutex;
-  pthread_cond_t cond;        // 用来唤醒工作线程
-  pthread_cond_t condAllDone; // 用来等待所有任务完成
-
-  std::atomic<bool> stop;
-  std::atomic<int> activeCount; // 当前正在执行的任务数
-
-  ThreadPoolImpl(int numThreads)
-      : threadCount(numThreads), threads(numThreads), stop(false),
-        activeCount(0) {
-    if (pthread_mutex_init(&mutex, nullptr) != 0) {
-      throw std::runtime_error("pthread_mutex_init failed");
-    }
-    if (pthread_cond_init(&cond, nullptr) != 0) {
-      pthread_mutex_destroy(&mutex);
-      throw std::runtime_error("pthread_cond_init failed");
-    }
-    if (pthread_cond_init(&condAllDone, nullptr) != 0) {
-      pthread_cond_destroy(&cond);
-      pthread_mutex_destroy(&mutex);
-      throw std::runtime_error("pthread_cond_init condAllDone failed");
-    }
-
-    // 创建线程
-    for (int i = 0; i < threadCount; ++i) {
-      if (pthread_create(&threads[i], nullptr, &ThreadPoolImpl::workerThread,
-                         this) != 0) {
-        // 如果创建失败，需要清理
+    struct Worker {
+        ThreadPoolImpl             *pool;
+        int                         index;
+        uint32_t                    rngState;
+        pthread_t                   thread;
+        WorkStealingDeque<TaskNode> deques[TaskPriorityCount];
+    };
+
+    // 当前线程若是某个线程池的工作线程, 则指向对应的 Worker
+    static thread_local Worker *tlsWorker;
+
+    int                                  threadCount;
+    std::vector<std::unique_ptr<Worker>> workers;
+    InjectionQueue<TaskNode>             injection[TaskPriorityCount];
+
+    // 外部线程不能压入 Chase-Lev 队列, 从注入队列整批取走后剩下的任务按顺序放在这里;
+    // 外部帮手每次取一个, 工作线程整批取走. 只有外部帮手会往里放, 锁上的竞争很少
+    struct Backlog {
+        TE::FMutex              mutex;
+        std::atomic<TaskNode *> head{ nullptr }; // 在锁内修改, 判空时可以不加锁读取
+        TaskNode               *tail = nullptr;
+    };
+    Backlog backlog[TaskPriorityCount];
+
+    TE::FEventCount workAvailable; // 用来唤醒休眠的工作线程
+    TE::FEventCount allDone;       // 用来等待所有任务完成
+
+    std::atomic<bool>                stop;
+    alignas(64) std::atomic<int64_t> pendingCount; // 已提交但尚未执行完的任务数
+
+    ThreadPoolImpl(int numThreads) : threadCount(numThreads), stop(false), pendingCount(0) {
+        workers.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            auto worker      = std::make_unique<Worker>();
+            worker->pool     = this;
+            worker->index    = i;
+            worker->rngState = 0x9E3779B9u * static_cast<uint32_t>(i + 1);
+            workers.push_back(std::move(worker));
+        }
+
+        // 创建线程
+        for (int i = 0; i < threadCount; ++i) {
+            if (pthread_create(&workers[i]->thread, nullptr, &ThreadPoolImpl::workerThread,
+                               workers[i].get()) != 0) {
+                // 如果创建失败，需要清理
+                stop = true;
+                workAvailable.NotifyAll();
+                for (int j = 0; j < i; ++j) {
+                    pthread_join(workers[j]->thread, nullptr);
+                }
+                throw std::runtime_error("pthread_create failed");
+            }
+        }
+    }
+
+    ~ThreadPoolImpl() {
+        // 先把已提交的任务全部执行完，再通知所有线程停止
+        waitAllTasksDone();
         stop = true;
-        pthread_cond_broadcast(&cond);
-        for (int j = 0; j < i; ++j) {
-          pthread_join(threads[j], nullptr);
-        }
-        pthread_cond_destroy(&condAllDone);
-        pthread_cond_destroy(&cond);
-        pthread_mutex_destroy(&mutex);
-        throw std::runtime_error("pthread_create failed");
-      }
-    }
-  }
-
-  ~ThreadPoolImpl() {
-    // 通知所有线程停止
-    stop = true;
-    pthread_cond_broadcast(&cond);
-
-    // 等待所有线程结束
-    for (int i = 0; i < threadCount; ++i) {
-      pthread_join(threads[i], nullptr);
-    }
-    pthread_cond_destroy(&condAllDone);
-    pthread_cond_destroy(&cond);
-    pthread_mutex_destroy(&mutex);
-  }
-
-  static void *workerThread(void *arg) {
-    ThreadPoolImpl *impl = static_cast<ThreadPoolImpl *>(arg);
-    impl->threadLoop();
-    return nullptr;
-  }
-
-  void threadLoop() {
-    while (true) {
-      std::function<void()> task;
-
-      pthread_mutex_lock(&mutex);
-
-      while (!stop && tasks.empty()) {
-        pthread_cond_wait(&cond, &mutex);
-      }
-
-      // 如果停止了且没有任务，直接退出
-      if (stop && tasks.empty()) {
-        pthread_mutex_unlock(&mutex);
-        break;
-      }
-
-      // 从队列取任务
-      task = std::move(tasks.front());
-      tasks.pop();
-      // 取到任务后，activeCount++，表示我们开始执行一个任务
-      activeCount.fetch_add(1, std::memory_order_relaxed);
-
-      pthread_mutex_unlock(&mutex);
-
-      // 执行任务
-      task();
-
-      // 任务执行完了，activeCount--
-      int stillActive = activeCount.fetch_sub(1, std::memory_order_relaxed) - 1;
-
-      // 如果此时 activeCount == 0，说明没有正在执行的任务了
-      // 但也要考虑队列中还有没有剩余任务。不过，对于 waitAll 而言，
-      // “执行完的任务”减少了 activeCount，就有机会唤醒 waitAll
-      // 注意：这里要再次加锁再发signal，避免和 waitAll 的锁冲突
-      pthread_mutex_lock(&mutex);
-      if (stillActive == 0 && tasks.empty()) {
-        // 所有任务都执行完了，可以唤醒 waitAll
-        pthread_cond_broadcast(&condAllDone);
-      }
-      pthread_mutex_unlock(&mutex);
-    }
-  }
-
-  void enqueueTask(std::function<void()> f) {
-    pthread_mutex_lock(&mutex);
-    tasks.push(std::move(f));
-    pthread_mutex_unlock(&mutex);
-    pthread_cond_signal(&cond);
-  }
-
-  void waitAllTasksDone() {
-    // 等待“队列为空 且 activeCount == 0”
-    pthread_mutex_lock(&mutex);
-    while (!tasks.empty() || activeCount.load(std::memory_order_relaxed) > 0) {
-      pthread_cond_wait(&condAllDone, &mutex);
-      // 被唤醒后再检查是否真的都结束
-    }
-    pthread_mutex_unlock(&mutex);
-  }
+        workAvailable.NotifyAll();
+
+        // 等待所有线程结束
+        for (auto &worker: workers) {
+            pthread_join(worker->thread, nullptr);
+        }
+    }
+
+    static void *workerThread(void *arg) {
+        Worker *worker = static_cast<Worker *>(arg);
+        tlsWorker      = worker;
+        TE::Trace::SetCurrentThreadName(("Worker " + std::to_string(worker->index)).c_str());
+        worker->pool->threadLoop(*worker);
+        tlsWorker = nullptr;
+        return nullptr;
+    }
+
+    static uint32_t nextRandom(uint32_t &state) {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // 是否还有可执行的任务 (近似值)
+    bool hasWork() const {
+        for (int priority = 0; priority < TaskPriorityCount; ++priority) {
+            if (!injection[priority].isEmptyApprox() ||
+                backlog[priority].head.load(std::memory_order_relaxed)) {
+                return true;
+            }
+            for (const auto &worker: workers) {
+                if (!worker->deques[priority].isEmptyApprox()) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // 从注入队列或积压链表整批取走任务: 第一个直接返回, 其余放进本地队列供他人窃取
+    TaskNode *takeFromInjection(Worker &self, int priority) {
+        return takeBatch(self, priority, injection[priority].popAll());
+    }
+
+    TaskNode *takeFromBacklog(Worker &self, int priority) {
+        Backlog &list = backlog[priority];
+        if (!list.head.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        TaskNode *batch;
+        {
+            TE::TUniqueLock lock(list.mutex);
+            batch = list.head.load(std::memory_order_relaxed);
+            list.head.store(nullptr, std::memory_order_relaxed);
+            list.tail = nullptr;
+        }
+        return takeBatch(self, priority, batch);
+    }
+
+    TaskNode *takeBatch(Worker &self, int priority, TaskNode *batch) {
+        if (!batch) {
+            return nullptr;
+        }
+        TaskNode *rest = batch->next;
+        if (rest) {
+            while (rest) {
+                TaskNode *next = rest->next;
+                self.deques[priority].push(rest);
+                rest = next;
+            }
+            // 剩余的任务需要帮手, 唤醒一个休眠的同伴来窃取
+            workAvailable.NotifyOne();
+        }
+        return batch;
+    }
+
+    TaskNode *stealFromOthers(Worker &self, int priority) {
+        if (threadCount <= 1) {
+            return nullptr;
+        }
+        int start = static_cast<int>(nextRandom(self.rngState) % threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            Worker &victim = *workers[(start + i) % threadCount];
+            if (&victim == &self) {
+                continue;
+            }
+            if (TaskNode *node = victim.deques[priority].steal()) {
+                // 受害者仍有积压, 继续唤醒同伴, 让休眠的线程逐个加入
+                if (!victim.deques[priority].isEmptyApprox()) {
+                    workAvailable.NotifyOne();
+                }
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    TaskNode *findTask(Worker &self) {
+        for (int priority = 0; priority < TaskPriorityCount; ++priority) {
+            if (TaskNode *node = self.deques[priority].pop()) {
+                return node;
+            }
+            // 积压链表里的任务比注入队列里的先提交
+            if (TaskNode *node = takeFromBacklog(self, priority)) {
+                return node;
+            }
+            if (TaskNode *node = takeFromInjection(self, priority)) {
+                return node;
+            }
+            if (TaskNode *node = stealFromOthers(self, priority)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // 非工作线程帮忙执行任务: 先窃取, 再从积压链表取一个;
+    // 都没有时从注入队列整批取走, 第一个直接返回, 其余接到积压链表末尾
+    TaskNode *findTaskExternal() {
+        thread_local uint32_t rngState = 0x85EBCA6Bu;
+        for (int priority = 0; priority < TaskPriorityCount; ++priority) {
+            int start = static_cast<int>(nextRandom(rngState) % threadCount);
+            for (int i = 0; i < threadCount; ++i) {
+                if (TaskNode *node = workers[(start + i) % threadCount]->deques[priority].steal()) {
+                    return node;
+                }
+            }
+            if (TaskNode *node = popFromBacklog(priority)) {
+                return node;
+            }
+            if (TaskNode *batch = injection[priority].popAll()) {
+                if (batch->next) {
+                    appendToBacklog(priority, batch->next);
+                }
+                return batch;
+            }
+        }
+        return nullptr;
+    }
+
+    TaskNode *popFromBacklog(int priority) {
+        Backlog &list = backlog[priority];
+        if (!list.head.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        TE::TUniqueLock lock(list.mutex);
+        TaskNode       *node = list.head.load(std::memory_order_relaxed);
+        if (node) {
+            list.head.store(node->next, std::memory_order_relaxed);
+            if (!node->next) {
+                list.tail = nullptr;
+            }
+        }
+        return node;
+    }
+
+    // 遍历一次找到链尾, 每批只发生一次
+    void appendToBacklog(int priority, TaskNode *first) {
+        TaskNode *last = first;
+        while (last->next) {
+            last = last->next;
+        }
+        Backlog &list = backlog[priority];
+        {
+            TE::TUniqueLock lock(list.mutex);
+            if (list.tail) {
+                list.tail->next = first;
+            } else {
+                list.head.store(first, std::memory_order_relaxed);
+            }
+            list.tail = last;
+        }
+        // 外部帮手随时可能停止帮忙, 叫醒一个工作线程来处理剩下的任务
+        workAvailable.NotifyOne();
+    }
+
+    bool tryExecuteOne() {
+        Worker   *self = tlsWorker;
+        TaskNode *node = (self && self->pool == this) ? findTask(*self) : findTaskExternal();
+        if (!node) {
+            return false;
+        }
+        runTask(node);
+        return true;
+    }
+
+    void runTask(TaskNode *node) {
+        // 执行任务
+        node->func();
+        delete node;
+
+        // 最后一个任务执行完毕时才需要去唤醒 waitAll
+        if (pendingCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            allDone.NotifyAll();
+        }
+    }
+
+    void threadLoop(Worker &self) {
+        while (true) {
+            if (TaskNode *node = findTask(self)) {
+                runTask(node);
+                continue;
+            }
+
+            if (stop.load(std::memory_order_acquire) && !hasWork()) {
+                break;
+            }
+
+            // 找不到任务时先自旋一小段时间, 避免任务间隙里频繁进出内核
+            if (TE::FutexInternal::SpinUntil([this] {
+                    return hasWork() || stop.load(std::memory_order_relaxed);
+                })) {
+                continue;
+            }
+
+            // 休眠协议: 先登记为等待者, 再复查是否有任务;
+            // 提交方先发布任务, 再检查等待者, 两边至少有一方能看到对方
+            TE::FEventCountToken token = workAvailable.PrepareWait();
+            if (stop.load(std::memory_order_relaxed) || hasWork()) {
+                workAvailable.CancelWait();
+                continue;
+            }
+            workAvailable.Wait(token);
+        }
+    }
+
+    void enqueueTask(TUniqueFunction<void()> f, int priority) {
+        TaskNode *node = new TaskNode{ std::move(f) };
+        pendingCount.fetch_add(1, std::memory_order_relaxed);
+
+        // 工作线程内部提交 => 本地队列; 外部线程提交 => 注入队列
+        Worker *self = tlsWorker;
+        if (self && self->pool == this) {
+            self->deques[priority].push(node);
+        } else {
+            injection[priority].push(node);
+        }
+
+        // 没有休眠的工作线程时只是一次读操作
+        workAvailable.NotifyOne();
+    }
+
+    void waitAllTasksDone() {
+        // 等待 "所有已提交任务都执行完毕"
+        while (pendingCount.load(std::memory_order_acquire) > 0) {
+            TE::FEventCountToken token = allDone.PrepareWait();
+            if (pendingCount.load(std::memory_order_acquire) == 0) {
+                allDone.CancelWait();
+                break;
+            }
+            allDone.Wait(token);
+        }
+    }
 };
 
+thread_local ThreadPool::ThreadPoolImpl::Worker *ThreadPool::ThreadPoolImpl::tlsWorker = nullptr;
+
 // ============== ThreadPool 对外接口实现 =============
 
 ThreadPool::ThreadPool(int numThreads) {
-  if (numThreads <= 0) {
-    numThreads = 1;
-  }
-  impl_ = std::make_unique<ThreadPoolImpl>(numThreads);
+    if (numThreads <= 0) {
+        numThreads = 1;
+    }
+    impl_ = std::make_unique<ThreadPoolImpl>(numThreads);
 }
 
 ThreadPool::~ThreadPool() = default;
 
-void ThreadPool::submit(std::function<void()> task) {
-  impl_->enqueueTask(std::move(task));
+void ThreadPool::submit(TUniqueFunction<void()> task, TaskPriority priority) {
+    impl_->enqueueTask(std::move(task), static_cast<int>(priority));
 }
 
-void ThreadPool::waitAll() { impl_->waitAllTasksDone(); }
+void ThreadPool::waitAll() {
+    impl_->waitAllTasksDone();
+}
+
+bool ThreadPool::tryExecuteOne() {
+    return impl_->tryExecuteOne();
+}
+
+int ThreadPool::threadCount() const {
+    return impl_->threadCount;
+}
 
 #endif // __linux__
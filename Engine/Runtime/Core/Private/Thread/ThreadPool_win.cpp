@@ -4,6 +4,7 @@
  *****************************************************/
 
 #include "Thread/ThreadPool.hpp"
+#include "Trace/Trace.hpp"
 #include "TypeUtils/CoreType.hpp"
 
 #ifdef ENGINE_PLATFORM_WINDOWS
@@ -11,17 +12,17 @@
 #include <windows.h>
 
 #include <atomic>
-#include <functional>
 #include <queue>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 struct ThreadPool::ThreadPoolImpl {
     int                 threadCount;
     std::vector<HANDLE> threads;
 
-    // 任务队列及其保护
-    std::queue<std::function<void()>> tasks;
+    // 每个优先级一个任务队列, 共用一把锁
+    std::queue<TUniqueFunction<void()>> tasks[TaskPriorityCount];
     CRITICAL_SECTION                  lock;
     CONDITION_VARIABLE                cond;        // 通知工作线程有任务可执行
     CONDITION_VARIABLE                condAllDone; // 通知 waitAll() 所有任务执行完毕
@@ -30,6 +31,8 @@ struct ThreadPool::ThreadPoolImpl {
     std::atomic<bool> stop;
     // 当前正在执行的任务计数
     std::atomic<int> activeCount;
+    // 给工作线程编号, 只用于追踪结果中的线程名
+    std::atomic<int> nextWorkerIndex{ 0 };
 
     ThreadPoolImpl(int numThreads)
         : threadCount(numThreads), threads(numThreads), stop(false), activeCount(0) {
@@ -78,52 +81,88 @@ struct ThreadPool::ThreadPoolImpl {
 
     static DWORD WINAPI threadEntry(LPVOID arg) {
         ThreadPoolImpl *impl = static_cast<ThreadPoolImpl *>(arg);
+        TE::Trace::SetCurrentThreadName(
+            ("Worker " + std::to_string(impl->nextWorkerIndex.fetch_add(1))).c_str());
         impl->threadLoop();
         return 0;
     }
 
     void threadLoop() {
         for (;;) {
-            std::function<void()> task;
-
             // 加锁取任务
             EnterCriticalSection(&lock);
             // 没任务且未 stop 时，睡眠等待
-            while (!stop && tasks.empty()) {
+            while (!stop && !hasTasks()) {
                 SleepConditionVariableCS(&cond, &lock, INFINITE);
             }
             // 如果 stop 并且任务队列空，则退出线程
-            if (stop && tasks.empty()) {
+            if (stop && !hasTasks()) {
                 LeaveCriticalSection(&lock);
                 break;
             }
 
-            // 取出一个任务
-            task = std::move(tasks.front());
-            tasks.pop();
-            // 取到任务后，活动数+1
-            activeCount.fetch_add(1, std::memory_order_relaxed);
-
+            TUniqueFunction<void()> task = popHighestLocked();
             LeaveCriticalSection(&lock);
 
-            // 执行任务
-            task();
-
-            // 任务执行结束后，activeCount - 1
-            int stillActive = activeCount.fetch_sub(1, std::memory_order_relaxed) - 1;
+            runTask(task);
+        }
+    }
 
-            // 如果此时没有活动任务了 (stillActive==0)，并且队列也空了，则可唤醒等待方
-            EnterCriticalSection(&lock);
-            if (stillActive == 0 && tasks.empty()) {
-                WakeAllConditionVariable(&condAllDone);
+    // 调用方需持有 lock 且队列非空: 取出优先级最高的一个任务, 活动数+1
+    TUniqueFunction<void()> popHighestLocked() {
+        TUniqueFunction<void()> task;
+        for (auto &queue: tasks) {
+            if (!queue.empty()) {
+                task = std::move(queue.front());
+                queue.pop();
+                break;
             }
+        }
+        activeCount.fetch_add(1, std::memory_order_relaxed);
+        return task;
+    }
+
+    void runTask(TUniqueFunction<void()> &task) {
+        // 执行任务
+        task();
+
+        // 任务执行结束后，activeCount - 1
+        int stillActive = activeCount.fetch_sub(1, std::memory_order_relaxed) - 1;
+
+        // 如果此时没有活动任务了 (stillActive==0)，并且队列也空了，则可唤醒等待方
+        EnterCriticalSection(&lock);
+        if (stillActive == 0 && !hasTasks()) {
+            WakeAllConditionVariable(&condAllDone);
+        }
+        LeaveCriticalSection(&lock);
+    }
+
+    bool tryExecuteOne() {
+        EnterCriticalSection(&lock);
+        if (!hasTasks()) {
             LeaveCriticalSection(&lock);
+            return false;
+        }
+        TUniqueFunction<void()> task = popHighestLocked();
+        LeaveCriticalSection(&lock);
+
+        runTask(task);
+        return true;
+    }
+
+    // 调用方需持有 lock
+    bool hasTasks() const {
+        for (const auto &queue: tasks) {
+            if (!queue.empty()) {
+                return true;
+            }
         }
+        return false;
     }
 
-    void enqueueTask(std::function<void()> f) {
+    void enqueueTask(TUniqueFunction<void()> f, int priority) {
         EnterCriticalSection(&lock);
-        tasks.push(std::move(f));
+        tasks[priority].push(std::move(f));
         LeaveCriticalSection(&lock);
         // 唤醒一个工作线程
         WakeConditionVariable(&cond);
@@ -132,7 +171,7 @@ struct ThreadPool::ThreadPoolImpl {
     void waitAllTasksDone() {
         // 等待队列为空且没有正在执行的任务
         EnterCriticalSection(&lock);
-        while (!tasks.empty() || activeCount.load(std::memory_order_relaxed) > 0) {
+        while (hasTasks() || activeCount.load(std::memory_order_relaxed) > 0) {
             SleepConditionVariableCS(&condAllDone, &lock, INFINITE);
         }
         LeaveCriticalSection(&lock);
@@ -150,11 +189,19 @@ ThreadPool::ThreadPool(int numThreads) {
 
 ThreadPool::~ThreadPool() = default;
 
-void ThreadPool::submit(std::function<void()> task) {
-    impl_->enqueueTask(std::move(task));
+void ThreadPool::submit(TUniqueFunction<void()> task, TaskPriority priority) {
+    impl_->enqueueTask(std::move(task), static_cast<int>(priority));
 }
 
 void ThreadPool::waitAll() {
     impl_->waitAllTasksDone();
 }
+
+bool ThreadPool::tryExecuteOne() {
+    return impl_->tryExecuteOne();
+}
+
+int ThreadPool::threadCount() const {
+    return impl_->threadCount;
+}
 #endif
\ No newline at end of file
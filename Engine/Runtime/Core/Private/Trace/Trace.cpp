@@ -0,0 +1,244 @@
+/******************************************************
+ * @file Trace/Trace.cpp
+ * @brief
+ *****************************************************/
+
+#include "Trace/Trace.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace TE::Trace::Private {
+std::atomic<bool>   GTracing{ false };
+std::atomic<uint32> GTraceSession{ 0 };
+
+namespace {
+// 字段都是 relaxed 原子量: 写入方只有所属线程, 导出方通过 Head 的 acquire 读取看到完整的事件
+struct FTraceEvent {
+    std::atomic<const TCHAR *> Name{ nullptr };
+    std::atomic<uint64>        BeginTimestamp{ 0 };
+    std::atomic<uint64>        EndTimestamp{ 0 };
+};
+
+struct FThreadBuffer {
+    uint32      ThreadId = 0;
+    std::string ThreadName; // 受 FRegistry::Mutex 保护
+
+    // 事件数组在第一次写入时才分配, 从不记录的线程 (例如一直空闲的工作线程) 不占内存
+    std::atomic<FTraceEvent *>     Events{ nullptr };
+    std::unique_ptr<FTraceEvent[]> EventStorage;
+    std::atomic<uint64>            Head{ 0 }; // 累计写入的事件数
+    // 缓冲区中事件所属的采集序号, 只由所属线程在发现新采集时更新并清空自己的缓冲区
+    std::atomic<uint32>            Session{ 0 };
+};
+
+// 线程退出后缓冲区仍然保留, 以便导出它记录过的事件
+struct FRegistry {
+    FMutex                                      Mutex;
+    std::vector<std::unique_ptr<FThreadBuffer>> Buffers;
+    uint64                                      StartTimestamp = 0;
+    std::chrono::steady_clock::time_point       StartTime;
+};
+
+FRegistry &GetRegistry() {
+    // 进程退出时其他线程可能仍在记录, 故意不析构
+    static FRegistry *Registry = new FRegistry();
+    return *Registry;
+}
+
+FThreadBuffer &GetThreadBuffer() {
+    thread_local FThreadBuffer *Buffer = nullptr;
+    if (UNLIKELY(!Buffer)) {
+        FRegistry  &Registry  = GetRegistry();
+        auto        NewBuffer = std::make_unique<FThreadBuffer>();
+        TUniqueLock Lock(Registry.Mutex);
+        NewBuffer->ThreadId = uint32(Registry.Buffers.size());
+        Buffer              = NewBuffer.get();
+        Registry.Buffers.push_back(std::move(NewBuffer));
+    }
+    return *Buffer;
+}
+
+// 名字只在导出时转码: UTF-16 -> UTF-8, 同时做 JSON 转义
+void AppendJsonString(std::string &Out, const TCHAR *Name) {
+    Out += '"';
+    for (const TCHAR *It = Name; *It; ++It) {
+        uint32 CodePoint = uint32(*It);
+        if (CodePoint >= 0xD800 && CodePoint < 0xDC00 && It[1] >= 0xDC00 && It[1] < 0xE000) {
+            CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (uint32(It[1]) - 0xDC00);
+            ++It;
+        }
+        if (CodePoint == '"' || CodePoint == '\\') {
+            Out += '\\';
+            Out += char(CodePoint);
+        } else if (CodePoint < 0x20) {
+            char Escaped[8];
+            std::snprintf(Escaped, sizeof(Escaped), "\\u%04x", CodePoint);
+            Out += Escaped;
+        } else if (CodePoint < 0x80) {
+            Out += char(CodePoint);
+        } else if (CodePoint < 0x800) {
+            Out += char(0xC0 | (CodePoint >> 6));
+            Out += char(0x80 | (CodePoint & 0x3F));
+        } else if (CodePoint < 0x10000) {
+            Out += char(0xE0 | (CodePoint >> 12));
+            Out += char(0x80 | ((CodePoint >> 6) & 0x3F));
+            Out += char(0x80 | (CodePoint & 0x3F));
+        } else {
+            Out += char(0xF0 | (CodePoint >> 18));
+            Out += char(0x80 | ((CodePoint >> 12) & 0x3F));
+            Out += char(0x80 | ((CodePoint >> 6) & 0x3F));
+            Out += char(0x80 | (CodePoint & 0x3F));
+        }
+    }
+    Out += '"';
+}
+
+// 线程名本来就是 UTF-8, 只做转义
+void AppendJsonString(std::string &Out, const std::string &Name) {
+    Out += '"';
+    for (const char Char: Name) {
+        if (Char == '"' || Char == '\\') {
+            Out += '\\';
+            Out += Char;
+        } else if (uint8(Char) < 0x20) {
+            Out += ' ';
+        } else {
+            Out += Char;
+        }
+    }
+    Out += '"';
+}
+} // namespace
+
+void WriteEvent(const TCHAR *Name, uint32 Session, uint64 BeginTimestamp, uint64 EndTimestamp) {
+    // 跨越 StartTracing 的作用域属于上一次采集
+    if (Session != GTraceSession.load(std::memory_order_acquire)) {
+        return;
+    }
+    FThreadBuffer &Buffer = GetThreadBuffer();
+    if (Buffer.Session.load(std::memory_order_relaxed) != Session) {
+        // 先清空再发布序号: 导出方看到新序号时 Head 已经归零
+        Buffer.Head.store(0, std::memory_order_relaxed);
+        Buffer.Session.store(Session, std::memory_order_release);
+    }
+    FTraceEvent   *Events = Buffer.Events.load(std::memory_order_relaxed);
+    if (UNLIKELY(!Events)) {
+        Buffer.EventStorage = std::make_unique<FTraceEvent[]>(ThreadEventCapacity);
+        Events              = Buffer.EventStorage.get();
+        Buffer.Events.store(Events, std::memory_order_release);
+    }
+    const uint64 Head  = Buffer.Head.load(std::memory_order_relaxed);
+    FTraceEvent &Event = Events[Head & (ThreadEventCapacity - 1)];
+    Event.Name.store(Name, std::memory_order_relaxed);
+    Event.BeginTimestamp.store(BeginTimestamp, std::memory_order_relaxed);
+    Event.EndTimestamp.store(EndTimestamp, std::memory_order_relaxed);
+    Buffer.Head.store(Head + 1, std::memory_order_release);
+}
+} // namespace TE::Trace::Private
+
+namespace TE::Trace {
+using namespace Private;
+
+void StartTracing() {
+    FRegistry &Registry = GetRegistry();
+    {
+        // 缓冲区不在这里清空: 其他线程可能正在写入, 由它们在下次写入时各自清空
+        TUniqueLock Lock(Registry.Mutex);
+        GTraceSession.fetch_add(1, std::memory_order_release);
+        Registry.StartTime      = std::chrono::steady_clock::now();
+        Registry.StartTimestamp = ReadTimestamp();
+    }
+    GTracing.store(true, std::memory_order_release);
+}
+
+void StopTracing() {
+    GTracing.store(false, std::memory_order_release);
+}
+
+void SetCurrentThreadName(const char *Name) {
+    FThreadBuffer &Buffer   = GetThreadBuffer();
+    FRegistry     &Registry = GetRegistry();
+    TUniqueLock    Lock(Registry.Mutex);
+    Buffer.ThreadName = Name;
+}
+
+std::string ExportChromeTrace() {
+    FRegistry  &Registry = GetRegistry();
+    TUniqueLock Lock(Registry.Mutex);
+
+    // 时间戳与墙钟的比例按 "开始记录 -> 导出" 这段时间计算
+    const uint64 EndTimestamp = ReadTimestamp();
+    const double ElapsedNs    = double(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now() - Registry.StartTime)
+                                        .count());
+    const double NsPerTick =
+        EndTimestamp > Registry.StartTimestamp
+            ? ElapsedNs / double(EndTimestamp - Registry.StartTimestamp)
+            : 1.0;
+    auto ToMicroseconds = [&](uint64 Timestamp) {
+        const double Ticks = Timestamp >= Registry.StartTimestamp
+                                 ? double(Timestamp - Registry.StartTimestamp)
+                                 : -double(Registry.StartTimestamp - Timestamp);
+        return Ticks * NsPerTick / 1000.0;
+    };
+
+    const uint32 Session = GTraceSession.load(std::memory_order_relaxed);
+
+    std::string Out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool        bFirst = true;
+    char        Fragment[160];
+    for (const auto &Buffer: Registry.Buffers) {
+        const std::string ThreadName =
+            Buffer->ThreadName.empty() ? "Thread " + std::to_string(Buffer->ThreadId)
+                                       : Buffer->ThreadName;
+        std::snprintf(Fragment, sizeof(Fragment),
+                      "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                      "\"args\":{\"name\":",
+                      bFirst ? "" : ",", Buffer->ThreadId);
+        Out += Fragment;
+        bFirst = false;
+        AppendJsonString(Out, ThreadName);
+        Out += "}}";
+
+        // 本次采集中还没写过事件的线程, 缓冲区里只有旧采集的事件
+        if (Buffer->Session.load(std::memory_order_acquire) != Session) {
+            continue;
+        }
+        const FTraceEvent *Events = Buffer->Events.load(std::memory_order_acquire);
+        const uint64       Head   = Buffer->Head.load(std::memory_order_acquire);
+        if (!Events) {
+            continue;
+        }
+        const uint64 First = Head > ThreadEventCapacity ? Head - ThreadEventCapacity : 0;
+        for (uint64 Index = First; Index < Head; ++Index) {
+            const FTraceEvent &Event = Events[Index & (ThreadEventCapacity - 1)];
+            const TCHAR       *Name  = Event.Name.load(std::memory_order_relaxed);
+            const uint64       Begin = Event.BeginTimestamp.load(std::memory_order_relaxed);
+            const uint64       End   = Event.EndTimestamp.load(std::memory_order_relaxed);
+            Out += ",{\"name\":";
+            AppendJsonString(Out, Name ? Name : TEXT("<unnamed>"));
+            std::snprintf(Fragment, sizeof(Fragment),
+                          ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                          Buffer->ThreadId, ToMicroseconds(Begin),
+                          End > Begin ? double(End - Begin) * NsPerTick / 1000.0 : 0.0);
+            Out += Fragment;
+        }
+    }
+    Out += "]}\n";
+    return Out;
+}
+
+bool WriteChromeTrace(const char *Path) {
+    const std::string Json = ExportChromeTrace();
+    std::FILE        *File = std::fopen(Path, "wb");
+    if (!File) {
+        return false;
+    }
+    const bool bWritten = std::fwrite(Json.data(), 1, Json.size(), File) == Json.size();
+    return std::fclose(File) == 0 && bWritten;
+}
+} // namespace TE::Trace
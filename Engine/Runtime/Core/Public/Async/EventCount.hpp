@@ -0,0 +1,104 @@
+/******************************************************
+ * @file Async/EventCount.hpp
+ * @brief 事件计数: 无锁数据结构的 "条件变量"
+ *****************************************************/
+
+#pragma once
+
+#include "Async/Futex.hpp"
+
+#include <atomic>
+
+namespace TE {
+class FEventCountToken {
+  public:
+    explicit operator bool() const { return bValid; }
+
+  private:
+    friend class FEventCount;
+
+    uint32 Epoch  = 0;
+    bool   bValid = false;
+};
+
+// 用法 (等待方):
+//     FEventCountToken Token = Event.PrepareWait();
+//     if (条件已满足) { Event.CancelWait(); } else { Event.Wait(Token); }
+// 用法 (通知方):
+//     修改条件; Event.NotifyOne() 或 Event.NotifyAll();
+//
+// 通知方只有在存在等待者时才会写共享变量并发起系统调用,
+// 因此在无人等待的热路径上 Notify 只是一次读操作.
+// 参考: folly::EventCount, Engine/Source/Runtime/Core/Public/Async/EventCount.h
+class FEventCount {
+  public:
+    constexpr FEventCount() = default;
+
+    FEventCount(const FEventCount &)            = delete;
+    FEventCount &operator=(const FEventCount &) = delete;
+
+    [[nodiscard]] FEventCountToken PrepareWait() {
+        Waiters.fetch_add(1, std::memory_order_seq_cst);
+        FEventCountToken Token;
+        Token.Epoch  = Epoch.load(std::memory_order_seq_cst);
+        Token.bValid = true;
+        // 之后调用方对条件的读取不能越过登记
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return Token;
+    }
+
+    // PrepareWait 之后发现条件已满足, 不再等待
+    void CancelWait() { Waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+    // 阻塞直到 PrepareWait 之后有过一次通知
+    void Wait(FEventCountToken Token) {
+        if (!FutexInternal::SpinUntil([this, Token] { return IsNotifiedSince(Token); })) {
+            while (!IsNotifiedSince(Token)) {
+                FutexInternal::FutexWait(Epoch, Token.Epoch);
+            }
+        }
+        Waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // 超时返回 false
+    bool WaitUntil(FEventCountToken Token, FutexInternal::FClock::time_point Deadline) {
+        bool bNotified =
+            FutexInternal::SpinUntil([this, Token] { return IsNotifiedSince(Token); });
+        while (!bNotified) {
+            if (!FutexInternal::FutexWaitUntil(Epoch, Token.Epoch, Deadline)) {
+                bNotified = IsNotifiedSince(Token);
+                break;
+            }
+            bNotified = IsNotifiedSince(Token);
+        }
+        Waiters.fetch_sub(1, std::memory_order_relaxed);
+        return bNotified;
+    }
+
+    void NotifyOne() { Notify(/*bAll=*/false); }
+    void NotifyAll() { Notify(/*bAll=*/true); }
+
+  private:
+    bool IsNotifiedSince(FEventCountToken Token) const {
+        return Epoch.load(std::memory_order_acquire) != Token.Epoch;
+    }
+
+    void Notify(bool bAll) {
+        // 与 PrepareWait 构成 Dekker 式同步: 通知方先发布条件再检查等待者,
+        // 等待方先登记再检查条件, 两者至少有一方能看到对方
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (LIKELY(Waiters.load(std::memory_order_relaxed) == 0)) {
+            return;
+        }
+        Epoch.fetch_add(1, std::memory_order_release);
+        if (bAll) {
+            FutexInternal::FutexWakeAll(Epoch);
+        } else {
+            FutexInternal::FutexWakeOne(Epoch);
+        }
+    }
+
+    std::atomic<uint32> Epoch{ 0 };
+    std::atomic<uint32> Waiters{ 0 };
+};
+} // namespace TE
@@ -0,0 +1,54 @@
+/******************************************************
+ * @file Async/Futex.hpp
+ * @brief 基于地址的等待/唤醒 (Linux futex / Windows WaitOnAddress)
+ *****************************************************/
+
+#pragma once
+
+#include "MarcoUtils/PlatformMarco.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <atomic>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace TE::FutexInternal {
+using FClock = std::chrono::steady_clock;
+
+// 若 Word 仍等于 Expected 则休眠, 直到被唤醒 (可能虚假唤醒, 调用方需循环检查)
+void FutexWait(const std::atomic<uint32> &Word, uint32 Expected);
+
+// 同 FutexWait, 但最多等到 Deadline; 超时返回 false
+bool FutexWaitUntil(const std::atomic<uint32> &Word, uint32 Expected, FClock::time_point Deadline);
+
+void FutexWakeOne(const std::atomic<uint32> &Word);
+void FutexWakeAll(const std::atomic<uint32> &Word);
+
+// 自旋等待时的 CPU 提示
+FORCEINLINE void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// 进入内核休眠前的自旋轮数上限, 每轮的 pause 次数指数增长
+inline constexpr int SpinLimit = 10;
+
+// 自旋等待 Condition 变为 true, 超过 SpinLimit 轮仍未满足时返回 false
+template <typename ConditionType> bool SpinUntil(ConditionType &&Condition) {
+    for (int Round = 0; Round < SpinLimit; ++Round) {
+        if (Condition()) {
+            return true;
+        }
+        for (int Pause = 0; Pause < (1 << Round); ++Pause) {
+            CpuRelax();
+        }
+    }
+    return Condition();
+}
+} // namespace TE::FutexInternal
@@ -0,0 +1,82 @@
+/******************************************************
+ * @file Async/ManualResetEvent.hpp
+ * @brief 1 字节手动复位事件
+ *****************************************************/
+
+#pragma once
+
+#include "Async/Futex.hpp"
+#include "Async/ParkingLot.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace TE {
+// Notify 之后一直保持触发状态, 直到 Reset; 可以有任意多个等待者
+// 等待者停在 ParkingLot 中, 事件本身只占一个字节
+// 参考: Engine/Source/Runtime/Core/Public/Async/ManualResetEvent.h
+class FManualResetEvent {
+  public:
+    constexpr FManualResetEvent() = default;
+
+    FManualResetEvent(const FManualResetEvent &)            = delete;
+    FManualResetEvent &operator=(const FManualResetEvent &) = delete;
+
+    bool IsNotified() const { return State.load(std::memory_order_acquire) & IsNotifiedFlag; }
+
+    void Wait() {
+        if (LIKELY(IsNotified()) || FutexInternal::SpinUntil([this] { return IsNotified(); })) {
+            return;
+        }
+        while (!IsNotified()) {
+            if (PrepareWait()) {
+                ParkingLot::Wait(&State, [this] { return CanWait(); }, [] {});
+            }
+        }
+    }
+
+    // 超时返回 false
+    bool WaitUntil(FutexInternal::FClock::time_point Deadline) {
+        if (LIKELY(IsNotified()) || FutexInternal::SpinUntil([this] { return IsNotified(); })) {
+            return true;
+        }
+        while (!IsNotified()) {
+            if (PrepareWait()) {
+                ParkingLot::FWaitState WaitState =
+                    ParkingLot::WaitUntil(&State, [this] { return CanWait(); }, [] {}, Deadline);
+                if (WaitState.bDidWait && !WaitState.bDidWake) {
+                    return IsNotified();
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename Rep, typename Period>
+    bool WaitFor(std::chrono::duration<Rep, Period> Timeout) {
+        return WaitUntil(FutexInternal::FClock::now() + Timeout);
+    }
+
+    void Notify() {
+        if (State.exchange(IsNotifiedFlag, std::memory_order_release) & MayHaveWaitingFlag) {
+            ParkingLot::WakeAll(&State);
+        }
+    }
+
+    // 只清除触发标志, 保留等待者标志, 以免后续 Notify 漏掉仍在休眠的线程
+    void Reset() { State.fetch_and(~IsNotifiedFlag, std::memory_order_relaxed); }
+
+  private:
+    // 设置等待者标志; 事件已触发时返回 false
+    bool PrepareWait() {
+        return !(State.fetch_or(MayHaveWaitingFlag, std::memory_order_acquire) & IsNotifiedFlag);
+    }
+
+    bool CanWait() const { return State.load(std::memory_order_relaxed) == MayHaveWaitingFlag; }
+
+    static constexpr uint8 IsNotifiedFlag     = 1 << 0;
+    static constexpr uint8 MayHaveWaitingFlag = 1 << 1;
+
+    std::atomic<uint8> State{ 0 };
+};
+} // namespace TE
@@ -0,0 +1,101 @@
+/******************************************************
+ * @file Async/Mutex.hpp
+ * @brief 1 字节互斥锁
+ *****************************************************/
+
+#pragma once
+
+#include "Async/Futex.hpp"
+#include "Async/ParkingLot.hpp"
+
+#include <atomic>
+
+namespace TE {
+// 只占一个字节的互斥锁, 等待队列放在 ParkingLot 中
+// 位 0: 已加锁; 位 1: 可能有线程在 ParkingLot 中等待
+// 无竞争时加锁/解锁各一次 CAS; 竞争时先自旋, 再停车休眠; 解锁时只有存在等待者才进入 ParkingLot
+// 参考: Engine/Source/Runtime/Core/Public/Async/Mutex.h
+class FMutex {
+  public:
+    constexpr FMutex() = default;
+
+    FMutex(const FMutex &)            = delete;
+    FMutex &operator=(const FMutex &) = delete;
+
+    bool IsLocked() const { return State.load(std::memory_order_relaxed) & IsLockedFlag; }
+
+    bool TryLock() {
+        uint8 Expected = State.load(std::memory_order_relaxed);
+        return !(Expected & IsLockedFlag) &&
+               State.compare_exchange_strong(Expected, Expected | IsLockedFlag,
+                                             std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void Lock() {
+        uint8 Expected = 0;
+        if (LIKELY(State.compare_exchange_weak(Expected, IsLockedFlag, std::memory_order_acquire,
+                                               std::memory_order_relaxed))) {
+            return;
+        }
+        LockSlow();
+    }
+
+    void Unlock() {
+        uint8 Expected = IsLockedFlag;
+        if (LIKELY(State.compare_exchange_strong(Expected, 0, std::memory_order_release,
+                                                 std::memory_order_relaxed))) {
+            return;
+        }
+        UnlockSlow();
+    }
+
+  private:
+    void LockSlow() {
+        // 自旋阶段只读不写; 已经有线程在停车时不再自旋, 避免插队饿死等待者
+        FutexInternal::SpinUntil([this] {
+            const uint8 Value = State.load(std::memory_order_relaxed);
+            return !(Value & IsLockedFlag) || (Value & MayHaveWaitingLockFlag);
+        });
+
+        while (true) {
+            uint8 Value = State.load(std::memory_order_relaxed);
+            if (!(Value & IsLockedFlag)) {
+                if (State.compare_exchange_weak(Value, Value | IsLockedFlag,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            if (!(Value & MayHaveWaitingLockFlag) &&
+                !State.compare_exchange_weak(Value, Value | MayHaveWaitingLockFlag,
+                                             std::memory_order_relaxed)) {
+                continue;
+            }
+            // 在桶锁内复查: 解锁方清除标志也在同一把桶锁内, 两者不会错过
+            ParkingLot::Wait(
+                &State,
+                [this] {
+                    return State.load(std::memory_order_relaxed) ==
+                           (IsLockedFlag | MayHaveWaitingLockFlag);
+                },
+                [] {});
+        }
+    }
+
+    void UnlockSlow() {
+        // 唤醒一个等待者, 并根据队列中是否还有等待者决定是否保留等待标志;
+        // 被唤醒的线程需要重新竞争, 不做锁的直接移交
+        ParkingLot::WakeOne(&State, [this](ParkingLot::FWakeState WakeState) -> uint64 {
+            State.store(WakeState.bHasWaitingThreads ? MayHaveWaitingLockFlag : 0,
+                        std::memory_order_release);
+            return 0;
+        });
+    }
+
+    static constexpr uint8 IsLockedFlag           = 1 << 0;
+    static constexpr uint8 MayHaveWaitingLockFlag = 1 << 1;
+
+    std::atomic<uint8> State{ 0 };
+};
+} // namespace TE
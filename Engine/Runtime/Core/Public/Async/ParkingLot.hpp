@@ -0,0 +1,69 @@
+/******************************************************
+ * @file Async/ParkingLot.hpp
+ * @brief 以地址为键的全局等待队列
+ *****************************************************/
+
+#pragma once
+
+#include "Async/Futex.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "TypeUtils/FunctionRef.hpp"
+
+#include <chrono>
+
+// ParkingLot: 线程在任意地址上排队休眠, 由其他线程按地址唤醒 (WebKit WTF::ParkingLot)
+//
+// 同步对象本身只需保存一两个状态位 ("已加锁" / "可能有等待者"), 等待队列、
+// 线程事件等重量级状态都放在这张全局哈希表里, 按线程数而不是同步对象数分配;
+// 因此 FMutex、FManualResetEvent、任务的完成事件都可以只占一个字节
+//
+// 参考: Engine/Source/Runtime/Core/Public/Async/ParkingLot.h
+namespace TE::ParkingLot {
+struct FWaitState {
+    // 唤醒方通过 WakeOne 的回调传递过来的值
+    uint64 WakeToken = 0;
+    // CanWait 返回 true, 线程确实进入了等待
+    bool bDidWait = false;
+    // 被 Wake* 唤醒; 为 false 且 bDidWait 为 true 表示超时
+    bool bDidWake = false;
+};
+
+struct FWakeState {
+    // 是否唤醒了一个线程
+    bool bDidWake = false;
+    // 唤醒之后同一地址上是否还可能有等待者
+    bool bHasWaitingThreads = false;
+};
+
+// 在 Address 上排队并休眠, 直到被唤醒
+// CanWait 在队列锁内调用, 返回 false 则直接返回, 用来与 WakeOne 的回调原子地复查同步对象的状态;
+// BeforeWait 在入队并释放队列锁之后、真正休眠之前调用
+// 两个回调中都不能再调用 ParkingLot
+FWaitState Wait(const void *Address, TFunctionRef<bool()> CanWait,
+                TFunctionRef<void()> BeforeWait);
+
+// 同 Wait, 但最多等到 Deadline
+FWaitState WaitUntil(const void *Address, TFunctionRef<bool()> CanWait,
+                     TFunctionRef<void()> BeforeWait, FutexInternal::FClock::time_point Deadline);
+
+template <typename Rep, typename Period>
+FWaitState WaitFor(const void *Address, TFunctionRef<bool()> CanWait,
+                   TFunctionRef<void()> BeforeWait, std::chrono::duration<Rep, Period> Timeout) {
+    return WaitUntil(Address, CanWait, BeforeWait, FutexInternal::FClock::now() + Timeout);
+}
+
+// 唤醒在 Address 上等待最久的一个线程
+// OnWakeState 在队列锁内调用 (即使没有线程可唤醒), 返回值作为被唤醒线程的 WakeToken;
+// 同步对象可以在回调里根据 bHasWaitingThreads 清除自己的 "可能有等待者" 标志
+FWakeState WakeOne(const void *Address, TFunctionRef<uint64(FWakeState)> OnWakeState);
+
+FWakeState WakeOne(const void *Address);
+
+// 最多唤醒 WakeCount 个线程, 返回实际唤醒的数量
+uint32 WakeMultiple(const void *Address, uint32 WakeCount);
+
+void WakeAll(const void *Address);
+
+// 预先按线程数扩容哈希表; 每个线程第一次使用 ParkingLot 时会自动调用
+void Reserve(uint32 ThreadCount);
+} // namespace TE::ParkingLot
@@ -0,0 +1,22 @@
+/******************************************************
+ * @file Async/UniqueLock.hpp
+ * @brief
+ *****************************************************/
+
+#pragma once
+
+namespace TE {
+// 作用域锁, 适用于任何提供 Lock()/Unlock() 的互斥锁
+template <typename MutexType> class TUniqueLock {
+  public:
+    [[nodiscard]] explicit TUniqueLock(MutexType &InMutex) : Mutex(InMutex) { Mutex.Lock(); }
+
+    TUniqueLock(const TUniqueLock &)            = delete;
+    TUniqueLock &operator=(const TUniqueLock &) = delete;
+
+    ~TUniqueLock() { Mutex.Unlock(); }
+
+  private:
+    MutexType &Mutex;
+};
+} // namespace TE
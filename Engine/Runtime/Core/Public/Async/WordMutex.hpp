@@ -0,0 +1,66 @@
+/******************************************************
+ * @file Async/WordMutex.hpp
+ * @brief 4 字节互斥锁, 不依赖 ParkingLot
+ *****************************************************/
+
+#pragma once
+
+#include "Async/Futex.hpp"
+
+#include <atomic>
+
+namespace TE {
+// 基于 futex 的互斥锁 (Drepper, "Futexes Are Tricky" 中的三态实现)
+// 直接在自身的 32 位字上休眠, 用于 ParkingLot 内部等无法依赖 ParkingLot 的地方;
+// 其他场合优先使用 1 字节的 FMutex
+// 0: 未加锁; 1: 已加锁, 无等待者; 2: 已加锁, 可能有等待者
+// 竞争时先自旋, 仍拿不到才进入内核休眠; 解锁时只有存在等待者才发起系统调用
+class FWordMutex {
+  public:
+    constexpr FWordMutex() = default;
+
+    FWordMutex(const FWordMutex &)            = delete;
+    FWordMutex &operator=(const FWordMutex &) = delete;
+
+    bool IsLocked() const { return State.load(std::memory_order_relaxed) != Unlocked; }
+
+    bool TryLock() {
+        uint32 Expected = Unlocked;
+        return State.compare_exchange_strong(Expected, Locked, std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+    }
+
+    void Lock() {
+        if (LIKELY(TryLock())) {
+            return;
+        }
+        LockSlow();
+    }
+
+    void Unlock() {
+        if (UNLIKELY(State.exchange(Unlocked, std::memory_order_release) == LockedWithWaiters)) {
+            FutexInternal::FutexWakeOne(State);
+        }
+    }
+
+  private:
+    void LockSlow() {
+        // 自旋阶段只读不写, 避免在锁持有者的缓存行上制造写竞争
+        if (FutexInternal::SpinUntil(
+                [this] { return State.load(std::memory_order_relaxed) == Unlocked; }) &&
+            TryLock()) {
+            return;
+        }
+        // 标记存在等待者后休眠; 被唤醒后仍以 "有等待者" 状态加锁, 保证解锁时不漏唤醒
+        while (State.exchange(LockedWithWaiters, std::memory_order_acquire) != Unlocked) {
+            FutexInternal::FutexWait(State, LockedWithWaiters);
+        }
+    }
+
+    static constexpr uint32 Unlocked          = 0;
+    static constexpr uint32 Locked            = 1;
+    static constexpr uint32 LockedWithWaiters = 2;
+
+    std::atomic<uint32> State{ Unlocked };
+};
+} // namespace TE
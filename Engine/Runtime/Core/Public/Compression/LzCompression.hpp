@@ -0,0 +1,37 @@
+/******************************************************
+ * @file Compression/LzCompression.hpp
+ * @brief 面向解压速度的 LZ77 块压缩 (格式参照 LZ4 block)
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+
+#include <cstddef>
+
+// 块格式: 由若干序列组成, 每个序列为
+//   [Token: 高 4 位字面量长度, 低 4 位匹配长度 - MinMatch]
+//   [字面量长度扩展: 字段为 15 时追加若干字节, 直到某个字节不是 255]
+//   [字面量]
+//   [Offset: 2 字节小端, 1 ~ 65535]
+//   [匹配长度扩展]
+// 最后一个序列只有字面量, 没有 Offset. 匹配可以与输出重叠 (Offset < 匹配长度), 用于表示重复段.
+// 不保存原始长度, 解压时由调用方给出.
+//
+// 解压对任意输入都不会越界读写, 数据损坏时返回 false
+// 参考: Engine/Source/Runtime/Core/Public/Misc/Compression.h
+namespace TE::Compression {
+// Compress 在最坏情况下需要的输出容量
+constexpr std::size_t GetLzCompressBound(std::size_t SourceSize) {
+    return SourceSize + SourceSize / 255 + 16;
+}
+
+// 返回压缩后的字节数; 输出容量不足时返回 0.
+// 容量为 GetLzCompressBound(SourceSize) 时总能成功; 只想在压缩有收益时才保存压缩结果的调用方,
+// 可以把容量设为 SourceSize - 1, 返回 0 即表示不值得压缩
+std::size_t LzCompress(const void *Source, std::size_t SourceSize, void *Dest,
+                       std::size_t DestCapacity);
+
+// 把 Source 解压到 Dest, 解压结果必须恰好是 DestSize 字节
+bool LzDecompress(const void *Source, std::size_t SourceSize, void *Dest, std::size_t DestSize);
+} // namespace TE::Compression
@@ -0,0 +1,67 @@
+/******************************************************
+ * @file FileSystem/MappedFile.hpp
+ * @brief 只读内存映射文件与按偏移写入的文件
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// 参考: Engine/Source/Runtime/Core/Public/Async/MappedFileHandle.h
+namespace TE {
+// 只读映射整个文件. 映射建立后读取文件内容不再需要系统调用;
+// 只要文件中已映射部分的字节不再被改写, 其他进程/线程在文件末尾追加数据不影响已有映射
+class FMappedFile {
+  public:
+    FMappedFile(const FMappedFile &)            = delete;
+    FMappedFile &operator=(const FMappedFile &) = delete;
+
+    // 文件不存在或映射失败时返回 nullptr; 空文件返回 GetSize() == 0 的映射
+    static std::unique_ptr<FMappedFile> Map(const std::string &Path);
+
+    ~FMappedFile();
+
+    const uint8 *GetData() const { return Data; }
+    uint64       GetSize() const { return Size; }
+
+  private:
+    FMappedFile() = default;
+
+    const uint8 *Data = nullptr;
+    uint64       Size = 0;
+    // Windows 下的 file mapping 句柄, Linux 不使用
+    void *NativeMapping = nullptr;
+};
+
+// 按绝对偏移写入的文件, 不维护文件指针, 因此 Write 可以与其他线程的 Map 并发
+class FWritableFile {
+  public:
+    FWritableFile(const FWritableFile &)            = delete;
+    FWritableFile &operator=(const FWritableFile &) = delete;
+
+    // bTruncate 为 true 时清空已有内容; 文件不存在时总是创建
+    static std::unique_ptr<FWritableFile> Open(const std::string &Path, bool bTruncate);
+
+    ~FWritableFile();
+
+    bool   Write(uint64 Offset, const void *Buffer, std::size_t Size);
+    uint64 GetSize() const;
+    // 把数据刷到磁盘
+    bool Flush();
+
+  private:
+    FWritableFile() = default;
+
+    // Linux 为 fd, Windows 为 HANDLE
+    intptr_t NativeHandle = -1;
+};
+
+// 用 From 原子地替换 To (To 不存在时相当于重命名)
+bool AtomicReplaceFile(const std::string &From, const std::string &To);
+bool RemoveFile(const std::string &Path);
+} // namespace TE
@@ -49,6 +49,8 @@
     struct FPlatformTypes {
         using TCHAR = char16_t;
     };
+    // TCHAR 字面量
+    #define TEXT(x) u##x
 #endif
 
 /** Branch prediction hints */				
@@ -0,0 +1,154 @@
+/******************************************************
+ * @file Memory/FixedBlockAllocator.hpp
+ * @brief 定长内存块分配器, 带线程本地缓存
+ *****************************************************/
+
+#pragma once
+
+#include "MarcoUtils/PlatformMarco.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+// 定长内存块的空闲链表分配器
+//
+// 每个线程缓存两串空闲块 (Partial / Full), 分配与释放只在本线程缓存上操作;
+// 只有当一整串 (BundleSize 个) 块用完或攒满时, 才与全局空闲链表交换一次,
+// 全局链表的互斥锁因此每 BundleSize 次操作才会被触碰一次.
+// 块一旦分配就不会归还给系统, 适合任务节点这类数量稳定、高频复用的对象.
+//
+// 参考: Engine/Source/Runtime/Core/Public/Containers/LockFreeFixedSizeAllocator.h
+template <std::size_t BlockSize, std::size_t BlockAlign = alignof(std::max_align_t)>
+class TFixedBlockAllocator {
+    struct FFreeNode {
+        FFreeNode  *Next;       // 同一串中的下一个块
+        FFreeNode  *NextBundle; // 全局链表中的下一串, 只在每串的首块上有效
+        std::size_t Count;      // 本串块数, 只在每串的首块上有效
+    };
+
+  public:
+    static constexpr std::size_t AllocSize  = std::max(BlockSize, sizeof(FFreeNode));
+    static constexpr std::size_t BundleSize = 64;
+
+    static void *Allocate() {
+        if (UNLIKELY(bThreadCacheDestroyed)) {
+            return ::operator new(AllocSize, std::align_val_t(BlockAlign));
+        }
+        FThreadCache &Cache = GetThreadCache();
+        if (Cache.Partial.Count == 0) {
+            if (Cache.Full.Count != 0) {
+                Cache.Partial = Cache.Full;
+                Cache.Full    = {};
+            } else {
+                Cache.Partial = PopGlobalBundle();
+            }
+            if (Cache.Partial.Count == 0) {
+                return ::operator new(AllocSize, std::align_val_t(BlockAlign));
+            }
+        }
+        FFreeNode *Node    = Cache.Partial.Head;
+        Cache.Partial.Head = Node->Next;
+        --Cache.Partial.Count;
+        return Node;
+    }
+
+    static void Free(void *Ptr) {
+        if (!Ptr) {
+            return;
+        }
+        if (UNLIKELY(bThreadCacheDestroyed)) {
+            // 线程退出阶段本线程缓存已析构, 直接作为单块一串还给全局链表
+            FFreeNode *Node = static_cast<FFreeNode *>(Ptr);
+            Node->Next      = nullptr;
+            PushGlobalBundle({ Node, 1 });
+            return;
+        }
+        FThreadCache &Cache = GetThreadCache();
+        if (Cache.Partial.Count == BundleSize) {
+            if (Cache.Full.Count != 0) {
+                PushGlobalBundle(Cache.Full);
+            }
+            Cache.Full    = Cache.Partial;
+            Cache.Partial = {};
+        }
+        FFreeNode *Node    = static_cast<FFreeNode *>(Ptr);
+        Node->Next         = Cache.Partial.Head;
+        Cache.Partial.Head = Node;
+        ++Cache.Partial.Count;
+    }
+
+  private:
+    struct FBundle {
+        FFreeNode  *Head  = nullptr;
+        std::size_t Count = 0;
+    };
+
+    struct FThreadCache {
+        FBundle Partial;
+        FBundle Full;
+
+        // 线程退出时把缓存的块还给全局链表, 供其他线程复用
+        ~FThreadCache() {
+            bThreadCacheDestroyed = true;
+            if (Partial.Count != 0) {
+                PushGlobalBundle(Partial);
+            }
+            if (Full.Count != 0) {
+                PushGlobalBundle(Full);
+            }
+        }
+    };
+
+    // 其他 thread_local 对象的析构函数可能在本线程缓存析构之后仍在分配/释放,
+    // 用一个无需析构的标志把这些调用转到全局链表
+    static inline thread_local bool bThreadCacheDestroyed = false;
+
+    struct FGlobalFreeList {
+        std::mutex Mutex;
+        FFreeNode *Head = nullptr;
+    };
+
+    static FThreadCache &GetThreadCache() {
+        static thread_local FThreadCache Cache;
+        return Cache;
+    }
+
+    static FGlobalFreeList &GetGlobalFreeList() {
+        // 进程退出时工作线程可能仍在归还内存, 全局链表故意不析构
+        alignas(FGlobalFreeList) static unsigned char Storage[sizeof(FGlobalFreeList)];
+        static FGlobalFreeList *FreeList = new (Storage) FGlobalFreeList();
+        return *FreeList;
+    }
+
+    static void PushGlobalBundle(const FBundle &Bundle) {
+        FGlobalFreeList &FreeList = GetGlobalFreeList();
+        Bundle.Head->Count        = Bundle.Count;
+        std::lock_guard<std::mutex> Lock(FreeList.Mutex);
+        Bundle.Head->NextBundle = FreeList.Head;
+        FreeList.Head           = Bundle.Head;
+    }
+
+    static FBundle PopGlobalBundle() {
+        FGlobalFreeList            &FreeList = GetGlobalFreeList();
+        std::lock_guard<std::mutex> Lock(FreeList.Mutex);
+        FFreeNode                  *Head = FreeList.Head;
+        if (!Head) {
+            return {};
+        }
+        FreeList.Head = Head->NextBundle;
+        return { Head, Head->Count };
+    }
+};
+
+// 按类型分配的便捷封装
+template <typename T> struct TObjectAllocator {
+    using FAllocator = TFixedBlockAllocator<sizeof(T), alignof(T) < alignof(std::max_align_t)
+                                                           ? alignof(std::max_align_t)
+                                                           : alignof(T)>;
+
+    static void *Malloc() { return FAllocator::Allocate(); }
+    static void  Free(void *Ptr) { FAllocator::Free(Ptr); }
+};
@@ -0,0 +1,119 @@
+/******************************************************
+ * @file Memory/LinearAllocator.hpp
+ * @brief 线性 (bump) 分配器与按帧重置的线程本地分配器
+ *****************************************************/
+
+#pragma once
+
+#include "MarcoUtils/PlatformMarco.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 线性分配器 (arena)
+//
+// 从大页中顺序切出内存, 分配只是移动指针; 不能单独释放, 只能整体 Reset 或回退到标记处.
+// Reset 保留已申请的普通页供下一轮复用, 稳定状态下不再触碰全局堆; 超过页大小的分配单独成页,
+// Reset 时归还. 分配出的对象不会被析构, 只适合放平凡析构的临时数据.
+// 非线程安全: 每个线程使用自己的实例 (见 FFrameAllocator)
+//
+// 参考: Engine/Source/Runtime/Core/Public/Misc/MemStack.h
+class FLinearAllocator {
+    struct alignas(std::max_align_t) FPage {
+        FPage      *Next;
+        std::size_t Capacity; // 不含页头
+        bool        bOversized;
+
+        uint8 *Data() { return reinterpret_cast<uint8 *>(this + 1); }
+    };
+
+  public:
+    static constexpr std::size_t DefaultPageSize = 64 * 1024;
+
+    // 回退点: 之后的分配可以通过 Rewind 一次性撤销
+    struct FMarker {
+        FPage      *Page   = nullptr;
+        std::size_t Offset = 0;
+    };
+
+    explicit FLinearAllocator(std::size_t InPageSize = DefaultPageSize) : PageSize(InPageSize) {}
+    ~FLinearAllocator();
+
+    FLinearAllocator(const FLinearAllocator &)            = delete;
+    FLinearAllocator &operator=(const FLinearAllocator &) = delete;
+
+    FORCEINLINE void *Allocate(std::size_t Size, std::size_t Align = alignof(std::max_align_t)) {
+        if (LIKELY(Current)) {
+            const std::uintptr_t Base    = reinterpret_cast<std::uintptr_t>(Current->Data());
+            const std::size_t    Aligned = ((Base + Offset + Align - 1) & ~(Align - 1)) - Base;
+            if (LIKELY(Aligned + Size <= Current->Capacity)) {
+                Offset = Aligned + Size;
+                return Current->Data() + Aligned;
+            }
+        }
+        return AllocateSlow(Size, Align);
+    }
+
+    template <typename T, typename... ArgTypes> T *New(ArgTypes &&...Args) {
+        static_assert(std::is_trivially_destructible_v<T>, "线性分配器不会调用析构函数");
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<ArgTypes>(Args)...);
+    }
+
+    // 未初始化的数组
+    template <typename T> T *NewArray(std::size_t Count) {
+        static_assert(std::is_trivially_destructible_v<T>, "线性分配器不会调用析构函数");
+        return static_cast<T *>(Allocate(sizeof(T) * Count, alignof(T)));
+    }
+
+    FMarker GetMarker() const { return { Current, Offset }; }
+    // 撤销标记之后的所有分配; 之后申请的超大页会被归还
+    void    Rewind(const FMarker &Marker);
+
+    // 撤销所有分配, 保留普通页
+    void Reset() { Rewind({}); }
+
+    // 释放所有页
+    void Release();
+
+    std::size_t GetBytesUsed() const;
+    std::size_t GetBytesReserved() const;
+
+  private:
+    void *AllocateSlow(std::size_t Size, std::size_t Align);
+
+    static FPage *AllocatePage(std::size_t Capacity, bool bOversized);
+
+    // 已使用的页按申请顺序串成链表, Current 是最后一页;
+    // Reset 后的普通页进入 FreePages, 下次需要新页时优先复用
+    FPage      *First     = nullptr;
+    FPage      *Current   = nullptr;
+    FPage      *FreePages = nullptr;
+    std::size_t Offset    = 0;
+    std::size_t PageSize;
+};
+
+// 帧分配器
+//
+// 每个线程一个 FLinearAllocator. BeginFrame 只递增全局帧号, 各线程在下一次分配时发现帧号变化,
+// 才重置自己的分配器, 因此不需要遍历或同步其他线程.
+// 约定: 在某一帧分配的内存只在下一次 BeginFrame 之前有效, 不能跨帧保存
+class FFrameAllocator {
+  public:
+    // 由主循环在每帧开始时调用一次
+    static void   BeginFrame();
+    static uint64 GetFrameNumber();
+
+    static void *Allocate(std::size_t Size, std::size_t Align = alignof(std::max_align_t));
+
+    template <typename T> static T *NewArray(std::size_t Count) {
+        static_assert(std::is_trivially_destructible_v<T>, "帧分配器不会调用析构函数");
+        return static_cast<T *>(Allocate(sizeof(T) * Count, alignof(T)));
+    }
+
+    // 当前线程本帧已分配的字节数
+    static std::size_t GetThreadBytesUsed();
+};
@@ -1,72 +1,438 @@
 /******************************************************
  * @file Memory/RefCounting.hpp
- * @brief
+ * @brief 侵入式引用计数: 引用计数基类 + 强/弱引用智能指针
  *****************************************************/
 
 #pragma once
 
 #include "DebugUtils/CoreDebug.hpp"
+#include "MarcoUtils/PlatformMarco.hpp"
 #include "TypeUtils/CoreType.hpp"
 
+#include <atomic>
 #include <concepts>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
 
 template <typename T>
 concept RefCountable = requires(T *t) {
-  { t->AddRef() } -> std::same_as<void>;
-  { t->Release() } -> std::same_as<void>;
-  { t->GetRefCount() } -> std::same_as<uint32>;
+    { t->AddRef() } -> std::same_as<void>;
+    { t->Release() } -> std::same_as<void>;
+    { t->GetRefCount() } -> std::same_as<uint32>;
 };
 
+// 引用计数是否需要跨线程安全, 编译期选择
+// Engine/Source/Runtime/Core/Public/Templates/RefCounting.h:95
+enum class ERefCountingMode : uint8 {
+    NotThreadSafe, // 普通整数, 只在单个线程内共享的对象
+    ThreadSafe,    // 原子整数: 增加用 relaxed, 减少用 acq_rel
+};
+
+template <ERefCountingMode Mode> class TRefCountedObject;
+
+namespace TE::RefCountingPrivate {
+template <ERefCountingMode Mode>
+using TCounter =
+    std::conditional_t<Mode == ERefCountingMode::ThreadSafe, std::atomic<uint32>, uint32>;
+
+template <ERefCountingMode Mode> FORCEINLINE void Increment(TCounter<Mode> &Counter) {
+    if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+        // 增加计数前调用方已经持有一份引用, 不需要任何同步
+        Counter.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        ++Counter;
+    }
+}
+
+// 返回减少之后的计数
+template <ERefCountingMode Mode> FORCEINLINE uint32 Decrement(TCounter<Mode> &Counter) {
+    if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+        // release: 之前对对象的写入对析构者可见; acquire: 析构者看到所有其他持有者的写入
+        return Counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
+    } else {
+        return --Counter;
+    }
+}
+
+template <ERefCountingMode Mode> FORCEINLINE uint32 Load(const TCounter<Mode> &Counter) {
+    if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+        return Counter.load(std::memory_order_relaxed);
+    } else {
+        return Counter;
+    }
+}
+
+// 弱引用控制块, 第一次创建弱引用时才分配; 对象本身只多一个指针
+// 控制块的计数 = 弱引用数 + 1 (对象存活期间持有的一份)
+// Object 在对象析构前被清空; Pin 和清空都在控制块的自旋锁内进行,
+// 保证 Pin 看到非空 Object 时对象的内存仍然有效
+template <ERefCountingMode Mode> class TWeakReferenceControl {
+  public:
+    explicit TWeakReferenceControl(TRefCountedObject<Mode> *InObject) : Object(InObject) {}
+
+    void AddRef() { Increment<Mode>(RefCount); }
+
+    void Release() {
+        if (Decrement<Mode>(RefCount) == 0) {
+            delete this;
+        }
+    }
+
+    void Lock() {
+        if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+            // 临界区只有几条指令, 自旋即可
+            while (bLocked.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void Unlock() {
+        if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+            bLocked.clear(std::memory_order_release);
+        }
+    }
+
+    TRefCountedObject<Mode> *Object;
+
+  private:
+    TCounter<Mode>   RefCount{ 1 };
+    std::atomic_flag bLocked;
+};
+} // namespace TE::RefCountingPrivate
+
+// 侵入式引用计数基类, 计数归零时通过虚析构函数 delete 自身
+// 与 std::shared_ptr 相比, 对象和计数在同一次分配中, 不需要额外的控制块;
+// 只有真正用到 TWeakRefCountPtr 的对象才会额外分配一个弱引用控制块
+// Engine/Source/Runtime/Core/Public/Templates/RefCounting.h:120
+template <ERefCountingMode Mode> class TRefCountedObject {
+  public:
+    static constexpr ERefCountingMode RefCountingMode = Mode;
+
+    TRefCountedObject()                                     = default;
+    TRefCountedObject(const TRefCountedObject &)            = delete;
+    TRefCountedObject &operator=(const TRefCountedObject &) = delete;
+
+    void AddRef() const { TE::RefCountingPrivate::Increment<Mode>(RefCount); }
+
+    void Release() const {
+        if (TE::RefCountingPrivate::Decrement<Mode>(RefCount) == 0) {
+            const_cast<TRefCountedObject *>(this)->DetachWeakReferences();
+            delete this;
+        }
+    }
+
+    uint32 GetRefCount() const { return TE::RefCountingPrivate::Load<Mode>(RefCount); }
+
+  protected:
+    virtual ~TRefCountedObject() { check(GetRefCount() == 0); }
+
+  private:
+    using FWeakReferenceControl = TE::RefCountingPrivate::TWeakReferenceControl<Mode>;
+
+    template <typename> friend class TWeakRefCountPtr;
+
+    // 计数非零时加一, 用于从弱引用升级; 调用方必须持有控制块的锁
+    bool TryAddRef() const {
+        if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+            uint32 Count = RefCount.load(std::memory_order_relaxed);
+            while (Count != 0) {
+                if (RefCount.compare_exchange_weak(Count, Count + 1, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        } else {
+            if (RefCount == 0) {
+                return false;
+            }
+            ++RefCount;
+            return true;
+        }
+    }
+
+    // 调用方持有一份强引用, 对象不会在此期间析构
+    FWeakReferenceControl *GetOrCreateWeakControl() const {
+        FWeakReferenceControl *Control = LoadWeakControl();
+        if (Control) {
+            return Control;
+        }
+        FWeakReferenceControl *NewControl =
+            new FWeakReferenceControl(const_cast<TRefCountedObject *>(this));
+        if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+            if (!WeakControl.compare_exchange_strong(Control, NewControl,
+                                                     std::memory_order_acq_rel)) {
+                NewControl->Release();
+                return Control;
+            }
+        } else {
+            WeakControl = NewControl;
+        }
+        return NewControl;
+    }
+
+    FWeakReferenceControl *LoadWeakControl() const {
+        if constexpr (Mode == ERefCountingMode::ThreadSafe) {
+            return WeakControl.load(std::memory_order_acquire);
+        } else {
+            return WeakControl;
+        }
+    }
+
+    void DetachWeakReferences() {
+        if (FWeakReferenceControl *Control = LoadWeakControl()) {
+            Control->Lock();
+            Control->Object = nullptr;
+            Control->Unlock();
+            Control->Release();
+        }
+    }
+
+    mutable TE::RefCountingPrivate::TCounter<Mode> RefCount{ 0 };
+    mutable std::conditional_t<Mode == ERefCountingMode::ThreadSafe,
+                               std::atomic<FWeakReferenceControl *>, FWeakReferenceControl *>
+        WeakControl{ nullptr };
+};
+
+// 跨线程共享的对象的默认基类
+using FRefCountBase = TRefCountedObject<ERefCountingMode::ThreadSafe>;
+
 // 智能指针
 // 但是引用计数是在对象内部维护的 参考:
 // Engine/Source/Runtime/Core/Public/Templates/RefCounting.h
 template <RefCountable ReferencedType> class TRefCountPtr {
-public:
-  FORCEINLINE TRefCountPtr() : Reference(nullptr) {}
+  public:
+    FORCEINLINE TRefCountPtr() : Reference(nullptr) {}
+
+    FORCEINLINE TRefCountPtr(std::nullptr_t) : Reference(nullptr) {}
+
+    // 自身持有一个计数+1; bAddRef 为 false 时接管调用方已持有的一份引用
+    TRefCountPtr(ReferencedType *InReference, bool bAddRef = true) {
+        Reference = InReference;
+        if (Reference && bAddRef) {
+            Reference->AddRef();
+        }
+    }
+
+    TRefCountPtr(const TRefCountPtr &Copy) {
+        Reference = Copy.Reference;
+        if (Reference) {
+            Reference->AddRef();
+        }
+    }
+
+    template <typename CopyReferencedType>
+        requires std::convertible_to<CopyReferencedType *, ReferencedType *>
+    TRefCountPtr(const TRefCountPtr<CopyReferencedType> &Copy) {
+        Reference = Copy.GetReference();
+        if (Reference) {
+            Reference->AddRef();
+        }
+    }
 
-  // 自身持有一个计数+1
-  TRefCountPtr(ReferencedType *InReference, bool bAddRef = true) {
-    Reference = InReference;
-    if (Reference && bAddRef) {
-      Reference->AddRef();
+    FORCEINLINE TRefCountPtr(TRefCountPtr &&Move) noexcept {
+        Reference      = Move.Reference;
+        Move.Reference = nullptr;
     }
-  }
 
-  TRefCountPtr(const TRefCountPtr &Copy) {
-    Reference = Copy.Reference;
-    if (Reference) {
-      Reference->AddRef();
+    template <typename MoveReferencedType>
+        requires std::convertible_to<MoveReferencedType *, ReferencedType *>
+    FORCEINLINE TRefCountPtr(TRefCountPtr<MoveReferencedType> &&Move) noexcept {
+        Reference = Move.Detach();
     }
-  }
 
-  FORCEINLINE TRefCountPtr(TRefCountPtr &&Move) {
-    Reference = Move.Reference;
-    Move.Reference = nullptr;
-  }
+    ~TRefCountPtr() {
+        if (Reference) {
+            Reference->Release();
+        }
+    }
+
+    TRefCountPtr &operator=(ReferencedType *InReference) {
+        if (Reference != InReference) {
+            // 先加后减, 避免 InReference 的最后一份引用由 Reference 间接持有时被提前释放
+            ReferencedType *OldReference = Reference;
+            Reference                    = InReference;
+            if (Reference) {
+                Reference->AddRef();
+            }
+            if (OldReference) {
+                OldReference->Release();
+            }
+        }
+        return *this;
+    }
+
+    FORCEINLINE TRefCountPtr &operator=(const TRefCountPtr &InPtr) {
+        return *this = InPtr.Reference;
+    }
+
+    template <typename CopyReferencedType>
+        requires std::convertible_to<CopyReferencedType *, ReferencedType *>
+    FORCEINLINE TRefCountPtr &operator=(const TRefCountPtr<CopyReferencedType> &InPtr) {
+        return *this = InPtr.GetReference();
+    }
+
+    TRefCountPtr &operator=(TRefCountPtr &&InPtr) noexcept {
+        if (this != &InPtr) {
+            ReferencedType *OldReference = Reference;
+            Reference                    = InPtr.Reference;
+            InPtr.Reference              = nullptr;
+            if (OldReference) {
+                OldReference->Release();
+            }
+        }
+        return *this;
+    }
+
+    template <typename MoveReferencedType>
+        requires std::convertible_to<MoveReferencedType *, ReferencedType *>
+    TRefCountPtr &operator=(TRefCountPtr<MoveReferencedType> &&InPtr) noexcept {
+        ReferencedType *OldReference = Reference;
+        Reference                    = InPtr.Detach();
+        if (OldReference) {
+            OldReference->Release();
+        }
+        return *this;
+    }
+
+    TRefCountPtr &operator=(std::nullptr_t) {
+        SafeRelease();
+        return *this;
+    }
+
+  public:
+    FORCEINLINE ReferencedType *operator->() const { return Reference; }
+
+    FORCEINLINE ReferencedType &operator*() const {
+        check(Reference);
+        return *Reference;
+    }
+
+    FORCEINLINE ReferencedType *GetReference() const { return Reference; }
+
+    FORCEINLINE bool IsValid() const { return Reference != nullptr; }
+
+    FORCEINLINE explicit operator bool() const { return Reference != nullptr; }
+
+    // 释放持有的引用并置空
+    void SafeRelease() { *this = TRefCountPtr(); }
+
+    // 放弃所有权但不减少计数, 由调用方负责之后调用 Release
+    [[nodiscard]] ReferencedType *Detach() {
+        ReferencedType *Result = Reference;
+        Reference              = nullptr;
+        return Result;
+    }
+
+    uint32 GetRefCount() const {
+        uint32 Result = 0;
+        if (Reference) {
+            Result = Reference->GetRefCount();
+            check(Result > 0); // you should never have a zero ref count if there is a
+                               // live ref counted pointer (*this is live)
+        }
+        return Result;
+    }
 
-  ~TRefCountPtr() {
-    if (Reference) {
-      Reference->Release();
+    void Swap(TRefCountPtr &Other) noexcept { std::swap(Reference, Other.Reference); }
+
+    friend void swap(TRefCountPtr &A, TRefCountPtr &B) noexcept { A.Swap(B); }
+
+    template <typename OtherType>
+    FORCEINLINE bool operator==(const TRefCountPtr<OtherType> &Other) const {
+        return Reference == Other.GetReference();
+    }
+
+    FORCEINLINE bool operator==(const ReferencedType *Other) const { return Reference == Other; }
+
+    FORCEINLINE bool operator==(std::nullptr_t) const { return Reference == nullptr; }
+
+  private:
+    ReferencedType *Reference;
+};
+
+// 创建对象并返回持有它的 TRefCountPtr
+template <typename ReferencedType, typename... ArgTypes>
+TRefCountPtr<ReferencedType> MakeRefCount(ArgTypes &&...Args) {
+    return TRefCountPtr<ReferencedType>(new ReferencedType(std::forward<ArgTypes>(Args)...));
+}
+
+// 弱引用: 不阻止对象析构, 需要访问时通过 Pin 升级为强引用
+// ReferencedType 必须派生自 TRefCountedObject
+template <typename ReferencedType> class TWeakRefCountPtr {
+    static constexpr ERefCountingMode Mode = ReferencedType::RefCountingMode;
+    using FBase                            = TRefCountedObject<Mode>;
+    using FControl = TE::RefCountingPrivate::TWeakReferenceControl<Mode>;
+
+    static_assert(std::is_base_of_v<FBase, ReferencedType>,
+                  "TWeakRefCountPtr requires a TRefCountedObject-derived type");
+
+  public:
+    TWeakRefCountPtr() = default;
+
+    TWeakRefCountPtr(const TRefCountPtr<ReferencedType> &Strong) { Reset(Strong.GetReference()); }
+
+    TWeakRefCountPtr(const TWeakRefCountPtr &Other) : Control(Other.Control) {
+        if (Control) {
+            Control->AddRef();
+        }
+    }
+
+    TWeakRefCountPtr(TWeakRefCountPtr &&Other) noexcept : Control(Other.Control) {
+        Other.Control = nullptr;
+    }
+
+    ~TWeakRefCountPtr() {
+        if (Control) {
+            Control->Release();
+        }
+    }
+
+    TWeakRefCountPtr &operator=(TWeakRefCountPtr Other) noexcept {
+        std::swap(Control, Other.Control);
+        return *this;
+    }
+
+    TWeakRefCountPtr &operator=(const TRefCountPtr<ReferencedType> &Strong) {
+        return *this = TWeakRefCountPtr(Strong);
     }
-  }
 
-public:
-  FORCEINLINE ReferencedType *operator->() const { return Reference; }
+    // 对象仍然存活时返回一份强引用, 否则返回空
+    TRefCountPtr<ReferencedType> Pin() const {
+        if (!Control) {
+            return {};
+        }
+        ReferencedType *Result = nullptr;
+        Control->Lock();
+        if (Control->Object && Control->Object->TryAddRef()) {
+            Result = static_cast<ReferencedType *>(Control->Object);
+        }
+        Control->Unlock();
+        return TRefCountPtr<ReferencedType>(Result, /*bAddRef=*/false);
+    }
 
-  FORCEINLINE ReferencedType *GetReference() const { return Reference; }
+    // 对象是否已经析构 (或从未指向对象); 结果只是瞬时快照
+    bool IsExpired() const {
+        if (!Control) {
+            return true;
+        }
+        Control->Lock();
+        const bool bExpired = Control->Object == nullptr;
+        Control->Unlock();
+        return bExpired;
+    }
 
-  FORCEINLINE bool IsValid() const { return Reference != nullptr; }
+    void Reset() { *this = TWeakRefCountPtr(); }
 
-  uint32 GetRefCount() {
-    uint32 Result = 0;
-    if (Reference) {
-      Result = Reference->GetRefCount();
-      check(Result > 0); // you should never have a zero ref count if there is a
-                         // live ref counted pointer (*this is live)
+  private:
+    void Reset(ReferencedType *Object) {
+        if (Object) {
+            Control = static_cast<const FBase *>(Object)->GetOrCreateWeakControl();
+            Control->AddRef();
+        }
     }
-    return Result;
-  }
 
-private:
-  ReferencedType *Reference;
-};
\ No newline at end of file
+    FControl *Control = nullptr;
+};
@@ -0,0 +1,85 @@
+/******************************************************
+ * @file Memory/StlAllocator.hpp
+ * @brief 把引擎分配器接到 STL 容器上的适配器
+ *****************************************************/
+
+#pragma once
+
+#include "Memory/FixedBlockAllocator.hpp"
+#include "Memory/LinearAllocator.hpp"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// 从指定的 FLinearAllocator 分配; deallocate 什么也不做, 内存随 arena 一起回收
+template <typename T> class TLinearStlAllocator {
+  public:
+    using value_type = T;
+
+    explicit TLinearStlAllocator(FLinearAllocator &InArena) : Arena(&InArena) {}
+    template <typename U>
+    TLinearStlAllocator(const TLinearStlAllocator<U> &Other) : Arena(Other.GetArena()) {}
+
+    T *allocate(std::size_t Count) {
+        return static_cast<T *>(Arena->Allocate(sizeof(T) * Count, alignof(T)));
+    }
+    void deallocate(T *, std::size_t) {}
+
+    FLinearAllocator *GetArena() const { return Arena; }
+
+    template <typename U> bool operator==(const TLinearStlAllocator<U> &Other) const {
+        return Arena == Other.GetArena();
+    }
+
+  private:
+    FLinearAllocator *Arena;
+};
+
+// 从当前线程的帧分配器分配, 容器不能活过本帧, 也不能在本帧内交给其他线程扩容
+template <typename T> class TFrameStlAllocator {
+  public:
+    using value_type = T;
+
+    TFrameStlAllocator() = default;
+    template <typename U> TFrameStlAllocator(const TFrameStlAllocator<U> &) {}
+
+    T *allocate(std::size_t Count) {
+        return static_cast<T *>(FFrameAllocator::Allocate(sizeof(T) * Count, alignof(T)));
+    }
+    void deallocate(T *, std::size_t) {}
+
+    template <typename U> bool operator==(const TFrameStlAllocator<U> &) const { return true; }
+};
+
+// 单个元素走 TObjectAllocator (线程本地缓存的定长块), 数组回退到全局堆
+// 适合 std::list / std::map / std::unordered_map 这类按节点分配的容器
+template <typename T> class TFixedBlockStlAllocator {
+  public:
+    using value_type = T;
+
+    TFixedBlockStlAllocator() = default;
+    template <typename U> TFixedBlockStlAllocator(const TFixedBlockStlAllocator<U> &) {}
+
+    T *allocate(std::size_t Count) {
+        if (Count == 1) {
+            return static_cast<T *>(TObjectAllocator<T>::Malloc());
+        }
+        return static_cast<T *>(::operator new(sizeof(T) * Count, std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T *Ptr, std::size_t Count) {
+        if (Count == 1) {
+            TObjectAllocator<T>::Free(Ptr);
+        } else {
+            ::operator delete(Ptr, std::align_val_t(alignof(T)));
+        }
+    }
+
+    template <typename U> bool operator==(const TFixedBlockStlAllocator<U> &) const {
+        return true;
+    }
+};
+
+// 本帧内使用的临时数组
+template <typename T> using TFrameVector = std::vector<T, TFrameStlAllocator<T>>;
@@ -1,7 +1,98 @@
 /******************************************************
  * @file Strings/CoreString.hpp
- * @brief
+ * @brief 字符串公共工具: UTF-8 / UTF-16 编解码
  *****************************************************/
 
 #pragma once
 
+#include "TypeUtils/CoreType.hpp"
+
+#include <string_view>
+
+// 字符串中 "未找到" 的下标
+inline constexpr int32 INDEX_NONE = -1;
+
+namespace TE::StringConv {
+// 非法编码统一替换成这个码点
+inline constexpr uint32 ReplacementCodePoint = 0xFFFD;
+
+// 逐个码点解码 UTF-8, 交给 Sink(uint32 CodePoint); 非法或截断的序列替换为 U+FFFD
+template <typename SinkType> void DecodeUtf8(std::string_view Str, SinkType &&Sink) {
+    const std::size_t Size = Str.size();
+    for (std::size_t Pos = 0; Pos < Size;) {
+        const uint8 Lead = uint8(Str[Pos]);
+        if (Lead < 0x80) {
+            Sink(uint32(Lead));
+            ++Pos;
+            continue;
+        }
+        const uint32 Count     = Lead >= 0xF0 ? 3 : Lead >= 0xE0 ? 2 : Lead >= 0xC0 ? 1 : 0;
+        uint32       CodePoint = Lead & (0x3F >> Count);
+        uint32       Index     = 1;
+        for (; Index <= Count && Pos + Index < Size; ++Index) {
+            const uint8 Trail = uint8(Str[Pos + Index]);
+            if ((Trail & 0xC0) != 0x80) {
+                break;
+            }
+            CodePoint = (CodePoint << 6) | (Trail & 0x3F);
+        }
+        // 截断的序列、超长编码 (overlong)、超出范围或落在代理区的码点都是非法的
+        constexpr uint32 MinCodePoint[] = { 0, 0x80, 0x800, 0x10000 };
+        if (Count == 0 || Lead >= 0xF8 || Index != Count + 1 || CodePoint < MinCodePoint[Count] ||
+            CodePoint > 0x10FFFF || (CodePoint >= 0xD800 && CodePoint < 0xE000)) {
+            Sink(ReplacementCodePoint);
+            Pos += Index;
+            continue;
+        }
+        Sink(CodePoint);
+        Pos += Index;
+    }
+}
+
+// 逐个码点解码 UTF-16; 落单的代理项替换为 U+FFFD
+template <typename SinkType> void DecodeUtf16(std::u16string_view Str, SinkType &&Sink) {
+    const std::size_t Size = Str.size();
+    for (std::size_t Pos = 0; Pos < Size; ++Pos) {
+        const uint32 Unit = Str[Pos];
+        if (Unit < 0xD800 || Unit >= 0xE000) {
+            Sink(Unit);
+        } else if (Unit < 0xDC00 && Pos + 1 < Size && Str[Pos + 1] >= 0xDC00 &&
+                   Str[Pos + 1] < 0xE000) {
+            Sink(0x10000 + ((Unit - 0xD800) << 10) + (uint32(Str[Pos + 1]) - 0xDC00));
+            ++Pos;
+        } else {
+            Sink(ReplacementCodePoint);
+        }
+    }
+}
+
+// 把一个码点编码为 UTF-8, 逐字节交给 Sink(char)
+template <typename SinkType> void EncodeUtf8(uint32 CodePoint, SinkType &&Sink) {
+    if (CodePoint < 0x80) {
+        Sink(char(CodePoint));
+    } else if (CodePoint < 0x800) {
+        Sink(char(0xC0 | (CodePoint >> 6)));
+        Sink(char(0x80 | (CodePoint & 0x3F)));
+    } else if (CodePoint < 0x10000) {
+        Sink(char(0xE0 | (CodePoint >> 12)));
+        Sink(char(0x80 | ((CodePoint >> 6) & 0x3F)));
+        Sink(char(0x80 | (CodePoint & 0x3F)));
+    } else {
+        Sink(char(0xF0 | (CodePoint >> 18)));
+        Sink(char(0x80 | ((CodePoint >> 12) & 0x3F)));
+        Sink(char(0x80 | ((CodePoint >> 6) & 0x3F)));
+        Sink(char(0x80 | (CodePoint & 0x3F)));
+    }
+}
+
+// 把一个码点编码为 UTF-16, 逐个码元交给 Sink(char16_t)
+template <typename SinkType> void EncodeUtf16(uint32 CodePoint, SinkType &&Sink) {
+    if (CodePoint < 0x10000) {
+        Sink(char16_t(CodePoint));
+    } else {
+        CodePoint -= 0x10000;
+        Sink(char16_t(0xD800 + (CodePoint >> 10)));
+        Sink(char16_t(0xDC00 + (CodePoint & 0x3FF)));
+    }
+}
+} // namespace TE::StringConv
@@ -0,0 +1,56 @@
+/******************************************************
+ * @file Strings/Name.hpp
+ * @brief 全局名字表与 FName 句柄
+ *****************************************************/
+
+#pragma once
+
+#include "Strings/FString.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <cstddef>
+#include <functional>
+
+// 名字
+//
+// 字符串只在构造时查一次全局名字表 (按哈希分片加锁), 之后 FName 只是一个 32 位下标:
+// 比较、哈希都是整数操作, 适合每帧都要做的资源路径、组件名查找.
+// 名字表只增不减, 条目存放在永不移动的大块内存中, 取回字符串不需要加锁.
+// 区分大小写; 空字符串即 None.
+//
+// 参考: Engine/Source/Runtime/Core/Public/UObject/NameTypes.h
+class FName {
+  public:
+    using ViewType = FString::ViewType;
+
+    // 名字最长的码元数, 超出部分被截断
+    static constexpr int32 MaxLength = 1024;
+
+    FName() = default;
+    FName(const TCHAR *Str) : FName(Str ? ViewType(Str) : ViewType()) {}
+    FName(ViewType Str);
+    FName(const FString &Str) : FName(Str.View()) {}
+
+    // 只查找, 不往名字表中添加; 不存在时返回 None
+    static FName Find(ViewType Str);
+
+    bool   IsNone() const { return Index == 0; }
+    uint32 GetIndex() const { return Index; }
+
+    // 指向名字表内部的视图, 在程序结束前一直有效
+    ViewType GetPlainView() const;
+    FString  ToString() const { return FString(GetPlainView()); }
+
+    friend bool operator==(FName Lhs, FName Rhs) { return Lhs.Index == Rhs.Index; }
+    // 按下标排序, 只保证稳定, 不是字典序
+    friend bool operator<(FName Lhs, FName Rhs) { return Lhs.Index < Rhs.Index; }
+
+  private:
+    explicit FName(uint32 InIndex) : Index(InIndex) {}
+
+    uint32 Index = 0;
+};
+
+template <> struct std::hash<FName> {
+    std::size_t operator()(FName Name) const { return std::size_t(Name.GetIndex()); }
+};
@@ -1,6 +1,6 @@
 /******************************************************
  * @file Strings/TemplateString.hpp
- * @brief
+ * @brief 字符串类模板 (TemplateString.inl) 的公共依赖
  *****************************************************/
 
 #pragma once
@@ -12,5 +12,18 @@
 #error "CoreString.hpp should not be included after defining TE_STRING_TYPE"
 #endif
 
+#include "DebugUtils/CoreDebug.hpp"
 #include "MarcoUtils/CoreMarco.hpp"
+#include "Strings/CoreString.hpp"
 #include "TypeUtils/CoreType.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
@@ -1,6 +1,6 @@
 /******************************************************
  * @file Strings/TemplateString.inl
- * @brief
+ * @brief 字符串类模板, 由 TE_STRING_CLASS / TE_STRING_TYPE 实例化 (见 FString.hpp)
  *****************************************************/
 
 // 仅仅用于静态分析
@@ -11,13 +11,351 @@
 
 #endif
 
-// struct TE_JOIN(TE_STRING_CLASS, FormatArg); // struct FStringFormatArg
-// template <typename InKeyType, typename InValueType, typename SetAllocator,
-//           typename KeyFuncs>
-// class TMap;
+#define TE_STRING_FORMAT_ARG TE_JOIN(TE_STRING_CLASS, FormatArg)
 
-// using TE_JOIN(TE_STRING_CLASS, FormatNamedArguments) =
-//     TMap<TE_STRING_CLASS, PREPROCESSOR_JOIN(TE_STRING_CLASS, FormatArg)>
-// FStringFormatNamedArguments = TMap<FString, FStringFormatArg>
+class TE_STRING_CLASS;
 
-class TE_STRING_CLASS {};
\ No newline at end of file
+// Format 的参数: 整数、浮点数或字符串 (只保存视图, 只在 Format 调用期间有效)
+// struct FStringFormatArg
+struct TE_STRING_FORMAT_ARG {
+    enum class EType : uint8 { Int, UInt, Double, String };
+
+    template <std::signed_integral T>
+    TE_STRING_FORMAT_ARG(T Value) : Type(EType::Int), IntValue(int64(Value)) {}
+
+    template <std::unsigned_integral T>
+        requires(!std::is_same_v<T, bool> && !std::is_same_v<T, TE_STRING_TYPE>)
+    TE_STRING_FORMAT_ARG(T Value) : Type(EType::UInt), UIntValue(uint64(Value)) {}
+
+    template <std::floating_point T>
+    TE_STRING_FORMAT_ARG(T Value) : Type(EType::Double), DoubleValue(double(Value)) {}
+
+    TE_STRING_FORMAT_ARG(const TE_STRING_TYPE *Value)
+        : Type(EType::String), StringValue(Value ? Value : TE_STRING_FORMAT_ARG::Empty) {}
+    TE_STRING_FORMAT_ARG(std::basic_string_view<TE_STRING_TYPE> Value)
+        : Type(EType::String), StringValue(Value) {}
+    TE_STRING_FORMAT_ARG(const TE_STRING_CLASS &Value);
+
+    EType Type;
+    union {
+        int64                                  IntValue;
+        uint64                                 UIntValue;
+        double                                 DoubleValue;
+        std::basic_string_view<TE_STRING_TYPE> StringValue;
+    };
+
+  private:
+    static constexpr TE_STRING_TYPE Empty[1] = { 0 };
+};
+
+// 字符串
+//
+// 小字符串优化: 不超过 InlineCapacity 个码元时存放在对象内部, 不分配堆内存
+// (TCHAR 版本为 23 个码元); 更长时才转到堆上, 按两倍增长.
+// 内容总是以 0 结尾, operator* 可以直接当作 C 字符串使用
+// Engine/Source/Runtime/Core/Public/Containers/UnrealString.h.inl
+class TE_STRING_CLASS {
+  public:
+    using ElementType = TE_STRING_TYPE;
+    using ViewType    = std::basic_string_view<ElementType>;
+    using FormatArg   = TE_STRING_FORMAT_ARG;
+
+    static constexpr int32 InlineCapacity = int32(48 / sizeof(ElementType)) - 1;
+
+    TE_STRING_CLASS() { InlineData[0] = 0; }
+    TE_STRING_CLASS(const ElementType *Str) : TE_STRING_CLASS() {
+        if (Str) {
+            Append(ViewType(Str));
+        }
+    }
+    TE_STRING_CLASS(const ElementType *Str, int32 Count) : TE_STRING_CLASS() {
+        Append(ViewType(Str, std::size_t(Count)));
+    }
+    explicit TE_STRING_CLASS(ViewType Str) : TE_STRING_CLASS() { Append(Str); }
+
+    TE_STRING_CLASS(const TE_STRING_CLASS &Other) : TE_STRING_CLASS() { Append(Other.View()); }
+    TE_STRING_CLASS(TE_STRING_CLASS &&Other) noexcept : Length(Other.Length) {
+        if (Other.IsInline()) {
+            std::copy_n(Other.InlineData, Length + 1, InlineData);
+        } else {
+            HeapData           = Other.HeapData;
+            HeapCapacity       = Other.HeapCapacity;
+            Other.HeapCapacity = 0;
+        }
+        Other.Length        = 0;
+        Other.InlineData[0] = 0;
+    }
+
+    TE_STRING_CLASS &operator=(const TE_STRING_CLASS &Other) {
+        if (this != &Other) {
+            Reset();
+            Append(Other.View());
+        }
+        return *this;
+    }
+    TE_STRING_CLASS &operator=(TE_STRING_CLASS &&Other) noexcept {
+        if (this != &Other) {
+            this->~TE_STRING_CLASS();
+            new (this) TE_STRING_CLASS(std::move(Other));
+        }
+        return *this;
+    }
+    TE_STRING_CLASS &operator=(ViewType Str) {
+        // Str 可能指向自身, 先复制一份
+        TE_STRING_CLASS Copy(Str);
+        return *this = std::move(Copy);
+    }
+    TE_STRING_CLASS &operator=(const ElementType *Str) {
+        return *this = ViewType(Str ? Str : EmptyText);
+    }
+
+    ~TE_STRING_CLASS() {
+        if (!IsInline()) {
+            delete[] HeapData;
+        }
+    }
+
+    // ============== 访问 ==============
+    int32 Len() const { return Length; }
+    bool  IsEmpty() const { return Length == 0; }
+    bool  IsInline() const { return HeapCapacity == 0; }
+    int32 GetCapacity() const { return IsInline() ? InlineCapacity : HeapCapacity; }
+
+    const ElementType *GetData() const { return IsInline() ? InlineData : HeapData; }
+    ElementType       *GetData() { return IsInline() ? InlineData : HeapData; }
+    const ElementType *operator*() const { return GetData(); }
+
+    ElementType &operator[](int32 Index) {
+        check(Index >= 0 && Index < Length);
+        return GetData()[Index];
+    }
+    const ElementType &operator[](int32 Index) const {
+        check(Index >= 0 && Index < Length);
+        return GetData()[Index];
+    }
+
+    ViewType View() const { return ViewType(GetData(), std::size_t(Length)); }
+    operator ViewType() const { return View(); }
+
+    // ============== 修改 ==============
+    void Reserve(int32 Capacity) {
+        if (Capacity > GetCapacity()) {
+            Reallocate(Capacity, ViewType());
+        }
+    }
+
+    // 清空内容, 保留已分配的容量
+    void Reset() {
+        Length       = 0;
+        GetData()[0] = 0;
+    }
+
+    // 清空内容并释放堆内存
+    void Empty() {
+        this->~TE_STRING_CLASS();
+        new (this) TE_STRING_CLASS();
+    }
+
+    TE_STRING_CLASS &Append(ViewType Str) {
+        const int32 Count = int32(Str.size());
+        if (Count == 0) {
+            return *this;
+        }
+        const int32 NewLength = Length + Count;
+        if (NewLength > GetCapacity()) {
+            Reallocate(std::max(NewLength, GetCapacity() * 2), Str);
+            return *this;
+        }
+        ElementType *Data = GetData();
+        std::copy_n(Str.data(), Count, Data + Length);
+        Length       = NewLength;
+        Data[Length] = 0;
+        return *this;
+    }
+
+    TE_STRING_CLASS &AppendChar(ElementType Char) { return Append(ViewType(&Char, 1)); }
+
+    TE_STRING_CLASS &operator+=(ViewType Str) { return Append(Str); }
+    TE_STRING_CLASS &operator+=(const TE_STRING_CLASS &Str) { return Append(Str.View()); }
+    TE_STRING_CLASS &operator+=(const ElementType *Str) { return Append(ViewType(Str)); }
+    TE_STRING_CLASS &operator+=(ElementType Char) { return AppendChar(Char); }
+
+    friend TE_STRING_CLASS operator+(TE_STRING_CLASS Lhs, ViewType Rhs) {
+        Lhs.Append(Rhs);
+        return Lhs;
+    }
+    friend TE_STRING_CLASS operator+(TE_STRING_CLASS Lhs, const ElementType *Rhs) {
+        Lhs.Append(ViewType(Rhs));
+        return Lhs;
+    }
+    friend TE_STRING_CLASS operator+(TE_STRING_CLASS Lhs, const TE_STRING_CLASS &Rhs) {
+        Lhs.Append(Rhs.View());
+        return Lhs;
+    }
+
+    // ============== 比较与查找 ==============
+    friend bool operator==(const TE_STRING_CLASS &Lhs, const TE_STRING_CLASS &Rhs) {
+        return Lhs.View() == Rhs.View();
+    }
+    friend bool operator==(const TE_STRING_CLASS &Lhs, ViewType Rhs) { return Lhs.View() == Rhs; }
+    friend bool operator==(const TE_STRING_CLASS &Lhs, const ElementType *Rhs) {
+        return Lhs.View() == ViewType(Rhs);
+    }
+    friend bool operator<(const TE_STRING_CLASS &Lhs, const TE_STRING_CLASS &Rhs) {
+        return Lhs.View() < Rhs.View();
+    }
+
+    // 返回子串第一次出现的位置, 找不到时返回 INDEX_NONE
+    int32 Find(ViewType SubStr, int32 StartPosition = 0) const {
+        const std::size_t Pos = View().find(SubStr, std::size_t(std::max(StartPosition, 0)));
+        return Pos == ViewType::npos ? INDEX_NONE : int32(Pos);
+    }
+    int32 Find(ElementType Char, int32 StartPosition = 0) const {
+        return Find(ViewType(&Char, 1), StartPosition);
+    }
+    bool Contains(ViewType SubStr) const { return Find(SubStr) != INDEX_NONE; }
+    bool StartsWith(ViewType Prefix) const { return View().starts_with(Prefix); }
+    bool EndsWith(ViewType Suffix) const { return View().ends_with(Suffix); }
+
+    TE_STRING_CLASS Left(int32 Count) const { return Mid(0, Count); }
+    TE_STRING_CLASS Right(int32 Count) const {
+        Count = std::clamp(Count, 0, Length);
+        return Mid(Length - Count, Count);
+    }
+    TE_STRING_CLASS Mid(int32 Start, int32 Count = 0x7FFFFFFF) const {
+        Start = std::clamp(Start, 0, Length);
+        Count = std::clamp(Count, 0, Length - Start);
+        return TE_STRING_CLASS(ViewType(GetData() + Start, std::size_t(Count)));
+    }
+
+    // ============== 编码转换 ==============
+    static TE_STRING_CLASS FromUtf8(std::string_view Str) {
+        TE_STRING_CLASS Result;
+        if constexpr (sizeof(ElementType) == 1) {
+            Result.Append(ViewType(reinterpret_cast<const ElementType *>(Str.data()), Str.size()));
+        } else {
+            Result.Reserve(int32(Str.size()));
+            TE::StringConv::DecodeUtf8(Str, [&Result](uint32 CodePoint) {
+                TE::StringConv::EncodeUtf16(
+                    CodePoint, [&Result](char16_t Unit) { Result.AppendChar(ElementType(Unit)); });
+            });
+        }
+        return Result;
+    }
+
+    std::string ToUtf8() const {
+        if constexpr (sizeof(ElementType) == 1) {
+            return std::string(reinterpret_cast<const char *>(GetData()), std::size_t(Length));
+        } else {
+            std::string Result;
+            Result.reserve(std::size_t(Length));
+            TE::StringConv::DecodeUtf16(
+                std::u16string_view(reinterpret_cast<const char16_t *>(GetData()),
+                                    std::size_t(Length)),
+                [&Result](uint32 CodePoint) {
+                    TE::StringConv::EncodeUtf8(CodePoint,
+                                               [&Result](char Byte) { Result.push_back(Byte); });
+                });
+            return Result;
+        }
+    }
+
+    // ============== 格式化 ==============
+    // 按位置替换 "{0}" "{1}" ...; 编号越界或不是合法占位符的花括号原样保留
+    // 例: FString::Format(TEXT("{0} has {1} hp"), { Name, 42 })
+    static TE_STRING_CLASS Format(const ElementType *Fmt, std::initializer_list<FormatArg> Args) {
+        TE_STRING_CLASS Result;
+        const ViewType  FmtView(Fmt);
+        std::size_t     LiteralBegin = 0;
+        for (std::size_t Pos = 0; Pos < FmtView.size(); ++Pos) {
+            if (FmtView[Pos] != ElementType('{')) {
+                continue;
+            }
+            std::size_t End   = Pos + 1;
+            std::size_t Index = 0;
+            while (End < FmtView.size() && FmtView[End] >= ElementType('0') &&
+                   FmtView[End] <= ElementType('9')) {
+                Index = Index * 10 + std::size_t(FmtView[End] - ElementType('0'));
+                ++End;
+            }
+            if (End == Pos + 1 || End >= FmtView.size() || FmtView[End] != ElementType('}') ||
+                Index >= Args.size()) {
+                continue;
+            }
+            Result.Append(FmtView.substr(LiteralBegin, Pos - LiteralBegin));
+            Result.AppendFormatArg(Args.begin()[Index]);
+            LiteralBegin = End + 1;
+            Pos          = End;
+        }
+        Result.Append(FmtView.substr(LiteralBegin));
+        return Result;
+    }
+
+    // 数字转字符串
+    template <typename T>
+        requires std::is_arithmetic_v<T>
+    static TE_STRING_CLASS FromNumber(T Value) {
+        TE_STRING_CLASS Result;
+        Result.AppendFormatArg(FormatArg(Value));
+        return Result;
+    }
+
+  private:
+    // 换到新的堆缓冲区并追加 Tail; Tail 可能指向自身 (包括内联缓冲区),
+    // 所以先在新缓冲区里拼好, 再释放或覆盖旧的
+    void Reallocate(int32 Capacity, ViewType Tail) {
+        ElementType *NewData = new ElementType[std::size_t(Capacity) + 1];
+        std::copy_n(GetData(), Length, NewData);
+        std::copy_n(Tail.data(), Tail.size(), NewData + Length);
+        if (!IsInline()) {
+            delete[] HeapData;
+        }
+        Length          = Length + int32(Tail.size());
+        NewData[Length] = 0;
+        HeapData        = NewData;
+        HeapCapacity    = Capacity;
+    }
+
+    void AppendFormatArg(const FormatArg &Arg) {
+        char                     Buffer[32];
+        std::to_chars_result     Converted{ Buffer, std::errc() };
+        switch (Arg.Type) {
+        case FormatArg::EType::String:
+            Append(Arg.StringValue);
+            return;
+        case FormatArg::EType::Int:
+            Converted = std::to_chars(Buffer, Buffer + sizeof(Buffer), Arg.IntValue);
+            break;
+        case FormatArg::EType::UInt:
+            Converted = std::to_chars(Buffer, Buffer + sizeof(Buffer), Arg.UIntValue);
+            break;
+        case FormatArg::EType::Double:
+            Converted = std::to_chars(Buffer, Buffer + sizeof(Buffer), Arg.DoubleValue);
+            break;
+        }
+        // 数字只含 ASCII 字符, 直接逐个拓宽
+        for (const char *It = Buffer; It != Converted.ptr; ++It) {
+            AppendChar(ElementType(*It));
+        }
+    }
+
+    static constexpr ElementType EmptyText[1] = { 0 };
+
+    union {
+        ElementType  InlineData[InlineCapacity + 1];
+        ElementType *HeapData;
+    };
+    int32 Length       = 0;
+    int32 HeapCapacity = 0; // 0 表示使用内联存储
+};
+
+inline TE_STRING_FORMAT_ARG::TE_STRING_FORMAT_ARG(const TE_STRING_CLASS &Value)
+    : Type(EType::String), StringValue(Value.View()) {}
+
+template <> struct std::hash<TE_STRING_CLASS> {
+    std::size_t operator()(const TE_STRING_CLASS &Str) const {
+        return std::hash<TE_STRING_CLASS::ViewType>()(Str.View());
+    }
+};
+
+#undef TE_STRING_FORMAT_ARG
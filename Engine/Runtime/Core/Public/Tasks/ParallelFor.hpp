@@ -0,0 +1,132 @@
+/******************************************************
+ * @file Tasks/ParallelFor.hpp
+ * @brief 并行循环: ParallelFor / ParallelReduce
+ *****************************************************/
+
+#pragma once
+
+#include "Async/ManualResetEvent.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+#include "Memory/RefCounting.hpp"
+#include "Tasks/TaskPriority.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace TE::Tasks {
+namespace Private {
+// 一次并行循环的共享状态; 分出去的子区间任务可能比调用方等待得更久, 因此用引用计数管理
+template <typename RangeBodyType> struct TParallelForState : FRefCountBase {
+    TParallelForState(RangeBodyType &InRangeBody, int32 Num, int32 InMinBatch,
+                      ETaskPriority InPriority)
+        : RangeBody(InRangeBody), MinBatch(InMinBatch), Priority(InPriority), Remaining(Num),
+          MaxQueuedRanges(ThreadPool::global().threadCount()) {}
+
+    RangeBodyType      &RangeBody;
+    const int32         MinBatch;
+    const ETaskPriority Priority;
+    std::atomic<int32>  Remaining;           // 尚未执行完的迭代数, 归零即完成
+    std::atomic<int32>  QueuedRanges{ 0 };   // 已分出但还没有线程领走的子区间数
+    const int32         MaxQueuedRanges;
+    FManualResetEvent   AllDone;
+};
+
+// 懒惰二分: 每执行完一批都检查一次, 只有在排队的子区间不够空闲线程领取时,
+// 才把剩余区间的后一半分出去. 负载均匀时几乎不拆分, 不均匀时空闲线程总能领到活
+template <typename RangeBodyType>
+void RunParallelRange(const TRefCountPtr<TParallelForState<RangeBodyType>> &State, int32 Begin,
+                      int32 End) {
+    using FState = TParallelForState<RangeBodyType>;
+    int32 Done   = 0;
+    while (Begin < End) {
+        while (End - Begin > State->MinBatch &&
+               State->QueuedRanges.load(std::memory_order_relaxed) < State->MaxQueuedRanges) {
+            const int32 Mid = Begin + (End - Begin) / 2;
+            State->QueuedRanges.fetch_add(1, std::memory_order_relaxed);
+            ThreadPool::global().submit(
+                [SubState = TRefCountPtr<FState>(State), Mid, End]() {
+                    SubState->QueuedRanges.fetch_sub(1, std::memory_order_relaxed);
+                    RunParallelRange(SubState, Mid, End);
+                },
+                ToThreadPoolPriority(State->Priority));
+            End = Mid;
+        }
+        const int32 BatchEnd = std::min(End, Begin + State->MinBatch);
+        State->RangeBody(Begin, BatchEnd);
+        Done += BatchEnd - Begin;
+        Begin = BatchEnd;
+    }
+    if (State->Remaining.fetch_sub(Done, std::memory_order_acq_rel) == Done) {
+        State->AllDone.Notify();
+    }
+}
+
+// 以批为单位对 [0, Num) 调用 RangeBody(Begin, End), 返回时所有批都已执行完
+template <typename RangeBodyType>
+void ParallelForRange(int32 Num, RangeBodyType &RangeBody, int32 MinBatch,
+                      ETaskPriority Priority) {
+    MinBatch = std::max(MinBatch, 1);
+    if (Num <= 0) {
+        return;
+    }
+    // 只够一批, 不值得拆分
+    if (Num <= MinBatch) {
+        RangeBody(0, Num);
+        return;
+    }
+
+    using FState = TParallelForState<RangeBodyType>;
+    TRefCountPtr<FState> State = MakeRefCount<FState>(RangeBody, Num, MinBatch, Priority);
+    RunParallelRange(State, 0, Num);
+
+    // 自己的区间做完后继续帮线程池干活, 只在确实没有可执行的任务时才休眠;
+    // 因此可以在工作线程上嵌套调用, 不会把工作线程全部堵死
+    while (State->Remaining.load(std::memory_order_acquire) != 0) {
+        if (!ThreadPool::global().tryExecuteOne()) {
+            State->AllDone.Wait();
+            break;
+        }
+    }
+}
+} // namespace Private
+
+// 对 [0, Num) 中的每个下标并行调用 Body(int32 Index), 返回时全部执行完毕
+//
+// 调用线程也参与执行; 每次最少连续执行 MinBatch 个下标, 循环体很轻时应调大.
+// 只等待本次调用拆出的子区间, 与 ThreadPool::waitAll 不同, 不受其他任务影响.
+// 可以在任务或另一个 ParallelFor 的循环体中嵌套调用
+// Engine/Source/Runtime/Core/Public/Async/ParallelFor.h
+template <typename BodyType>
+void ParallelFor(int32 Num, BodyType &&Body, int32 MinBatch = 1,
+                 ETaskPriority Priority = ETaskPriority::Normal) {
+    auto RangeBody = [&Body](int32 Begin, int32 End) {
+        for (int32 Index = Begin; Index < End; ++Index) {
+            Body(Index);
+        }
+    };
+    Private::ParallelForRange(Num, RangeBody, MinBatch, Priority);
+}
+
+// 并行归约: 返回 Identity 与所有 Map(Index) 经 Reduce 合并的结果
+// 每批先在本地归约, 再合并到总结果中, 合并顺序不确定, Reduce 必须满足结合律与交换律
+template <typename ValueType, typename MapType, typename ReduceType>
+ValueType ParallelReduce(int32 Num, ValueType Identity, MapType &&Map, ReduceType &&Reduce,
+                         int32 MinBatch = 1, ETaskPriority Priority = ETaskPriority::Normal) {
+    ValueType Result = Identity;
+    FMutex    ResultMutex;
+    auto      RangeBody = [&](int32 Begin, int32 End) {
+        ValueType Partial = Identity;
+        for (int32 Index = Begin; Index < End; ++Index) {
+            Partial = Reduce(std::move(Partial), Map(Index));
+        }
+        TUniqueLock Lock(ResultMutex);
+        Result = Reduce(std::move(Result), std::move(Partial));
+    };
+    Private::ParallelForRange(Num, RangeBody, MinBatch, Priority);
+    return Result;
+}
+} // namespace TE::Tasks
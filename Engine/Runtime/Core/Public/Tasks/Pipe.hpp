@@ -0,0 +1,113 @@
+/******************************************************
+ * @file Tasks/Pipe.hpp
+ * @brief 管道: 投入同一管道的任务依次执行, 互不并发
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "Tasks/TaskPriority.hpp"
+#include "Tasks/Tasks.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "TypeUtils/Invoke.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+
+namespace TE::Tasks {
+// 管道
+//
+// 投入同一管道的任务按投入顺序依次执行, 任意时刻最多只有一个在运行, 但不绑定线程,
+// 仍由共享的线程池执行. 用来保护某个子系统的状态, 代替给它单独开一个线程.
+// 串行化只依靠任务依赖: 每个新任务以管道中的上一个任务为前置依赖, 投入时只做一次原子交换,
+// 调用方不需要加锁, 也不会阻塞.
+//
+// 管道对象必须比投入其中的任务活得长, 析构前需要 WaitUntilEmpty
+// Engine/Source/Runtime/Core/Public/Tasks/Pipe.h
+class FPipe {
+  public:
+    explicit FPipe(const TCHAR *InDebugName) : DebugName(InDebugName) {}
+    ~FPipe();
+
+    FPipe(const FPipe &)            = delete;
+    FPipe &operator=(const FPipe &) = delete;
+
+    template <typename TaskBodyType>
+    TTask<TInvokeResult_T<std::decay_t<TaskBodyType>>>
+    Launch(const TCHAR *TaskDebugName, TaskBodyType &&TaskBody,
+           ETaskPriority         Priority         = ETaskPriority::Normal,
+           EExtendedTaskPriority ExtendedPriority = EExtendedTaskPriority::None) {
+        return Launch(TaskDebugName, Forward<TaskBodyType>(TaskBody),
+                      std::array<Private::FTaskBase *, 0>{}, Priority, ExtendedPriority);
+    }
+
+    // 除管道中的上一个任务外, 还要等 Prerequisites 全部完成
+    template <typename TaskBodyType, typename PrerequisitesCollectionType>
+        requires(!std::is_enum_v<PrerequisitesCollectionType>)
+    TTask<TInvokeResult_T<std::decay_t<TaskBodyType>>>
+    Launch(const TCHAR *TaskDebugName, TaskBodyType &&TaskBody,
+           const PrerequisitesCollectionType &PrerequisitesCollection,
+           ETaskPriority                      Priority         = ETaskPriority::Normal,
+           EExtendedTaskPriority              ExtendedPriority = EExtendedTaskPriority::None) {
+        using FBody   = std::decay_t<TaskBodyType>;
+        using FResult = TInvokeResult_T<FBody>;
+        auto PipedBody = [this, Body = FBody(Forward<TaskBodyType>(TaskBody))]() mutable
+            -> FResult {
+            FPipeScope Scope(*this);
+            return Invoke(Body);
+        };
+        auto *Task = Private::TExecutableTaskFor<decltype(PipedBody)>::Create(
+            TaskDebugName, Priority, ExtendedPriority, std::move(PipedBody));
+        for (const auto &Prerequisite: PrerequisitesCollection) {
+            if (Private::FTaskBase *PrerequisiteTask = Private::GetTaskBase(Prerequisite)) {
+                Task->AddPrerequisite(PrerequisiteTask);
+            }
+        }
+        TaskCount.fetch_add(1, std::memory_order_relaxed);
+        PushIntoPipe(*Task);
+        Task->TryLaunch();
+        return Private::MakeTask(Task);
+    }
+
+    // 是否还有未执行完的任务
+    bool HasWork() const { return TaskCount.load(std::memory_order_acquire) != 0; }
+
+    // 阻塞直到管道中的任务全部执行完
+    void WaitUntilEmpty();
+
+    // 超时返回 false
+    template <typename Rep, typename Period>
+    bool WaitUntilEmpty(std::chrono::duration<Rep, Period> Timeout) {
+        return WaitUntilEmpty(FutexInternal::FClock::now() + Timeout);
+    }
+
+    bool WaitUntilEmpty(FutexInternal::FClock::time_point Deadline);
+
+    // 当前线程是否正在执行本管道的任务; 可以用来断言子系统状态只在管道内访问
+    bool IsInContext() const;
+
+    const TCHAR *GetDebugName() const { return DebugName; }
+
+  private:
+    // 任务体执行期间把管道压入当前线程的管道调用栈, 结束后弹出并减少计数
+    class FPipeScope {
+      public:
+        explicit FPipeScope(FPipe &InPipe);
+        ~FPipeScope();
+
+      private:
+        FPipe &Pipe;
+    };
+
+    // 让 Task 成为管道的最后一个任务, 并以原来的最后一个任务为前置依赖
+    void PushIntoPipe(Private::FTaskBase &Task);
+
+    const TCHAR *DebugName;
+    // 管道持有最后一个任务的一份引用, 新任务投入时交换出来并释放
+    std::atomic<Private::FTaskBase *> LastTask{ nullptr };
+    // 已投入但尚未执行完的任务数; 等待者以它的地址停在 ParkingLot 中
+    std::atomic<uint64> TaskCount{ 0 };
+};
+} // namespace TE::Tasks
@@ -0,0 +1,57 @@
+/******************************************************
+ * @file Tasks/TaskPriority.hpp
+ * @brief 任务优先级与命名线程
+ *****************************************************/
+
+#pragma once
+
+#include "Thread/ThreadPool.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+namespace TE::Tasks {
+// 工作线程按优先级分档取任务, 先取完高档再取低档
+// Engine/Source/Runtime/Core/Public/Async/Fundamental/TaskShared.h:22
+enum class ETaskPriority : uint8 {
+    High,
+    Normal,
+    Background,
+    Count
+};
+
+static_assert(int(ETaskPriority::Count) == TaskPriorityCount);
+
+inline TaskPriority ToThreadPoolPriority(ETaskPriority Priority) {
+    return static_cast<TaskPriority>(Priority);
+}
+
+// 不由线程池执行的线程, 由线程自己在合适的时机调用 ProcessNamedThreadUntilIdle 执行投递给它的任务
+enum class ENamedThread : uint8 {
+    GameThread,
+    RenderThread,
+    Count
+};
+
+// 决定任务在哪里执行
+// Engine/Source/Runtime/Core/Public/Tasks/TaskPrivate.h:28
+enum class EExtendedTaskPriority : uint8 {
+    None,         // 由线程池按 ETaskPriority 执行
+    Inline,       // 在解除最后一个依赖的线程上直接执行, 只适合非常小的任务
+    GameThread,   // 投递到游戏线程
+    RenderThread, // 投递到渲染线程
+};
+
+inline bool IsNamedThreadPriority(EExtendedTaskPriority ExtendedPriority) {
+    return ExtendedPriority == EExtendedTaskPriority::GameThread ||
+           ExtendedPriority == EExtendedTaskPriority::RenderThread;
+}
+
+inline ENamedThread ToNamedThread(EExtendedTaskPriority ExtendedPriority) {
+    return ExtendedPriority == EExtendedTaskPriority::GameThread ? ENamedThread::GameThread
+                                                                   : ENamedThread::RenderThread;
+}
+
+inline EExtendedTaskPriority ToExtendedPriority(ENamedThread Thread) {
+    return Thread == ENamedThread::GameThread ? EExtendedTaskPriority::GameThread
+                                              : EExtendedTaskPriority::RenderThread;
+}
+} // namespace TE::Tasks
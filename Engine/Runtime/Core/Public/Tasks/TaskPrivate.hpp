@@ -0,0 +1,352 @@
+/******************************************************
+ * @file Tasks/TaskPrivate.hpp
+ * @brief 任务图内部实现, 外部请使用 Tasks/Tasks.hpp
+ *****************************************************/
+
+#pragma once
+
+#include "Async/ManualResetEvent.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+#include "DebugUtils/CoreDebug.hpp"
+#include "Memory/FixedBlockAllocator.hpp"
+#include "Tasks/TaskPriority.hpp"
+#include "Trace/Trace.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "TypeUtils/Invoke.hpp"
+#include "TypeUtils/TypeCompatibleBytes.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace TE::Tasks::Private {
+
+class FTaskBase;
+class FNamedThreadQueue;
+
+// 任务的前置依赖, 任务执行完毕后统一释放引用
+// Engine/Source/Runtime/Core/Public/Tasks/TaskPrivate.h:55
+class FPrerequisites {
+  public:
+    void Push(FTaskBase *Prerequisite) {
+        TUniqueLock Lock(Mutex);
+        PushNoLock(Prerequisite);
+    }
+
+    // 任务发射前只有创建者一个线程可见, 无需加锁
+    void PushNoLock(FTaskBase *Prerequisite) { Prerequisites.push_back(Prerequisite); }
+
+    std::vector<FTaskBase *> PopAll() {
+        TUniqueLock Lock(Mutex);
+        return std::move(Prerequisites);
+    }
+
+    // 第 Index 个前置任务, 已经 AddRef; 越界或任务已完成 (列表已清空) 时返回 nullptr
+    // 逐个取出而不是拷贝整个列表, 撤回执行时不需要分配内存
+    FTaskBase *AddRefAt(std::size_t Index);
+
+  private:
+    std::vector<FTaskBase *> Prerequisites;
+    FMutex                   Mutex;
+};
+
+// 任务的后继, 任务完成时关闭列表并逐个解锁
+// Engine/Source/Runtime/Core/Public/Tasks/TaskPrivate.h:80
+class FSubsequents {
+  public:
+    // 列表已关闭 (任务已完成) 时返回 false
+    bool PushIfNotClosed(FTaskBase *Subsequent) {
+        if (IsClosed()) {
+            return false;
+        }
+        TUniqueLock Lock(Mutex);
+        if (bIsClosed.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        Subsequents.push_back(Subsequent);
+        return true;
+    }
+
+    std::vector<FTaskBase *> Close() {
+        TUniqueLock Lock(Mutex);
+        bIsClosed.store(true, std::memory_order_release);
+        return std::move(Subsequents);
+    }
+
+    bool IsClosed() const { return bIsClosed.load(std::memory_order_acquire); }
+
+  private:
+    std::vector<FTaskBase *> Subsequents;
+    FMutex                   Mutex;
+    std::atomic<bool>        bIsClosed{ false };
+};
+
+// 任务图中的一个节点: 侵入式引用计数 + 前置/后继依赖 + 完成事件
+// 生命周期: 创建时引用计数为 2, 一份属于返回给用户的句柄, 一份属于调度器,
+// 后者在任务执行完毕并通知后继之后释放
+// Engine/Source/Runtime/Core/Public/Tasks/TaskPrivate.h:120
+class FTaskBase {
+  public:
+    FTaskBase(const FTaskBase &)            = delete;
+    FTaskBase &operator=(const FTaskBase &) = delete;
+
+    // ============== Liveness ==============
+    void AddRef() { RefCount.fetch_add(1, std::memory_order_relaxed); }
+
+    void Release() {
+        if (RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    uint32 GetRefCount() { return RefCount.load(std::memory_order_relaxed); }
+
+    // ============== Tasks Order ==============
+    // 只能在 TryLaunch 之前调用
+    void AddPrerequisite(FTaskBase *Prerequisite) {
+        check(Prerequisite != this);
+        // 先加锁再挂到前置任务上, 避免前置任务在中途完成导致提前解锁
+        NumLocks.fetch_add(1, std::memory_order_relaxed);
+        if (Prerequisite->AddSubsequent(this)) {
+            Prerequisite->AddRef();
+            Prerequisites.PushNoLock(Prerequisite);
+        } else {
+            // 前置任务已经完成
+            NumLocks.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 解除 "发射锁"; 如果没有未完成的前置任务, 立即交给调度器执行
+    bool TryLaunch() { return TryUnlock(); }
+
+    // ============== Internal State ==============
+    bool IsCompleted() const { return CompletionEvent.IsNotified(); }
+
+    // 阻塞等待任务完成; 任务还没开始执行时先尝试撤回到当前线程直接执行
+    // 在命名线程上等待时, 一边等一边执行投递给该线程的任务, 以免等待依赖于它的任务时死锁
+    void Wait() {
+        if (!TryRetractAndExecute()) {
+            WaitUntil(FutexInternal::FClock::time_point::max());
+        }
+    }
+
+    // 超时返回 false
+    template <typename Rep, typename Period> bool Wait(std::chrono::duration<Rep, Period> Timeout) {
+        return TryRetractAndExecute() || WaitUntil(FutexInternal::FClock::now() + Timeout);
+    }
+
+    // 以下定义在 Private/Tasks/Tasks.cpp
+    bool WaitUntil(FutexInternal::FClock::time_point Deadline);
+
+    // 任务已被调度但还没有线程开始执行时, 把它从队列中 "撤回" 到当前线程直接执行,
+    // 尚未开始的前置任务先递归地撤回执行. 返回任务是否已经完成
+    // Engine/Source/Runtime/Core/Public/Tasks/TaskPrivate.h:447
+    bool TryRetractAndExecute();
+
+    // 等待期间不休眠, 而是在当前线程上执行线程池 (以及本线程的命名线程队列) 中的其他任务
+    // 超时返回 false
+    bool BusyWaitUntil(FutexInternal::FClock::time_point Deadline);
+
+    const TCHAR *GetDebugName() const { return DebugName; }
+
+    ETaskPriority GetPriority() const { return Priority; }
+
+    EExtendedTaskPriority GetExtendedPriority() const { return ExtendedPriority; }
+
+  protected:
+    explicit FTaskBase(const TCHAR *InDebugName, ETaskPriority InPriority,
+                       EExtendedTaskPriority InExtendedPriority, uint32 InitRefCount)
+        : DebugName(InDebugName), RefCount(InitRefCount), Priority(InPriority),
+          ExtendedPriority(InExtendedPriority) {}
+
+    virtual ~FTaskBase() = default;
+
+    // 执行任务体, 由派生类实现
+    virtual void ExecuteTask() = 0;
+
+  private:
+    friend class FNamedThreadQueue;
+
+    // 后继列表已关闭 (本任务已完成) 时返回 false
+    bool AddSubsequent(FTaskBase *Subsequent) { return Subsequents.PushIfNotClosed(Subsequent); }
+
+    // 前置任务完成或发射时调用, 最后一把锁解开时调度执行
+    bool TryUnlock() {
+        if (NumLocks.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return false;
+        }
+        Schedule();
+        return true;
+    }
+
+    // 按优先级交给全局线程池或命名线程, 定义在 Private/Tasks/Tasks.cpp
+    void Schedule();
+
+    // 调度队列与撤回方都可能来执行, 只有先抢到的一方真正执行
+    bool TryExecuteTask() {
+        if (bExecutionClaimed.exchange(true, std::memory_order_acq_rel)) {
+            return false;
+        }
+        {
+#if ENGINE_ENABLE_TRACE
+            Trace::FTraceScope TraceScope(DebugName);
+#endif
+            ExecuteTask();
+        }
+        Close();
+        return true;
+    }
+
+    void Close() {
+        // 先标记完成并唤醒等待者
+        CompletionEvent.Notify();
+
+        // 再解锁后继
+        for (FTaskBase *Subsequent: Subsequents.Close()) {
+            Subsequent->TryUnlock();
+        }
+
+        for (FTaskBase *Prerequisite: Prerequisites.PopAll()) {
+            Prerequisite->Release();
+        }
+
+        // 释放调度器持有的引用
+        Release();
+    }
+
+  private:
+    const TCHAR          *DebugName;
+    std::atomic<uint32>   RefCount;
+    // 发射锁 (1) + 未完成的前置任务数
+    std::atomic<uint32>   NumLocks{ 1 };
+    ETaskPriority         Priority;
+    EExtendedTaskPriority ExtendedPriority;
+    // 已交给调度队列 (队列持有一份引用), 此后才允许撤回执行
+    std::atomic<bool>     bScheduled{ false };
+    std::atomic<bool>     bExecutionClaimed{ false };
+    // 只占一个字节, 等待者停在 ParkingLot 中
+    FManualResetEvent     CompletionEvent;
+    FPrerequisites        Prerequisites;
+    FSubsequents          Subsequents;
+};
+
+inline FTaskBase *FPrerequisites::AddRefAt(std::size_t Index) {
+    TUniqueLock Lock(Mutex);
+    if (Index >= Prerequisites.size()) {
+        return nullptr;
+    }
+    Prerequisites[Index]->AddRef();
+    return Prerequisites[Index];
+}
+
+// 在任务对象内部原地存放执行结果, 不要求结果类型可默认构造或可拷贝;
+// 引用类型的结果只保存地址, void 不占空间
+template <typename ResultType> class TTaskWithResult : public FTaskBase {
+    static_assert(!std::is_rvalue_reference_v<ResultType>, "任务结果不能是右值引用");
+
+  public:
+    ResultType &GetResult() {
+        check(IsCompleted());
+        if constexpr (std::is_reference_v<ResultType>) {
+            return **ResultStorage.GetTypedPtr();
+        } else {
+            return *ResultStorage.GetTypedPtr();
+        }
+    }
+
+  protected:
+    using FTaskBase::FTaskBase;
+    using StorageType = std::conditional_t<std::is_reference_v<ResultType>,
+                                           std::remove_reference_t<ResultType> *, ResultType>;
+
+    ~TTaskWithResult() override {
+        if (IsCompleted()) {
+            ResultStorage.GetTypedPtr()->~StorageType();
+        }
+    }
+
+    // 直接用任务体的返回值构造结果; 返回纯右值时不经过拷贝或移动
+    template <typename TaskBodyType> void ExecuteAndStoreResult(TaskBodyType &TaskBody) {
+        if constexpr (std::is_reference_v<ResultType>) {
+            ResultType Result = Invoke(TaskBody);
+            new (ResultStorage.GetTypedPtr()) StorageType(&Result);
+        } else {
+            new (ResultStorage.GetTypedPtr()) ResultType(Invoke(TaskBody));
+        }
+    }
+
+    TTypeCompatibleBytes<StorageType> ResultStorage;
+};
+
+template <> class TTaskWithResult<void> : public FTaskBase {
+  protected:
+    using FTaskBase::FTaskBase;
+
+    template <typename TaskBodyType> void ExecuteAndStoreResult(TaskBodyType &TaskBody) {
+        Invoke(TaskBody);
+    }
+};
+
+// 任务对象按 64 字节分档复用定长块, 过大的任务体才走全局堆
+inline constexpr std::size_t SmallTaskSizeClass = 64;
+inline constexpr std::size_t SmallTaskMaxSize   = 1024;
+
+template <typename TaskType>
+using TSmallTaskAllocator =
+    TFixedBlockAllocator<(sizeof(TaskType) + SmallTaskSizeClass - 1) / SmallTaskSizeClass *
+                             SmallTaskSizeClass,
+                         alignof(TaskType) < alignof(std::max_align_t) ? alignof(std::max_align_t)
+                                                                       : alignof(TaskType)>;
+
+// 持有任务体的可执行任务, 任务体执行完即析构, 以尽早释放捕获的资源
+template <typename TaskBodyType, typename ResultType = TInvokeResult_T<TaskBodyType>>
+class TExecutableTask final : public TTaskWithResult<ResultType> {
+  public:
+    template <typename InTaskBodyType>
+    static TExecutableTask *Create(const TCHAR *DebugName, ETaskPriority Priority,
+                                   EExtendedTaskPriority ExtendedPriority,
+                                   InTaskBodyType      &&TaskBody) {
+        return new TExecutableTask(DebugName, Priority, ExtendedPriority,
+                                   Forward<InTaskBodyType>(TaskBody));
+    }
+
+    static void *operator new(std::size_t Size) {
+        if constexpr (sizeof(TExecutableTask) <= SmallTaskMaxSize) {
+            return TSmallTaskAllocator<TExecutableTask>::Allocate();
+        } else {
+            return ::operator new(Size, std::align_val_t(alignof(TExecutableTask)));
+        }
+    }
+
+    static void operator delete(void *Ptr) {
+        if constexpr (sizeof(TExecutableTask) <= SmallTaskMaxSize) {
+            TSmallTaskAllocator<TExecutableTask>::Free(Ptr);
+        } else {
+            ::operator delete(Ptr, std::align_val_t(alignof(TExecutableTask)));
+        }
+    }
+
+  private:
+    template <typename InTaskBodyType>
+    TExecutableTask(const TCHAR *DebugName, ETaskPriority Priority,
+                    EExtendedTaskPriority ExtendedPriority, InTaskBodyType &&TaskBody)
+        : TTaskWithResult<ResultType>(DebugName, Priority, ExtendedPriority,
+                                      /*InitRefCount=*/2) {
+        new (TaskBodyStorage.GetTypedPtr()) TaskBodyType(Forward<InTaskBodyType>(TaskBody));
+    }
+
+    void ExecuteTask() override {
+        TaskBodyType &TaskBody = *TaskBodyStorage.GetTypedPtr();
+        this->ExecuteAndStoreResult(TaskBody);
+        TaskBody.~TaskBodyType();
+    }
+
+    TTypeCompatibleBytes<TaskBodyType> TaskBodyStorage;
+};
+
+} // namespace TE::Tasks::Private
@@ -6,57 +6,264 @@
 #pragma once
 
 #include "Memory/RefCounting.hpp"
+#include "Tasks/TaskPriority.hpp"
+#include "Tasks/TaskPrivate.hpp"
 #include "TypeUtils/CoreType.hpp"
 #include "TypeUtils/Invoke.hpp"
+
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <type_traits>
 
 namespace TE::Tasks {
+template <typename ResultType> class TTask;
+
 namespace Private {
+// Engine/Source/Runtime/Core/Public/Tasks/Task.h:33
+class FTaskHandle {
+  public:
+    FTaskHandle() = default;
+
+    bool IsValid() const { return Pimpl.IsValid(); }
+
+    // 检查任务是否已经完成 (空句柄视为已完成)
+    bool IsCompleted() const { return !IsValid() || Pimpl->IsCompleted(); }
+
+    // 阻塞等待任务完成
+    void Wait() const {
+        if (IsValid()) {
+            Pimpl->Wait();
+        }
+    }
 
-// Engine/Source/Runtime/Core/Public/Tasks/TaskPrivate.h:120
-class FTaskBase {
+    // 超时返回 false
+    template <typename Rep, typename Period>
+    bool Wait(std::chrono::duration<Rep, Period> Timeout) const {
+        return !IsValid() || Pimpl->Wait(Timeout);
+    }
 
-public:
-  void AddRef() {}
-  void Release() {}
-  uint32 GetRefCount() { return 0; }
+    // 任务还没开始执行时在当前线程上直接执行它 (连同尚未开始的前置任务)
+    // 返回任务是否已经完成; 任务正在其他线程上执行时返回 false, 不会阻塞
+    bool TryRetractAndExecute() const { return !IsValid() || Pimpl->TryRetractAndExecute(); }
+
+    // 等待任务完成, 期间在当前线程上执行线程池中的其他任务而不是休眠
+    void BusyWait() const {
+        if (IsValid()) {
+            Pimpl->BusyWaitUntil(FutexInternal::FClock::time_point::max());
+        }
+    }
+
+    // 超时返回 false
+    template <typename Rep, typename Period>
+    bool BusyWait(std::chrono::duration<Rep, Period> Timeout) const {
+        return !IsValid() || Pimpl->BusyWaitUntil(FutexInternal::FClock::now() + Timeout);
+    }
+
+    FTaskBase *GetTaskBase() const { return Pimpl.GetReference(); }
+
+  protected:
+    // 接管 Other 已持有的一份引用
+    explicit FTaskHandle(FTaskBase *Other) : Pimpl(Other, /*bAddRef=*/false) {}
+
+    TRefCountPtr<FTaskBase> Pimpl;
 };
 
-// Engine/Source/Runtime/Core/Public/Tasks/Task.h:33
-class FTaskHandle {
-public:
-  bool IsValid() const { return false; }
+inline FTaskBase *GetTaskBase(const FTaskHandle &Handle) {
+    return Handle.GetTaskBase();
+}
+
+inline FTaskBase *GetTaskBase(FTaskBase *Task) {
+    return Task;
+}
 
-  // 检查任务是否已经完成
-  bool IsCompleted() const { return false; }
+template <typename ResultType>
+TTask<ResultType> MakeTask(TTaskWithResult<ResultType> *Task);
 
-protected:
-  TRefCountPtr<FTaskBase> Pimpl;
+// 延续任务的结果类型: 前置任务的结果以左值引用传入, void 任务的延续不带参数
+template <typename ResultType, typename ContinuationType> struct TContinuationResult {
+    using Type = TInvokeResult_T<ContinuationType, ResultType &>;
 };
+
+template <typename ContinuationType> struct TContinuationResult<void, ContinuationType> {
+    using Type = TInvokeResult_T<ContinuationType>;
+};
+
+template <typename ResultType, typename ContinuationType>
+using TContinuationResult_T =
+    typename TContinuationResult<ResultType, std::decay_t<ContinuationType>>::Type;
+
+template <typename ResultType, typename ContinuationType>
+TTask<TContinuationResult_T<ResultType, ContinuationType>>
+LaunchContinuation(const TTask<ResultType> &Parent, const TCHAR *DebugName,
+                   ContinuationType &&Continuation, ETaskPriority Priority,
+                   EExtendedTaskPriority ExtendedPriority);
 } // namespace Private
 
 // Engine/Source/Runtime/Core/Public/Tasks/Task.h:220
-template <typename ResultType> class TTask {
-public:
-  ResultType Result;
-  TTask(ResultType Result) : Result(Result) {}
+template <typename ResultType> class TTask : public Private::FTaskHandle {
+  public:
+    TTask() = default;
+
+    // 等待任务完成并返回结果的引用, 结果存放在任务对象内部, 与句柄同生命周期
+    ResultType &GetResult() {
+        check(IsValid());
+        Wait();
+        return static_cast<Private::TTaskWithResult<ResultType> *>(Pimpl.GetReference())
+            ->GetResult();
+    }
+
+    // 本任务完成后以它的结果调用 Continuation, 返回延续任务的句柄, 可以继续链式调用.
+    // 默认 Inline: 直接在完成本任务的线程上执行, 不经过队列; 较重的延续应传 None 交给线程池
+    template <typename ContinuationType>
+    TTask<Private::TContinuationResult_T<ResultType, ContinuationType>>
+    Then(const TCHAR *DebugName, ContinuationType &&Continuation,
+         ETaskPriority         Priority         = ETaskPriority::Normal,
+         EExtendedTaskPriority ExtendedPriority = EExtendedTaskPriority::Inline) const {
+        return Private::LaunchContinuation(*this, DebugName,
+                                           Forward<ContinuationType>(Continuation), Priority,
+                                           ExtendedPriority);
+    }
+
+  private:
+    explicit TTask(Private::TTaskWithResult<ResultType> *Task) : FTaskHandle(Task) {}
+
+    friend TTask Private::MakeTask<ResultType>(Private::TTaskWithResult<ResultType> *Task);
+};
+
+template <> class TTask<void> : public Private::FTaskHandle {
+  public:
+    TTask() = default;
+
+    void GetResult() {
+        check(IsValid());
+        Wait();
+    }
+
+    // 本任务完成后不带参数调用 Continuation, 返回延续任务的句柄, 可以继续链式调用.
+    // 默认 Inline 的含义同 TTask<T>::Then
+    template <typename ContinuationType>
+    TTask<Private::TContinuationResult_T<void, ContinuationType>>
+    Then(const TCHAR *DebugName, ContinuationType &&Continuation,
+         ETaskPriority         Priority         = ETaskPriority::Normal,
+         EExtendedTaskPriority ExtendedPriority = EExtendedTaskPriority::Inline) const {
+        return Private::LaunchContinuation(*this, DebugName,
+                                           Forward<ContinuationType>(Continuation), Priority,
+                                           ExtendedPriority);
+    }
+
+  private:
+    explicit TTask(Private::TTaskWithResult<void> *Task) : FTaskHandle(Task) {}
+
+    friend TTask Private::MakeTask<void>(Private::TTaskWithResult<void> *Task);
+};
+
+namespace Private {
+template <typename ResultType>
+TTask<ResultType> MakeTask(TTaskWithResult<ResultType> *Task) {
+    return TTask<ResultType>(Task);
+}
+
+template <typename TaskBodyType>
+using TExecutableTaskFor = TExecutableTask<std::decay_t<TaskBodyType>>;
+
+// 延续任务的任务体: 持有前置任务的句柄 (保证结果在执行时仍然有效), 直接引用其内部的结果,
+// 不拷贝结果, 也不需要额外的中转任务
+template <typename ResultType, typename ContinuationType> class TContinuationBody {
+  public:
+    template <typename InContinuationType>
+    TContinuationBody(const TTask<ResultType> &InParent, InContinuationType &&InContinuation)
+        : Parent(InParent), Continuation(Forward<InContinuationType>(InContinuation)) {}
+
+    TContinuationResult_T<ResultType, ContinuationType> operator()() {
+        if constexpr (std::is_void_v<ResultType>) {
+            return Invoke(Continuation);
+        } else {
+            auto *ParentTask = static_cast<TTaskWithResult<ResultType> *>(Parent.GetTaskBase());
+            return Invoke(Continuation, ParentTask->GetResult());
+        }
+    }
+
+  private:
+    TTask<ResultType> Parent;
+    ContinuationType  Continuation;
 };
 
+template <typename ResultType, typename ContinuationType>
+TTask<TContinuationResult_T<ResultType, ContinuationType>>
+LaunchContinuation(const TTask<ResultType> &Parent, const TCHAR *DebugName,
+                   ContinuationType &&Continuation, ETaskPriority Priority,
+                   EExtendedTaskPriority ExtendedPriority) {
+    check(Parent.IsValid());
+    using BodyType = TContinuationBody<ResultType, std::decay_t<ContinuationType>>;
+    auto *Task     = TExecutableTask<BodyType>::Create(
+        DebugName, Priority, ExtendedPriority,
+        BodyType(Parent, Forward<ContinuationType>(Continuation)));
+    Task->AddPrerequisite(Parent.GetTaskBase());
+    Task->TryLaunch();
+    return MakeTask(Task);
+}
+} // namespace Private
+
+// 将若干任务打包成前置依赖集合, 用于 Launch 的 Prerequisites 参数
+// 返回的集合不持有引用, 需要在 Launch 调用期间保持任务句柄有效
+template <typename... TaskTypes>
+std::array<Private::FTaskBase *, sizeof...(TaskTypes)> Prerequisites(const TaskTypes &...Tasks) {
+    return { Private::GetTaskBase(Tasks)... };
+}
+
+// 创建任务并异步执行: 默认交给全局线程池, ExtendedPriority 可以指定命名线程
 // Engine/Source/Runtime/Core/Public/Tasks/Task.h:299
 template <typename TaskBodyType>
-TTask<TInvokeResult_T<TaskBodyType>> Launch(const TCHAR *DebugName,
-                                            TaskBodyType &&TaskBody) {
-  TInvokeResult_T<TaskBodyType> Result;
-  Result = Invoke(TaskBody);
-  return TTask<TInvokeResult_T<TaskBodyType>>(Result);
-}
-// Launch(const TCHAR *DebugName, TaskBodyType &&TaskBody,
-//        ETaskPriority         Priority         = ETaskPriority::Normal,
-//        EExtendedTaskPriority ExtendedPriority = EExtendedTaskPriority::None,
-//        ETaskFlags            Flags            = ETaskFlags::None) {
-//     using FResult = TInvokeResult_T<TaskBodyType>;
-//     TTask<FResult> Task;
-//     Task.Launch(DebugName, Forward<TaskBodyType>(TaskBody), Priority,
-//     ExtendedPriority, Flags); return Task;
-// }
-} // namespace TE::Tasks
\ No newline at end of file
+TTask<TInvokeResult_T<std::decay_t<TaskBodyType>>>
+Launch(const TCHAR *DebugName, TaskBodyType &&TaskBody,
+       ETaskPriority         Priority         = ETaskPriority::Normal,
+       EExtendedTaskPriority ExtendedPriority = EExtendedTaskPriority::None) {
+    auto *Task = Private::TExecutableTaskFor<TaskBodyType>::Create(
+        DebugName, Priority, ExtendedPriority, Forward<TaskBodyType>(TaskBody));
+    Task->TryLaunch();
+    return Private::MakeTask(Task);
+}
+
+// 在 Prerequisites 中的所有任务完成后才开始执行
+// PrerequisitesCollectionType 可以是 Prerequisites(...) 的返回值, 也可以是任务句柄的容器
+template <typename TaskBodyType, typename PrerequisitesCollectionType>
+    requires(!std::is_enum_v<PrerequisitesCollectionType>)
+TTask<TInvokeResult_T<std::decay_t<TaskBodyType>>>
+Launch(const TCHAR *DebugName, TaskBodyType &&TaskBody,
+       const PrerequisitesCollectionType &PrerequisitesCollection,
+       ETaskPriority                      Priority         = ETaskPriority::Normal,
+       EExtendedTaskPriority              ExtendedPriority = EExtendedTaskPriority::None) {
+    auto *Task = Private::TExecutableTaskFor<TaskBodyType>::Create(
+        DebugName, Priority, ExtendedPriority, Forward<TaskBodyType>(TaskBody));
+    for (const auto &Prerequisite: PrerequisitesCollection) {
+        if (Private::FTaskBase *PrerequisiteTask = Private::GetTaskBase(Prerequisite)) {
+            Task->AddPrerequisite(PrerequisiteTask);
+        }
+    }
+    Task->TryLaunch();
+    return Private::MakeTask(Task);
+}
+
+// 等待集合中的所有任务完成
+template <typename TaskCollectionType> void Wait(const TaskCollectionType &Tasks) {
+    for (const auto &Task: Tasks) {
+        if (Private::FTaskBase *TaskBase = Private::GetTaskBase(Task)) {
+            TaskBase->Wait();
+        }
+    }
+}
+
+// ============== Named Threads ==============
+// 把当前线程登记为命名线程 Thread; 一个命名线程同一时刻只能由一个线程登记
+void AttachToNamedThread(ENamedThread Thread);
+
+void DetachFromNamedThread();
+
+// 当前线程登记的命名线程, 没有登记时返回 ENamedThread::Count
+ENamedThread GetCurrentNamedThread();
+
+// 执行投递给 Thread 的任务, 直到队列为空, 返回执行的任务数
+// 只能在登记为 Thread 的线程上调用
+uint32 ProcessNamedThreadUntilIdle(ENamedThread Thread);
+} // namespace TE::Tasks
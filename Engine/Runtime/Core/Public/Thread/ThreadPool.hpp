@@ -5,9 +5,20 @@
 
 #pragma once
 
-#include <functional>
+#include "TypeUtils/UniqueFunction.hpp"
+
 #include <memory>
 
+// 提交优先级: 工作线程总是先取完高优先级的任务, 再去取低优先级的任务
+// 已经开始执行的任务不会被抢占
+enum class TaskPriority : int {
+    High,       // 帧内关键路径上的任务
+    Normal,     // 默认
+    Background, // 存盘、流式加载等可以延后的任务
+};
+
+inline constexpr int TaskPriorityCount = 3;
+
 class ThreadPool {
   public:
     // 创建指定数量线程
@@ -21,11 +32,22 @@ class ThreadPool {
     ~ThreadPool();
 
     // 提交一个任务，任务是一个无参可调用对象
-    void submit(std::function<void()> task);
+    // 可调用对象只需可移动; 捕获不超过 TUniqueFunction::InlineSize 字节时, 稳定状态下提交不发生堆分配
+    void submit(TUniqueFunction<void()> task, TaskPriority priority = TaskPriority::Normal);
 
     // 等待所有已经提交的任务执行完毕
     void waitAll();
 
+    // 在调用线程上执行一个排队中的任务 (优先级最高的), 没有任务时返回 false
+    // 供等待方在等待期间帮忙, 任意线程都可以调用
+    bool tryExecuteOne();
+
+    // 工作线程数量
+    int threadCount() const;
+
+    // 引擎全局线程池, 首次调用时创建 (硬件线程数 - 1 个工作线程, 至少 1 个)
+    static ThreadPool &global();
+
   private:
     // 前向声明，不需要暴露实现细节到头文件
     struct ThreadPoolImpl;
@@ -0,0 +1,172 @@
+/******************************************************
+ * @file Thread/WorkStealingDeque.hpp
+ * @brief Chase-Lev 工作窃取双端队列
+ *****************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Chase-Lev 无锁工作窃取队列, 内存序参考:
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., PPoPP'13)
+//
+// - push / pop 只能由拥有者线程调用, 在 bottom 端操作 (LIFO, 利于缓存局部性)
+// - steal 可由任意线程调用, 在 top 端操作 (FIFO)
+//
+// 队列只保存指针: steal 在 CAS 成功之前读出的槽位可能已被拥有者覆盖,
+// 只有指针这种可原子读写的元素才能安全地被丢弃重试
+template <typename T> class WorkStealingDeque {
+  public:
+    explicit WorkStealingDeque(int64_t initialCapacity = 1024) {
+        int64_t capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        buffer_.store(new Buffer(capacity), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque &)            = delete;
+    WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    ~WorkStealingDeque() { delete buffer_.load(std::memory_order_relaxed); }
+
+    // 仅拥有者线程调用
+    void push(T *item) {
+        int64_t b   = bottom_.load(std::memory_order_relaxed);
+        int64_t t   = top_.load(std::memory_order_acquire);
+        Buffer *buf = buffer_.load(std::memory_order_relaxed);
+        if (b - t > buf->mask) {
+            buf = grow(buf, t, b);
+        }
+        buf->put(b, item);
+        // 用 release 写代替 release 栅栏 + relaxed 写: x86 上代价相同, 且 TSan 能识别这条同步边
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    // 仅拥有者线程调用, 队列为空时返回 nullptr
+    T *pop() {
+        int64_t b   = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer *buf = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            // 队列为空, 恢复 bottom
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T *item = buf->get(b);
+        if (t == b) {
+            // 最后一个元素, 需要与窃取者竞争
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    // 任意线程调用; 队列为空或与其他线程竞争失败时返回 nullptr
+    T *steal() {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        Buffer *buf  = buffer_.load(std::memory_order_acquire);
+        T      *item = buf->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+
+    // 近似值, 仅用于调度启发
+    int64_t sizeApprox() const {
+        int64_t b = bottom_.load(std::memory_order_relaxed);
+        int64_t t = top_.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool isEmptyApprox() const { return sizeApprox() == 0; }
+
+  private:
+    struct Buffer {
+        int64_t                            mask;
+        std::unique_ptr<std::atomic<T *>[]> slots;
+        Buffer                            *retired = nullptr; // 扩容前的旧缓冲区
+
+        explicit Buffer(int64_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<T *>[capacity]) {}
+
+        ~Buffer() { delete retired; }
+
+        T *get(int64_t index) const { return slots[index & mask].load(std::memory_order_relaxed); }
+
+        void put(int64_t index, T *item) {
+            slots[index & mask].store(item, std::memory_order_relaxed);
+        }
+    };
+
+    Buffer *grow(Buffer *old, int64_t t, int64_t b) {
+        Buffer *grown = new Buffer((old->mask + 1) * 2);
+        for (int64_t i = t; i < b; ++i) {
+            grown->put(i, old->get(i));
+        }
+        // 窃取者可能仍在读旧缓冲区, 旧缓冲区挂到新缓冲区上, 随队列一起释放
+        grown->retired = old;
+        buffer_.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+    // top 与 bottom 分别由窃取者和拥有者频繁写入, 放在不同缓存行避免伪共享
+    alignas(64) std::atomic<int64_t> top_{ 0 };
+    alignas(64) std::atomic<int64_t> bottom_{ 0 };
+    alignas(64) std::atomic<Buffer *> buffer_{ nullptr };
+};
+
+// 无锁注入队列 (多生产者, 批量消费)
+//
+// 外部线程提交任务时 push 到这里; 工作线程通过 popAll 一次性取走整批任务,
+// 再放进自己的 WorkStealingDeque 中供其他工作线程窃取.
+// push 只做 CAS 压栈, popAll 只做 exchange, 因此不存在 ABA 问题.
+// NodeType 需要一个 NodeType *next 成员.
+template <typename NodeType> class InjectionQueue {
+  public:
+    void push(NodeType *node) {
+        NodeType *head = head_.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!head_.compare_exchange_weak(head, node, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    // 取走全部节点, 按提交顺序 (FIFO) 以链表形式返回
+    NodeType *popAll() {
+        if (head_.load(std::memory_order_relaxed) == nullptr) {
+            return nullptr;
+        }
+        NodeType *head     = head_.exchange(nullptr, std::memory_order_acquire);
+        NodeType *reversed = nullptr;
+        while (head) {
+            NodeType *next = head->next;
+            head->next     = reversed;
+            reversed       = head;
+            head           = next;
+        }
+        return reversed;
+    }
+
+    bool isEmptyApprox() const { return head_.load(std::memory_order_relaxed) == nullptr; }
+
+  private:
+    alignas(64) std::atomic<NodeType *> head_{ nullptr };
+};
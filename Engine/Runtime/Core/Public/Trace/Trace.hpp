@@ -0,0 +1,102 @@
+/******************************************************
+ * @file Trace/Trace.hpp
+ * @brief 轻量级性能追踪, 导出为 Chrome trace JSON
+ *****************************************************/
+
+#pragma once
+
+#include "MarcoUtils/CoreMarco.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// 编译期开关: 以 -DENGINE_ENABLE_TRACE=0 编译时, TRACE_SCOPE 与任务追踪全部展开为空
+#ifndef ENGINE_ENABLE_TRACE
+#define ENGINE_ENABLE_TRACE 1
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// 追踪
+//
+// 每个线程把事件写进自己的环形缓冲区 (单写者, 无锁), 缓冲区写满后覆盖最旧的事件.
+// 一个事件只在作用域结束时写一次: 名字指针 + 开始/结束时间戳, 不格式化、不分配内存;
+// 名字必须是静态生命周期的字符串 (字面量或任务的 DebugName).
+// 导出时再把时间戳换算成微秒, 生成可以直接拖进 chrome://tracing / Perfetto 的 JSON.
+namespace TE::Trace {
+namespace Private {
+extern std::atomic<bool>   GTracing;
+// 每次 StartTracing 加一; 事件与线程缓冲区都带上所属的采集序号, 旧采集的数据不会混进新采集
+extern std::atomic<uint32> GTraceSession;
+
+// 原始时间戳: x86-64 上直接读 TSC (约几个纳秒), 导出时按采集期间的墙钟时间换算
+FORCEINLINE uint64 ReadTimestamp() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count());
+#endif
+}
+
+// 写入当前线程的环形缓冲区, 定义在 Private/Trace/Trace.cpp
+// Session 为事件开始时的采集序号, 与当前采集不同时丢弃
+void WriteEvent(const TCHAR *Name, uint32 Session, uint64 BeginTimestamp, uint64 EndTimestamp);
+} // namespace Private
+
+// 每个线程最多保留的事件数
+inline constexpr uint32 ThreadEventCapacity = 1u << 16;
+
+FORCEINLINE bool IsTracing() {
+    return Private::GTracing.load(std::memory_order_relaxed);
+}
+
+// 丢弃之前记录的事件并开始记录. 可以在记录中途调用, 仍在写入的线程会在下次写入时丢弃自己的旧事件
+void StartTracing();
+void StopTracing();
+
+// 设置当前线程在追踪结果中显示的名字, 未设置时显示为 "Thread N"
+void SetCurrentThreadName(const char *Name);
+
+// 把所有线程记录的事件导出为 Chrome trace-event JSON
+// 应在 StopTracing 之后调用, 记录期间导出可能漏掉或截断正在写入的事件
+std::string ExportChromeTrace();
+bool        WriteChromeTrace(const char *Path);
+
+// 作用域事件; 构造时没有在记录, 则析构时也不记录
+class FTraceScope {
+  public:
+    explicit FTraceScope(const TCHAR *InName)
+        : Name(IsTracing() ? InName : nullptr),
+          Session(Name ? Private::GTraceSession.load(std::memory_order_relaxed) : 0),
+          BeginTimestamp(Name ? Private::ReadTimestamp() : 0) {}
+
+    ~FTraceScope() {
+        if (Name) {
+            Private::WriteEvent(Name, Session, BeginTimestamp, Private::ReadTimestamp());
+        }
+    }
+
+    FTraceScope(const FTraceScope &)            = delete;
+    FTraceScope &operator=(const FTraceScope &) = delete;
+
+  private:
+    const TCHAR *Name;
+    uint32       Session;
+    uint64       BeginTimestamp;
+};
+} // namespace TE::Trace
+
+// 记录所在作用域的耗时, 用法: TRACE_SCOPE("UpdatePhysics");
+#if ENGINE_ENABLE_TRACE
+#define TRACE_SCOPE(Name) ::TE::Trace::FTraceScope TE_JOIN(TraceScope_, __LINE__)(TEXT(Name))
+#else
+#define TRACE_SCOPE(Name)
+#endif
@@ -14,5 +14,11 @@ using ANSICHAR = char;
 using UTF8CHAR = unsigned char;
 using TCHAR = FPlatformTypes::TCHAR;
 // 整数类型
+using uint8 = unsigned char;
+using uint16 = unsigned short;
 using uint32 = unsigned int;
+using uint64 = unsigned long long;
+using int8 = signed char;
+using int16 = short;
 using int32 = int;
+using int64 = long long;
@@ -0,0 +1,43 @@
+/******************************************************
+ * @file TypeUtils/FunctionRef.hpp
+ * @brief 不持有可调用对象的轻量引用
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/Invoke.hpp"
+
+#include <memory>
+#include <type_traits>
+
+template <typename FuncType> class TFunctionRef;
+
+// 只保存可调用对象的地址和一个调用函数指针, 不分配内存、不拷贝;
+// 被引用的可调用对象必须比 TFunctionRef 活得更久, 适合作为同步调用的回调参数
+// 参考: Engine/Source/Runtime/Core/Public/Templates/Function.h
+template <typename ReturnType, typename... ArgTypes> class TFunctionRef<ReturnType(ArgTypes...)> {
+  public:
+    template <typename FunctorType,
+              typename = std::enable_if_t<
+                  !std::is_same_v<std::decay_t<FunctorType>, TFunctionRef> &&
+                  std::is_invocable_r_v<ReturnType, FunctorType &, ArgTypes...>>>
+    TFunctionRef(FunctorType &&Functor)
+        : Callable(const_cast<void *>(static_cast<const void *>(std::addressof(Functor)))),
+          Caller(&Call<std::remove_reference_t<FunctorType>>) {}
+
+    TFunctionRef(const TFunctionRef &)            = default;
+    TFunctionRef &operator=(const TFunctionRef &) = delete;
+
+    ReturnType operator()(ArgTypes... Args) const {
+        return Caller(Callable, Forward<ArgTypes>(Args)...);
+    }
+
+  private:
+    template <typename FunctorType>
+    static ReturnType Call(void *Callable, ArgTypes &&...Args) {
+        return Invoke(*static_cast<FunctorType *>(Callable), Forward<ArgTypes>(Args)...);
+    }
+
+    void *Callable;
+    ReturnType (*Caller)(void *, ArgTypes &&...);
+};
@@ -0,0 +1,17 @@
+/******************************************************
+ * @file TypeUtils/TypeCompatibleBytes.hpp
+ * @brief
+ *****************************************************/
+
+#pragma once
+
+// 与 T 大小、对齐一致的未初始化存储, 由使用者负责 placement new 与析构
+// 参考: Engine/Source/Runtime/Core/Public/Templates/TypeCompatibleBytes.h
+template <typename T> struct TTypeCompatibleBytes {
+    using ElementType = T;
+
+    alignas(T) unsigned char Pad[sizeof(T)];
+
+    T       *GetTypedPtr() { return reinterpret_cast<T *>(Pad); }
+    const T *GetTypedPtr() const { return reinterpret_cast<const T *>(Pad); }
+};
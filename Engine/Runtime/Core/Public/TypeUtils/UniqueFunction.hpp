@@ -0,0 +1,154 @@
+/******************************************************
+ * @file TypeUtils/UniqueFunction.hpp
+ * @brief 只可移动的类型擦除可调用对象, 带内联小缓冲区
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "TypeUtils/Invoke.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// 内联缓冲区大小: 加上一个操作表指针正好占满一条 64 字节缓存行
+#ifndef TE_UNIQUE_FUNCTION_INLINE_SIZE
+#define TE_UNIQUE_FUNCTION_INLINE_SIZE 56
+#endif
+
+template <typename FuncType> class TUniqueFunction;
+
+// 与 std::function 的区别:
+// - 只可移动, 允许捕获 std::unique_ptr 等只可移动的对象
+// - 不超过 TE_UNIQUE_FUNCTION_INLINE_SIZE 字节且 noexcept 可移动的可调用对象直接存放在内联缓冲区,
+//   不发生堆分配; 超出时退化为一次堆分配
+// 参考: Engine/Source/Runtime/Core/Public/Templates/Function.h
+template <typename ReturnType, typename... ArgTypes>
+class TUniqueFunction<ReturnType(ArgTypes...)> {
+  public:
+    static constexpr std::size_t InlineSize  = TE_UNIQUE_FUNCTION_INLINE_SIZE;
+    static constexpr std::size_t InlineAlign = alignof(std::max_align_t);
+
+    // 可调用对象能否放进内联缓冲区
+    template <typename FunctorType>
+    static constexpr bool IsStoredInline = sizeof(FunctorType) <= InlineSize &&
+                                           alignof(FunctorType) <= InlineAlign &&
+                                           std::is_nothrow_move_constructible_v<FunctorType>;
+
+    TUniqueFunction() = default;
+    TUniqueFunction(std::nullptr_t) {}
+
+    template <typename FunctorType, typename DecayedType = std::decay_t<FunctorType>,
+              typename = std::enable_if_t<!std::is_same_v<DecayedType, TUniqueFunction> &&
+                                          std::is_invocable_r_v<ReturnType, DecayedType &,
+                                                                ArgTypes...>>>
+    TUniqueFunction(FunctorType &&Functor) {
+        if constexpr (std::is_pointer_v<DecayedType> || std::is_member_pointer_v<DecayedType>) {
+            if (!Functor) {
+                return;
+            }
+        }
+        if constexpr (IsStoredInline<DecayedType>) {
+            new (Storage) DecayedType(Forward<FunctorType>(Functor));
+            Ops = &TInlineOps<DecayedType>::Table;
+        } else {
+            *reinterpret_cast<DecayedType **>(Storage) =
+                new DecayedType(Forward<FunctorType>(Functor));
+            Ops = &THeapOps<DecayedType>::Table;
+        }
+    }
+
+    TUniqueFunction(const TUniqueFunction &)            = delete;
+    TUniqueFunction &operator=(const TUniqueFunction &) = delete;
+
+    TUniqueFunction(TUniqueFunction &&Other) noexcept { MoveFrom(Other); }
+
+    TUniqueFunction &operator=(TUniqueFunction &&Other) noexcept {
+        if (this != &Other) {
+            Reset();
+            MoveFrom(Other);
+        }
+        return *this;
+    }
+
+    TUniqueFunction &operator=(std::nullptr_t) {
+        Reset();
+        return *this;
+    }
+
+    ~TUniqueFunction() { Reset(); }
+
+    ReturnType operator()(ArgTypes... Args) {
+        check(Ops != nullptr);
+        return Ops->Call(Storage, Forward<ArgTypes>(Args)...);
+    }
+
+    bool IsSet() const { return Ops != nullptr; }
+
+    explicit operator bool() const { return IsSet(); }
+
+    void Reset() {
+        if (Ops) {
+            Ops->Destroy(Storage);
+            Ops = nullptr;
+        }
+    }
+
+  private:
+    struct FOps {
+        ReturnType (*Call)(void *Storage, ArgTypes &&...Args);
+        // 移动构造到 Dst 并析构 Src
+        void (*Relocate)(void *Dst, void *Src);
+        void (*Destroy)(void *Storage);
+    };
+
+    template <typename FunctorType> struct TInlineOps {
+        static ReturnType Call(void *Storage, ArgTypes &&...Args) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                Invoke(*static_cast<FunctorType *>(Storage), Forward<ArgTypes>(Args)...);
+            } else {
+                return Invoke(*static_cast<FunctorType *>(Storage), Forward<ArgTypes>(Args)...);
+            }
+        }
+        static void Relocate(void *Dst, void *Src) {
+            FunctorType *SrcFunctor = static_cast<FunctorType *>(Src);
+            new (Dst) FunctorType(std::move(*SrcFunctor));
+            SrcFunctor->~FunctorType();
+        }
+        static void Destroy(void *Storage) { static_cast<FunctorType *>(Storage)->~FunctorType(); }
+
+        static constexpr FOps Table{ &Call, &Relocate, &Destroy };
+    };
+
+    template <typename FunctorType> struct THeapOps {
+        static FunctorType *&Ptr(void *Storage) { return *static_cast<FunctorType **>(Storage); }
+
+        static ReturnType Call(void *Storage, ArgTypes &&...Args) {
+            if constexpr (std::is_void_v<ReturnType>) {
+                Invoke(*Ptr(Storage), Forward<ArgTypes>(Args)...);
+            } else {
+                return Invoke(*Ptr(Storage), Forward<ArgTypes>(Args)...);
+            }
+        }
+        static void Relocate(void *Dst, void *Src) {
+            *static_cast<FunctorType **>(Dst) = Ptr(Src);
+            Ptr(Src)                          = nullptr;
+        }
+        static void Destroy(void *Storage) { delete Ptr(Storage); }
+
+        static constexpr FOps Table{ &Call, &Relocate, &Destroy };
+    };
+
+    void MoveFrom(TUniqueFunction &Other) {
+        if (Other.Ops) {
+            Other.Ops->Relocate(Storage, Other.Storage);
+            Ops       = Other.Ops;
+            Other.Ops = nullptr;
+        }
+    }
+
+    alignas(InlineAlign) unsigned char Storage[InlineSize];
+    const FOps *Ops = nullptr;
+};
@@ -0,0 +1,143 @@
+/******************************************************
+ * @file AsyncTests/AsyncTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Async/EventCount.hpp"
+#include "Async/ManualResetEvent.hpp"
+#include "Async/Mutex.hpp"
+#include "Async/UniqueLock.hpp"
+#include "Async/WordMutex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace TE;
+
+TEST(AsyncTest, PrimitiveSizes) {
+    EXPECT_EQ(sizeof(FMutex), 1u);
+    EXPECT_EQ(sizeof(FManualResetEvent), 1u);
+    EXPECT_EQ(sizeof(FWordMutex), 4u);
+    EXPECT_EQ(sizeof(FEventCount), 8u);
+}
+
+TEST(AsyncTest, MutexTryLock) {
+    FMutex Mutex;
+    EXPECT_FALSE(Mutex.IsLocked());
+    EXPECT_TRUE(Mutex.TryLock());
+    EXPECT_TRUE(Mutex.IsLocked());
+    EXPECT_FALSE(Mutex.TryLock());
+    Mutex.Unlock();
+    EXPECT_FALSE(Mutex.IsLocked());
+}
+
+// 多线程竞争下的互斥性
+template <typename MutexType> void TestMutexContention() {
+    MutexType     Mutex;
+    int64_t       Counter     = 0;
+    constexpr int ThreadCount = 4;
+    constexpr int Iterations  = 100000;
+
+    std::vector<std::thread> Threads;
+    for (int Index = 0; Index < ThreadCount; ++Index) {
+        Threads.emplace_back([&] {
+            for (int Iteration = 0; Iteration < Iterations; ++Iteration) {
+                TUniqueLock Lock(Mutex);
+                ++Counter;
+            }
+        });
+    }
+    for (auto &Thread: Threads) {
+        Thread.join();
+    }
+    EXPECT_EQ(Counter, int64_t(ThreadCount) * Iterations);
+}
+
+TEST(AsyncTest, MutexContention) {
+    TestMutexContention<FMutex>();
+}
+
+TEST(AsyncTest, WordMutexContention) {
+    TestMutexContention<FWordMutex>();
+}
+
+TEST(AsyncTest, ManualResetEvent) {
+    FManualResetEvent Event;
+    EXPECT_FALSE(Event.IsNotified());
+    EXPECT_FALSE(Event.WaitFor(std::chrono::milliseconds(5)));
+
+    std::atomic<int>         Woken{ 0 };
+    std::vector<std::thread> Waiters;
+    for (int Index = 0; Index < 3; ++Index) {
+        Waiters.emplace_back([&] {
+            Event.Wait();
+            Woken.fetch_add(1);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(Woken.load(), 0);
+    Event.Notify();
+    for (auto &Waiter: Waiters) {
+        Waiter.join();
+    }
+    EXPECT_EQ(Woken.load(), 3);
+
+    // 保持触发状态直到 Reset
+    EXPECT_TRUE(Event.WaitFor(std::chrono::milliseconds(0)));
+    Event.Reset();
+    EXPECT_FALSE(Event.IsNotified());
+}
+
+TEST(AsyncTest, EventCountTimeout) {
+    FEventCount      Event;
+    FEventCountToken Token = Event.PrepareWait();
+    EXPECT_TRUE(static_cast<bool>(Token));
+    auto Start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(Event.WaitUntil(Token, Start + std::chrono::milliseconds(5)));
+    EXPECT_GE(std::chrono::steady_clock::now() - Start, std::chrono::milliseconds(5));
+}
+
+// 生产者/消费者: 不丢失唤醒
+TEST(AsyncTest, EventCountNoLostWakeup) {
+    FEventCount      Event;
+    std::atomic<int> Available{ 0 };
+    std::atomic<int> Consumed{ 0 };
+    constexpr int    ItemCount = 20000;
+
+    std::vector<std::thread> Consumers;
+    for (int Index = 0; Index < 3; ++Index) {
+        Consumers.emplace_back([&] {
+            while (Consumed.load() < ItemCount) {
+                int Value = Available.load();
+                if (Value > 0) {
+                    if (Available.compare_exchange_weak(Value, Value - 1)) {
+                        Consumed.fetch_add(1);
+                    }
+                    continue;
+                }
+                FEventCountToken Token = Event.PrepareWait();
+                if (Available.load() > 0 || Consumed.load() >= ItemCount) {
+                    Event.CancelWait();
+                    continue;
+                }
+                Event.Wait(Token);
+            }
+        });
+    }
+    for (int Index = 0; Index < ItemCount; ++Index) {
+        Available.fetch_add(1);
+        Event.NotifyOne();
+    }
+    while (Consumed.load() < ItemCount) {
+        std::this_thread::yield();
+    }
+    Event.NotifyAll();
+    for (auto &Consumer: Consumers) {
+        Consumer.join();
+    }
+    EXPECT_EQ(Consumed.load(), ItemCount);
+}
@@ -0,0 +1,116 @@
+/******************************************************
+ * @file AsyncTests/ParkingLotTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Async/ManualResetEvent.hpp"
+#include "Async/ParkingLot.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace TE;
+
+// CanWait 返回 false 时不进入等待
+TEST(ParkingLotTest, CanWaitFalse) {
+    int                    Word      = 0;
+    bool                   bBefore   = false;
+    ParkingLot::FWaitState WaitState = ParkingLot::Wait(
+        &Word, [] { return false; }, [&] { bBefore = true; });
+    EXPECT_FALSE(WaitState.bDidWait);
+    EXPECT_FALSE(WaitState.bDidWake);
+    EXPECT_FALSE(bBefore);
+}
+
+TEST(ParkingLotTest, Timeout) {
+    int                    Word      = 0;
+    ParkingLot::FWaitState WaitState = ParkingLot::WaitFor(
+        &Word, [] { return true; }, [] {}, std::chrono::milliseconds(5));
+    EXPECT_TRUE(WaitState.bDidWait);
+    EXPECT_FALSE(WaitState.bDidWake);
+    // 超时的线程已经离开队列
+    EXPECT_FALSE(ParkingLot::WakeOne(&Word).bDidWake);
+}
+
+// WakeOne 的返回值传递给被唤醒的线程
+TEST(ParkingLotTest, WakeToken) {
+    int                    Word = 0;
+    std::atomic<bool>      bParked{ false };
+    ParkingLot::FWaitState WaitState;
+    std::thread            Waiter([&] {
+        WaitState = ParkingLot::Wait(
+            &Word, [] { return true; }, [&] { bParked = true; });
+    });
+    while (!bParked) {
+        std::this_thread::yield();
+    }
+
+    ParkingLot::FWakeState WakeState =
+        ParkingLot::WakeOne(&Word, [](ParkingLot::FWakeState State) -> uint64 {
+            EXPECT_TRUE(State.bDidWake);
+            EXPECT_FALSE(State.bHasWaitingThreads);
+            return 42;
+        });
+    Waiter.join();
+    EXPECT_TRUE(WakeState.bDidWake);
+    EXPECT_TRUE(WaitState.bDidWake);
+    EXPECT_EQ(WaitState.WakeToken, 42u);
+}
+
+// 只唤醒等待同一地址的线程
+TEST(ParkingLotTest, WakeByAddress) {
+    int              Words[2] = {};
+    std::atomic<int> Parked{ 0 };
+    std::atomic<int> Woken[2] = {};
+
+    std::vector<std::thread> Waiters;
+    for (int Index = 0; Index < 6; ++Index) {
+        Waiters.emplace_back([&, Index] {
+            ParkingLot::Wait(
+                &Words[Index % 2], [] { return true; }, [&] { Parked.fetch_add(1); });
+            Woken[Index % 2].fetch_add(1);
+        });
+    }
+    while (Parked.load() < 6) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_EQ(ParkingLot::WakeMultiple(&Words[0], 2), 2u);
+    while (Woken[0].load() < 2) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(Woken[1].load(), 0);
+
+    ParkingLot::WakeAll(&Words[1]);
+    ParkingLot::WakeAll(&Words[0]);
+    for (auto &Waiter: Waiters) {
+        Waiter.join();
+    }
+    EXPECT_EQ(Woken[0].load(), 3);
+    EXPECT_EQ(Woken[1].load(), 3);
+}
+
+// 大量线程首次使用时哈希表扩容, 迁移过程中不丢失等待者
+TEST(ParkingLotTest, GrowWhileWaiting) {
+    constexpr int             EventCount = 64;
+    std::vector<std::thread>  Waiters;
+    FManualResetEvent         Events[EventCount];
+    std::atomic<int>          Done{ 0 };
+    for (int Index = 0; Index < EventCount; ++Index) {
+        Waiters.emplace_back([&, Index] {
+            Events[Index].Wait();
+            Done.fetch_add(1);
+        });
+    }
+    for (int Index = 0; Index < EventCount; ++Index) {
+        Events[Index].Notify();
+    }
+    for (auto &Waiter: Waiters) {
+        Waiter.join();
+    }
+    EXPECT_EQ(Done.load(), EventCount);
+}
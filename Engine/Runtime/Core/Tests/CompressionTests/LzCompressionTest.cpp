@@ -0,0 +1,95 @@
+/******************************************************
+ * @file CompressionTests/LzCompressionTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Compression/LzCompression.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace TE::Compression;
+
+namespace {
+std::vector<uint8> RoundTrip(const std::vector<uint8> &Source, std::size_t &OutCompressedSize) {
+    std::vector<uint8> Compressed(GetLzCompressBound(Source.size()));
+    OutCompressedSize = LzCompress(Source.data(), Source.size(), Compressed.data(),
+                                   Compressed.size());
+    EXPECT_GT(OutCompressedSize, 0u);
+    std::vector<uint8> Decompressed(Source.size());
+    EXPECT_TRUE(LzDecompress(Compressed.data(), OutCompressedSize, Decompressed.data(),
+                             Decompressed.size()));
+    return Decompressed;
+}
+} // namespace
+
+TEST(LzCompressionTest, RoundTrip) {
+    std::mt19937 Rng(7);
+    std::size_t  CompressedSize = 0;
+
+    // 空输入与极短输入
+    for (std::size_t Size : { 0u, 1u, 3u, 4u, 5u, 17u }) {
+        std::vector<uint8> Source(Size);
+        for (uint8 &Byte : Source) {
+            Byte = uint8(Rng());
+        }
+        EXPECT_EQ(RoundTrip(Source, CompressedSize), Source);
+    }
+
+    // 全零: 一个重叠匹配即可表示
+    std::vector<uint8> Zeros(64 * 1024, 0);
+    EXPECT_EQ(RoundTrip(Zeros, CompressedSize), Zeros);
+    EXPECT_LT(CompressedSize, 512u);
+
+    // 低熵 (类似调色板索引): 小字母表 + 长游程
+    std::vector<uint8> Runs;
+    while (Runs.size() < 32 * 1024) {
+        Runs.insert(Runs.end(), 1 + Rng() % 40, uint8(Rng() % 4));
+    }
+    EXPECT_EQ(RoundTrip(Runs, CompressedSize), Runs);
+    EXPECT_LT(CompressedSize, Runs.size() / 2);
+
+    // 随机数据不可压缩, 但最坏容量内仍能成功
+    std::vector<uint8> Noise(10000);
+    for (uint8 &Byte : Noise) {
+        Byte = uint8(Rng());
+    }
+    EXPECT_EQ(RoundTrip(Noise, CompressedSize), Noise);
+    EXPECT_LE(CompressedSize, GetLzCompressBound(Noise.size()));
+
+    // 容量小于原始大小时, 不可压缩的数据返回 0
+    std::vector<uint8> Small(Noise.size() - 1);
+    EXPECT_EQ(LzCompress(Noise.data(), Noise.size(), Small.data(), Small.size()), 0u);
+}
+
+TEST(LzCompressionTest, RejectsCorruptInput) {
+    std::vector<uint8> Source(4096);
+    for (std::size_t Index = 0; Index < Source.size(); ++Index) {
+        Source[Index] = uint8((Index / 7) % 5);
+    }
+    std::vector<uint8> Compressed(GetLzCompressBound(Source.size()));
+    Compressed.resize(LzCompress(Source.data(), Source.size(), Compressed.data(),
+                                 Compressed.size()));
+    ASSERT_FALSE(Compressed.empty());
+
+    std::vector<uint8> Out(Source.size());
+    // 期望长度不符
+    EXPECT_FALSE(LzDecompress(Compressed.data(), Compressed.size(), Out.data(), Out.size() - 1));
+    std::vector<uint8> Larger(Source.size() + 1);
+    EXPECT_FALSE(
+        LzDecompress(Compressed.data(), Compressed.size(), Larger.data(), Larger.size()));
+    // 截断
+    EXPECT_FALSE(LzDecompress(Compressed.data(), Compressed.size() / 2, Out.data(), Out.size()));
+
+    // 随机翻转字节: 结果可以错, 但不能越界 (配合 ASan 运行)
+    std::mt19937 Rng(11);
+    for (int Iteration = 0; Iteration < 2000; ++Iteration) {
+        std::vector<uint8> Corrupt = Compressed;
+        for (int Flip = 0; Flip < 3; ++Flip) {
+            Corrupt[Rng() % Corrupt.size()] = uint8(Rng());
+        }
+        LzDecompress(Corrupt.data(), Corrupt.size(), Out.data(), Out.size());
+    }
+}
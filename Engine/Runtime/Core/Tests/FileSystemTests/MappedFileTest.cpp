@@ -0,0 +1,66 @@
+/******************************************************
+ * @file FileSystemTests/MappedFileTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "FileSystem/MappedFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+using namespace TE;
+
+namespace {
+std::string TempPath(const char *Name) {
+    return (std::filesystem::temp_directory_path() / Name).string();
+}
+} // namespace
+
+TEST(MappedFileTest, WriteMapAndReplace) {
+    const std::string Path  = TempPath("TE_MappedFileTest.bin");
+    const std::string Other = TempPath("TE_MappedFileTest.tmp");
+    RemoveFile(Path);
+    EXPECT_EQ(FMappedFile::Map(Path), nullptr);
+
+    auto Writer = FWritableFile::Open(Path, true);
+    ASSERT_NE(Writer, nullptr);
+    auto Empty = FMappedFile::Map(Path);
+    ASSERT_NE(Empty, nullptr);
+    EXPECT_EQ(Empty->GetSize(), 0u);
+
+    // 写入不必按顺序, 中间空洞补零
+    EXPECT_TRUE(Writer->Write(8, "World", 5));
+    EXPECT_TRUE(Writer->Write(0, "Hello", 5));
+    EXPECT_EQ(Writer->GetSize(), 13u);
+    auto First = FMappedFile::Map(Path);
+    ASSERT_NE(First, nullptr);
+    ASSERT_EQ(First->GetSize(), 13u);
+    EXPECT_EQ(std::memcmp(First->GetData(), "Hello\0\0\0World", 13), 0);
+
+    // 追加不影响已有映射
+    EXPECT_TRUE(Writer->Write(13, "!", 1));
+    EXPECT_TRUE(Writer->Flush());
+    EXPECT_EQ(First->GetSize(), 13u);
+    EXPECT_EQ(std::memcmp(First->GetData() + 8, "World", 5), 0);
+    EXPECT_EQ(FMappedFile::Map(Path)->GetSize(), 14u);
+    Writer.reset();
+
+    {
+        auto Replacement = FWritableFile::Open(Other, true);
+        ASSERT_NE(Replacement, nullptr);
+        EXPECT_TRUE(Replacement->Write(0, "New", 3));
+    }
+    First.reset();
+    EXPECT_TRUE(AtomicReplaceFile(Other, Path));
+    auto Replaced = FMappedFile::Map(Path);
+    ASSERT_NE(Replaced, nullptr);
+    ASSERT_EQ(Replaced->GetSize(), 3u);
+    EXPECT_EQ(std::memcmp(Replaced->GetData(), "New", 3), 0);
+    EXPECT_EQ(FMappedFile::Map(Other), nullptr);
+
+    Replaced.reset();
+    EXPECT_TRUE(RemoveFile(Path));
+}
@@ -0,0 +1,130 @@
+/******************************************************
+ * @file MemoryTests/LinearAllocatorTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Memory/LinearAllocator.hpp"
+#include "Memory/StlAllocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace {
+bool IsAligned(const void *Ptr, std::size_t Align) {
+    return reinterpret_cast<std::uintptr_t>(Ptr) % Align == 0;
+}
+} // namespace
+
+TEST(LinearAllocatorTest, AlignmentAndPages) {
+    FLinearAllocator Arena(1024);
+    for (std::size_t Align: { 1u, 2u, 4u, 8u, 16u, 64u, 256u }) {
+        void *Ptr = Arena.Allocate(3, Align);
+        EXPECT_TRUE(IsAligned(Ptr, Align)) << Align;
+    }
+    // 跨页: 填满第一页后自动换页
+    std::vector<int *> Blocks;
+    for (int Index = 0; Index < 100; ++Index) {
+        int *Block = Arena.NewArray<int>(16);
+        Block[0]   = Index;
+        Blocks.push_back(Block);
+    }
+    for (int Index = 0; Index < 100; ++Index) {
+        EXPECT_EQ(Blocks[Index][0], Index);
+    }
+    EXPECT_GE(Arena.GetBytesUsed(), 100 * 16 * sizeof(int));
+}
+
+// Reset 之后复用同一批页, 不再申请新内存
+TEST(LinearAllocatorTest, ResetReusesPages) {
+    FLinearAllocator Arena(4096);
+    auto             Fill = [&Arena] {
+        void *FirstBlock = Arena.Allocate(64);
+        for (int Index = 0; Index < 200; ++Index) {
+            Arena.Allocate(100);
+        }
+        return FirstBlock;
+    };
+    Fill();
+    const std::size_t Reserved = Arena.GetBytesReserved();
+    for (int Round = 0; Round < 4; ++Round) {
+        Arena.Reset();
+        EXPECT_EQ(Arena.GetBytesUsed(), 0u);
+        Fill();
+        EXPECT_EQ(Arena.GetBytesReserved(), Reserved);
+    }
+
+    // 超大分配单独成页, Reset 时归还
+    void *Huge = Arena.Allocate(1 << 20);
+    EXPECT_NE(Huge, nullptr);
+    EXPECT_GT(Arena.GetBytesReserved(), Reserved + (1u << 20) - 1);
+    Arena.Reset();
+    EXPECT_EQ(Arena.GetBytesReserved(), Reserved);
+
+    Arena.Release();
+    EXPECT_EQ(Arena.GetBytesReserved(), 0u);
+}
+
+TEST(LinearAllocatorTest, MarkerRewind) {
+    FLinearAllocator Arena(256);
+    Arena.Allocate(32);
+    const FLinearAllocator::FMarker Marker = Arena.GetMarker();
+    const std::size_t               Used   = Arena.GetBytesUsed();
+    void                           *Next   = Arena.Allocate(16);
+    for (int Index = 0; Index < 64; ++Index) {
+        Arena.Allocate(48);
+    }
+    Arena.Rewind(Marker);
+    EXPECT_EQ(Arena.GetBytesUsed(), Used);
+    EXPECT_EQ(Arena.Allocate(16), Next);
+}
+
+// 帧号变化后各线程在下一次分配时重置自己的分配器
+TEST(FrameAllocatorTest, ResetsEachFrame) {
+    FFrameAllocator::BeginFrame();
+    int *First = FFrameAllocator::NewArray<int>(8);
+    FFrameAllocator::NewArray<int>(8);
+    EXPECT_GE(FFrameAllocator::GetThreadBytesUsed(), 16 * sizeof(int));
+
+    // 其他线程的分配互不影响
+    std::thread Other([] {
+        EXPECT_EQ(FFrameAllocator::GetThreadBytesUsed(), 0u);
+        FFrameAllocator::Allocate(128);
+        EXPECT_GE(FFrameAllocator::GetThreadBytesUsed(), 128u);
+    });
+    Other.join();
+
+    FFrameAllocator::BeginFrame();
+    EXPECT_EQ(FFrameAllocator::GetThreadBytesUsed(), 0u);
+    EXPECT_EQ(FFrameAllocator::NewArray<int>(8), First);
+}
+
+TEST(StlAllocatorTest, Containers) {
+    FLinearAllocator                          Arena;
+    std::vector<int, TLinearStlAllocator<int>> Values{ TLinearStlAllocator<int>(Arena) };
+    for (int Index = 0; Index < 1000; ++Index) {
+        Values.push_back(Index);
+    }
+    EXPECT_EQ(Values[999], 999);
+    EXPECT_GT(Arena.GetBytesUsed(), 1000 * sizeof(int));
+
+    FFrameAllocator::BeginFrame();
+    TFrameVector<float> Scratch(256, 1.0f);
+    EXPECT_EQ(Scratch.size(), 256u);
+    EXPECT_GE(FFrameAllocator::GetThreadBytesUsed(), 256 * sizeof(float));
+
+    std::map<int, int, std::less<int>, TFixedBlockStlAllocator<std::pair<const int, int>>> Map;
+    std::list<int, TFixedBlockStlAllocator<int>>                                     List;
+    for (int Index = 0; Index < 500; ++Index) {
+        Map[Index] = Index * 2;
+        List.push_back(Index);
+    }
+    EXPECT_EQ(Map[250], 500);
+    EXPECT_EQ(List.size(), 500u);
+    Map.clear();
+    List.clear();
+}
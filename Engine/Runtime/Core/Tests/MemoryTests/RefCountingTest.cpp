@@ -0,0 +1,166 @@
+/******************************************************
+ * @file MemoryTests/RefCountingTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Memory/RefCounting.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct FTracked : FRefCountBase {
+    explicit FTracked(int InValue, int *InDestroyed) : Value(InValue), Destroyed(InDestroyed) {}
+    ~FTracked() override { ++*Destroyed; }
+
+    int  Value;
+    int *Destroyed;
+};
+
+struct FDerived : FTracked {
+    using FTracked::FTracked;
+};
+
+struct FLocal : TRefCountedObject<ERefCountingMode::NotThreadSafe> {
+    int Value = 7;
+};
+} // namespace
+
+TEST(RefCountingTest, Lifetime) {
+    int Destroyed = 0;
+    {
+        TRefCountPtr<FTracked> A = MakeRefCount<FTracked>(1, &Destroyed);
+        EXPECT_EQ(A.GetRefCount(), 1u);
+        {
+            TRefCountPtr<FTracked> B = A;
+            EXPECT_EQ(A.GetRefCount(), 2u);
+            EXPECT_TRUE(A == B);
+        }
+        EXPECT_EQ(A.GetRefCount(), 1u);
+        EXPECT_EQ(Destroyed, 0);
+    }
+    EXPECT_EQ(Destroyed, 1);
+}
+
+TEST(RefCountingTest, Assignment) {
+    int                    Destroyed = 0;
+    TRefCountPtr<FTracked> A         = MakeRefCount<FTracked>(1, &Destroyed);
+    TRefCountPtr<FTracked> B         = MakeRefCount<FTracked>(2, &Destroyed);
+
+    // 拷贝赋值: 释放旧对象
+    B = A;
+    EXPECT_EQ(Destroyed, 1);
+    EXPECT_EQ(B->Value, 1);
+    EXPECT_EQ(A.GetRefCount(), 2u);
+
+    // 自赋值
+    B = B;
+    EXPECT_EQ(A.GetRefCount(), 2u);
+
+    // 移动赋值: 不改变计数
+    TRefCountPtr<FTracked> C;
+    C = std::move(B);
+    EXPECT_FALSE(B.IsValid());
+    EXPECT_EQ(A.GetRefCount(), 2u);
+
+    C = nullptr;
+    EXPECT_EQ(A.GetRefCount(), 1u);
+    A.SafeRelease();
+    EXPECT_EQ(Destroyed, 2);
+    EXPECT_TRUE(A == nullptr);
+}
+
+TEST(RefCountingTest, SwapAndConversion) {
+    int                    Destroyed = 0;
+    TRefCountPtr<FTracked> A         = MakeRefCount<FTracked>(1, &Destroyed);
+    TRefCountPtr<FTracked> B         = MakeRefCount<FDerived>(2, &Destroyed);
+    swap(A, B);
+    EXPECT_EQ(A->Value, 2);
+    EXPECT_EQ((*B).Value, 1);
+
+    TRefCountPtr<FDerived> Derived = MakeRefCount<FDerived>(3, &Destroyed);
+    TRefCountPtr<FTracked> Base    = Derived;
+    EXPECT_EQ(Derived.GetRefCount(), 2u);
+    Base = std::move(Derived);
+    EXPECT_EQ(Base.GetRefCount(), 1u);
+}
+
+TEST(RefCountingTest, NotThreadSafe) {
+    TRefCountPtr<FLocal> A = MakeRefCount<FLocal>();
+    TRefCountPtr<FLocal> B = A;
+    EXPECT_EQ(B.GetRefCount(), 2u);
+    EXPECT_EQ(B->Value, 7);
+
+    TWeakRefCountPtr<FLocal> Weak = A;
+    A                             = nullptr;
+    EXPECT_TRUE(Weak.Pin().IsValid());
+    B = nullptr;
+    EXPECT_TRUE(Weak.IsExpired());
+}
+
+TEST(RefCountingTest, Weak) {
+    int                        Destroyed = 0;
+    TWeakRefCountPtr<FTracked> Weak;
+    EXPECT_TRUE(Weak.IsExpired());
+    EXPECT_FALSE(Weak.Pin().IsValid());
+    {
+        TRefCountPtr<FTracked> Strong = MakeRefCount<FTracked>(5, &Destroyed);
+        Weak                          = Strong;
+
+        TWeakRefCountPtr<FTracked> Copy = Weak;
+
+        TRefCountPtr<FTracked> Pinned = Copy.Pin();
+        ASSERT_TRUE(Pinned.IsValid());
+        EXPECT_EQ(Pinned->Value, 5);
+        EXPECT_EQ(Strong.GetRefCount(), 2u);
+    }
+    EXPECT_EQ(Destroyed, 1);
+    EXPECT_TRUE(Weak.IsExpired());
+    EXPECT_FALSE(Weak.Pin().IsValid());
+}
+
+// 最后一份强引用释放与弱引用升级并发进行
+TEST(RefCountingTest, ConcurrentPin) {
+    constexpr int Rounds = 2000;
+    for (int Round = 0; Round < Rounds; ++Round) {
+        int                        Destroyed = 0;
+        TRefCountPtr<FTracked>     Strong    = MakeRefCount<FTracked>(Round, &Destroyed);
+        TWeakRefCountPtr<FTracked> Weak      = Strong;
+        std::atomic<bool>          bGo{ false };
+
+        std::thread Pinner([&] {
+            while (!bGo.load()) {
+            }
+            if (TRefCountPtr<FTracked> Pinned = Weak.Pin()) {
+                EXPECT_EQ(Pinned->Value, Round);
+            }
+        });
+        bGo = true;
+        Strong.SafeRelease();
+        Pinner.join();
+        EXPECT_EQ(Destroyed, 1);
+    }
+}
+
+TEST(RefCountingTest, ConcurrentCopies) {
+    int                    Destroyed = 0;
+    TRefCountPtr<FTracked> Shared    = MakeRefCount<FTracked>(0, &Destroyed);
+
+    std::vector<std::thread> Threads;
+    for (int Index = 0; Index < 4; ++Index) {
+        Threads.emplace_back([&] {
+            for (int Iteration = 0; Iteration < 100000; ++Iteration) {
+                TRefCountPtr<FTracked> Copy = Shared;
+            }
+        });
+    }
+    for (auto &Thread: Threads) {
+        Thread.join();
+    }
+    EXPECT_EQ(Shared.GetRefCount(), 1u);
+    Shared = nullptr;
+    EXPECT_EQ(Destroyed, 1);
+}
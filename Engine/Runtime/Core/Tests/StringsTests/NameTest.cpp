@@ -0,0 +1,70 @@
+/******************************************************
+ * @file StringsTests/NameTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Strings/Name.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(NameTest, Interning) {
+    FName None;
+    EXPECT_TRUE(None.IsNone());
+    EXPECT_TRUE(FName(TEXT("")).IsNone());
+    EXPECT_EQ(None.GetPlainView().size(), 0u);
+
+    FName A(TEXT("Transform"));
+    FName B(FString(TEXT("Transform")));
+    FName C(TEXT("transform"));
+    EXPECT_EQ(A, B);
+    EXPECT_EQ(A.GetIndex(), B.GetIndex());
+    EXPECT_FALSE(A == C);
+    EXPECT_EQ(A.ToString(), TEXT("Transform"));
+    EXPECT_EQ(C.GetPlainView(), FName::ViewType(TEXT("transform")));
+
+    EXPECT_EQ(FName::Find(TEXT("Transform")), A);
+    EXPECT_TRUE(FName::Find(TEXT("NeverInterned")).IsNone());
+}
+
+// 多线程同时登记同一批名字, 每个名字只得到一个下标; 大量名字会跨越多个内存块
+TEST(NameTest, ConcurrentInterning) {
+    constexpr int NameCount   = 20000;
+    constexpr int ThreadCount = 4;
+    auto          MakeName    = [](int Index) {
+        std::string Utf8 = "Asset/Path/Number_" + std::to_string(Index);
+        return FString::FromUtf8(Utf8);
+    };
+
+    std::vector<std::vector<uint32>> Indices(ThreadCount, std::vector<uint32>(NameCount));
+    std::vector<std::thread>         Threads;
+    for (int Thread = 0; Thread < ThreadCount; ++Thread) {
+        Threads.emplace_back([&, Thread] {
+            for (int Index = 0; Index < NameCount; ++Index) {
+                const int Shuffled         = (Index * 7919 + Thread * 13) % NameCount;
+                Indices[Thread][Shuffled] = FName(MakeName(Shuffled)).GetIndex();
+            }
+        });
+    }
+    for (auto &Thread: Threads) {
+        Thread.join();
+    }
+    for (int Index = 0; Index < NameCount; ++Index) {
+        for (int Thread = 1; Thread < ThreadCount; ++Thread) {
+            ASSERT_EQ(Indices[Thread][Index], Indices[0][Index]);
+        }
+    }
+    for (int Index = 0; Index < NameCount; Index += 997) {
+        EXPECT_EQ(FName(MakeName(Index)).ToString(), MakeName(Index));
+    }
+
+    // 超长名字被截断
+    FString Long;
+    for (int Index = 0; Index < FName::MaxLength + 10; ++Index) {
+        Long += TCHAR('n');
+    }
+    EXPECT_EQ(FName(Long).ToString().Len(), FName::MaxLength);
+}
@@ -0,0 +1,109 @@
+/******************************************************
+ * @file StringsTests/StringTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Strings/FString.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+TEST(StringTest, SmallStringStaysInline) {
+    FString Empty;
+    EXPECT_TRUE(Empty.IsEmpty());
+    EXPECT_EQ(**Empty, 0);
+
+    FString Short(TEXT("Hello"));
+    EXPECT_TRUE(Short.IsInline());
+    EXPECT_EQ(Short.Len(), 5);
+    EXPECT_EQ(Short, TEXT("Hello"));
+
+    FString Full;
+    for (int32 Index = 0; Index < FString::InlineCapacity; ++Index) {
+        Full += TCHAR('a' + Index % 26);
+    }
+    EXPECT_TRUE(Full.IsInline());
+    EXPECT_GE(FString::InlineCapacity, 22);
+
+    // 超过内联容量后转到堆上, 内容不变
+    Full += TEXT("xyz");
+    EXPECT_FALSE(Full.IsInline());
+    EXPECT_EQ(Full.Len(), FString::InlineCapacity + 3);
+    EXPECT_TRUE(Full.StartsWith(TEXT("abc")));
+    EXPECT_TRUE(Full.EndsWith(TEXT("xyz")));
+    EXPECT_EQ(Full.GetData()[Full.Len()], 0);
+}
+
+TEST(StringTest, CopyMoveAndSelfAppend) {
+    FString Long(TEXT("0123456789012345678901234567890123456789"));
+    FString Copy = Long;
+    EXPECT_EQ(Copy, Long);
+    EXPECT_NE(Copy.GetData(), Long.GetData());
+
+    const TCHAR *HeapData = Long.GetData();
+    FString      Moved    = std::move(Long);
+    EXPECT_EQ(Moved.GetData(), HeapData);
+    EXPECT_TRUE(Long.IsEmpty());
+
+    FString Small(TEXT("ab"));
+    Small = std::move(Moved);
+    EXPECT_EQ(Small.Len(), 40);
+
+    // 追加自身: 扩容时旧缓冲区不能提前释放
+    FString Self(TEXT("abcdefghijklmnop"));
+    Self += Self;
+    Self += Self;
+    EXPECT_EQ(Self.Len(), 64);
+    EXPECT_EQ(Self.Mid(48), TEXT("abcdefghijklmnop"));
+
+    Self.Reset();
+    EXPECT_TRUE(Self.IsEmpty());
+    EXPECT_FALSE(Self.IsInline());
+    Self.Empty();
+    EXPECT_TRUE(Self.IsInline());
+}
+
+TEST(StringTest, SearchAndSubstrings) {
+    const FString Path(TEXT("Content/Voxel/Stone.asset"));
+    EXPECT_EQ(Path.Find(TEXT("Voxel")), 8);
+    EXPECT_EQ(Path.Find(TCHAR('/')), 7);
+    EXPECT_EQ(Path.Find(TCHAR('/'), 8), 13);
+    EXPECT_EQ(Path.Find(TEXT("Dirt")), INDEX_NONE);
+    EXPECT_TRUE(Path.Contains(TEXT("Stone")));
+    EXPECT_EQ(Path.Left(7), TEXT("Content"));
+    EXPECT_EQ(Path.Right(5), TEXT("asset"));
+    EXPECT_EQ(Path.Mid(14, 5), TEXT("Stone"));
+    EXPECT_EQ(Path.Mid(100), TEXT(""));
+    EXPECT_TRUE(FString(TEXT("a")) < FString(TEXT("b")));
+
+    std::unordered_set<FString> Set{ Path, FString(TEXT("Other")) };
+    EXPECT_EQ(Set.count(FString(TEXT("Content/Voxel/Stone.asset"))), 1u);
+}
+
+TEST(StringTest, Utf8Conversion) {
+    const char *Utf8 = "Voxel \xE4\xBD\x93\xE7\xB4\xA0 \xF0\x9F\x98\x80";
+    FString     Str  = FString::FromUtf8(Utf8);
+    // 两个汉字各占一个码元, emoji 占两个 (代理对)
+    EXPECT_EQ(Str.Len(), 6 + 2 + 1 + 2);
+    EXPECT_EQ(Str[6], TCHAR(0x4F53));
+    EXPECT_EQ(Str.ToUtf8(), Utf8);
+
+    // 非法序列替换为 U+FFFD
+    FString Broken = FString::FromUtf8("a\xC0\x80" "b\xFF");
+    EXPECT_EQ(Broken.Len(), 4);
+    EXPECT_EQ(Broken[1], TCHAR(0xFFFD));
+    EXPECT_EQ(Broken[3], TCHAR(0xFFFD));
+}
+
+TEST(StringTest, Format) {
+    const FString Name(TEXT("Zombie"));
+    FString       Line = FString::Format(TEXT("{0} has {1} hp, {2}% armor, id {3}"),
+                                         { Name, 42, 12.5, uint64(7) });
+    EXPECT_EQ(Line, TEXT("Zombie has 42 hp, 12.5% armor, id 7"));
+
+    EXPECT_EQ(FString::Format(TEXT("{1}{0}{1}"), { TEXT("a"), -3 }), TEXT("-3a-3"));
+    // 越界或不完整的占位符原样保留
+    EXPECT_EQ(FString::Format(TEXT("{2} {x} {"), { 1 }), TEXT("{2} {x} {"));
+    EXPECT_EQ(FString::FromNumber(-1234567890123ll), TEXT("-1234567890123"));
+}
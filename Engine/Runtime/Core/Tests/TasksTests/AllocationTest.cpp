@@ -0,0 +1,58 @@
+/******************************************************
+ * @file TasksTests/AllocationTest.cpp
+ * @brief 统计全局堆分配次数, 验证 Launch 不发生 malloc
+ *****************************************************/
+
+#include "Tasks/Tasks.hpp"
+
+#include "TestUtils/AllocationCounter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace TE::Tasks;
+
+// 捕获较多数据的任务, 预热之后 Launch + GetResult 不再分配内存
+TEST(AllocationTest, LaunchIsAllocationFree) {
+    constexpr int TaskCount = 256;
+    int           A = 1, B = 2, C = 3, D = 4;
+
+    auto RunBatch = [&](std::vector<std::unique_ptr<int>> &Buffers) {
+        int Sum = 0;
+        for (auto &Buffer: Buffers) {
+            TTask<int> Task = Launch(TEXT("Capture"), [PA = &A, PB = &B, PC = &C, PD = &D,
+                                                       Buffer = std::move(Buffer)]() {
+                return *PA + *PB + *PC + *PD + *Buffer;
+            });
+            Sum += Task.GetResult();
+        }
+        return Sum;
+    };
+    auto MakeBuffers = [] {
+        std::vector<std::unique_ptr<int>> Buffers(TaskCount);
+        for (auto &Buffer: Buffers) {
+            Buffer = std::make_unique<int>(5);
+        }
+        return Buffers;
+    };
+
+    // 预热: 让任务对象与任务节点的缓存达到稳定容量
+    for (int Warmup = 0; Warmup < 16; ++Warmup) {
+        auto Buffers = MakeBuffers();
+        RunBatch(Buffers);
+    }
+    // GetResult 会把任务撤回到当前线程执行, 队列里剩下的空条目由工作线程稍后释放;
+    // 等它们都跑完, 释放的块才回到全局空闲链表
+    ThreadPool::global().waitAll();
+
+    // 测试自身准备数据的分配在计数窗口之外
+    auto Buffers = MakeBuffers();
+    TE::Tests::StartCountingAllocations();
+    int       Sum             = RunBatch(Buffers);
+    const int AllocationCount = TE::Tests::StopCountingAllocations();
+
+    EXPECT_EQ(Sum, TaskCount * 15);
+    EXPECT_EQ(AllocationCount, 0);
+}
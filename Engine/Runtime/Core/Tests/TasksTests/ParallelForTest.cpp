@@ -0,0 +1,85 @@
+/******************************************************
+ * @file TasksTests/ParallelForTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Tasks/ParallelFor.hpp"
+#include "Tasks/Tasks.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace TE::Tasks;
+
+// 每个下标恰好执行一次, 各种批大小都一样
+TEST(ParallelForTest, VisitsEachIndexOnce) {
+    for (int32 minBatch: { 1, 7, 64, 5000 }) {
+        constexpr int32               num = 4096;
+        std::vector<std::atomic<int>> visits(num);
+        ParallelFor(num, [&visits](int32 index) { visits[index].fetch_add(1); }, minBatch);
+        for (int32 index = 0; index < num; ++index) {
+            ASSERT_EQ(visits[index].load(), 1) << "index " << index << " minBatch " << minBatch;
+        }
+    }
+
+    int calls = 0;
+    ParallelFor(0, [&calls](int32) { ++calls; });
+    EXPECT_EQ(calls, 0);
+}
+
+TEST(ParallelForTest, Reduce) {
+    const int64 sum = ParallelReduce(
+        100000, int64(0), [](int32 index) { return int64(index); },
+        [](int64 a, int64 b) { return a + b; }, 256);
+    EXPECT_EQ(sum, int64(100000) * 99999 / 2);
+
+    const int32 maxValue = ParallelReduce(
+        1000, int32(-1), [](int32 index) { return (index * 7919) % 1000; },
+        [](int32 a, int32 b) { return std::max(a, b); });
+    EXPECT_EQ(maxValue, 999);
+}
+
+// 在循环体中嵌套调用, 外层迭代分布在工作线程上也不会死锁
+TEST(ParallelForTest, Nested) {
+    constexpr int32  outer = 32;
+    constexpr int32  inner = 256;
+    std::atomic<int> counter{ 0 };
+    ParallelFor(outer, [&counter](int32) {
+        ParallelFor(inner, [&counter](int32) { counter.fetch_add(1); }, 16);
+    });
+    EXPECT_EQ(counter.load(), outer * inner);
+}
+
+// 只等待自己的迭代: 工作线程全被无关任务占住时, 调用线程独自完成整个循环
+TEST(ParallelForTest, DoesNotWaitForUnrelatedTasks) {
+    const int          workerCount = ThreadPool::global().threadCount();
+    std::atomic<int>   started{ 0 };
+    std::atomic<bool>  release{ false };
+    std::vector<TTask<void>> blockers;
+    for (int i = 0; i < workerCount; ++i) {
+        blockers.push_back(Launch(TEXT("Blocker"), [&started, &release]() {
+            started.fetch_add(1);
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+        }));
+    }
+    while (started.load() < workerCount) {
+        std::this_thread::yield();
+    }
+
+    const std::thread::id callerId = std::this_thread::get_id();
+    std::atomic<int>      onCaller{ 0 };
+    ParallelFor(1024, [&onCaller, callerId](int32) {
+        if (std::this_thread::get_id() == callerId) {
+            onCaller.fetch_add(1);
+        }
+    });
+    EXPECT_EQ(onCaller.load(), 1024);
+
+    release = true;
+    Wait(blockers);
+}
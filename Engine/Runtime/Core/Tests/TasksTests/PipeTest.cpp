@@ -0,0 +1,97 @@
+/******************************************************
+ * @file TasksTests/PipeTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Tasks/Pipe.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace TE::Tasks;
+
+// 同一管道的任务不会并发执行, 且单个线程投入的任务按顺序执行
+TEST(PipeTest, TasksNeverOverlap) {
+    FPipe            pipe(TEXT("Pipe"));
+    std::atomic<int> running{ 0 };
+    int              counter = 0; // 只在管道内访问, 不需要同步
+    std::vector<int> order;
+
+    constexpr int producerCount = 4;
+    constexpr int taskCount     = 2000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < taskCount; ++i) {
+                pipe.Launch(TEXT("Piped"), [&, p, i]() {
+                    EXPECT_EQ(running.fetch_add(1), 0);
+                    EXPECT_TRUE(pipe.IsInContext());
+                    ++counter;
+                    if (p == 0) {
+                        order.push_back(i);
+                    }
+                    running.fetch_sub(1);
+                });
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    pipe.WaitUntilEmpty();
+
+    EXPECT_FALSE(pipe.HasWork());
+    EXPECT_FALSE(pipe.IsInContext());
+    EXPECT_EQ(counter, producerCount * taskCount);
+    ASSERT_EQ(order.size(), size_t(taskCount));
+    for (int i = 0; i < taskCount; ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+// 管道任务可以有返回值和额外的前置依赖
+// 用投递给游戏线程的任务当作闸门, 不占用工作线程
+TEST(PipeTest, ResultsAndPrerequisites) {
+    AttachToNamedThread(ENamedThread::GameThread);
+    FPipe pipe(TEXT("Pipe"));
+
+    auto gate   = Launch(
+        TEXT("Gate"), []() { return 10; }, ETaskPriority::Normal,
+        EExtendedTaskPriority::GameThread);
+    auto first  = pipe.Launch(
+        TEXT("First"), [&gate]() { return gate.GetResult() + 1; }, Prerequisites(gate));
+    auto second = pipe.Launch(TEXT("Second"), [&first]() { return first.GetResult() * 2; });
+    EXPECT_TRUE(pipe.HasWork());
+    EXPECT_FALSE(pipe.WaitUntilEmpty(std::chrono::milliseconds(5)));
+
+    ProcessNamedThreadUntilIdle(ENamedThread::GameThread);
+    EXPECT_EQ(second.GetResult(), 22);
+    EXPECT_TRUE(pipe.WaitUntilEmpty(std::chrono::seconds(10)));
+    DetachFromNamedThread();
+}
+
+// 一个管道被阻塞时, 其他管道照常执行
+TEST(PipeTest, IndependentPipes) {
+    FPipe a(TEXT("A"));
+    FPipe b(TEXT("B"));
+
+    auto gate = Launch(
+        TEXT("Gate"), []() {}, ETaskPriority::Normal, EExtendedTaskPriority::GameThread);
+    a.Launch(TEXT("Blocked"), []() {}, Prerequisites(gate));
+    auto other =
+        b.Launch(TEXT("Other"), [&a, &b]() { return !a.IsInContext() && b.IsInContext(); });
+    // 当前线程还不是游戏线程, 等待时不会顺带执行闸门
+    EXPECT_TRUE(other.GetResult());
+    EXPECT_TRUE(a.HasWork());
+
+    AttachToNamedThread(ENamedThread::GameThread);
+    ProcessNamedThreadUntilIdle(ENamedThread::GameThread);
+    a.WaitUntilEmpty();
+    b.WaitUntilEmpty();
+    DetachFromNamedThread();
+}
@@ -7,6 +7,11 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace TE::Core::TypeUtils::Tests {
 int Nothing() {
     return 233;
@@ -18,6 +23,378 @@ using namespace TE::Core::TypeUtils::Tests;
 using namespace TE::Tasks;
 
 TEST(TasksTest, TestLaunch) {
-    auto result1 = Launch("Nothing", Nothing);
-    EXPECT_EQ(result1.Result, 233);
+    auto result1 = Launch(TEXT("Nothing"), Nothing);
+    EXPECT_EQ(result1.GetResult(), 233);
+}
+
+// 任务在线程池上执行, 而不是调用线程
+// (GetResult 会把尚未开始的任务撤回到调用线程执行, 所以先轮询等它完成)
+TEST(TasksTest, RunsOnWorkerThread) {
+    std::thread::id callerId = std::this_thread::get_id();
+    auto task = Launch(TEXT("ThreadId"), []() { return std::this_thread::get_id(); });
+    while (!task.IsCompleted()) {
+        std::this_thread::yield();
+    }
+    EXPECT_NE(task.GetResult(), callerId);
+    EXPECT_TRUE(task.IsCompleted());
+}
+
+TEST(TasksTest, VoidTask) {
+    std::atomic<int> counter{ 0 };
+    TTask<void>      task = Launch(TEXT("Void"), [&counter]() { counter.fetch_add(1); });
+    task.Wait();
+    EXPECT_TRUE(task.IsCompleted());
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(TasksTest, EmptyHandle) {
+    TTask<int> task;
+    EXPECT_FALSE(task.IsValid());
+    EXPECT_TRUE(task.IsCompleted());
+}
+
+// 前置任务完成之前后继任务不会开始
+TEST(TasksTest, Prerequisites) {
+    std::atomic<int> stage{ 0 };
+    auto first = Launch(TEXT("First"), [&stage]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stage.store(1);
+        return 1;
+    });
+    auto second = Launch(
+        TEXT("Second"), [&stage]() { return stage.load() == 1 ? 2 : -1; }, Prerequisites(first));
+    EXPECT_EQ(second.GetResult(), 2);
+    EXPECT_TRUE(first.IsCompleted());
+}
+
+// 前置任务已完成时, 后继任务直接执行
+TEST(TasksTest, CompletedPrerequisite) {
+    auto first = Launch(TEXT("First"), []() { return 1; });
+    first.Wait();
+    auto second = Launch(
+        TEXT("Second"), [&first]() { return first.GetResult() + 1; }, Prerequisites(first));
+    EXPECT_EQ(second.GetResult(), 2);
+}
+
+// 扇出 / 扇入
+TEST(TasksTest, FanOutFanIn) {
+    constexpr int                 taskCount = 64;
+    std::vector<std::atomic<int>> slots(taskCount);
+    std::vector<TTask<void>>      tasks;
+    for (int i = 0; i < taskCount; ++i) {
+        tasks.push_back(Launch(TEXT("FanOut"), [&slots, i]() { slots[i].store(i); }));
+    }
+    auto join = Launch(
+        TEXT("FanIn"),
+        [&slots]() {
+            int sum = 0;
+            for (auto &slot: slots) {
+                sum += slot.load();
+            }
+            return sum;
+        },
+        tasks);
+    EXPECT_EQ(join.GetResult(), taskCount * (taskCount - 1) / 2);
+    for (auto &task: tasks) {
+        EXPECT_TRUE(task.IsCompleted());
+    }
+}
+
+// 任务体在执行完毕后析构, 任务对象在最后一个句柄释放后析构
+TEST(TasksTest, Lifetime) {
+    auto               marker = std::make_shared<int>(7);
+    std::weak_ptr<int> weak   = marker;
+    {
+        auto task = Launch(TEXT("Capture"), [marker = std::move(marker)]() { return *marker; });
+        EXPECT_EQ(task.GetResult(), 7);
+        EXPECT_TRUE(weak.expired());
+    }
+}
+
+// 多个句柄共享同一个任务
+TEST(TasksTest, CopyHandle) {
+    auto task = Launch(TEXT("Copy"), []() { return 5; });
+    auto copy = task;
+    EXPECT_EQ(copy.GetResult(), 5);
+    EXPECT_EQ(task.GetResult(), 5);
+    Wait(std::vector<TTask<int>>{ task, copy });
+}
+
+// 句柄可以重新赋值, 旧任务的引用随之释放
+TEST(TasksTest, AssignHandle) {
+    TTask<int> task;
+    EXPECT_FALSE(task.IsValid());
+    for (int i = 0; i < 4; ++i) {
+        task = Launch(TEXT("Assign"), [i]() { return i; });
+        EXPECT_EQ(task.GetResult(), i);
+    }
+    TTask<int> other = Launch(TEXT("Other"), []() { return 42; });
+    task             = other;
+    EXPECT_EQ(task.GetResult(), 42);
+    task = TTask<int>();
+    EXPECT_TRUE(task.IsCompleted());
+}
+
+// 投递给命名线程的任务只在该线程处理队列时执行
+TEST(TasksTest, NamedThread) {
+    AttachToNamedThread(ENamedThread::GameThread);
+    const std::thread::id gameThreadId = std::this_thread::get_id();
+
+    auto task = Launch(
+        TEXT("OnGameThread"), []() { return std::this_thread::get_id(); }, ETaskPriority::Normal,
+        EExtendedTaskPriority::GameThread);
+    EXPECT_FALSE(task.IsCompleted());
+    EXPECT_EQ(ProcessNamedThreadUntilIdle(ENamedThread::GameThread), 1u);
+    EXPECT_EQ(task.GetResult(), gameThreadId);
+
+    // 工作线程任务 -> 游戏线程任务 -> 工作线程任务; 在游戏线程上等待最后一个不会死锁
+    std::atomic<int> stage{ 0 };
+    auto             first  = Launch(TEXT("First"), [&stage]() { stage = 1; });
+    auto             second = Launch(
+        TEXT("Second"),
+        [&stage, gameThreadId]() {
+            EXPECT_EQ(std::this_thread::get_id(), gameThreadId);
+            EXPECT_EQ(stage.exchange(2), 1);
+        },
+        Prerequisites(first), ETaskPriority::High, EExtendedTaskPriority::GameThread);
+    auto third = Launch(
+        TEXT("Third"), [&stage]() { EXPECT_EQ(stage.exchange(3), 2); }, Prerequisites(second));
+    third.Wait();
+    EXPECT_EQ(stage.load(), 3);
+
+    // 没人处理的命名线程任务: 在其他线程上限时等待会超时
+    auto render = Launch(
+        TEXT("OnRenderThread"), []() {}, ETaskPriority::Normal,
+        EExtendedTaskPriority::RenderThread);
+    EXPECT_FALSE(render.Wait(std::chrono::milliseconds(5)));
+    std::thread renderThread([]() {
+        AttachToNamedThread(ENamedThread::RenderThread);
+        EXPECT_EQ(ProcessNamedThreadUntilIdle(ENamedThread::RenderThread), 1u);
+        DetachFromNamedThread();
+    });
+    renderThread.join();
+    EXPECT_TRUE(render.IsCompleted());
+
+    DetachFromNamedThread();
+    EXPECT_EQ(GetCurrentNamedThread(), ENamedThread::Count);
+}
+
+// Inline 任务在解除最后一个依赖的线程上直接执行
+TEST(TasksTest, InlineTask) {
+    auto task = Launch(
+        TEXT("Inline"), []() { return std::this_thread::get_id(); }, ETaskPriority::Normal,
+        EExtendedTaskPriority::Inline);
+    EXPECT_TRUE(task.IsCompleted());
+    EXPECT_EQ(task.GetResult(), std::this_thread::get_id());
+}
+
+// 带优先级的任务照常执行, 并与前置依赖组合
+TEST(TasksTest, Priorities) {
+    std::atomic<int> counter{ 0 };
+    auto background = Launch(TEXT("Background"), [&counter]() { counter.fetch_add(1); },
+                             ETaskPriority::Background);
+    auto high       = Launch(
+        TEXT("High"), [&counter]() { return counter.load(); }, Prerequisites(background),
+        ETaskPriority::High);
+    EXPECT_EQ(high.GetResult(), 1);
+}
+
+namespace {
+// 让全局线程池的所有工作线程都忙起来, 之后提交的任务只能排队
+class FWorkerBlocker {
+  public:
+    FWorkerBlocker() {
+        const int workerCount = ThreadPool::global().threadCount();
+        for (int i = 0; i < workerCount; ++i) {
+            Blockers.push_back(Launch(TEXT("Blocker"), [this]() {
+                Started.fetch_add(1);
+                while (!bRelease.load()) {
+                    std::this_thread::yield();
+                }
+            }));
+        }
+        while (Started.load() < workerCount) {
+            std::this_thread::yield();
+        }
+    }
+
+    ~FWorkerBlocker() {
+        bRelease = true;
+        for (TTask<void> &blocker: Blockers) {
+            blocker.Wait();
+        }
+    }
+
+  private:
+    std::vector<TTask<void>> Blockers;
+    std::atomic<int>   Started{ 0 };
+    std::atomic<bool>  bRelease{ false };
+};
+} // namespace
+
+// 还在队列里排队的任务被等待方撤回, 连同前置任务一起在等待线程上执行
+TEST(TasksTest, RetractAndExecute) {
+    FWorkerBlocker        blocker;
+    const std::thread::id waiterId = std::this_thread::get_id();
+
+    auto task = Launch(TEXT("Queued"), []() { return std::this_thread::get_id(); });
+    EXPECT_TRUE(task.TryRetractAndExecute());
+    EXPECT_EQ(task.GetResult(), waiterId);
+
+    std::vector<int> order;
+    auto             first  = Launch(TEXT("First"), [&order]() { order.push_back(1); });
+    auto             second = Launch(
+        TEXT("Second"), [&order]() { order.push_back(2); }, Prerequisites(first));
+    auto third = Launch(
+        TEXT("Third"), [&order]() { return std::this_thread::get_id(); }, Prerequisites(second));
+    EXPECT_EQ(third.GetResult(), waiterId);
+    EXPECT_EQ(order, (std::vector<int>{ 1, 2 }));
+
+    // 前置任务在别的命名线程上, 撤回失败但不阻塞
+    auto gate  = Launch(
+        TEXT("Gate"), []() {}, ETaskPriority::Normal, EExtendedTaskPriority::RenderThread);
+    auto gated = Launch(TEXT("Gated"), []() {}, Prerequisites(gate));
+    EXPECT_FALSE(gated.TryRetractAndExecute());
+    std::thread renderThread([]() {
+        AttachToNamedThread(ENamedThread::RenderThread);
+        ProcessNamedThreadUntilIdle(ENamedThread::RenderThread);
+        DetachFromNamedThread();
+    });
+    renderThread.join();
+    gated.Wait();
+    EXPECT_TRUE(gated.IsCompleted());
+}
+
+// 忙等期间等待线程帮忙执行线程池里的其他任务
+TEST(TasksTest, BusyWait) {
+    FWorkerBlocker blocker;
+
+    constexpr int    taskCount = 16;
+    std::atomic<int> counter{ 0 };
+    std::vector<TTask<void>> tasks;
+    for (int i = 0; i < taskCount; ++i) {
+        tasks.push_back(Launch(TEXT("Work"), [&counter]() { counter.fetch_add(1); }));
+    }
+    auto gate   = Launch(
+        TEXT("Gate"), []() {}, ETaskPriority::Normal, EExtendedTaskPriority::RenderThread);
+    auto target = Launch(TEXT("Target"), []() {}, Prerequisites(gate));
+
+    EXPECT_FALSE(target.BusyWait(std::chrono::milliseconds(5)));
+    EXPECT_EQ(counter.load(), taskCount);
+
+    std::thread renderThread([]() {
+        AttachToNamedThread(ENamedThread::RenderThread);
+        ProcessNamedThreadUntilIdle(ENamedThread::RenderThread);
+        DetachFromNamedThread();
+    });
+    target.BusyWait();
+    renderThread.join();
+    EXPECT_TRUE(target.IsCompleted());
+}
+
+// 命名线程上的限时等待按期返回, 不会把期间才被调度的任务撤回到本线程执行
+TEST(TasksTest, NamedThreadWaitTimeout) {
+    AttachToNamedThread(ENamedThread::GameThread);
+    TTask<void> target;
+    {
+        FWorkerBlocker blocker;
+        auto           gate = Launch(
+            TEXT("Gate"), []() {}, ETaskPriority::Normal, EExtendedTaskPriority::RenderThread);
+        target = Launch(
+            TEXT("Slow"), []() { std::this_thread::sleep_for(std::chrono::milliseconds(500)); },
+            Prerequisites(gate));
+        // 等待期间前置任务完成, target 进入线程池队列
+        std::thread renderThread([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            AttachToNamedThread(ENamedThread::RenderThread);
+            ProcessNamedThreadUntilIdle(ENamedThread::RenderThread);
+            DetachFromNamedThread();
+        });
+        const auto start = std::chrono::steady_clock::now();
+        EXPECT_FALSE(target.Wait(std::chrono::milliseconds(50)));
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(300));
+        renderThread.join();
+    }
+    target.Wait();
+    EXPECT_TRUE(target.IsCompleted());
+    ProcessNamedThreadUntilIdle(ENamedThread::GameThread);
+    DetachFromNamedThread();
+}
+
+namespace {
+// 记录拷贝与移动次数, 没有默认构造函数
+struct FCountedResult {
+    explicit FCountedResult(int InValue) : Value(InValue) {}
+    FCountedResult(const FCountedResult &Other) : Value(Other.Value) { ++Copies; }
+    FCountedResult(FCountedResult &&Other) noexcept : Value(Other.Value) { ++Moves; }
+
+    int               Value;
+    static inline int Copies = 0;
+    static inline int Moves  = 0;
+};
+} // namespace
+
+// 结果直接在任务对象内部构造: 不需要默认构造, 不拷贝也不移动; 只能移动的类型同样可用
+TEST(TasksTest, ResultStoredInPlace) {
+    FCountedResult::Copies = 0;
+    FCountedResult::Moves  = 0;
+    auto counted           = Launch(TEXT("Counted"), []() { return FCountedResult(7); });
+    EXPECT_EQ(counted.GetResult().Value, 7);
+    EXPECT_EQ(FCountedResult::Copies, 0);
+    EXPECT_EQ(FCountedResult::Moves, 0);
+
+    auto unique = Launch(TEXT("Unique"), []() { return std::make_unique<int>(42); });
+    std::unique_ptr<int> taken = std::move(unique.GetResult());
+    EXPECT_EQ(*taken, 42);
+
+    // 引用结果只保存地址
+    static int shared = 0;
+    TTask<int &> reference = Launch(TEXT("Reference"), []() -> int & { return shared; });
+    reference.GetResult()  = 5;
+    EXPECT_EQ(shared, 5);
+}
+
+// 延续任务以前置任务的结果为参数, 可以链式调用, 默认在完成前置任务的线程上直接执行
+TEST(TasksTest, Then) {
+    std::atomic<bool> bRelease{ false };
+    std::thread::id   firstThread;
+    auto first = Launch(TEXT("First"), [&bRelease, &firstThread]() {
+        while (!bRelease.load()) {
+            std::this_thread::yield();
+        }
+        firstThread = std::this_thread::get_id();
+        return 20;
+    });
+    TTask<std::thread::id> where = first.Then(TEXT("Where"), [](int) {
+        return std::this_thread::get_id();
+    });
+    TTask<FCountedResult> chain =
+        first.Then(TEXT("Double"), [](int &Value) { return Value * 2; })
+            .Then(TEXT("Add"), [](int Value) { return FCountedResult(Value + 1); });
+    TTask<void> tail = chain.Then(TEXT("Tail"), [](FCountedResult &) {});
+    std::atomic<int> counter{ 0 };
+    TTask<int> afterVoid = tail.Then(TEXT("AfterVoid"), [&counter]() { return ++counter; });
+
+    EXPECT_FALSE(chain.IsCompleted());
+    bRelease = true;
+    EXPECT_EQ(chain.GetResult().Value, 41);
+    EXPECT_EQ(afterVoid.GetResult(), 1);
+
+    EXPECT_EQ(where.GetResult(), firstThread);
+
+    // 前置任务已经完成时 Inline 延续立即执行
+    auto done = first.Then(TEXT("Done"), [](int Value) { return Value + 1; });
+    EXPECT_TRUE(done.IsCompleted());
+    EXPECT_EQ(done.GetResult(), 21);
+
+    // 交给线程池执行的延续, 只能移动的结果可以被延续取走
+    auto moved = Launch(TEXT("Unique"), []() { return std::make_unique<int>(3); })
+                     .Then(
+                         TEXT("Take"),
+                         [](std::unique_ptr<int> &Value) {
+                             std::unique_ptr<int> taken = std::move(Value);
+                             return *taken + 1;
+                         },
+                         ETaskPriority::Normal, EExtendedTaskPriority::None);
+    EXPECT_EQ(moved.GetResult(), 4);
 }
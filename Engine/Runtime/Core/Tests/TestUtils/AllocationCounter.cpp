@@ -0,0 +1,66 @@
+/******************************************************
+ * @file TestUtils/AllocationCounter.cpp
+ * @brief
+ *****************************************************/
+
+#include "TestUtils/AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// 替换函数放在单独的编译单元里, 不会被内联进调用 new 的测试代码,
+// 否则 GCC 会把 delete 中的 free 当成与 new 不配对而报 -Wmismatched-new-delete
+namespace {
+std::atomic<bool> GCountAllocations{ false };
+std::atomic<int>  GAllocationCount{ 0 };
+
+void CountAllocation() {
+    if (GCountAllocations.load(std::memory_order_relaxed)) {
+        GAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void *AllocateOrThrow(void *Ptr) {
+    if (!Ptr) {
+        throw std::bad_alloc();
+    }
+    return Ptr;
+}
+} // namespace
+
+namespace TE::Tests {
+void StartCountingAllocations() {
+    GAllocationCount.store(0);
+    GCountAllocations.store(true);
+}
+
+int StopCountingAllocations() {
+    GCountAllocations.store(false);
+    return GAllocationCount.load();
+}
+} // namespace TE::Tests
+
+void *operator new(std::size_t Size) {
+    CountAllocation();
+    return AllocateOrThrow(std::malloc(Size == 0 ? 1 : Size));
+}
+void *operator new(std::size_t Size, std::align_val_t Align) {
+    CountAllocation();
+    // aligned_alloc 要求大小是对齐的整数倍
+    const std::size_t Alignment = static_cast<std::size_t>(Align);
+    Size                        = (Size + Alignment - 1) / Alignment * Alignment;
+    return AllocateOrThrow(std::aligned_alloc(Alignment, Size == 0 ? Alignment : Size));
+}
+void operator delete(void *Ptr) noexcept {
+    std::free(Ptr);
+}
+void operator delete(void *Ptr, std::size_t) noexcept {
+    std::free(Ptr);
+}
+void operator delete(void *Ptr, std::align_val_t) noexcept {
+    std::free(Ptr);
+}
+void operator delete(void *Ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(Ptr);
+}
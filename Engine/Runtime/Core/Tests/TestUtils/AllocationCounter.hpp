@@ -0,0 +1,14 @@
+/******************************************************
+ * @file TestUtils/AllocationCounter.hpp
+ * @brief 替换全局 operator new / delete, 统计测试期间的堆分配次数
+ *****************************************************/
+
+#pragma once
+
+namespace TE::Tests {
+// 计数清零并开始计数; 统计的是整个进程 (所有线程) 的分配
+void StartCountingAllocations();
+
+// 停止计数, 返回自 StartCountingAllocations 以来 operator new 的调用次数
+int StopCountingAllocations();
+} // namespace TE::Tests
@@ -0,0 +1,50 @@
+/******************************************************
+ * @file ThreadTests/AllocationTest.cpp
+ * @brief 统计全局堆分配次数, 验证提交任务不发生 malloc
+ *****************************************************/
+
+#include "Thread/ThreadPool.hpp"
+
+#include "TestUtils/AllocationCounter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+
+// 捕获了多个指针和一个 std::unique_ptr 的任务, 预热之后提交不再分配内存
+TEST(AllocationTest, SubmitIsAllocationFree) {
+    ThreadPool       pool(4);
+    std::atomic<int> counter{ 0 };
+    int              a = 1, b = 2, c = 3;
+
+    auto submitBatch = [&](int count, std::unique_ptr<int> *buffers) {
+        for (int i = 0; i < count; ++i) {
+            pool.submit([&counter, pa = &a, pb = &b, pc = &c, buffer = std::move(buffers[i])]() {
+                counter.fetch_add(*pa + *pb + *pc + *buffer, std::memory_order_relaxed);
+            });
+        }
+        pool.waitAll();
+    };
+
+    constexpr int        warmupCount = 4096;
+    constexpr int        taskCount   = 512;
+    std::unique_ptr<int> buffers[warmupCount];
+    for (auto &buffer: buffers) {
+        buffer = std::make_unique<int>(0);
+    }
+
+    // 预热: 让任务节点缓存和工作线程队列达到稳定容量
+    submitBatch(warmupCount, buffers);
+    for (auto &buffer: buffers) {
+        buffer = std::make_unique<int>(0);
+    }
+    counter.store(0);
+
+    TE::Tests::StartCountingAllocations();
+    submitBatch(taskCount, buffers);
+    const int allocationCount = TE::Tests::StopCountingAllocations();
+
+    EXPECT_EQ(counter.load(), taskCount * 6);
+    EXPECT_EQ(allocationCount, 0);
+}
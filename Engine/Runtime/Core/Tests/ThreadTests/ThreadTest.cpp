@@ -7,9 +7,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 static void spinForMS(int ms) {
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
@@ -190,3 +192,148 @@ TEST(ThreadPoolTest, DestructWaitAll) {
     // 如果析构做了等待，这里应该等到 counter=5
     EXPECT_EQ(counter.load(), 5);
 }
+
+// 测试9：工作线程内部提交的任务 (进入本地队列, 可被其他线程窃取)
+TEST(ThreadPoolTest, NestedSubmit) {
+    ThreadPool       pool(4);
+    std::atomic<int> counter{ 0 };
+
+    constexpr int outerCount = 16;
+    constexpr int innerCount = 64;
+    for (int i = 0; i < outerCount; ++i) {
+        pool.submit([&pool, &counter]() {
+            for (int j = 0; j < innerCount; ++j) {
+                pool.submit([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    pool.waitAll();
+    EXPECT_EQ(counter.load(), outerCount * innerCount);
+}
+
+// 测试10：多个外部线程同时提交 (注入队列的并发压栈)
+TEST(ThreadPoolTest, ConcurrentExternalSubmit) {
+    ThreadPool       pool(4);
+    std::atomic<int> counter{ 0 };
+
+    constexpr int producerCount = 4;
+    constexpr int taskCount     = 20000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&pool, &counter]() {
+            for (int i = 0; i < taskCount; ++i) {
+                pool.submit([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    pool.waitAll();
+    EXPECT_EQ(counter.load(), producerCount * taskCount);
+}
+
+// 测试11：高优先级的任务先于低优先级的任务执行
+TEST(ThreadPoolTest, PriorityBands) {
+    ThreadPool        pool(1);
+    std::atomic<bool> release{ false };
+    std::atomic<bool> blocked{ false };
+
+    // 先让唯一的工作线程忙起来, 保证后面的任务都在队列里排队
+    pool.submit([&]() {
+        blocked = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!blocked.load()) {
+        std::this_thread::yield();
+    }
+
+    std::vector<int> order;
+    constexpr int    perBand = 8;
+    for (int i = 0; i < perBand; ++i) {
+        pool.submit([&order]() { order.push_back(2); }, TaskPriority::Background);
+        pool.submit([&order]() { order.push_back(1); }, TaskPriority::Normal);
+        pool.submit([&order]() { order.push_back(0); }, TaskPriority::High);
+    }
+    release = true;
+    pool.waitAll();
+
+    ASSERT_EQ(order.size(), 3u * perBand);
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()))
+        << "低优先级任务插到了高优先级任务前面";
+}
+
+// 测试12：非工作线程通过 tryExecuteOne 帮忙执行排队中的任务
+TEST(ThreadPoolTest, TryExecuteOne) {
+    ThreadPool        pool(1);
+    std::atomic<bool> release{ false };
+    std::atomic<bool> blocked{ false };
+    EXPECT_FALSE(pool.tryExecuteOne());
+
+    pool.submit([&]() {
+        blocked = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!blocked.load()) {
+        std::this_thread::yield();
+    }
+
+    constexpr int         taskCount = 8;
+    std::atomic<int>      counter{ 0 };
+    const std::thread::id helperId = std::this_thread::get_id();
+    for (int i = 0; i < taskCount; ++i) {
+        pool.submit([&counter, helperId]() {
+            EXPECT_EQ(std::this_thread::get_id(), helperId);
+            counter.fetch_add(1);
+        });
+    }
+    int executed = 0;
+    while (pool.tryExecuteOne()) {
+        ++executed;
+    }
+    EXPECT_EQ(executed, taskCount);
+    EXPECT_EQ(counter.load(), taskCount);
+
+    release = true;
+    pool.waitAll();
+}
+
+// 测试13：外部线程只取走一两个任务就停止帮忙, 同批剩下的任务仍由工作线程执行完
+TEST(ThreadPoolTest, TryExecuteOneLeavesRestToWorkers) {
+    ThreadPool        pool(1);
+    std::atomic<bool> release{ false };
+    std::atomic<bool> blocked{ false };
+    pool.submit([&]() {
+        blocked = true;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!blocked.load()) {
+        std::this_thread::yield();
+    }
+
+    constexpr int    taskCount = 1000;
+    std::vector<int> order;
+    for (int i = 0; i < taskCount; ++i) {
+        pool.submit([&order, i]() { order.push_back(i); });
+    }
+    // 前两个由本线程执行: 第一个来自注入队列, 第二个来自积压链表
+    EXPECT_TRUE(pool.tryExecuteOne());
+    EXPECT_TRUE(pool.tryExecuteOne());
+
+    release = true;
+    pool.waitAll();
+    ASSERT_EQ(order.size(), std::size_t(taskCount));
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+    std::sort(order.begin(), order.end());
+    for (int i = 0; i < taskCount; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
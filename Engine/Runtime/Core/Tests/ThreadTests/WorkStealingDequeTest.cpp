@@ -0,0 +1,107 @@
+/******************************************************
+ * @file ThreadTests/WorkStealingDequeTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Thread/WorkStealingDeque.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Node {
+    int   value = 0;
+    Node *next  = nullptr;
+};
+} // namespace
+
+// 拥有者端 LIFO, 窃取端 FIFO
+TEST(WorkStealingDequeTest, PushPopSteal) {
+    WorkStealingDeque<Node> deque(4);
+    Node                    nodes[3] = { { 1 }, { 2 }, { 3 } };
+    for (Node &node: nodes) {
+        deque.push(&node);
+    }
+    EXPECT_EQ(deque.sizeApprox(), 3);
+    EXPECT_EQ(deque.steal()->value, 1);
+    EXPECT_EQ(deque.pop()->value, 3);
+    EXPECT_EQ(deque.pop()->value, 2);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+}
+
+// 超过初始容量时自动扩容, 元素不丢失
+TEST(WorkStealingDequeTest, Grow) {
+    WorkStealingDeque<Node> deque(2);
+    std::vector<Node>       nodes(1000);
+    for (int i = 0; i < 1000; ++i) {
+        nodes[i].value = i;
+        deque.push(&nodes[i]);
+    }
+    for (int i = 999; i >= 0; --i) {
+        Node *node = deque.pop();
+        ASSERT_NE(node, nullptr);
+        EXPECT_EQ(node->value, i);
+    }
+}
+
+// 一个拥有者 + 多个窃取者并发, 每个元素恰好被取走一次
+TEST(WorkStealingDequeTest, ConcurrentSteal) {
+    constexpr int           itemCount = 100000;
+    WorkStealingDeque<Node> deque(16);
+    std::vector<Node>       nodes(itemCount);
+    std::vector<std::atomic<int>> taken(itemCount);
+    std::atomic<bool>             done{ false };
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t) {
+        thieves.emplace_back([&]() {
+            while (!done.load(std::memory_order_acquire) || !deque.isEmptyApprox()) {
+                if (Node *node = deque.steal()) {
+                    taken[node->value].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < itemCount; ++i) {
+        nodes[i].value = i;
+        deque.push(&nodes[i]);
+        if (i % 3 == 0) {
+            if (Node *node = deque.pop()) {
+                taken[node->value].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    while (Node *node = deque.pop()) {
+        taken[node->value].fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &thief: thieves) {
+        thief.join();
+    }
+
+    for (int i = 0; i < itemCount; ++i) {
+        ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+    }
+}
+
+// 注入队列: 批量取出时保持提交顺序
+TEST(WorkStealingDequeTest, InjectionQueueFifo) {
+    InjectionQueue<Node> queue;
+    Node                 nodes[4] = { { 0 }, { 1 }, { 2 }, { 3 } };
+    for (Node &node: nodes) {
+        queue.push(&node);
+    }
+    Node *batch = queue.popAll();
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_NE(batch, nullptr);
+        EXPECT_EQ(batch->value, i);
+        batch = batch->next;
+    }
+    EXPECT_EQ(batch, nullptr);
+    EXPECT_TRUE(queue.isEmptyApprox());
+}
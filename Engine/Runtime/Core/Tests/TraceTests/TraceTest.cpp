@@ -0,0 +1,114 @@
+/******************************************************
+ * @file TraceTests/TraceTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Tasks/Tasks.hpp"
+#include "Trace/Trace.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace TE;
+
+namespace {
+std::size_t CountOccurrences(const std::string &Text, const std::string &Pattern) {
+    std::size_t Count = 0;
+    for (std::size_t Pos = Text.find(Pattern); Pos != std::string::npos;
+         Pos             = Text.find(Pattern, Pos + Pattern.size())) {
+        ++Count;
+    }
+    return Count;
+}
+} // namespace
+
+// 只有在记录期间进入的作用域才会被记录
+TEST(TraceTest, ScopeRecordedOnlyWhileTracing) {
+    { TRACE_SCOPE("BeforeStart"); }
+    Trace::StartTracing();
+    EXPECT_TRUE(Trace::IsTracing());
+    {
+        TRACE_SCOPE("Outer");
+        TRACE_SCOPE("Inner \"quoted\"");
+    }
+    Trace::StopTracing();
+    { TRACE_SCOPE("AfterStop"); }
+
+    const std::string Json = Trace::ExportChromeTrace();
+    EXPECT_EQ(CountOccurrences(Json, "\"name\":\"Outer\",\"ph\":\"X\""), 1u);
+    EXPECT_EQ(CountOccurrences(Json, "\"name\":\"Inner \\\"quoted\\\"\""), 1u);
+    EXPECT_EQ(Json.find("BeforeStart"), std::string::npos);
+    EXPECT_EQ(Json.find("AfterStop"), std::string::npos);
+    EXPECT_NE(Json.find("\"ph\":\"M\""), std::string::npos);
+}
+
+// 任务的 DebugName 作为事件名, 记录在执行它的工作线程上
+TEST(TraceTest, TasksAreTraced) {
+    Trace::StartTracing();
+    auto Task = Tasks::Launch(TEXT("TracedTask"), []() { return 1; });
+    while (!Task.IsCompleted()) {
+        std::this_thread::yield();
+    }
+    Trace::StopTracing();
+
+    const std::string Json = Trace::ExportChromeTrace();
+    EXPECT_EQ(CountOccurrences(Json, "\"name\":\"TracedTask\""), 1u);
+    EXPECT_NE(Json.find("\"args\":{\"name\":\"Worker 0\"}"), std::string::npos);
+}
+
+// 环形缓冲区写满后只保留最新的事件; 重新开始记录会丢弃旧事件
+TEST(TraceTest, RingBufferKeepsNewestEvents) {
+    Trace::StartTracing();
+    { TRACE_SCOPE("Oldest"); }
+    for (uint32 Index = 0; Index < Trace::ThreadEventCapacity; ++Index) {
+        TRACE_SCOPE("Filler");
+    }
+    Trace::StopTracing();
+    std::string Json = Trace::ExportChromeTrace();
+    EXPECT_EQ(Json.find("Oldest"), std::string::npos);
+    EXPECT_EQ(CountOccurrences(Json, "\"name\":\"Filler\""), Trace::ThreadEventCapacity);
+
+    Trace::StartTracing();
+    Trace::StopTracing();
+    Json = Trace::ExportChromeTrace();
+    EXPECT_EQ(Json.find("Filler"), std::string::npos);
+}
+
+// 记录中途重新开始: 跨越 StartTracing 的作用域和其他线程上一次采集的事件都不会出现
+TEST(TraceTest, RestartWhileTracing) {
+    Trace::StartTracing();
+    std::thread([]() { TRACE_SCOPE("OtherThread"); }).join();
+    {
+        TRACE_SCOPE("Straddling");
+        Trace::StartTracing();
+    }
+    { TRACE_SCOPE("Current"); }
+    Trace::StopTracing();
+
+    const std::string Json = Trace::ExportChromeTrace();
+    EXPECT_EQ(Json.find("OtherThread"), std::string::npos);
+    EXPECT_EQ(Json.find("Straddling"), std::string::npos);
+    EXPECT_EQ(CountOccurrences(Json, "\"name\":\"Current\""), 1u);
+}
+
+TEST(TraceTest, WriteToFile) {
+    Trace::SetCurrentThreadName("TraceTestMain");
+    Trace::StartTracing();
+    { TRACE_SCOPE("Saved"); }
+    Trace::StopTracing();
+
+    const char *Path = "TraceTest.json";
+    ASSERT_TRUE(Trace::WriteChromeTrace(Path));
+    std::ifstream     File(Path);
+    std::stringstream Content;
+    Content << File.rdbuf();
+    EXPECT_EQ(Content.str().rfind("{\"displayTimeUnit\"", 0), 0u);
+    EXPECT_NE(Content.str().find("\"name\":\"Saved\""), std::string::npos);
+    EXPECT_NE(Content.str().find("TraceTestMain"), std::string::npos);
+    std::remove(Path);
+}
@@ -0,0 +1,85 @@
+/******************************************************
+ * @file TypeUtilsTests/UniqueFunctionTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "TypeUtils/UniqueFunction.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+
+TEST(UniqueFunctionTest, CallAndReturn) {
+    int                       base = 10;
+    TUniqueFunction<int(int)> func = [base](int value) { return base + value; };
+    ASSERT_TRUE(func);
+    EXPECT_EQ(func(5), 15);
+}
+
+// 返回 void 的签名丢弃可调用对象的返回值, 与 std::function 一致
+TEST(UniqueFunctionTest, VoidDiscardsReturnValue) {
+    int                     calls = 0;
+    TUniqueFunction<void()> func  = [&calls]() { return ++calls; };
+    func();
+    EXPECT_EQ(calls, 1);
+
+    std::array<char, 256>   padding{};
+    TUniqueFunction<void()> large = [&calls, padding]() { return calls += padding[0] + 1; };
+    large();
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(UniqueFunctionTest, EmptyFunction) {
+    TUniqueFunction<void()> func;
+    EXPECT_FALSE(func);
+    int (*nullFunc)() = nullptr;
+    TUniqueFunction<int()> fromNull = nullFunc;
+    EXPECT_FALSE(fromNull);
+}
+
+// 只可移动的捕获
+TEST(UniqueFunctionTest, MoveOnlyCapture) {
+    auto                   ptr  = std::make_unique<int>(42);
+    TUniqueFunction<int()> func = [ptr = std::move(ptr)]() { return *ptr; };
+    EXPECT_EQ(func(), 42);
+
+    TUniqueFunction<int()> moved = std::move(func);
+    EXPECT_FALSE(func);
+    EXPECT_EQ(moved(), 42);
+}
+
+TEST(UniqueFunctionTest, InlineAndHeapStorage) {
+    struct FSmall {
+        void *pointers[6];
+        void  operator()() {}
+    };
+    struct FLarge {
+        std::array<char, 256> data;
+        void                  operator()() {}
+    };
+    EXPECT_TRUE(TUniqueFunction<void()>::IsStoredInline<FSmall>);
+    EXPECT_FALSE(TUniqueFunction<void()>::IsStoredInline<FLarge>);
+    EXPECT_EQ(sizeof(TUniqueFunction<void()>), 64u);
+
+    // 超出内联容量时退化为堆分配, 行为不变
+    auto                   shared = std::make_shared<int>(3);
+    std::array<char, 256>  padding{};
+    TUniqueFunction<int()> func = [shared, padding]() { return *shared + padding[0]; };
+    TUniqueFunction<int()> moved;
+    moved = std::move(func);
+    EXPECT_EQ(moved(), 3);
+    EXPECT_EQ(shared.use_count(), 2);
+    moved = nullptr;
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+// 析构时释放捕获对象
+TEST(UniqueFunctionTest, DestroysCapture) {
+    auto shared = std::make_shared<int>(1);
+    {
+        TUniqueFunction<void()> func = [shared]() {};
+        EXPECT_EQ(shared.use_count(), 2);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
@@ -0,0 +1,143 @@
+/******************************************************
+ * @file Culling/ChunkCuller.cpp
+ * @brief
+ *****************************************************/
+
+#include "Culling/ChunkCuller.hpp"
+#include "Tasks/ParallelFor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <unordered_set>
+
+namespace TE::Culling {
+namespace {
+// 视锥剔除每个任务处理的包围盒数, 是 FAabbSoA::Lanes 的倍数
+constexpr uint32 FrustumBlockSize = 1024;
+static_assert(FrustumBlockSize % FAabbSoA::Lanes == 0);
+
+// 遮挡测试每批的包围盒数
+constexpr int32 OcclusionBatchSize = 64;
+} // namespace
+
+const std::vector<uint32> &FChunkCuller::Cull(const FMatrix44 &ViewProjection,
+                                              const FAabbSoA &Boxes,
+                                              std::span<const FAabb> Occluders) {
+    Stats           = {};
+    Stats.NumTested = Boxes.Num();
+
+    // 1. 视锥剔除: 每块写到自己的区间, 之后按块顺序压缩, 结果与串行一致
+    const FFrustum Frustum   = FFrustum::FromViewProjection(ViewProjection);
+    const uint32   NumBlocks = (Boxes.Num() + FrustumBlockSize - 1) / FrustumBlockSize;
+    InFrustum.resize(Boxes.Num());
+    BlockCounts.resize(NumBlocks);
+    Tasks::ParallelFor(int32(NumBlocks), [&](int32 Block) {
+        const uint32 Begin = uint32(Block) * FrustumBlockSize;
+        const uint32 End   = std::min(Begin + FrustumBlockSize, Boxes.Num());
+        BlockCounts[Block] = CullFrustum(Frustum, Boxes, Begin, End, InFrustum.data() + Begin);
+    });
+    uint32 NumInFrustum = 0;
+    for (uint32 Block = 0; Block < NumBlocks; ++Block) {
+        const uint32 *Source = InFrustum.data() + Block * FrustumBlockSize;
+        if (Source != InFrustum.data() + NumInFrustum) {
+            std::memmove(InFrustum.data() + NumInFrustum, Source,
+                         BlockCounts[Block] * sizeof(uint32));
+        }
+        NumInFrustum += BlockCounts[Block];
+    }
+    InFrustum.resize(NumInFrustum);
+    Stats.NumInFrustum = NumInFrustum;
+
+    if (Occluders.empty()) {
+        Visible.assign(InFrustum.begin(), InFrustum.end());
+        Stats.NumVisible = uint32(Visible.size());
+        return Visible;
+    }
+
+    // 2. 光栅化遮挡体
+    OcclusionBuffer.Begin(ViewProjection);
+    OcclusionBuffer.AddOccluders(Occluders);
+    OcclusionBuffer.Rasterize();
+    Stats.NumOccluders = OcclusionBuffer.NumOccluders();
+
+    // 3. 遮挡测试, 标记后按原顺序压缩
+    bOccludeeVisible.resize(NumInFrustum);
+    Tasks::ParallelFor(
+        int32(NumInFrustum),
+        [&](int32 Index) {
+            bOccludeeVisible[Index] = OcclusionBuffer.IsVisible(Boxes.Get(InFrustum[Index]));
+        },
+        OcclusionBatchSize);
+    Visible.clear();
+    for (uint32 Index = 0; Index < NumInFrustum; ++Index) {
+        if (bOccludeeVisible[Index]) {
+            Visible.push_back(InFrustum[Index]);
+        }
+    }
+    Stats.NumVisible = uint32(Visible.size());
+    return Visible;
+}
+
+void GatherVoxelChunks(const Voxel::FVoxelMap &Map, FAabbSoA &OutBounds,
+                       std::vector<Voxel::FChunkCoord> &OutCoords,
+                       std::vector<FAabb>              &OutOccluders) {
+    OutBounds.Reset();
+    OutCoords.clear();
+    OutOccluders.clear();
+    OutBounds.Reserve(Map.NumChunks());
+    OutCoords.reserve(Map.NumChunks());
+    std::unordered_set<Voxel::FChunkCoord> Solid;
+    Map.ForEachChunk([&](const Voxel::FChunkCoord &Coord, const Voxel::FVoxelChunk &Chunk) {
+        if (Chunk.IsEmpty()) {
+            return;
+        }
+        OutBounds.Add(GetChunkBounds(Coord));
+        OutCoords.push_back(Coord);
+        if (Chunk.IsUniform()) {
+            Solid.insert(Coord);
+        }
+    });
+
+    // 贪心合并实心区块: 先沿 X 延伸, 再把整行沿 Z 延伸, 最后把整个矩形沿 Y 延伸.
+    // 遮挡缓冲在相邻遮挡体的接缝处会留下空隙, 合并后接缝和遮挡体数量都大幅减少
+    std::vector<Voxel::FChunkCoord> Order(Solid.begin(), Solid.end());
+    std::sort(Order.begin(), Order.end(), [](const auto &A, const auto &B) {
+        return std::tie(A.Y, A.Z, A.X) < std::tie(B.Y, B.Z, B.X);
+    });
+    auto IsRectSolid = [&Solid](int32 MinX, int32 MaxX, int32 Y, int32 MinZ, int32 MaxZ) {
+        for (int32 Z = MinZ; Z <= MaxZ; ++Z) {
+            for (int32 X = MinX; X <= MaxX; ++X) {
+                if (!Solid.contains({ X, Y, Z })) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    for (const Voxel::FChunkCoord &Start: Order) {
+        if (!Solid.contains(Start)) {
+            continue;
+        }
+        int32 MaxX = Start.X, MaxZ = Start.Z, MaxY = Start.Y;
+        while (Solid.contains({ MaxX + 1, Start.Y, Start.Z })) {
+            ++MaxX;
+        }
+        while (IsRectSolid(Start.X, MaxX, Start.Y, MaxZ + 1, MaxZ + 1)) {
+            ++MaxZ;
+        }
+        while (IsRectSolid(Start.X, MaxX, MaxY + 1, Start.Z, MaxZ)) {
+            ++MaxY;
+        }
+        for (int32 Y = Start.Y; Y <= MaxY; ++Y) {
+            for (int32 Z = Start.Z; Z <= MaxZ; ++Z) {
+                for (int32 X = Start.X; X <= MaxX; ++X) {
+                    Solid.erase({ X, Y, Z });
+                }
+            }
+        }
+        OutOccluders.push_back(
+            { GetChunkBounds(Start).Min, GetChunkBounds({ MaxX, MaxY, MaxZ }).Max });
+    }
+}
+} // namespace TE::Culling
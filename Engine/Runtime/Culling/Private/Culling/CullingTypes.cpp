@@ -0,0 +1,93 @@
+/******************************************************
+ * @file Culling/CullingTypes.cpp
+ * @brief
+ *****************************************************/
+
+#include "Culling/CullingTypes.hpp"
+
+namespace TE::Culling {
+FMatrix44 FMatrix44::Identity() {
+    FMatrix44 Result;
+    Result.M[0] = Result.M[5] = Result.M[10] = Result.M[15] = 1.0f;
+    return Result;
+}
+
+FMatrix44 FMatrix44::Perspective(float FovY, float Aspect, float Near, float Far) {
+    const float InvTan = 1.0f / std::tan(FovY * 0.5f);
+    FMatrix44   Result;
+    Result.M[0]  = InvTan / Aspect;
+    Result.M[5]  = InvTan;
+    Result.M[10] = -(Far + Near) / (Far - Near);
+    Result.M[11] = -1.0f;
+    Result.M[14] = -2.0f * Far * Near / (Far - Near);
+    return Result;
+}
+
+FMatrix44 FMatrix44::LookAt(FVec3 Eye, FVec3 Target, FVec3 Up) {
+    const FVec3 Forward = Normalize(Target - Eye);
+    const FVec3 Right   = Normalize(Cross(Forward, Up));
+    const FVec3 CamUp   = Cross(Right, Forward);
+    FMatrix44   Result  = Identity();
+    Result.M[0]         = Right.X;
+    Result.M[4]         = Right.Y;
+    Result.M[8]         = Right.Z;
+    Result.M[1]         = CamUp.X;
+    Result.M[5]         = CamUp.Y;
+    Result.M[9]         = CamUp.Z;
+    Result.M[2]         = -Forward.X;
+    Result.M[6]         = -Forward.Y;
+    Result.M[10]        = -Forward.Z;
+    Result.M[12]        = -Dot(Right, Eye);
+    Result.M[13]        = -Dot(CamUp, Eye);
+    Result.M[14]        = Dot(Forward, Eye);
+    return Result;
+}
+
+FMatrix44 FMatrix44::FromColumnMajor(const float *Data) {
+    FMatrix44 Result;
+    for (int32 Index = 0; Index < 16; ++Index) {
+        Result.M[Index] = Data[Index];
+    }
+    return Result;
+}
+
+FMatrix44 operator*(const FMatrix44 &A, const FMatrix44 &B) {
+    FMatrix44 Result;
+    for (int32 Column = 0; Column < 4; ++Column) {
+        for (int32 Row = 0; Row < 4; ++Row) {
+            float Sum = 0.0f;
+            for (int32 K = 0; K < 4; ++K) {
+                Sum += A.Get(Row, K) * B.Get(K, Column);
+            }
+            Result.M[Column * 4 + Row] = Sum;
+        }
+    }
+    return Result;
+}
+
+FFrustum FFrustum::FromViewProjection(const FMatrix44 &ViewProjection) {
+    // 裁剪空间中 -w <= x <= w 等价于 (Row3 + Row0) · P >= 0 与 (Row3 - Row0) · P >= 0
+    auto Row = [&ViewProjection](int32 Index) {
+        return FVec4{ ViewProjection.Get(Index, 0), ViewProjection.Get(Index, 1),
+                      ViewProjection.Get(Index, 2), ViewProjection.Get(Index, 3) };
+    };
+    const FVec4 Row3 = Row(3);
+    FFrustum    Frustum;
+    for (int32 Axis = 0; Axis < 3; ++Axis) {
+        const FVec4 RowAxis = Row(Axis);
+        for (int32 Side = 0; Side < 2; ++Side) {
+            const float Sign  = Side == 0 ? 1.0f : -1.0f;
+            FPlane     &Plane = Frustum.Planes[Axis * 2 + Side];
+            Plane.Normal      = { Row3.X + Sign * RowAxis.X, Row3.Y + Sign * RowAxis.Y,
+                                  Row3.Z + Sign * RowAxis.Z };
+            Plane.D           = Row3.W + Sign * RowAxis.W;
+            const float Length = std::sqrt(Dot(Plane.Normal, Plane.Normal));
+            if (Length > 0.0f) {
+                Plane.Normal = Plane.Normal * (1.0f / Length);
+                Plane.D /= Length;
+            }
+        }
+    }
+    return Frustum;
+}
+} // namespace TE::Culling
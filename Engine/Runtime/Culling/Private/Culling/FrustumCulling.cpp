@@ -0,0 +1,154 @@
+/******************************************************
+ * @file Culling/FrustumCulling.cpp
+ * @brief
+ *****************************************************/
+
+#include "Culling/FrustumCulling.hpp"
+
+#include <atomic>
+#include <bit>
+
+// AVX2 路径用 target 属性单独编译, 其余代码不要求 -mavx2, 运行时再检查 CPU 是否支持
+// MSVC 暂时只有标量路径
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TE_CULLING_AVX2 1
+#include <immintrin.h>
+#else
+#define TE_CULLING_AVX2 0
+#endif
+
+namespace TE::Culling {
+namespace {
+// 每个平面的 p-vertex 分量: 法线分量非负时取 Max, 否则取 Min
+struct FPlaneSelect {
+    const float *X;
+    const float *Y;
+    const float *Z;
+};
+
+void SelectPositiveVertices(const FFrustum &Frustum, const FAabbSoA &Boxes,
+                            FPlaneSelect (&OutSelects)[6]) {
+    for (int32 PlaneIndex = 0; PlaneIndex < 6; ++PlaneIndex) {
+        const FVec3 &Normal  = Frustum.Planes[PlaneIndex].Normal;
+        OutSelects[PlaneIndex] = { Normal.X >= 0.0f ? Boxes.GetMax(0) : Boxes.GetMin(0),
+                                   Normal.Y >= 0.0f ? Boxes.GetMax(1) : Boxes.GetMin(1),
+                                   Normal.Z >= 0.0f ? Boxes.GetMax(2) : Boxes.GetMin(2) };
+    }
+}
+
+// 两条路径按同样的顺序做乘加 (不用 FMA), 保证结果逐位一致
+uint32 CullFrustumScalar(const FFrustum &Frustum, const FAabbSoA &Boxes, uint32 Begin,
+                         uint32 End, uint32 *OutVisible) {
+    FPlaneSelect Selects[6];
+    SelectPositiveVertices(Frustum, Boxes, Selects);
+    uint32 NumVisible = 0;
+    for (uint32 Index = Begin; Index < End; ++Index) {
+        bool bOutside = false;
+        for (int32 PlaneIndex = 0; PlaneIndex < 6; ++PlaneIndex) {
+            const FPlane       &Plane  = Frustum.Planes[PlaneIndex];
+            const FPlaneSelect &Select = Selects[PlaneIndex];
+            const float Distance = Plane.Normal.X * Select.X[Index] +
+                                   Plane.Normal.Y * Select.Y[Index] +
+                                   Plane.Normal.Z * Select.Z[Index] + Plane.D;
+            bOutside |= Distance < 0.0f;
+        }
+        OutVisible[NumVisible] = Index;
+        NumVisible += bOutside ? 0 : 1;
+    }
+    return NumVisible;
+}
+
+#if TE_CULLING_AVX2
+__attribute__((target("avx2"))) uint32 CullFrustumAvx2(const FFrustum &Frustum,
+                                                       const FAabbSoA &Boxes, uint32 Begin,
+                                                       uint32 End, uint32 *OutVisible) {
+    FPlaneSelect Selects[6];
+    SelectPositiveVertices(Frustum, Boxes, Selects);
+    __m256 NormalX[6], NormalY[6], NormalZ[6], PlaneD[6];
+    for (int32 PlaneIndex = 0; PlaneIndex < 6; ++PlaneIndex) {
+        const FPlane &Plane  = Frustum.Planes[PlaneIndex];
+        NormalX[PlaneIndex] = _mm256_set1_ps(Plane.Normal.X);
+        NormalY[PlaneIndex] = _mm256_set1_ps(Plane.Normal.Y);
+        NormalZ[PlaneIndex] = _mm256_set1_ps(Plane.Normal.Z);
+        PlaneD[PlaneIndex]  = _mm256_set1_ps(Plane.D);
+    }
+
+    const __m256 Zero       = _mm256_setzero_ps();
+    uint32       NumVisible = 0;
+    for (uint32 Base = Begin; Base < End; Base += FAabbSoA::Lanes) {
+        __m256 Outside = Zero;
+        for (int32 PlaneIndex = 0; PlaneIndex < 6; ++PlaneIndex) {
+            const FPlaneSelect &Select = Selects[PlaneIndex];
+            __m256 Distance = _mm256_mul_ps(NormalX[PlaneIndex], _mm256_loadu_ps(Select.X + Base));
+            Distance        = _mm256_add_ps(
+                Distance, _mm256_mul_ps(NormalY[PlaneIndex], _mm256_loadu_ps(Select.Y + Base)));
+            Distance        = _mm256_add_ps(
+                Distance, _mm256_mul_ps(NormalZ[PlaneIndex], _mm256_loadu_ps(Select.Z + Base)));
+            Distance        = _mm256_add_ps(Distance, PlaneD[PlaneIndex]);
+            Outside         = _mm256_or_ps(Outside, _mm256_cmp_ps(Distance, Zero, _CMP_LT_OQ));
+        }
+        uint32 VisibleMask = ~uint32(_mm256_movemask_ps(Outside)) & 0xFF;
+        if (End - Base < FAabbSoA::Lanes) {
+            VisibleMask &= (1u << (End - Base)) - 1;
+        }
+        // 压缩: 逐个取出最低位
+        while (VisibleMask) {
+            OutVisible[NumVisible++] = Base + uint32(std::countr_zero(VisibleMask));
+            VisibleMask &= VisibleMask - 1;
+        }
+    }
+    return NumVisible;
+}
+#endif
+
+ECullingSimd DetectCullingSimd() {
+#if TE_CULLING_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ECullingSimd::Avx2;
+    }
+#endif
+    return ECullingSimd::Scalar;
+}
+
+std::atomic<ECullingSimd> GCullingSimd{ GetSupportedCullingSimd() };
+} // namespace
+
+ECullingSimd GetSupportedCullingSimd() {
+    static const ECullingSimd Supported = DetectCullingSimd();
+    return Supported;
+}
+
+ECullingSimd GetCullingSimd() {
+    return GCullingSimd.load(std::memory_order_relaxed);
+}
+
+void SetCullingSimd(ECullingSimd Simd) {
+    GCullingSimd.store(Simd <= GetSupportedCullingSimd() ? Simd : GetSupportedCullingSimd(),
+                       std::memory_order_relaxed);
+}
+
+uint32 CullFrustum(const FFrustum &Frustum, const FAabbSoA &Boxes, uint32 Begin, uint32 End,
+                   uint32 *OutVisible) {
+    check(Begin % FAabbSoA::Lanes == 0 && Begin <= End && End <= Boxes.Num());
+#if TE_CULLING_AVX2
+    if (GetCullingSimd() == ECullingSimd::Avx2) {
+        return CullFrustumAvx2(Frustum, Boxes, Begin, End, OutVisible);
+    }
+#endif
+    return CullFrustumScalar(Frustum, Boxes, Begin, End, OutVisible);
+}
+
+bool IsInFrustum(const FFrustum &Frustum, const FAabb &Box) {
+    for (const FPlane &Plane: Frustum.Planes) {
+        const float Distance = Plane.Normal.X * (Plane.Normal.X >= 0.0f ? Box.Max.X : Box.Min.X) +
+                               Plane.Normal.Y * (Plane.Normal.Y >= 0.0f ? Box.Max.Y : Box.Min.Y) +
+                               Plane.Normal.Z * (Plane.Normal.Z >= 0.0f ? Box.Max.Z : Box.Min.Z) +
+                               Plane.D;
+        if (Distance < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace TE::Culling
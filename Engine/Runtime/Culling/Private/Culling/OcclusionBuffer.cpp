@@ -0,0 +1,290 @@
+/******************************************************
+ * @file Culling/OcclusionBuffer.cpp
+ * @brief
+ *****************************************************/
+
+#include "Culling/OcclusionBuffer.hpp"
+#include "DebugUtils/CoreDebug.hpp"
+#include "Tasks/ParallelFor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace TE::Culling {
+namespace {
+// 裁剪空间 w 小于它的角点视为在相机平面附近或身后, 不做透视除法
+constexpr float MinClipW = 1e-4f;
+
+// 每条光栅化任务处理的行数
+constexpr int32 RowsPerStrip = 8;
+
+constexpr float NoOccluderDepth = std::numeric_limits<float>::infinity();
+
+// 先在浮点域夹紧再取整, 远在屏幕外的坐标转换成 int32 时不会溢出
+int32 FloorToInt(float Value, int32 Min, int32 Max) {
+    return int32(std::floor(std::clamp(Value, float(Min), float(Max))));
+}
+
+int32 CeilToInt(float Value, int32 Min, int32 Max) {
+    return int32(std::ceil(std::clamp(Value, float(Min), float(Max))));
+}
+
+float Cross(float Ax, float Ay, float Bx, float By, float Cx, float Cy) {
+    return (Bx - Ax) * (Cy - Ay) - (By - Ay) * (Cx - Ax);
+}
+} // namespace
+
+FOcclusionBuffer::FOcclusionBuffer(int32 InWidth, int32 InHeight)
+    : Width(InWidth), Height(InHeight),
+      Depth(std::size_t(InWidth) * std::size_t(InHeight), NoOccluderDepth) {
+    check(Width > 0 && Height > 0);
+}
+
+void FOcclusionBuffer::Begin(const FMatrix44 &InViewProjection) {
+    ViewProjection = InViewProjection;
+    // 相机位置满足 Row0 · P = Row1 · P = Row3 · P = 0 (P.w = 1), 用 Cramer 法则解 3x3 方程;
+    // 正交投影没有相机位置, 此时遮挡体退化为常数深度
+    const int32 Rows[3] = { 0, 1, 3 };
+    float       A[3][3], B[3];
+    for (int32 Row = 0; Row < 3; ++Row) {
+        for (int32 Column = 0; Column < 3; ++Column) {
+            A[Row][Column] = ViewProjection.Get(Rows[Row], Column);
+        }
+        B[Row] = -ViewProjection.Get(Rows[Row], 3);
+    }
+    auto Determinant = [](const float (&M)[3][3]) {
+        return M[0][0] * (M[1][1] * M[2][2] - M[1][2] * M[2][1]) -
+               M[0][1] * (M[1][0] * M[2][2] - M[1][2] * M[2][0]) +
+               M[0][2] * (M[1][0] * M[2][1] - M[1][1] * M[2][0]);
+    };
+    const float Det = Determinant(A);
+    bHasEye         = std::abs(Det) > 1e-12f;
+    if (bHasEye) {
+        float Solution[3];
+        for (int32 Column = 0; Column < 3; ++Column) {
+            float Replaced[3][3];
+            for (int32 Row = 0; Row < 3; ++Row) {
+                for (int32 Other = 0; Other < 3; ++Other) {
+                    Replaced[Row][Other] = Other == Column ? B[Row] : A[Row][Other];
+                }
+            }
+            Solution[Column] = Determinant(Replaced) / Det;
+        }
+        Eye = { Solution[0], Solution[1], Solution[2] };
+    }
+    std::fill(Depth.begin(), Depth.end(), NoOccluderDepth);
+    Occluders.clear();
+}
+
+bool FOcclusionBuffer::ProjectCorners(const FAabb &Box, float (&OutX)[8], float (&OutY)[8],
+                                      float (&OutZ)[8]) const {
+    for (uint32 Corner = 0; Corner < 8; ++Corner) {
+        const FVec4 Clip = ViewProjection.TransformPoint(Box.GetCorner(Corner));
+        if (Clip.W < MinClipW) {
+            return false;
+        }
+        const float InvW = 1.0f / Clip.W;
+        OutX[Corner]     = (Clip.X * InvW * 0.5f + 0.5f) * float(Width);
+        OutY[Corner]     = (0.5f - Clip.Y * InvW * 0.5f) * float(Height);
+        OutZ[Corner]     = Clip.Z * InvW;
+    }
+    return true;
+}
+
+void FOcclusionBuffer::AddOccluders(std::span<const FAabb> InOccluders) {
+    Occluders.reserve(Occluders.size() + InOccluders.size());
+    for (const FAabb &Box: InOccluders) {
+        float X[8], Y[8], Z[8];
+        if (!ProjectCorners(Box, X, Y, Z)) {
+            continue;
+        }
+
+        // Andrew 单调链求 8 个投影点的凸包, 去掉共线点
+        uint32 Order[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+        std::sort(Order, Order + 8, [&](uint32 A, uint32 B) {
+            return X[A] < X[B] || (X[A] == X[B] && Y[A] < Y[B]);
+        });
+        uint32 Hull[16];
+        int32  NumHull = 0;
+        for (int32 Pass = 0; Pass < 2; ++Pass) {
+            const int32 Start = NumHull;
+            for (int32 Step = 0; Step < 8; ++Step) {
+                const uint32 Point = Order[Pass == 0 ? Step : 7 - Step];
+                while (NumHull >= Start + 2 &&
+                       Cross(X[Hull[NumHull - 2]], Y[Hull[NumHull - 2]], X[Hull[NumHull - 1]],
+                             Y[Hull[NumHull - 1]], X[Point], Y[Point]) <= 0.0f) {
+                    --NumHull;
+                }
+                Hull[NumHull++] = Point;
+            }
+            // 每条链的最后一个点是另一条链的起点
+            --NumHull;
+        }
+        if (NumHull < 3) {
+            continue;
+        }
+
+        FProjectedOccluder Occluder;
+        Occluder.NumVertices = NumHull;
+        Occluder.MaxDepth    = -std::numeric_limits<float>::infinity();
+        float MinX = X[Hull[0]], MaxX = MinX, MinY = Y[Hull[0]], MaxY = MinY;
+        for (int32 Vertex = 0; Vertex < NumHull; ++Vertex) {
+            Occluder.X[Vertex] = X[Hull[Vertex]];
+            Occluder.Y[Vertex] = Y[Hull[Vertex]];
+            MinX               = std::min(MinX, Occluder.X[Vertex]);
+            MaxX               = std::max(MaxX, Occluder.X[Vertex]);
+            MinY               = std::min(MinY, Occluder.Y[Vertex]);
+            MaxY               = std::max(MaxY, Occluder.Y[Vertex]);
+        }
+        for (const float CornerDepth: Z) {
+            Occluder.MaxDepth = std::max(Occluder.MaxDepth, CornerDepth);
+        }
+        // 视线进入凸体的位置是各个正对相机的面中最远的那个交点, 而平面的 NDC 深度在屏幕上是
+        // 仿射的, 所以表面深度 = 这些面 (最多 3 个) 的深度平面在该像素处的最大值
+        Occluder.NumPlanes = 0;
+        if (bHasEye) {
+            const float EyeAxis[3] = { Eye.X, Eye.Y, Eye.Z };
+            const float MinAxis[3] = { Box.Min.X, Box.Min.Y, Box.Min.Z };
+            const float MaxAxis[3] = { Box.Max.X, Box.Max.Y, Box.Max.Z };
+            for (int32 Axis = 0; Axis < 3; ++Axis) {
+                uint32 Side;
+                if (EyeAxis[Axis] < MinAxis[Axis]) {
+                    Side = 0;
+                } else if (EyeAxis[Axis] > MaxAxis[Axis]) {
+                    Side = 1u << Axis;
+                } else {
+                    continue;
+                }
+                // 该面上的三个角点: 本轴的位固定, 另外两轴各取一位
+                const uint32 BitU = 1u << ((Axis + 1) % 3);
+                const uint32 BitV = 1u << ((Axis + 2) % 3);
+                const uint32 C0 = Side, C1 = Side | BitU, C2 = Side | BitV;
+                const float  Ux = X[C1] - X[C0], Uy = Y[C1] - Y[C0], Uz = Z[C1] - Z[C0];
+                const float  Vx = X[C2] - X[C0], Vy = Y[C2] - Y[C0], Vz = Z[C2] - Z[C0];
+                const float  Nx = Uy * Vz - Uz * Vy;
+                const float  Ny = Uz * Vx - Ux * Vz;
+                const float  Nz = Ux * Vy - Uy * Vx;
+                // 侧对屏幕的面不影响进入点
+                if (std::abs(Nz) < 1e-6f) {
+                    continue;
+                }
+                FDepthPlane &Plane = Occluder.Planes[Occluder.NumPlanes++];
+                Plane.A            = -Nx / Nz;
+                Plane.B            = -Ny / Nz;
+                // 平面在一个像素内的最大增量, 让每个像素取到保守的 (最远的) 深度
+                Plane.C = Z[C0] - Plane.A * X[C0] - Plane.B * Y[C0] +
+                          0.5f * (std::abs(Plane.A) + std::abs(Plane.B));
+            }
+        }
+        // 只有完全落在包围矩形内的像素才可能被完全覆盖
+        Occluder.MinPixelX = CeilToInt(MinX, 0, Width);
+        Occluder.MaxPixelX = FloorToInt(MaxX, 0, Width) - 1;
+        Occluder.MinPixelY = CeilToInt(MinY, 0, Height);
+        Occluder.MaxPixelY = FloorToInt(MaxY, 0, Height) - 1;
+        if (Occluder.MinPixelX > Occluder.MaxPixelX || Occluder.MinPixelY > Occluder.MaxPixelY) {
+            continue;
+        }
+        Occluders.push_back(Occluder);
+    }
+}
+
+void FOcclusionBuffer::Rasterize() {
+    if (Occluders.empty()) {
+        return;
+    }
+    const int32 NumStrips = (Height + RowsPerStrip - 1) / RowsPerStrip;
+    Tasks::ParallelFor(NumStrips, [this](int32 Strip) {
+        RasterizeRows(Strip * RowsPerStrip, std::min((Strip + 1) * RowsPerStrip, Height));
+    });
+}
+
+void FOcclusionBuffer::RasterizeRows(int32 RowBegin, int32 RowEnd) {
+    for (const FProjectedOccluder &Occluder: Occluders) {
+        const int32 FirstRow = std::max(RowBegin, Occluder.MinPixelY);
+        const int32 LastRow  = std::min(RowEnd - 1, Occluder.MaxPixelY);
+        for (int32 Row = FirstRow; Row <= LastRow; ++Row) {
+            // 像素 [x, x+1] x [Row, Row+1] 被完全覆盖, 当且仅当对凸包的每条边,
+            // 边函数在像素中心的值减去半个像素的最大变化量仍然非负; 每条边给出中心 x 的一个界
+            const float CenterY = float(Row) + 0.5f;
+            float       Lo      = float(Occluder.MinPixelX) + 0.5f;
+            float       Hi      = float(Occluder.MaxPixelX) + 0.5f;
+            for (int32 Vertex = 0; Vertex < Occluder.NumVertices && Lo <= Hi; ++Vertex) {
+                const int32 Next = Vertex + 1 == Occluder.NumVertices ? 0 : Vertex + 1;
+                const float Ax   = Occluder.X[Vertex];
+                const float Ay   = Occluder.Y[Vertex];
+                // E(P) = StepX * (Py - Ay) - StepY * (Px - Ax) = CoefX * Px + Rest
+                const float StepX = Occluder.X[Next] - Ax;
+                const float StepY = Occluder.Y[Next] - Ay;
+                const float CoefX = -StepY;
+                const float Rest  = StepX * (CenterY - Ay) + StepY * Ax -
+                                   0.5f * (std::abs(StepX) + std::abs(StepY));
+                if (CoefX > 0.0f) {
+                    Lo = std::max(Lo, -Rest / CoefX);
+                } else if (CoefX < 0.0f) {
+                    Hi = std::min(Hi, -Rest / CoefX);
+                } else if (Rest < 0.0f) {
+                    Hi = Lo - 1.0f;
+                }
+            }
+            if (Lo > Hi) {
+                continue;
+            }
+            const int32 FirstPixel = CeilToInt(Lo - 0.5f, Occluder.MinPixelX, Occluder.MaxPixelX);
+            const int32 LastPixel = FloorToInt(Hi - 0.5f, Occluder.MinPixelX, Occluder.MaxPixelX);
+            float      *RowDepth   = Depth.data() + std::size_t(Row) * Width;
+            if (Occluder.NumPlanes == 0) {
+                for (int32 Pixel = FirstPixel; Pixel <= LastPixel; ++Pixel) {
+                    RowDepth[Pixel] = std::min(RowDepth[Pixel], Occluder.MaxDepth);
+                }
+                continue;
+            }
+            for (int32 Pixel = FirstPixel; Pixel <= LastPixel; ++Pixel) {
+                const float CenterX = float(Pixel) + 0.5f;
+                float       Surface = -std::numeric_limits<float>::infinity();
+                for (int32 PlaneIndex = 0; PlaneIndex < Occluder.NumPlanes; ++PlaneIndex) {
+                    const FDepthPlane &Plane = Occluder.Planes[PlaneIndex];
+                    Surface = std::max(Surface, Plane.A * CenterX + Plane.B * CenterY + Plane.C);
+                }
+                RowDepth[Pixel] = std::min(RowDepth[Pixel], std::min(Surface, Occluder.MaxDepth));
+            }
+        }
+    }
+}
+
+bool FOcclusionBuffer::IsVisible(const FAabb &Box) const {
+    float X[8], Y[8], Z[8];
+    if (!ProjectCorners(Box, X, Y, Z)) {
+        // 完全在相机身后时不可见; 与相机平面相交时无法可靠地投影, 当作可见
+        for (uint32 Corner = 0; Corner < 8; ++Corner) {
+            if (ViewProjection.TransformPoint(Box.GetCorner(Corner)).W >= MinClipW) {
+                return true;
+            }
+        }
+        return false;
+    }
+    float MinX = X[0], MaxX = X[0], MinY = Y[0], MaxY = Y[0], MinZ = Z[0];
+    for (int32 Corner = 1; Corner < 8; ++Corner) {
+        MinX = std::min(MinX, X[Corner]);
+        MaxX = std::max(MaxX, X[Corner]);
+        MinY = std::min(MinY, Y[Corner]);
+        MaxY = std::max(MaxY, Y[Corner]);
+        MinZ = std::min(MinZ, Z[Corner]);
+    }
+    // 与投影矩形有交集的所有像素
+    const int32 FirstX = FloorToInt(MinX, 0, Width);
+    const int32 LastX  = CeilToInt(MaxX, 0, Width) - 1;
+    const int32 FirstY = FloorToInt(MinY, 0, Height);
+    const int32 LastY  = CeilToInt(MaxY, 0, Height) - 1;
+    for (int32 Row = FirstY; Row <= LastY; ++Row) {
+        const float *RowDepth = Depth.data() + std::size_t(Row) * Width;
+        for (int32 Pixel = FirstX; Pixel <= LastX; ++Pixel) {
+            if (RowDepth[Pixel] >= MinZ) {
+                return true;
+            }
+        }
+    }
+    // 完全在屏幕外, 或者每个像素都被更近的遮挡体挡住
+    return false;
+}
+} // namespace TE::Culling
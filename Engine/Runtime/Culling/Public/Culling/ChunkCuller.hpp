@@ -0,0 +1,65 @@
+/******************************************************
+ * @file Culling/ChunkCuller.hpp
+ * @brief 体素区块的可见性判定: 视锥剔除 + 遮挡剔除 -> 紧凑的可见列表
+ *****************************************************/
+
+#pragma once
+
+#include "Culling/CullingTypes.hpp"
+#include "Culling/FrustumCulling.hpp"
+#include "Culling/OcclusionBuffer.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelMap.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <span>
+#include <vector>
+
+namespace TE::Culling {
+struct FCullingStats {
+    uint32 NumTested    = 0;
+    uint32 NumInFrustum = 0;
+    uint32 NumOccluders = 0; // 实际光栅化的遮挡体
+    uint32 NumVisible   = 0;
+};
+
+// 每帧一次: 先用 SIMD 批量做视锥剔除 (线程池上分块并行), 再光栅化遮挡体,
+// 最后对留下的包围盒做遮挡测试, 输出升序的可见下标列表. 不依赖图形 API, 可以离屏测试.
+// 一个实例同一时刻只能由一个线程调用 Cull
+class FChunkCuller {
+  public:
+    explicit FChunkCuller(int32 OcclusionWidth  = FOcclusionBuffer::DefaultWidth,
+                          int32 OcclusionHeight = FOcclusionBuffer::DefaultHeight)
+        : OcclusionBuffer(OcclusionWidth, OcclusionHeight) {}
+
+    // 返回 Boxes 中可见包围盒的下标 (升序), 在下一次调用 Cull 之前有效
+    // Occluders 为空时跳过遮挡剔除
+    const std::vector<uint32> &Cull(const FMatrix44 &ViewProjection, const FAabbSoA &Boxes,
+                                    std::span<const FAabb> Occluders);
+
+    const FCullingStats    &GetStats() const { return Stats; }
+    const FOcclusionBuffer &GetOcclusionBuffer() const { return OcclusionBuffer; }
+
+  private:
+    FOcclusionBuffer    OcclusionBuffer;
+    std::vector<uint32> InFrustum;
+    std::vector<uint32> BlockCounts;
+    std::vector<uint8>  bOccludeeVisible;
+    std::vector<uint32> Visible;
+    FCullingStats       Stats;
+};
+
+// 收集区块表中所有非空区块的世界包围盒 (1 体素 = 1 单位), OutCoords 与 OutBounds 一一对应;
+// 完全实心的均匀区块合并成尽量大的包围盒后作为遮挡体写入 OutOccluders. 输出容器先被清空.
+// 所有非空气方块都视为不透明
+void GatherVoxelChunks(const Voxel::FVoxelMap &Map, FAabbSoA &OutBounds,
+                       std::vector<Voxel::FChunkCoord> &OutCoords,
+                       std::vector<FAabb>              &OutOccluders);
+
+inline FAabb GetChunkBounds(const Voxel::FChunkCoord &Coord) {
+    const FVec3 Min{ float(Coord.X * Voxel::ChunkDim), float(Coord.Y * Voxel::ChunkDim),
+                     float(Coord.Z * Voxel::ChunkDim) };
+    return { Min, Min + FVec3{ float(Voxel::ChunkDim), float(Voxel::ChunkDim),
+                               float(Voxel::ChunkDim) } };
+}
+} // namespace TE::Culling
@@ -0,0 +1,93 @@
+/******************************************************
+ * @file Culling/CullingTypes.hpp
+ * @brief 剔除用的最小数学类型: 向量、包围盒、矩阵与视锥
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+
+#include <cmath>
+
+namespace TE::Culling {
+struct FVec3 {
+    float X = 0.0f;
+    float Y = 0.0f;
+    float Z = 0.0f;
+
+    friend FVec3 operator+(FVec3 A, FVec3 B) { return { A.X + B.X, A.Y + B.Y, A.Z + B.Z }; }
+    friend FVec3 operator-(FVec3 A, FVec3 B) { return { A.X - B.X, A.Y - B.Y, A.Z - B.Z }; }
+    friend FVec3 operator*(FVec3 A, float S) { return { A.X * S, A.Y * S, A.Z * S }; }
+};
+
+inline float Dot(FVec3 A, FVec3 B) {
+    return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+}
+
+inline FVec3 Cross(FVec3 A, FVec3 B) {
+    return { A.Y * B.Z - A.Z * B.Y, A.Z * B.X - A.X * B.Z, A.X * B.Y - A.Y * B.X };
+}
+
+inline FVec3 Normalize(FVec3 V) {
+    const float Length = std::sqrt(Dot(V, V));
+    return Length > 0.0f ? V * (1.0f / Length) : V;
+}
+
+// 轴对齐包围盒, Min <= Max
+struct FAabb {
+    FVec3 Min;
+    FVec3 Max;
+
+    FVec3 GetCorner(uint32 Index) const {
+        return { Index & 1 ? Max.X : Min.X, Index & 2 ? Max.Y : Min.Y,
+                 Index & 4 ? Max.Z : Min.Z };
+    }
+};
+
+// 齐次裁剪空间坐标
+struct FVec4 {
+    float X = 0.0f;
+    float Y = 0.0f;
+    float Z = 0.0f;
+    float W = 0.0f;
+};
+
+// 4x4 矩阵, 列主序 (M[Column * 4 + Row]), 与 OpenGL / glm 的内存布局一致,
+// 可以直接传入 glm::value_ptr 的结果. 裁剪空间约定为 OpenGL 的 z ∈ [-w, w]
+struct FMatrix44 {
+    float M[16] = {};
+
+    static FMatrix44 Identity();
+    // FovY 为弧度
+    static FMatrix44 Perspective(float FovY, float Aspect, float Near, float Far);
+    static FMatrix44 LookAt(FVec3 Eye, FVec3 Target, FVec3 Up);
+    static FMatrix44 FromColumnMajor(const float *Data);
+
+    float Get(int32 Row, int32 Column) const { return M[Column * 4 + Row]; }
+
+    FVec4 TransformPoint(FVec3 P) const {
+        return { M[0] * P.X + M[4] * P.Y + M[8] * P.Z + M[12],
+                 M[1] * P.X + M[5] * P.Y + M[9] * P.Z + M[13],
+                 M[2] * P.X + M[6] * P.Y + M[10] * P.Z + M[14],
+                 M[3] * P.X + M[7] * P.Y + M[11] * P.Z + M[15] };
+    }
+
+    friend FMatrix44 operator*(const FMatrix44 &A, const FMatrix44 &B);
+};
+
+// 平面 Dot(Normal, P) + D = 0, 法线指向内侧
+struct FPlane {
+    FVec3 Normal;
+    float D = 0.0f;
+
+    float GetDistance(FVec3 P) const { return Dot(Normal, P) + D; }
+};
+
+// 视锥的 6 个平面: 左、右、下、上、近、远
+struct FFrustum {
+    FPlane Planes[6];
+
+    // 从 "投影 * 视图" 矩阵提取 (Gribb-Hartmann), 平面已归一化
+    static FFrustum FromViewProjection(const FMatrix44 &ViewProjection);
+};
+} // namespace TE::Culling
@@ -0,0 +1,98 @@
+/******************************************************
+ * @file Culling/FrustumCulling.hpp
+ * @brief SoA 包围盒批量视锥剔除 (AVX2 + 标量回退)
+ *****************************************************/
+
+#pragma once
+
+#include "Culling/CullingTypes.hpp"
+#include "DebugUtils/CoreDebug.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <vector>
+
+namespace TE::Culling {
+// 按分量分开存放的包围盒数组, 每个分量数组的长度补齐到 Lanes 的倍数,
+// 批量测试时一次读入 Lanes 个包围盒的同一个分量
+class FAabbSoA {
+  public:
+    static constexpr uint32 Lanes = 8;
+
+    void Reset() {
+        Count = 0;
+        for (std::vector<float> &Component: Components) {
+            Component.clear();
+        }
+    }
+
+    void Reserve(uint32 Capacity) {
+        for (std::vector<float> &Component: Components) {
+            Component.reserve(RoundUp(Capacity));
+        }
+    }
+
+    // 返回新包围盒的下标
+    uint32 Add(const FAabb &Box) {
+        if (Count == Components[0].size()) {
+            for (std::vector<float> &Component: Components) {
+                Component.resize(Count + Lanes, 0.0f);
+            }
+        }
+        Components[MinX][Count] = Box.Min.X;
+        Components[MinY][Count] = Box.Min.Y;
+        Components[MinZ][Count] = Box.Min.Z;
+        Components[MaxX][Count] = Box.Max.X;
+        Components[MaxY][Count] = Box.Max.Y;
+        Components[MaxZ][Count] = Box.Max.Z;
+        return Count++;
+    }
+
+    FAabb Get(uint32 Index) const {
+        check(Index < Count);
+        return { { Components[MinX][Index], Components[MinY][Index], Components[MinZ][Index] },
+                 { Components[MaxX][Index], Components[MaxY][Index], Components[MaxZ][Index] } };
+    }
+
+    uint32 Num() const { return Count; }
+
+    // Axis: 0 = X, 1 = Y, 2 = Z; 数组长度为 Num 向上取整到 Lanes 的倍数, 补齐部分为 0
+    const float *GetMin(int32 Axis) const { return Components[MinX + Axis].data(); }
+    const float *GetMax(int32 Axis) const { return Components[MaxX + Axis].data(); }
+
+  private:
+    enum EComponent { MinX, MinY, MinZ, MaxX, MaxY, MaxZ, NumComponents };
+
+    static uint32 RoundUp(uint32 Value) { return (Value + Lanes - 1) / Lanes * Lanes; }
+
+    std::vector<float> Components[NumComponents];
+    uint32             Count = 0;
+};
+
+enum class ECullingSimd : uint8 {
+    Scalar,
+    Avx2,
+};
+
+// 当前 CPU 与编译器支持的最高指令集
+ECullingSimd GetSupportedCullingSimd();
+
+// 实际使用的指令集, 默认为支持的最高一档; 设置时不会超过 GetSupportedCullingSimd
+// 主要供测试与基准对比两条路径
+ECullingSimd GetCullingSimd();
+void         SetCullingSimd(ECullingSimd Simd);
+
+// 测试 Boxes 中下标 [Begin, End) 的包围盒, 与视锥相交或在其内部的下标按升序写入 OutVisible,
+// 返回写入的个数. Begin 必须是 FAabbSoA::Lanes 的倍数, OutVisible 至少能容纳 End - Begin 个
+//
+// 对每个平面只检查包围盒离它最远的内侧顶点 (p-vertex), 是保守的: 不会漏掉可见的包围盒,
+// 但视锥角落外侧的少数包围盒会被当作可见
+uint32 CullFrustum(const FFrustum &Frustum, const FAabbSoA &Boxes, uint32 Begin, uint32 End,
+                   uint32 *OutVisible);
+
+inline uint32 CullFrustum(const FFrustum &Frustum, const FAabbSoA &Boxes, uint32 *OutVisible) {
+    return CullFrustum(Frustum, Boxes, 0, Boxes.Num(), OutVisible);
+}
+
+// 单个包围盒, 与 CullFrustum 的判定完全一致
+bool IsInFrustum(const FFrustum &Frustum, const FAabb &Box);
+} // namespace TE::Culling
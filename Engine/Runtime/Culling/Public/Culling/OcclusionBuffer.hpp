@@ -0,0 +1,82 @@
+/******************************************************
+ * @file Culling/OcclusionBuffer.hpp
+ * @brief 低分辨率软件深度缓冲, 用于 CPU 端遮挡剔除
+ *****************************************************/
+
+#pragma once
+
+#include "Culling/CullingTypes.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <span>
+#include <vector>
+
+namespace TE::Culling {
+// 遮挡缓冲
+//
+// 把遮挡体 (实心的包围盒, 例如完全被方块填满的区块) 光栅化到一张很小的深度图上,
+// 再用它判断其他包围盒是否被完全挡住. 两步都是保守的, 只会把被遮挡的物体当作可见, 反之不会:
+//   - 遮挡体: 只写入被其投影轮廓 (凸包) 完全覆盖的像素, 深度取正对相机的面在像素范围内
+//     最远的深度; 相邻遮挡体的接缝处会留下空隙, 应尽量把相邻的遮挡体合并成大的包围盒
+//   - 被测物体: 投影矩形覆盖的任一像素中, 物体最近的深度不比缓冲中的深度远, 就算可见
+// 深度为 NDC z (OpenGL 约定, [-1, 1]), 没有遮挡体的像素为 +inf.
+// 光栅化按行分条交给线程池并行, 各条互不重叠, 不需要同步
+//
+// 用法: Begin -> AddOccluders -> Rasterize -> IsVisible (IsVisible 可以多线程并发调用)
+class FOcclusionBuffer {
+  public:
+    static constexpr int32 DefaultWidth  = 256;
+    static constexpr int32 DefaultHeight = 128;
+
+    explicit FOcclusionBuffer(int32 InWidth = DefaultWidth, int32 InHeight = DefaultHeight);
+
+    // 清空深度与遮挡体, 设置本帧的 "投影 * 视图" 矩阵
+    void Begin(const FMatrix44 &InViewProjection);
+
+    // 投影遮挡体, 与近平面相交的遮挡体被忽略
+    void AddOccluders(std::span<const FAabb> Occluders);
+
+    // 光栅化所有已添加的遮挡体
+    void Rasterize();
+
+    // 只光栅化 [RowBegin, RowEnd) 行, Rasterize 按条调用它
+    void RasterizeRows(int32 RowBegin, int32 RowEnd);
+
+    bool IsVisible(const FAabb &Box) const;
+
+    int32  GetWidth() const { return Width; }
+    int32  GetHeight() const { return Height; }
+    float  GetDepth(int32 X, int32 Y) const { return Depth[std::size_t(Y) * Width + X]; }
+    uint32 NumOccluders() const { return uint32(Occluders.size()); }
+
+  private:
+    // 屏幕空间的深度平面 z = A * x + B * y + C, C 已加上半个像素的最大增量
+    struct FDepthPlane {
+        float A, B, C;
+    };
+
+    // 投影后的遮挡体: 屏幕空间凸包 (逆时针, 最多 6 个顶点), 正对相机的面的深度平面,
+    // 以及角点的最远深度 (没有相机位置时作为常数深度)
+    struct FProjectedOccluder {
+        float       X[8];
+        float       Y[8];
+        int32       NumVertices;
+        FDepthPlane Planes[3];
+        int32       NumPlanes;
+        float       MaxDepth;
+        int32       MinPixelX, MaxPixelX, MinPixelY, MaxPixelY;
+    };
+
+    // 把 8 个角点变换到屏幕空间 (像素, y 向下), 有角点在相机平面附近或身后时返回 false
+    bool ProjectCorners(const FAabb &Box, float (&OutX)[8], float (&OutY)[8],
+                        float (&OutZ)[8]) const;
+
+    int32                           Width;
+    int32                           Height;
+    FMatrix44                       ViewProjection;
+    FVec3                           Eye;
+    bool                            bHasEye = false;
+    std::vector<float>              Depth;
+    std::vector<FProjectedOccluder> Occluders;
+};
+} // namespace TE::Culling
@@ -0,0 +1,90 @@
+/******************************************************
+ * @file CullingTests/FrustumCullingTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Culling/FrustumCulling.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace TE::Culling;
+
+namespace {
+// 相机在原点看向 -Z, 90 度视角
+FMatrix44 MakeViewProjection() {
+    return FMatrix44::Perspective(1.5707964f, 1.0f, 0.1f, 100.0f) *
+           FMatrix44::LookAt({ 0, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 });
+}
+
+FAabb MakeBox(FVec3 Center, float HalfSize) {
+    return { Center - FVec3{ HalfSize, HalfSize, HalfSize },
+             Center + FVec3{ HalfSize, HalfSize, HalfSize } };
+}
+
+// 恢复默认指令集
+struct FSimdGuard {
+    ~FSimdGuard() { SetCullingSimd(GetSupportedCullingSimd()); }
+};
+} // namespace
+
+TEST(FrustumCullingTest, Planes) {
+    const FFrustum Frustum = FFrustum::FromViewProjection(MakeViewProjection());
+    EXPECT_TRUE(IsInFrustum(Frustum, MakeBox({ 0, 0, -10 }, 1)));
+    EXPECT_FALSE(IsInFrustum(Frustum, MakeBox({ 0, 0, 10 }, 1)));    // 身后
+    EXPECT_FALSE(IsInFrustum(Frustum, MakeBox({ 0, 0, -110 }, 1)));  // 远平面之外
+    EXPECT_FALSE(IsInFrustum(Frustum, MakeBox({ -30, 0, -10 }, 1))); // 左侧之外
+    EXPECT_TRUE(IsInFrustum(Frustum, MakeBox({ -10, 0, -10 }, 1)));  // 跨过左平面
+    EXPECT_TRUE(IsInFrustum(Frustum, MakeBox({ 0, 0, 0 }, 1)));      // 包住相机
+}
+
+// 两条路径的结果逐个一致, 与单个测试一致, 并且不会漏掉可见的包围盒
+TEST(FrustumCullingTest, BatchMatchesScalar) {
+    FSimdGuard     Guard;
+    const FFrustum Frustum = FFrustum::FromViewProjection(MakeViewProjection());
+
+    std::mt19937                          Random(42);
+    std::uniform_real_distribution<float> Position(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> Size(0.1f, 8.0f);
+    FAabbSoA                              Boxes;
+    std::vector<FAabb>                    Source;
+    for (int32 Index = 0; Index < 1003; ++Index) {
+        Source.push_back(MakeBox({ Position(Random), Position(Random), Position(Random) },
+                                 Size(Random)));
+        EXPECT_EQ(Boxes.Add(Source.back()), uint32(Index));
+    }
+
+    std::vector<uint32> Expected;
+    for (uint32 Index = 0; Index < Boxes.Num(); ++Index) {
+        if (IsInFrustum(Frustum, Source[Index])) {
+            Expected.push_back(Index);
+        }
+        // 中心点在视锥内的包围盒一定保留
+        const FVec3 Center = (Source[Index].Min + Source[Index].Max) * 0.5f;
+        if (IsInFrustum(Frustum, { Center, Center })) {
+            EXPECT_TRUE(IsInFrustum(Frustum, Source[Index]));
+        }
+    }
+    EXPECT_GT(Expected.size(), 10u);
+    EXPECT_LT(Expected.size(), Source.size());
+
+    for (const ECullingSimd Simd: { ECullingSimd::Scalar, ECullingSimd::Avx2 }) {
+        SetCullingSimd(Simd);
+        std::vector<uint32> Visible(Boxes.Num());
+        Visible.resize(CullFrustum(Frustum, Boxes, Visible.data()));
+        EXPECT_EQ(Visible, Expected);
+
+        // 从中间的某一批开始
+        std::vector<uint32> Tail(Boxes.Num());
+        Tail.resize(CullFrustum(Frustum, Boxes, 512, Boxes.Num(), Tail.data()));
+        std::vector<uint32> ExpectedTail;
+        for (const uint32 Index: Expected) {
+            if (Index >= 512) {
+                ExpectedTail.push_back(Index);
+            }
+        }
+        EXPECT_EQ(Tail, ExpectedTail);
+    }
+}
@@ -0,0 +1,178 @@
+/******************************************************
+ * @file CullingTests/OcclusionTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Culling/ChunkCuller.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace TE::Culling;
+
+namespace {
+FMatrix44 MakeViewProjection(FVec3 Eye, FVec3 Target) {
+    return FMatrix44::Perspective(1.0471976f, 16.0f / 9.0f, 0.1f, 1000.0f) *
+           FMatrix44::LookAt(Eye, Target, { 0, 1, 0 });
+}
+
+FAabb MakeBox(FVec3 Center, FVec3 HalfSize) {
+    return { Center - HalfSize, Center + HalfSize };
+}
+
+// 射线 Origin -> Target 在到达 Target 之前是否穿过 Box
+bool IsSegmentBlocked(FVec3 Origin, FVec3 Target, const FAabb &Box) {
+    const float Direction[3] = { Target.X - Origin.X, Target.Y - Origin.Y, Target.Z - Origin.Z };
+    const float Start[3]     = { Origin.X, Origin.Y, Origin.Z };
+    const float Min[3]       = { Box.Min.X, Box.Min.Y, Box.Min.Z };
+    const float Max[3]       = { Box.Max.X, Box.Max.Y, Box.Max.Z };
+    float       Enter = 0.0f, Exit = 0.999f;
+    for (int32 Axis = 0; Axis < 3; ++Axis) {
+        if (std::abs(Direction[Axis]) < 1e-9f) {
+            if (Start[Axis] < Min[Axis] || Start[Axis] > Max[Axis]) {
+                return false;
+            }
+            continue;
+        }
+        float Near = (Min[Axis] - Start[Axis]) / Direction[Axis];
+        float Far  = (Max[Axis] - Start[Axis]) / Direction[Axis];
+        if (Near > Far) {
+            std::swap(Near, Far);
+        }
+        Enter = std::max(Enter, Near);
+        Exit  = std::min(Exit, Far);
+    }
+    return Enter <= Exit;
+}
+} // namespace
+
+TEST(OcclusionTest, WallHidesBoxesBehindIt) {
+    const FVec3      Eye{ 0, 0, 0 };
+    FOcclusionBuffer Buffer;
+    Buffer.Begin(MakeViewProjection(Eye, { 0, 0, -1 }));
+    const FAabb Wall = MakeBox({ 0, 0, -20 }, { 10, 6, 0.5f });
+    Buffer.AddOccluders({ &Wall, 1 });
+    Buffer.Rasterize();
+    EXPECT_EQ(Buffer.NumOccluders(), 1u);
+
+    EXPECT_FALSE(Buffer.IsVisible(MakeBox({ 0, 0, -40 }, { 2, 2, 2 })));
+    EXPECT_FALSE(Buffer.IsVisible(MakeBox({ 3, -2, -25 }, { 1, 1, 1 })));
+    EXPECT_TRUE(Buffer.IsVisible(MakeBox({ 0, 0, -10 }, { 1, 1, 1 })));  // 墙前
+    EXPECT_TRUE(Buffer.IsVisible(MakeBox({ 0, 0, -20 }, { 12, 1, 1 }))); // 穿过墙
+    EXPECT_TRUE(Buffer.IsVisible(MakeBox({ 24, 0, -40 }, { 2, 2, 2 }))); // 从墙边露出来
+    EXPECT_TRUE(Buffer.IsVisible(MakeBox({ 0, 0, 0.05f }, { 1, 1, 1 }))); // 包住相机
+    EXPECT_FALSE(Buffer.IsVisible(MakeBox({ 0, 0, 10 }, { 1, 1, 1 })));   // 身后, 不在屏幕上
+
+    // 与近平面相交的遮挡体不参与光栅化
+    Buffer.Begin(MakeViewProjection(Eye, { 0, 0, -1 }));
+    const FAabb Around = MakeBox({ 0, 0, 0 }, { 5, 5, 5 });
+    Buffer.AddOccluders({ &Around, 1 });
+    EXPECT_EQ(Buffer.NumOccluders(), 0u);
+}
+
+// 随机场景: 被判为不可见的包围盒, 其角点与中心到相机的连线都必须被某个遮挡体挡住
+TEST(OcclusionTest, Conservative) {
+    std::mt19937                          Random(7);
+    std::uniform_real_distribution<float> Lateral(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> Distance(-120.0f, -10.0f);
+    std::uniform_real_distribution<float> Size(0.5f, 8.0f);
+
+    const FVec3 Eye{ 0, 2, 5 };
+    for (int32 Round = 0; Round < 4; ++Round) {
+        std::vector<FAabb> Occluders;
+        for (int32 Index = 0; Index < 40; ++Index) {
+            Occluders.push_back(MakeBox({ Lateral(Random), Lateral(Random) * 0.3f,
+                                          Distance(Random) * 0.5f },
+                                        { Size(Random), Size(Random), Size(Random) }));
+        }
+        FOcclusionBuffer Buffer(128, 64);
+        Buffer.Begin(MakeViewProjection(Eye, { 0, 0, -50 }));
+        Buffer.AddOccluders(Occluders);
+        Buffer.Rasterize();
+
+        int32 NumHidden = 0;
+        for (int32 Index = 0; Index < 400; ++Index) {
+            const FAabb Box = MakeBox({ Lateral(Random), Lateral(Random) * 0.3f, Distance(Random) },
+                                      { 1, 1, 1 });
+            if (Buffer.IsVisible(Box)) {
+                continue;
+            }
+            ++NumHidden;
+            for (uint32 Corner = 0; Corner <= 8; ++Corner) {
+                const FVec3 Point = Corner < 8 ? Box.GetCorner(Corner) : (Box.Min + Box.Max) * 0.5f;
+                const bool  bBlocked =
+                    std::any_of(Occluders.begin(), Occluders.end(), [&](const FAabb &Occluder) {
+                        return IsSegmentBlocked(Eye, Point, Occluder);
+                    });
+                // 不在屏幕上的点本来就看不到
+                const FVec4 Clip = MakeViewProjection(Eye, { 0, 0, -50 }).TransformPoint(Point);
+                const bool  bOnScreen = Clip.W > 0 && std::abs(Clip.X) <= Clip.W &&
+                                       std::abs(Clip.Y) <= Clip.W;
+                EXPECT_TRUE(bBlocked || !bOnScreen);
+            }
+        }
+        EXPECT_GT(NumHidden, 0);
+    }
+}
+
+TEST(OcclusionTest, ChunkCuller) {
+    using namespace TE::Voxel;
+    // 16 x 16 的地面: y = 0 层是实心石头, 下面一层是洞穴 (非均匀), 上面零星有树
+    FVoxelMap Map;
+    for (int32 X = -8; X < 8; ++X) {
+        for (int32 Z = -8; Z < 8; ++Z) {
+            Map.FindOrAddChunk({ X, 0, Z }).Fill(1);
+            FVoxelChunk &Cave = Map.FindOrAddChunk({ X, -1, Z });
+            Cave.Fill(1);
+            Cave.Set(3, 3, 3, AirVoxel);
+            if ((X + Z) % 5 == 0) {
+                Map.FindOrAddChunk({ X, 1, Z }).Set(0, 0, 0, 2);
+            }
+        }
+    }
+    Map.FindOrAddChunk({ 0, 2, 0 }); // 全空气, 不参与剔除
+
+    FAabbSoA                 Bounds;
+    std::vector<FChunkCoord> Coords;
+    std::vector<FAabb>       Occluders;
+    GatherVoxelChunks(Map, Bounds, Coords, Occluders);
+    EXPECT_EQ(Bounds.Num(), Map.NumChunks() - 1);
+    // 整层实心区块合并成一个遮挡体
+    ASSERT_EQ(Occluders.size(), 1u);
+    EXPECT_EQ(Occluders[0].Min.X, -256.0f);
+    EXPECT_EQ(Occluders[0].Max.Z, 256.0f);
+    EXPECT_EQ(Occluders[0].Max.Y, 32.0f);
+
+    // 在地面外侧的高处往斜下方看
+    const FMatrix44 ViewProjection = MakeViewProjection({ 0, 200, 450 }, { 0, 0, 0 });
+    FChunkCuller    Culler;
+    const std::vector<uint32> WithoutOcclusion = Culler.Cull(ViewProjection, Bounds, {});
+    const std::vector<uint32> Visible          = Culler.Cull(ViewProjection, Bounds, Occluders);
+    const FCullingStats      &Stats            = Culler.GetStats();
+    EXPECT_EQ(Stats.NumTested, Bounds.Num());
+    EXPECT_EQ(Stats.NumInFrustum, WithoutOcclusion.size());
+    EXPECT_EQ(Stats.NumVisible, Visible.size());
+    EXPECT_GT(Stats.NumOccluders, 0u);
+    EXPECT_TRUE(std::is_sorted(Visible.begin(), Visible.end()));
+    EXPECT_TRUE(std::includes(WithoutOcclusion.begin(), WithoutOcclusion.end(), Visible.begin(),
+                              Visible.end()));
+
+    int32 NumCaveVisible = 0, NumFrontCaveVisible = 0, NumTreesVisible = 0, NumTrees = 0;
+    for (const uint32 Index: WithoutOcclusion) {
+        NumTrees += Coords[Index].Y == 1 ? 1 : 0;
+    }
+    for (const uint32 Index: Visible) {
+        NumCaveVisible += Coords[Index].Y == -1 && Coords[Index].Z < 6 ? 1 : 0;
+        NumFrontCaveVisible += Coords[Index].Y == -1 && Coords[Index].Z == 7 ? 1 : 0;
+        NumTreesVisible += Coords[Index].Y == 1 ? 1 : 0;
+    }
+    // 最前排洞穴的侧面朝向相机, 第二排在它们 (不是遮挡体) 身后; 更靠里的洞穴被地面完全挡住.
+    // 视野内地面上的区块都可见
+    EXPECT_EQ(NumFrontCaveVisible, 16);
+    EXPECT_EQ(NumCaveVisible, 0);
+    EXPECT_GT(NumTrees, 0);
+    EXPECT_EQ(NumTreesVisible, NumTrees);
+}
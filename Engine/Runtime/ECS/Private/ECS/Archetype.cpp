@@ -0,0 +1,140 @@
+/******************************************************
+ * @file ECS/Archetype.cpp
+ * @brief
+ *****************************************************/
+
+#include "ECS/Archetype.hpp"
+#include "Memory/FixedBlockAllocator.hpp"
+
+#include <new>
+
+namespace TE::ECS {
+namespace {
+// 所有 Archetype 共用一个 16 KB 块池, 空块归还后可被其他 Archetype 复用
+using FChunkAllocator = TFixedBlockAllocator<ChunkSize, ChunkAlignment>;
+
+constexpr uint32 AlignUp(uint32 Value, uint32 Alignment) {
+    return (Value + Alignment - 1) / Alignment * Alignment;
+}
+} // namespace
+
+FArchetype::FArchetype(const FComponentMask &InMask, uint32 InIndex)
+    : Mask(InMask), Index(InIndex), ColumnOf(MaxComponentTypes, -1) {
+    uint32 RowSize = sizeof(FEntity);
+    for (FComponentTypeId TypeId = 0; TypeId < MaxComponentTypes; ++TypeId) {
+        if (!Mask.test(TypeId)) {
+            continue;
+        }
+        const FComponentTypeInfo &Info = FComponentRegistry::Get(TypeId);
+        ColumnOf[TypeId]               = int16(Columns.size());
+        Columns.push_back({ TypeId, 0, Info.Size, &Info });
+        RowSize += Info.Size;
+    }
+
+    // 每个数组都从缓存行边界开始; 先按无填充估算容量, 放不下再逐个减少
+    const uint32 HeaderSize = AlignUp(sizeof(FChunk), ChunkAlignment);
+    for (ChunkCapacity = (ChunkSize - HeaderSize) / RowSize; ChunkCapacity > 0; --ChunkCapacity) {
+        uint32 Offset  = HeaderSize;
+        EntitiesOffset = Offset;
+        Offset += ChunkCapacity * sizeof(FEntity);
+        for (FColumn &Column: Columns) {
+            if (Column.Size == 0) {
+                continue;
+            }
+            Offset        = AlignUp(Offset, ChunkAlignment);
+            Column.Offset = Offset;
+            Offset += ChunkCapacity * Column.Size;
+        }
+        if (Offset <= ChunkSize) {
+            break;
+        }
+    }
+    check(ChunkCapacity > 0);
+}
+
+FArchetype::~FArchetype() {
+    for (FChunk *Chunk: Chunks) {
+        for (const FColumn &Column: Columns) {
+            if (Column.Size == 0) {
+                continue;
+            }
+            for (uint32 Row = 0; Row < Chunk->Count; ++Row) {
+                Column.Info->Destruct(GetCell(Chunk, Row, Column));
+            }
+        }
+        FreeChunk(Chunk);
+    }
+}
+
+FEntityLocation FArchetype::AllocateRow(FEntity Entity) {
+    if (Chunks.empty() || Chunks.back()->Count == ChunkCapacity) {
+        Chunks.push_back(AllocateChunk());
+    }
+    FChunk *Chunk           = Chunks.back();
+    uint32  Row             = Chunk->Count++;
+    GetEntities(Chunk)[Row] = Entity;
+    ++EntityCount;
+    return { Chunk, Row };
+}
+
+FEntity FArchetype::RemoveRow(const FEntityLocation &Location, bool bDestruct) {
+    check(Location.Chunk->Archetype == this && Location.Row < Location.Chunk->Count);
+    if (bDestruct) {
+        for (const FColumn &Column: Columns) {
+            if (Column.Size != 0) {
+                Column.Info->Destruct(GetCell(Location.Chunk, Location.Row, Column));
+            }
+        }
+    }
+
+    FChunk      *LastChunk = Chunks.back();
+    const uint32 LastRow   = LastChunk->Count - 1;
+    FEntity      Moved;
+    if (Location.Chunk != LastChunk || Location.Row != LastRow) {
+        // 用最后一行填补空位
+        for (const FColumn &Column: Columns) {
+            if (Column.Size != 0) {
+                Column.Info->Relocate(GetCell(Location.Chunk, Location.Row, Column),
+                                      GetCell(LastChunk, LastRow, Column));
+            }
+        }
+        Moved                                     = GetEntities(LastChunk)[LastRow];
+        GetEntities(Location.Chunk)[Location.Row] = Moved;
+    }
+
+    --EntityCount;
+    if (--LastChunk->Count == 0) {
+        Chunks.pop_back();
+        FreeChunk(LastChunk);
+    }
+    return Moved;
+}
+
+void FArchetype::RelocateRowFrom(const FArchetype &Src, const FEntityLocation &SrcLocation,
+                                 const FEntityLocation &DstLocation) const {
+    for (const FColumn &SrcColumn: Src.Columns) {
+        if (SrcColumn.Size == 0) {
+            continue;
+        }
+        void       *SrcCell   = Src.GetCell(SrcLocation.Chunk, SrcLocation.Row, SrcColumn);
+        const int32 DstColumn = GetColumn(SrcColumn.TypeId);
+        if (DstColumn >= 0) {
+            void *DstCell = GetCell(DstLocation.Chunk, DstLocation.Row, Columns[DstColumn]);
+            SrcColumn.Info->Relocate(DstCell, SrcCell);
+        } else {
+            SrcColumn.Info->Destruct(SrcCell);
+        }
+    }
+}
+
+FChunk *FArchetype::AllocateChunk() {
+    FChunk *Chunk    = new (FChunkAllocator::Allocate()) FChunk();
+    Chunk->Archetype = this;
+    return Chunk;
+}
+
+void FArchetype::FreeChunk(FChunk *Chunk) {
+    Chunk->~FChunk();
+    FChunkAllocator::Free(Chunk);
+}
+} // namespace TE::ECS
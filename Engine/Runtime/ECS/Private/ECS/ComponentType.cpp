@@ -0,0 +1,46 @@
+/******************************************************
+ * @file ECS/ComponentType.cpp
+ * @brief
+ *****************************************************/
+
+#include "ECS/ComponentType.hpp"
+#include "DebugUtils/CoreDebug.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace TE::ECS {
+namespace {
+// 定长数组: 注册时只追加, 读取已发布的 Id 无需加锁
+struct FRegistryStorage {
+    std::mutex                                        Mutex;
+    std::array<FComponentTypeInfo, MaxComponentTypes> Infos;
+    std::atomic<uint32>                               Count{ 0 };
+};
+
+FRegistryStorage &GetStorage() {
+    static FRegistryStorage Storage;
+    return Storage;
+}
+} // namespace
+
+FComponentTypeId FComponentRegistry::Register(const FComponentTypeInfo &Info) {
+    FRegistryStorage           &Storage = GetStorage();
+    std::lock_guard<std::mutex> Lock(Storage.Mutex);
+    const uint32                TypeId = Storage.Count.load(std::memory_order_relaxed);
+    check(TypeId < MaxComponentTypes);
+    Storage.Infos[TypeId] = Info;
+    Storage.Count.store(TypeId + 1, std::memory_order_release);
+    return TypeId;
+}
+
+const FComponentTypeInfo &FComponentRegistry::Get(FComponentTypeId TypeId) {
+    check(TypeId < Num());
+    return GetStorage().Infos[TypeId];
+}
+
+uint32 FComponentRegistry::Num() {
+    return GetStorage().Count.load(std::memory_order_acquire);
+}
+} // namespace TE::ECS
@@ -0,0 +1,107 @@
+/******************************************************
+ * @file ECS/SystemScheduler.cpp
+ * @brief
+ *****************************************************/
+
+#include "ECS/SystemScheduler.hpp"
+#include "Tasks/Tasks.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace TE::ECS {
+void FSystemScheduler::BuildGraph() {
+    constexpr uint32 None = ~0u;
+
+    // 每个组件: 最近的写者, 以及该写者之后的读者
+    std::array<uint32, MaxComponentTypes>              LastWriter;
+    std::array<std::vector<uint32>, MaxComponentTypes> ReadersSinceWrite;
+    LastWriter.fill(None);
+    // 独占系统: 最近一个独占系统, 以及它之后的所有系统
+    uint32              LastExclusive = None;
+    std::vector<uint32> SinceExclusive;
+
+    Prerequisites.assign(Systems.size(), {});
+    for (uint32 Index = 0; Index < Systems.size(); ++Index) {
+        const FSystemAccess &Access = Systems[Index]->GetAccess();
+        std::vector<uint32> &Deps   = Prerequisites[Index];
+
+        if (Access.IsExclusive()) {
+            Deps = SinceExclusive;
+            if (LastExclusive != None) {
+                Deps.push_back(LastExclusive);
+            }
+        } else {
+            if (LastExclusive != None) {
+                Deps.push_back(LastExclusive);
+            }
+            for (FComponentTypeId TypeId = 0; TypeId < MaxComponentTypes; ++TypeId) {
+                const bool bReads  = Access.GetReads().test(TypeId);
+                const bool bWrites = Access.GetWrites().test(TypeId);
+                if (!bReads && !bWrites) {
+                    continue;
+                }
+                if (LastWriter[TypeId] != None) {
+                    Deps.push_back(LastWriter[TypeId]);
+                }
+                if (bWrites) {
+                    Deps.insert(Deps.end(), ReadersSinceWrite[TypeId].begin(),
+                                ReadersSinceWrite[TypeId].end());
+                }
+            }
+        }
+        std::sort(Deps.begin(), Deps.end());
+        Deps.erase(std::unique(Deps.begin(), Deps.end()), Deps.end());
+        std::erase(Deps, Index);
+
+        // 更新各组件的读写记录
+        if (Access.IsExclusive()) {
+            LastExclusive = Index;
+            SinceExclusive.clear();
+            LastWriter.fill(None);
+            for (auto &Readers: ReadersSinceWrite) {
+                Readers.clear();
+            }
+            continue;
+        }
+        SinceExclusive.push_back(Index);
+        for (FComponentTypeId TypeId = 0; TypeId < MaxComponentTypes; ++TypeId) {
+            if (Access.GetWrites().test(TypeId)) {
+                LastWriter[TypeId] = Index;
+                ReadersSinceWrite[TypeId].clear();
+            } else if (Access.GetReads().test(TypeId)) {
+                ReadersSinceWrite[TypeId].push_back(Index);
+            }
+        }
+    }
+    bGraphDirty = false;
+}
+
+const std::vector<uint32> &FSystemScheduler::GetPrerequisites(uint32 SystemIndex) {
+    if (bGraphDirty) {
+        BuildGraph();
+    }
+    return Prerequisites[SystemIndex];
+}
+
+void FSystemScheduler::Update(FWorld &World, float DeltaTime) {
+    if (bGraphDirty) {
+        BuildGraph();
+    }
+
+    std::vector<Tasks::TTask<void>> SystemTasks;
+    SystemTasks.reserve(Systems.size());
+    std::vector<Tasks::TTask<void>> SystemPrerequisites;
+    for (uint32 Index = 0; Index < Systems.size(); ++Index) {
+        FSystem *System = Systems[Index].get();
+        SystemPrerequisites.clear();
+        for (uint32 Prerequisite: Prerequisites[Index]) {
+            SystemPrerequisites.push_back(SystemTasks[Prerequisite]);
+        }
+        SystemTasks.push_back(Tasks::Launch(
+            System->GetName(), [System, &World, DeltaTime] { System->Update(World, DeltaTime); },
+            SystemPrerequisites));
+    }
+    Tasks::Wait(SystemTasks);
+}
+} // namespace TE::ECS
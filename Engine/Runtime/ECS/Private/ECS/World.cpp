@@ -0,0 +1,127 @@
+/******************************************************
+ * @file ECS/World.cpp
+ * @brief
+ *****************************************************/
+
+#include "ECS/World.hpp"
+
+#include <atomic>
+
+namespace TE::ECS {
+namespace {
+std::atomic<uint64> GNextWorldId{ 1 };
+} // namespace
+
+FWorld::FWorld() : Id(GNextWorldId.fetch_add(1, std::memory_order_relaxed)) {
+    EmptyArchetype = GetOrCreateArchetype(FComponentMask());
+}
+
+FWorld::~FWorld() = default;
+
+FEntity FWorld::AllocateEntity() {
+    FEntity Entity;
+    if (!FreeIndices.empty()) {
+        Entity.Index = FreeIndices.back();
+        FreeIndices.pop_back();
+    } else {
+        Entity.Index = uint32(Records.size());
+        Records.emplace_back();
+    }
+    Entity.Generation = Records[Entity.Index].Generation;
+    ++NumAlive;
+    return Entity;
+}
+
+FEntity FWorld::CreateEntity() {
+    FEntity        Entity = AllocateEntity();
+    FEntityRecord &Record = Records[Entity.Index];
+    Record.Archetype      = EmptyArchetype;
+    Record.Location       = EmptyArchetype->AllocateRow(Entity);
+    return Entity;
+}
+
+void FWorld::DestroyEntity(FEntity Entity) {
+    if (!IsAlive(Entity)) {
+        return;
+    }
+    FEntityRecord &Record = Records[Entity.Index];
+    FEntity        Moved  = Record.Archetype->RemoveRow(Record.Location, /*bDestruct=*/true);
+    if (!Moved.IsNull()) {
+        PatchMovedEntity(Moved, Record.Location);
+    }
+    Record.Archetype = nullptr;
+    Record.Location  = {};
+    ++Record.Generation;
+    FreeIndices.push_back(Entity.Index);
+    --NumAlive;
+}
+
+FArchetype *FWorld::GetOrCreateArchetype(const FComponentMask &Mask) {
+    auto It = ArchetypeMap.find(Mask);
+    if (It != ArchetypeMap.end()) {
+        return It->second.get();
+    }
+    auto        NewArchetype = std::make_unique<FArchetype>(Mask, uint32(Archetypes.size()));
+    FArchetype *Archetype    = NewArchetype.get();
+    ArchetypeMap.emplace(Mask, std::move(NewArchetype));
+    Archetypes.push_back(Archetype);
+    return Archetype;
+}
+
+FArchetype *FWorld::GetArchetypeWith(FArchetype *Archetype, FComponentTypeId TypeId) {
+    if (FArchetype *Target = Archetype->GetAddEdge(TypeId)) {
+        return Target;
+    }
+    FComponentMask Mask = Archetype->GetMask();
+    Mask.set(TypeId);
+    FArchetype *Target = GetOrCreateArchetype(Mask);
+    // 边是双向的: A + T = B 意味着 B - T = A
+    Archetype->SetAddEdge(TypeId, Target);
+    Target->SetRemoveEdge(TypeId, Archetype);
+    return Target;
+}
+
+FArchetype *FWorld::GetArchetypeWithout(FArchetype *Archetype, FComponentTypeId TypeId) {
+    if (FArchetype *Target = Archetype->GetRemoveEdge(TypeId)) {
+        return Target;
+    }
+    FComponentMask Mask = Archetype->GetMask();
+    Mask.reset(TypeId);
+    FArchetype *Target = GetOrCreateArchetype(Mask);
+    Archetype->SetRemoveEdge(TypeId, Target);
+    Target->SetAddEdge(TypeId, Archetype);
+    return Target;
+}
+
+void FWorld::MoveEntity(FEntity Entity, FEntityRecord &Record, FArchetype *Target) {
+    FArchetype           *Source         = Record.Archetype;
+    const FEntityLocation SourceLocation = Record.Location;
+    const FEntityLocation TargetLocation = Target->AllocateRow(Entity);
+    Target->RelocateRowFrom(*Source, SourceLocation, TargetLocation);
+
+    FEntity Moved = Source->RemoveRow(SourceLocation, /*bDestruct=*/false);
+    if (!Moved.IsNull()) {
+        PatchMovedEntity(Moved, SourceLocation);
+    }
+    Record.Archetype = Target;
+    Record.Location  = TargetLocation;
+}
+
+void FWorld::PatchMovedEntity(FEntity Moved, const FEntityLocation &Location) {
+    Records[Moved.Index].Location = Location;
+}
+
+const std::vector<FArchetype *> &FWorld::GetMatchingArchetypes(FQuery &Query) const {
+    if (Query.CachedWorldId != Id) {
+        Query.ResetCache();
+        Query.CachedWorldId = Id;
+    }
+    for (; Query.NumArchetypesSeen < Archetypes.size(); ++Query.NumArchetypesSeen) {
+        FArchetype *Archetype = Archetypes[Query.NumArchetypesSeen];
+        if (Query.Matches(Archetype->GetMask())) {
+            Query.MatchedArchetypes.push_back(Archetype);
+        }
+    }
+    return Query.MatchedArchetypes;
+}
+} // namespace TE::ECS
@@ -0,0 +1,158 @@
+/******************************************************
+ * @file ECS/Archetype.hpp
+ * @brief Archetype 与 16 KB 数据块
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "ECS/ComponentType.hpp"
+#include "ECS/ECSTypes.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace TE::ECS {
+class FArchetype;
+
+// 一个 16 KB 的数据块, 块头之后依次是实体数组和各组件数组 (SoA):
+// [FChunk][FEntity x Capacity][Component0 x Capacity][Component1 x Capacity]...
+// 同一 Archetype 的所有块布局相同, 遍历时每个组件数组都是连续内存
+struct alignas(ChunkAlignment) FChunk {
+    FArchetype *Archetype = nullptr;
+    uint32      Count     = 0;
+
+    std::byte *GetData() { return reinterpret_cast<std::byte *>(this); }
+};
+
+// 实体在 Archetype 中的位置
+struct FEntityLocation {
+    FChunk *Chunk = nullptr;
+    uint32  Row   = 0;
+};
+
+// 拥有相同组件集合的所有实体
+// 块按顺序填满, 只有最后一块可能不满; 删除时用最后一行填补空位, 保持所有块紧凑
+// 每个 Archetype 记录 "加/减一个组件" 之后的目标 Archetype (边), 组件增删时无需重新查表
+class FArchetype {
+  public:
+    FArchetype(const FComponentMask &InMask, uint32 InIndex);
+    ~FArchetype();
+
+    FArchetype(const FArchetype &)            = delete;
+    FArchetype &operator=(const FArchetype &) = delete;
+
+    // ============== Layout ==============
+    const FComponentMask &GetMask() const { return Mask; }
+
+    // 在 FWorld 中的创建顺序, 查询缓存据此增量更新
+    uint32 GetIndex() const { return Index; }
+
+    uint32 GetChunkCapacity() const { return ChunkCapacity; }
+
+    bool HasComponent(FComponentTypeId TypeId) const { return Mask.test(TypeId); }
+
+    // 组件在本 Archetype 中的列号, 不存在时返回 -1
+    int32 GetColumn(FComponentTypeId TypeId) const { return ColumnOf[TypeId]; }
+
+    // 组件数组在块内的起始地址; 标签组件返回 nullptr
+    void *GetColumnData(FChunk *Chunk, int32 Column) const {
+        return Columns[Column].Size ? Chunk->GetData() + Columns[Column].Offset : nullptr;
+    }
+
+    void *GetComponent(const FEntityLocation &Location, FComponentTypeId TypeId) const {
+        const int32 Column = GetColumn(TypeId);
+        check(Column >= 0);
+        const FColumn &Info = Columns[Column];
+        return Info.Size ? GetCell(Location.Chunk, Location.Row, Info) : nullptr;
+    }
+
+    FEntity *GetEntities(FChunk *Chunk) const {
+        return reinterpret_cast<FEntity *>(Chunk->GetData() + EntitiesOffset);
+    }
+
+    // ============== Storage ==============
+    const std::vector<FChunk *> &GetChunks() const { return Chunks; }
+
+    uint32 Num() const { return EntityCount; }
+
+    // 在末尾分配一行并写入实体, 组件存储保持未初始化
+    FEntityLocation AllocateRow(FEntity Entity);
+
+    // 删除一行: bDestruct 为 true 时析构该行所有组件, 否则认为组件已被搬走;
+    // 用最后一行填补空位, 返回被搬到该位置的实体 (空位本身就是最后一行时返回空实体)
+    FEntity RemoveRow(const FEntityLocation &Location, bool bDestruct);
+
+    // 把 Src 行中两边都有的组件搬到本 Archetype 的 Dst 行, Src 独有的组件被析构
+    void RelocateRowFrom(const FArchetype &Src, const FEntityLocation &SrcLocation,
+                         const FEntityLocation &DstLocation) const;
+
+    // ============== Edges ==============
+    FArchetype *GetAddEdge(FComponentTypeId TypeId) const {
+        const FEdge *Edge = FindEdge(TypeId);
+        return Edge ? Edge->Add : nullptr;
+    }
+    FArchetype *GetRemoveEdge(FComponentTypeId TypeId) const {
+        const FEdge *Edge = FindEdge(TypeId);
+        return Edge ? Edge->Remove : nullptr;
+    }
+
+    void SetAddEdge(FComponentTypeId TypeId, FArchetype *Target) {
+        FindOrAddEdge(TypeId).Add = Target;
+    }
+    void SetRemoveEdge(FComponentTypeId TypeId, FArchetype *Target) {
+        FindOrAddEdge(TypeId).Remove = Target;
+    }
+
+  private:
+    struct FColumn {
+        FComponentTypeId          TypeId;
+        uint32                    Offset; // 组件数组在块内的偏移
+        uint32                    Size;
+        const FComponentTypeInfo *Info;
+    };
+
+    // 加/减同一个组件的两条边放在一起; 一个 Archetype 实际用到的边很少, 线性查找即可
+    struct FEdge {
+        FComponentTypeId TypeId;
+        FArchetype      *Add    = nullptr;
+        FArchetype      *Remove = nullptr;
+    };
+
+    const FEdge *FindEdge(FComponentTypeId TypeId) const {
+        for (const FEdge &Edge: Edges) {
+            if (Edge.TypeId == TypeId) {
+                return &Edge;
+            }
+        }
+        return nullptr;
+    }
+
+    FEdge &FindOrAddEdge(FComponentTypeId TypeId) {
+        for (FEdge &Edge: Edges) {
+            if (Edge.TypeId == TypeId) {
+                return Edge;
+            }
+        }
+        return Edges.emplace_back(FEdge{ TypeId });
+    }
+
+    void *GetCell(FChunk *InChunk, uint32 Row, const FColumn &Column) const {
+        return InChunk->GetData() + Column.Offset + std::size_t(Row) * Column.Size;
+    }
+
+    FChunk *AllocateChunk();
+    void    FreeChunk(FChunk *InChunk);
+
+    FComponentMask            Mask;
+    uint32                    Index;
+    uint32                    ChunkCapacity  = 0;
+    uint32                    EntitiesOffset = 0;
+    uint32                    EntityCount    = 0;
+    std::vector<FColumn>      Columns;
+    std::vector<int16>        ColumnOf;
+    std::vector<FChunk *>     Chunks;
+    std::vector<FEdge>        Edges;
+};
+} // namespace TE::ECS
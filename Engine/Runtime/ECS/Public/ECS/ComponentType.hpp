@@ -0,0 +1,72 @@
+/******************************************************
+ * @file ECS/ComponentType.hpp
+ * @brief 组件类型注册表
+ *****************************************************/
+
+#pragma once
+
+#include "ECS/ECSTypes.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace TE::ECS {
+// 类型擦除后的组件操作, Archetype 在块之间搬移组件时使用
+struct FComponentTypeInfo {
+    const char *Name      = nullptr;
+    uint32      Size      = 0; // 空类型 (标签组件) 为 0, 不占用块内存储
+    uint32      Alignment = 1;
+
+    void (*DefaultConstruct)(void *Dst)    = nullptr;
+    // 移动构造到 Dst 并析构 Src
+    void (*Relocate)(void *Dst, void *Src) = nullptr;
+    void (*Destruct)(void *Ptr)            = nullptr;
+};
+
+// 全局组件类型表; 组件 Id 按第一次使用的顺序分配, 进程内稳定
+class FComponentRegistry {
+  public:
+    static FComponentTypeId Register(const FComponentTypeInfo &Info);
+
+    static const FComponentTypeInfo &Get(FComponentTypeId TypeId);
+
+    static uint32 Num();
+};
+
+template <typename T> FComponentTypeInfo MakeComponentTypeInfo() {
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "ECS components must be nothrow move constructible");
+    static_assert(alignof(T) <= ChunkAlignment, "ECS component alignment too large");
+
+    FComponentTypeInfo Info;
+    Info.Name      = typeid(T).name();
+    Info.Size      = std::is_empty_v<T> ? 0 : uint32(sizeof(T));
+    Info.Alignment = uint32(alignof(T));
+    if constexpr (std::is_default_constructible_v<T>) {
+        Info.DefaultConstruct = [](void *Dst) { new (Dst) T(); };
+    }
+    Info.Relocate = [](void *Dst, void *Src) {
+        T *SrcComponent = static_cast<T *>(Src);
+        new (Dst) T(std::move(*SrcComponent));
+        SrcComponent->~T();
+    };
+    Info.Destruct = [](void *Ptr) { static_cast<T *>(Ptr)->~T(); };
+    return Info;
+}
+
+// 组件类型的 Id, 第一次调用时注册 (线程安全)
+template <typename T> FComponentTypeId GetComponentTypeId() {
+    static const FComponentTypeId TypeId =
+        FComponentRegistry::Register(MakeComponentTypeInfo<std::remove_cvref_t<T>>());
+    return TypeId;
+}
+
+template <typename... Ts> FComponentMask MakeComponentMask() {
+    FComponentMask Mask;
+    (Mask.set(GetComponentTypeId<Ts>()), ...);
+    return Mask;
+}
+} // namespace TE::ECS
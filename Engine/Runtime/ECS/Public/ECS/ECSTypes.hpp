@@ -0,0 +1,49 @@
+/******************************************************
+ * @file ECS/ECSTypes.hpp
+ * @brief ECS 基础类型: 实体句柄、组件类型 ID、组件签名
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <functional>
+
+namespace TE::ECS {
+// 组件类型数量上限, 决定组件签名的位数
+inline constexpr uint32 MaxComponentTypes = 256;
+
+// 每个 Archetype 块的大小, 组件以 SoA 方式排布在块内
+inline constexpr std::size_t ChunkSize = 16 * 1024;
+
+// 块内组件数组的对齐, 同时也是组件类型允许的最大对齐
+inline constexpr std::size_t ChunkAlignment = 64;
+
+using FComponentTypeId = uint32;
+
+// 组件签名: 第 i 位表示实体拥有 Id 为 i 的组件
+using FComponentMask = std::bitset<MaxComponentTypes>;
+
+// 实体句柄 = 槽位下标 + 代数
+// 实体销毁后槽位被复用时代数加一, 旧句柄因此自动失效
+struct FEntity {
+    static constexpr uint32 InvalidIndex = ~0u;
+
+    uint32 Index      = InvalidIndex;
+    uint32 Generation = 0;
+
+    bool IsNull() const { return Index == InvalidIndex; }
+
+    uint64 ToBits() const { return (uint64(Generation) << 32) | Index; }
+
+    bool operator==(const FEntity &) const = default;
+};
+} // namespace TE::ECS
+
+template <> struct std::hash<TE::ECS::FEntity> {
+    std::size_t operator()(const TE::ECS::FEntity &Entity) const noexcept {
+        return std::hash<uint64>()(Entity.ToBits());
+    }
+};
@@ -0,0 +1,91 @@
+/******************************************************
+ * @file ECS/ParallelQuery.hpp
+ * @brief 把查询匹配的块分给线程池并行处理
+ *****************************************************/
+
+#pragma once
+
+#include "Async/ManualResetEvent.hpp"
+#include "ECS/Query.hpp"
+#include "ECS/World.hpp"
+#include "Memory/RefCounting.hpp"
+#include "Thread/ThreadPool.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace TE::ECS {
+namespace Private {
+// 一次并行遍历的共享状态; 辅助任务可能在遍历结束之后才开始执行, 因此用引用计数管理
+template <typename FuncType> struct TParallelChunkState : FRefCountBase {
+    TParallelChunkState(std::vector<FChunkView> &&InChunks, FuncType &InFunc)
+        : Chunks(std::move(InChunks)), Func(InFunc) {}
+
+    // 领取块直到领完; 处理完最后一块的线程负责通知调用方
+    void Work() {
+        const uint32 Count = uint32(Chunks.size());
+        uint32       Done  = 0;
+        for (uint32 Index = NextChunk.fetch_add(1, std::memory_order_relaxed); Index < Count;
+             Index        = NextChunk.fetch_add(1, std::memory_order_relaxed)) {
+            Func(Chunks[Index]);
+            ++Done;
+        }
+        if (Done != 0 &&
+            FinishedChunks.fetch_add(Done, std::memory_order_acq_rel) + Done == Count) {
+            AllDone.Notify();
+        }
+    }
+
+    std::vector<FChunkView> Chunks;
+    FuncType               &Func;
+    std::atomic<uint32>     NextChunk{ 0 };
+    std::atomic<uint32>     FinishedChunks{ 0 };
+    FManualResetEvent       AllDone;
+};
+} // namespace Private
+
+// 对查询匹配的每个非空块调用 Func(const FChunkView &), 块之间并行
+// 调用线程也参与处理, 只等待已被其他线程领走的块, 不会等待尚未开始执行的辅助任务,
+// 因此可以在线程池的工作线程 (例如系统的 Update) 中安全调用.
+// Func 会被多个线程同时调用, 各块之间的写入不能重叠; 遍历期间不能进行结构性修改.
+template <typename FuncType>
+void ParallelForEachChunk(FWorld &World, FQuery &Query, FuncType &&Func) {
+    std::vector<FChunkView> Chunks;
+    for (FArchetype *Archetype: World.GetMatchingArchetypes(Query)) {
+        for (FChunk *Chunk: Archetype->GetChunks()) {
+            Chunks.emplace_back(Archetype, Chunk);
+        }
+    }
+    if (Chunks.empty()) {
+        return;
+    }
+    if (Chunks.size() == 1) {
+        Func(Chunks[0]);
+        return;
+    }
+
+    using FState = Private::TParallelChunkState<std::remove_reference_t<FuncType>>;
+    ThreadPool          &Pool = ThreadPool::global();
+    const uint32         HelperCount =
+        uint32(std::min<std::size_t>(Chunks.size() - 1, std::size_t(Pool.threadCount())));
+    TRefCountPtr<FState> State = MakeRefCount<FState>(std::move(Chunks), Func);
+    for (uint32 Helper = 0; Helper < HelperCount; ++Helper) {
+        Pool.submit([State]() { State->Work(); });
+    }
+    State->Work();
+    State->AllDone.Wait();
+}
+
+// 对每个同时拥有 ComponentTypes 的实体并行调用 Func(ComponentTypes &...)
+// 或 Func(FEntity, ComponentTypes &...), 以块为单位分配给工作线程
+template <typename... ComponentTypes, typename FuncType>
+void ParallelEach(FWorld &World, FuncType &&Func) {
+    FQuery Query;
+    Query.With<ComponentTypes...>();
+    ParallelForEachChunk(World, Query, [&Func](const FChunkView &View) {
+        FWorld::EachInChunk<ComponentTypes...>(View, Func);
+    });
+}
+} // namespace TE::ECS
@@ -0,0 +1,95 @@
+/******************************************************
+ * @file ECS/Query.hpp
+ * @brief 按组件签名匹配 Archetype 的查询, 以及块的访问视图
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "ECS/Archetype.hpp"
+#include "ECS/ComponentType.hpp"
+#include "ECS/ECSTypes.hpp"
+
+#include <vector>
+
+namespace TE::ECS {
+class FWorld;
+
+// 匹配 "包含 All 中所有组件、且不包含 None 中任何组件" 的 Archetype
+//
+// 匹配结果缓存在查询对象中, 只对新创建的 Archetype 增量检查; 修改条件或换一个 World
+// 查询时缓存重建. 遍历会更新缓存, 同一个查询对象不能在多个线程上同时使用,
+// 并行的系统各自持有自己的查询
+class FQuery {
+  public:
+    template <typename... Ts> FQuery &With() {
+        All |= MakeComponentMask<Ts...>();
+        ResetCache();
+        return *this;
+    }
+
+    template <typename... Ts> FQuery &Without() {
+        None |= MakeComponentMask<Ts...>();
+        ResetCache();
+        return *this;
+    }
+
+    bool Matches(const FComponentMask &Mask) const {
+        return (Mask & All) == All && (Mask & None).none();
+    }
+
+    const FComponentMask &GetAll() const { return All; }
+    const FComponentMask &GetNone() const { return None; }
+
+  private:
+    friend class FWorld;
+
+    void ResetCache() {
+        CachedWorldId     = 0;
+        NumArchetypesSeen = 0;
+        MatchedArchetypes.clear();
+    }
+
+    FComponentMask All;
+    FComponentMask None;
+
+    // 缓存: 属于哪个 World (FWorld::GetId, 0 表示无), 已检查过的 Archetype 数量, 匹配的 Archetype
+    uint64                    CachedWorldId     = 0;
+    uint32                    NumArchetypesSeen = 0;
+    std::vector<FArchetype *> MatchedArchetypes;
+};
+
+// 一个块的只读结构视图; 通过 Get<T>() 拿到组件数组后可以按下标直接读写
+class FChunkView {
+  public:
+    FChunkView(FArchetype *InArchetype, FChunk *InChunk) : Archetype(InArchetype), Chunk(InChunk) {}
+
+    uint32 Num() const { return Chunk->Count; }
+
+    const FEntity *GetEntities() const { return Archetype->GetEntities(Chunk); }
+
+    template <typename T> bool Has() const {
+        return Archetype->HasComponent(GetComponentTypeId<T>());
+    }
+
+    // 组件数组, 长度为 Num(); 组件必须存在
+    template <typename T> T *Get() const {
+        const int32 Column = Archetype->GetColumn(GetComponentTypeId<T>());
+        check(Column >= 0);
+        return static_cast<T *>(Archetype->GetColumnData(Chunk, Column));
+    }
+
+    // 组件不存在时返回 nullptr
+    template <typename T> T *TryGet() const {
+        const int32 Column = Archetype->GetColumn(GetComponentTypeId<T>());
+        return Column >= 0 ? static_cast<T *>(Archetype->GetColumnData(Chunk, Column)) : nullptr;
+    }
+
+    FArchetype *GetArchetype() const { return Archetype; }
+    FChunk     *GetChunk() const { return Chunk; }
+
+  private:
+    FArchetype *Archetype;
+    FChunk     *Chunk;
+};
+} // namespace TE::ECS
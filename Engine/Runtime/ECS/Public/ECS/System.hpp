@@ -0,0 +1,66 @@
+/******************************************************
+ * @file ECS/System.hpp
+ * @brief 系统基类与组件访问声明
+ *****************************************************/
+
+#pragma once
+
+#include "ECS/ComponentType.hpp"
+#include "ECS/ECSTypes.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+namespace TE::ECS {
+class FWorld;
+
+// 系统对组件的读写声明, 调度器据此判断两个系统能否并行
+// 读-读不冲突; 任一方写同一组件即冲突; Exclusive 系统与所有系统冲突
+class FSystemAccess {
+  public:
+    template <typename... Ts> FSystemAccess &Read() {
+        Reads |= MakeComponentMask<Ts...>();
+        return *this;
+    }
+
+    template <typename... Ts> FSystemAccess &Write() {
+        Writes |= MakeComponentMask<Ts...>();
+        return *this;
+    }
+
+    // 会创建/销毁实体或增删组件的系统必须声明为独占, 结构性修改不能与任何遍历并行
+    FSystemAccess &Exclusive() {
+        bExclusive = true;
+        return *this;
+    }
+
+    const FComponentMask &GetReads() const { return Reads; }
+    const FComponentMask &GetWrites() const { return Writes; }
+    bool                  IsExclusive() const { return bExclusive; }
+
+  private:
+    FComponentMask Reads;
+    FComponentMask Writes;
+    bool           bExclusive = false;
+};
+
+// 系统基类: 子类在构造函数中通过 Access 声明读写的组件, 在 Update 中遍历 World
+class FSystem {
+  public:
+    explicit FSystem(const TCHAR *InName) : Name(InName) {}
+    virtual ~FSystem() = default;
+
+    FSystem(const FSystem &)            = delete;
+    FSystem &operator=(const FSystem &) = delete;
+
+    // 可能在任意工作线程上调用, 只能访问 Access 中声明过的组件
+    virtual void Update(FWorld &World, float DeltaTime) = 0;
+
+    const FSystemAccess &GetAccess() const { return Access; }
+    const TCHAR         *GetName() const { return Name; }
+
+  protected:
+    FSystemAccess Access;
+
+  private:
+    const TCHAR *Name;
+};
+} // namespace TE::ECS
@@ -0,0 +1,45 @@
+/******************************************************
+ * @file ECS/SystemScheduler.hpp
+ * @brief 按组件读写关系并行调度系统
+ *****************************************************/
+
+#pragma once
+
+#include "ECS/System.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace TE::ECS {
+// 每帧把系统按注册顺序展开成一张任务图:
+// 系统只依赖于在它之前注册、且与它访问冲突的系统, 互不冲突的系统在线程池上并行执行.
+// 对同一组件的依赖只连到最近的写者和此后的读者, 图中的边数与组件数而不是系统数的平方成正比.
+// 结果与按注册顺序串行执行完全一致.
+class FSystemScheduler {
+  public:
+    template <typename SystemType, typename... ArgTypes> SystemType &AddSystem(ArgTypes &&...Args) {
+        auto        System = std::make_unique<SystemType>(std::forward<ArgTypes>(Args)...);
+        SystemType &Result = *System;
+        Systems.push_back(std::move(System));
+        bGraphDirty = true;
+        return Result;
+    }
+
+    // 执行所有系统一次, 返回时全部执行完毕; 调用线程不能是线程池的工作线程
+    void Update(FWorld &World, float DeltaTime);
+
+    uint32 NumSystems() const { return uint32(Systems.size()); }
+
+    // 第 SystemIndex 个系统直接依赖的系统下标, 用于调试与测试
+    const std::vector<uint32> &GetPrerequisites(uint32 SystemIndex);
+
+  private:
+    void BuildGraph();
+
+    std::vector<std::unique_ptr<FSystem>> Systems;
+    std::vector<std::vector<uint32>>      Prerequisites;
+    bool                                  bGraphDirty = true;
+};
+} // namespace TE::ECS
@@ -0,0 +1,210 @@
+/******************************************************
+ * @file ECS/World.hpp
+ * @brief ECS 对外接口: 实体、组件与遍历
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "ECS/Archetype.hpp"
+#include "ECS/ComponentType.hpp"
+#include "ECS/ECSTypes.hpp"
+#include "ECS/Query.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "TypeUtils/Invoke.hpp"
+
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace TE::ECS {
+// 基于 Archetype 的 ECS 世界
+//
+// 拥有相同组件集合的实体存放在同一个 Archetype 的 16 KB 块中, 每个组件一段连续数组 (SoA);
+// 系统按块线性遍历, 访问组件不需要任何哈希查找. 实体句柄带代数, 销毁后旧句柄自动失效.
+// 增删组件时通过 Archetype 之间缓存的边找到目标 Archetype, 然后把该行搬过去.
+//
+// 结构性修改 (创建/销毁实体、增删组件) 会移动组件, 之前拿到的组件指针随之失效,
+// 不能在遍历过程中进行
+class FWorld {
+  public:
+    FWorld();
+    ~FWorld();
+
+    FWorld(const FWorld &)            = delete;
+    FWorld &operator=(const FWorld &) = delete;
+
+    // ============== Entities ==============
+    FEntity CreateEntity();
+
+    // 创建实体并一次性放入所有组件, 直接落到最终的 Archetype, 不经过中间搬移
+    template <typename... ComponentTypes> FEntity CreateEntity(ComponentTypes &&...Components) {
+        static_assert(sizeof...(ComponentTypes) > 0);
+        FArchetype *Archetype =
+            GetOrCreateArchetype(MakeComponentMask<std::remove_cvref_t<ComponentTypes>...>());
+        check(Archetype->GetMask().count() == sizeof...(ComponentTypes)); // 组件类型不能重复
+        FEntity               Entity   = AllocateEntity();
+        const FEntityLocation Location = Archetype->AllocateRow(Entity);
+        (ConstructComponent<std::remove_cvref_t<ComponentTypes>>(
+             Archetype, Location, Forward<ComponentTypes>(Components)),
+         ...);
+        FEntityRecord &Record = Records[Entity.Index];
+        Record.Archetype      = Archetype;
+        Record.Location       = Location;
+        return Entity;
+    }
+
+    void DestroyEntity(FEntity Entity);
+
+    bool IsAlive(FEntity Entity) const {
+        return Entity.Index < Records.size() && Records[Entity.Index].Archetype &&
+               Records[Entity.Index].Generation == Entity.Generation;
+    }
+
+    uint32 NumEntities() const { return NumAlive; }
+
+    // ============== Components ==============
+    // 添加组件并返回它; 已经存在时用新值覆盖
+    template <typename T, typename... ArgTypes>
+    T &AddComponent(FEntity Entity, ArgTypes &&...Args) {
+        const FComponentTypeId TypeId = GetComponentTypeId<T>();
+        FEntityRecord         &Record = GetRecord(Entity);
+        if (Record.Archetype->HasComponent(TypeId)) {
+            if constexpr (std::is_empty_v<T>) {
+                return *ConstructComponent<T>(Record.Archetype, Record.Location);
+            } else {
+                T *Component =
+                    static_cast<T *>(Record.Archetype->GetComponent(Record.Location, TypeId));
+                *Component = T(Forward<ArgTypes>(Args)...);
+                return *Component;
+            }
+        }
+        MoveEntity(Entity, Record, GetArchetypeWith(Record.Archetype, TypeId));
+        return *ConstructComponent<T>(Record.Archetype, Record.Location,
+                                      Forward<ArgTypes>(Args)...);
+    }
+
+    template <typename T> void RemoveComponent(FEntity Entity) {
+        const FComponentTypeId TypeId = GetComponentTypeId<T>();
+        FEntityRecord         &Record = GetRecord(Entity);
+        if (Record.Archetype->HasComponent(TypeId)) {
+            MoveEntity(Entity, Record, GetArchetypeWithout(Record.Archetype, TypeId));
+        }
+    }
+
+    template <typename T> bool HasComponent(FEntity Entity) const {
+        return IsAlive(Entity) &&
+               Records[Entity.Index].Archetype->HasComponent(GetComponentTypeId<T>());
+    }
+
+    // 组件不存在时返回 nullptr; 标签组件 (空类型) 没有存储, 请用 HasComponent
+    template <typename T> T *GetComponent(FEntity Entity) {
+        static_assert(!std::is_empty_v<T>, "Tag components have no storage");
+        const FComponentTypeId TypeId = GetComponentTypeId<T>();
+        if (!IsAlive(Entity)) {
+            return nullptr;
+        }
+        const FEntityRecord &Record = Records[Entity.Index];
+        return Record.Archetype->HasComponent(TypeId)
+                   ? static_cast<T *>(Record.Archetype->GetComponent(Record.Location, TypeId))
+                   : nullptr;
+    }
+
+    // ============== Iteration ==============
+    // 与查询匹配的所有 Archetype (按创建顺序), 结果缓存在 Query 中;
+    // 新建的 Archetype 在下次调用时增量加入
+    const std::vector<FArchetype *> &GetMatchingArchetypes(FQuery &Query) const;
+
+    // 对每个匹配的非空块调用 Func(FChunkView)
+    template <typename FuncType> void ForEachChunk(FQuery &Query, FuncType &&Func) {
+        for (FArchetype *Archetype: GetMatchingArchetypes(Query)) {
+            for (FChunk *Chunk: Archetype->GetChunks()) {
+                Func(FChunkView(Archetype, Chunk));
+            }
+        }
+    }
+
+    // 对每个同时拥有 ComponentTypes 的实体调用 Func(ComponentTypes &...),
+    // 或者 Func(FEntity, ComponentTypes &...)
+    template <typename... ComponentTypes, typename FuncType> void Each(FuncType &&Func) {
+        static_assert((!std::is_empty_v<ComponentTypes> && ...),
+                      "Filter tag components with FQuery::With instead");
+        FQuery Query;
+        Query.With<ComponentTypes...>();
+        ForEachChunk(Query, [&Func](const FChunkView &View) {
+            EachInChunk<ComponentTypes...>(View, Func);
+        });
+    }
+
+    // 对单个块中的每个实体调用 Func, 供并行遍历等自行划分块的场合使用
+    template <typename... ComponentTypes, typename FuncType>
+    static void EachInChunk(const FChunkView &View, FuncType &Func) {
+        const uint32   Count    = View.Num();
+        const FEntity *Entities = View.GetEntities();
+        std::tuple<ComponentTypes *...> Arrays{ View.Get<ComponentTypes>()... };
+        for (uint32 Row = 0; Row < Count; ++Row) {
+            if constexpr (std::is_invocable_v<FuncType &, FEntity, ComponentTypes &...>) {
+                Func(Entities[Row], std::get<ComponentTypes *>(Arrays)[Row]...);
+            } else {
+                Func(std::get<ComponentTypes *>(Arrays)[Row]...);
+            }
+        }
+    }
+
+    uint32 NumArchetypes() const { return uint32(Archetypes.size()); }
+
+    // 进程内唯一且不复用的编号 (从 1 开始), 查询缓存据此区分 World;
+    // 地址可能被之后新建的 World 复用, 不能代替编号
+    uint64 GetId() const { return Id; }
+
+  private:
+    struct FEntityRecord {
+        FArchetype     *Archetype = nullptr; // 为空表示槽位空闲
+        FEntityLocation Location;
+        uint32          Generation = 0;
+    };
+
+    FEntityRecord &GetRecord(FEntity Entity) {
+        check(IsAlive(Entity));
+        return Records[Entity.Index];
+    }
+
+    template <typename T, typename... ArgTypes>
+    static T *ConstructComponent(FArchetype *Archetype, const FEntityLocation &Location,
+                                 ArgTypes &&...Args) {
+        if constexpr (std::is_empty_v<T>) {
+            // 标签组件不占存储, 返回一个共享的空对象
+            static T Tag;
+            return &Tag;
+        } else {
+            void *Storage = Archetype->GetComponent(Location, GetComponentTypeId<T>());
+            return new (Storage) T(Forward<ArgTypes>(Args)...);
+        }
+    }
+
+    // 分配实体槽位, 调用方负责填写 Archetype 和 Location
+    FEntity AllocateEntity();
+
+    FArchetype *GetOrCreateArchetype(const FComponentMask &Mask);
+    FArchetype *GetArchetypeWith(FArchetype *Archetype, FComponentTypeId TypeId);
+    FArchetype *GetArchetypeWithout(FArchetype *Archetype, FComponentTypeId TypeId);
+
+    // 把实体的行搬到 Target, 两边都有的组件被移动, Target 新增的组件保持未初始化
+    void MoveEntity(FEntity Entity, FEntityRecord &Record, FArchetype *Target);
+
+    // 某一行被删除后, 原来的最后一行搬到了空位上, 更新它的记录
+    void PatchMovedEntity(FEntity Moved, const FEntityLocation &Location);
+
+    uint64                     Id;
+    std::vector<FEntityRecord> Records;
+    std::vector<uint32>        FreeIndices;
+    uint32                     NumAlive = 0;
+
+    std::unordered_map<FComponentMask, std::unique_ptr<FArchetype>> ArchetypeMap;
+    std::vector<FArchetype *>                                       Archetypes;
+    FArchetype                                                     *EmptyArchetype = nullptr;
+};
+} // namespace TE::ECS
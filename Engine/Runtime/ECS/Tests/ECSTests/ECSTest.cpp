@@ -0,0 +1,238 @@
+/******************************************************
+ * @file ECSTests/ECSTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "ECS/World.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+using namespace TE::ECS;
+
+namespace {
+struct FPosition {
+    float X = 0, Y = 0, Z = 0;
+};
+
+struct FVelocity {
+    float X = 0, Y = 0, Z = 0;
+};
+
+struct FHealth {
+    int Value = 100;
+};
+
+// 标签组件
+struct FFrozen {};
+
+// 只可移动、带析构的组件, 检查搬移过程中没有泄漏或重复析构
+struct FOwned {
+    std::unique_ptr<int> Value;
+};
+} // namespace
+
+TEST(ECSTest, CreateAndDestroy) {
+    FWorld  World;
+    FEntity A = World.CreateEntity();
+    FEntity B = World.CreateEntity(FPosition{ 1, 2, 3 });
+    EXPECT_TRUE(World.IsAlive(A));
+    EXPECT_TRUE(World.IsAlive(B));
+    EXPECT_EQ(World.NumEntities(), 2u);
+    EXPECT_EQ(World.GetComponent<FPosition>(B)->Y, 2);
+    EXPECT_EQ(World.GetComponent<FPosition>(A), nullptr);
+
+    World.DestroyEntity(A);
+    EXPECT_FALSE(World.IsAlive(A));
+    EXPECT_EQ(World.NumEntities(), 1u);
+
+    // 槽位复用后代数不同, 旧句柄失效
+    FEntity C = World.CreateEntity();
+    EXPECT_EQ(C.Index, A.Index);
+    EXPECT_NE(C.Generation, A.Generation);
+    EXPECT_FALSE(World.IsAlive(A));
+    EXPECT_TRUE(World.IsAlive(C));
+    World.DestroyEntity(A); // 对失效句柄无效果
+    EXPECT_TRUE(World.IsAlive(C));
+}
+
+TEST(ECSTest, AddRemoveComponents) {
+    FWorld  World;
+    FEntity Entity = World.CreateEntity();
+    World.AddComponent<FPosition>(Entity, FPosition{ 1, 0, 0 });
+    World.AddComponent<FVelocity>(Entity, FVelocity{ 0, 1, 0 });
+    World.AddComponent<FFrozen>(Entity);
+    EXPECT_TRUE(World.HasComponent<FPosition>(Entity));
+    EXPECT_TRUE(World.HasComponent<FVelocity>(Entity));
+    EXPECT_TRUE(World.HasComponent<FFrozen>(Entity));
+    EXPECT_EQ(World.GetComponent<FPosition>(Entity)->X, 1);
+
+    // 覆盖已有组件
+    World.AddComponent<FPosition>(Entity, FPosition{ 5, 0, 0 });
+    EXPECT_EQ(World.GetComponent<FPosition>(Entity)->X, 5);
+
+    World.RemoveComponent<FPosition>(Entity);
+    EXPECT_FALSE(World.HasComponent<FPosition>(Entity));
+    EXPECT_EQ(World.GetComponent<FVelocity>(Entity)->Y, 1);
+
+    // 同样的增删路径复用已有的 Archetype
+    const uint32 NumArchetypes = World.NumArchetypes();
+    FEntity      Other         = World.CreateEntity();
+    World.AddComponent<FPosition>(Other);
+    World.AddComponent<FVelocity>(Other);
+    World.AddComponent<FFrozen>(Other);
+    World.RemoveComponent<FPosition>(Other);
+    EXPECT_EQ(World.NumArchetypes(), NumArchetypes);
+}
+
+// 跨越多个块的增删, 检查搬移后每个实体的数据仍然正确
+TEST(ECSTest, ManyEntitiesStayConsistent) {
+    FWorld               World;
+    std::vector<FEntity> Entities;
+    constexpr int        Count = 5000;
+    for (int Index = 0; Index < Count; ++Index) {
+        Entities.push_back(World.CreateEntity(FHealth{ Index }));
+        if (Index % 3 == 0) {
+            World.AddComponent<FPosition>(Entities.back(), FPosition{ float(Index), 0, 0 });
+        }
+    }
+    // 删除一半, 触发大量末行填补
+    for (int Index = 0; Index < Count; Index += 2) {
+        World.DestroyEntity(Entities[Index]);
+    }
+    for (int Index = 1; Index < Count; Index += 2) {
+        ASSERT_TRUE(World.IsAlive(Entities[Index]));
+        EXPECT_EQ(World.GetComponent<FHealth>(Entities[Index])->Value, Index);
+        if (Index % 3 == 0) {
+            EXPECT_EQ(World.GetComponent<FPosition>(Entities[Index])->X, float(Index));
+        }
+    }
+    EXPECT_EQ(World.NumEntities(), uint32(Count / 2));
+}
+
+TEST(ECSTest, EachAndQuery) {
+    FWorld World;
+    for (int Index = 0; Index < 100; ++Index) {
+        FEntity Entity = World.CreateEntity(FPosition{}, FVelocity{ 1, 2, 3 });
+        if (Index % 4 == 0) {
+            World.AddComponent<FFrozen>(Entity);
+        }
+        if (Index % 5 == 0) {
+            World.AddComponent<FHealth>(Entity);
+        }
+    }
+    World.CreateEntity(FPosition{});
+
+    int Visited = 0;
+    World.Each<FPosition, FVelocity>([&](FPosition &Position, const FVelocity &Velocity) {
+        Position.X += Velocity.X;
+        ++Visited;
+    });
+    EXPECT_EQ(Visited, 100);
+
+    // 带实体句柄的回调
+    std::unordered_set<FEntity> Seen;
+    World.Each<FPosition>([&](FEntity Entity, FPosition &) { Seen.insert(Entity); });
+    EXPECT_EQ(Seen.size(), 101u);
+
+    // 按块遍历并排除标签
+    FQuery Query;
+    Query.With<FPosition, FVelocity>().Without<FFrozen>();
+    int Moving = 0;
+    World.ForEachChunk(Query, [&](const FChunkView &View) {
+        FPosition       *Positions  = View.Get<FPosition>();
+        const FVelocity *Velocities = View.Get<FVelocity>();
+        for (uint32 Row = 0; Row < View.Num(); ++Row) {
+            Positions[Row].Y += Velocities[Row].Y;
+            ++Moving;
+        }
+        EXPECT_FALSE(View.Has<FFrozen>());
+    });
+    EXPECT_EQ(Moving, 75);
+
+    // 查询缓存会增量纳入之后新建的 Archetype
+    struct FLate {
+        int Value = 1;
+    };
+    World.CreateEntity(FPosition{}, FVelocity{}, FLate{});
+    Moving = 0;
+    World.ForEachChunk(Query, [&](const FChunkView &View) { Moving += View.Num(); });
+    EXPECT_EQ(Moving, 76);
+}
+
+// 修改查询条件或换一个 World 后, 缓存的匹配结果不再沿用
+TEST(ECSTest, QueryCacheInvalidation) {
+    FQuery     Query;
+    const auto Count = [&Query](FWorld &World) {
+        uint32 Total = 0;
+        World.ForEachChunk(Query, [&Total](const FChunkView &View) { Total += View.Num(); });
+        return Total;
+    };
+    {
+        FWorld World;
+        World.CreateEntity(FPosition{});
+        World.CreateEntity(FPosition{}, FVelocity{});
+        Query.With<FPosition>();
+        EXPECT_EQ(Count(World), 2u);
+        Query.With<FVelocity>();
+        EXPECT_EQ(Count(World), 1u);
+        Query.Without<FVelocity>();
+        EXPECT_EQ(Count(World), 0u);
+    }
+
+    // 新 World 可能复用刚释放的地址
+    auto First = std::make_unique<FWorld>();
+    First->CreateEntity(FHealth{});
+    FQuery HealthQuery;
+    HealthQuery.With<FHealth>();
+    EXPECT_EQ(First->GetMatchingArchetypes(HealthQuery).size(), 1u);
+    const uint64 FirstId = First->GetId();
+    First.reset();
+    FWorld Second;
+    EXPECT_NE(Second.GetId(), FirstId);
+    EXPECT_TRUE(Second.GetMatchingArchetypes(HealthQuery).empty());
+}
+
+TEST(ECSTest, NonTrivialComponents) {
+    FWorld               World;
+    std::vector<FEntity> Entities;
+    for (int Index = 0; Index < 1000; ++Index) {
+        Entities.push_back(World.CreateEntity(FOwned{ std::make_unique<int>(Index) }));
+    }
+    for (int Index = 0; Index < 1000; Index += 3) {
+        World.AddComponent<FPosition>(Entities[Index]);
+    }
+    for (int Index = 0; Index < 1000; Index += 7) {
+        World.DestroyEntity(Entities[Index]);
+    }
+    for (int Index = 0; Index < 1000; ++Index) {
+        if (Index % 7 == 0) {
+            continue;
+        }
+        FOwned *Owned = World.GetComponent<FOwned>(Entities[Index]);
+        ASSERT_NE(Owned, nullptr);
+        ASSERT_TRUE(Owned->Value);
+        EXPECT_EQ(*Owned->Value, Index);
+    }
+}
+
+// 组件数组按缓存行对齐, 且块被充分利用
+TEST(ECSTest, ChunkLayout) {
+    FWorld  World;
+    FEntity Entity = World.CreateEntity(FPosition{}, FVelocity{});
+    FQuery  Query;
+    Query.With<FPosition, FVelocity>();
+    for (FArchetype *Archetype: World.GetMatchingArchetypes(Query)) {
+        const uint32 RowSize = sizeof(FEntity) + sizeof(FPosition) + sizeof(FVelocity);
+        EXPECT_GT(Archetype->GetChunkCapacity() * RowSize, ChunkSize * 9 / 10);
+        for (FChunk *Chunk: Archetype->GetChunks()) {
+            FChunkView View(Archetype, Chunk);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(View.Get<FPosition>()) % ChunkAlignment, 0u);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(View.Get<FVelocity>()) % ChunkAlignment, 0u);
+        }
+    }
+    EXPECT_TRUE(World.IsAlive(Entity));
+}
@@ -0,0 +1,197 @@
+/******************************************************
+ * @file ECSTests/SystemSchedulerTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "ECS/ParallelQuery.hpp"
+#include "ECS/SystemScheduler.hpp"
+#include "ECS/World.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+using namespace TE::ECS;
+
+namespace {
+struct FPosition {
+    float X = 0;
+};
+
+struct FVelocity {
+    float X = 0;
+};
+
+struct FMass {
+    float Value = 1;
+};
+
+// 只声明访问、记录执行顺序的系统
+class FRecordSystem : public FSystem {
+  public:
+    FRecordSystem(int InId, std::vector<int> &InOrder, std::atomic<int> &InCursor)
+        : FSystem(TEXT("Record")), Id(InId), Order(InOrder), Cursor(InCursor) {}
+
+    FSystemAccess &GetMutableAccess() { return Access; }
+
+    void Update(FWorld &, float) override { Order[Cursor.fetch_add(1)] = Id; }
+
+  private:
+    int               Id;
+    std::vector<int> &Order;
+    std::atomic<int> &Cursor;
+};
+
+class FMoveSystem : public FSystem {
+  public:
+    FMoveSystem() : FSystem(TEXT("Move")) { Access.Read<FVelocity>().Write<FPosition>(); }
+
+    void Update(FWorld &World, float DeltaTime) override {
+        ParallelEach<FPosition, FVelocity>(World, [DeltaTime](FPosition &Position,
+                                                              const FVelocity &Velocity) {
+            Position.X += Velocity.X * DeltaTime;
+        });
+    }
+};
+
+class FAccelerateSystem : public FSystem {
+  public:
+    FAccelerateSystem() : FSystem(TEXT("Accelerate")) {
+        Access.Read<FMass>().Write<FVelocity>();
+    }
+
+    void Update(FWorld &World, float DeltaTime) override {
+        ParallelEach<FVelocity, FMass>(World, [DeltaTime](FVelocity &Velocity, const FMass &Mass) {
+            Velocity.X += DeltaTime / Mass.Value;
+        });
+    }
+};
+
+// 只读 FMass, 与 FAccelerateSystem 不冲突
+class FMassStatsSystem : public FSystem {
+  public:
+    FMassStatsSystem() : FSystem(TEXT("MassStats")) { Access.Read<FMass>(); }
+
+    void Update(FWorld &World, float) override {
+        float Sum = 0;
+        World.Each<FMass>([&Sum](const FMass &Mass) { Sum += Mass.Value; });
+        TotalMass = Sum;
+    }
+
+    float TotalMass = 0;
+};
+} // namespace
+
+TEST(SystemSchedulerTest, DependencyGraph) {
+    std::vector<int> Order(8);
+    std::atomic<int> Cursor{ 0 };
+    FSystemScheduler Scheduler;
+
+    auto &WritePosition = Scheduler.AddSystem<FRecordSystem>(0, Order, Cursor);
+    WritePosition.GetMutableAccess().Write<FPosition>();
+    auto &ReadPositionA = Scheduler.AddSystem<FRecordSystem>(1, Order, Cursor);
+    ReadPositionA.GetMutableAccess().Read<FPosition>();
+    auto &ReadPositionB = Scheduler.AddSystem<FRecordSystem>(2, Order, Cursor);
+    ReadPositionB.GetMutableAccess().Read<FPosition>();
+    auto &WriteVelocity = Scheduler.AddSystem<FRecordSystem>(3, Order, Cursor);
+    WriteVelocity.GetMutableAccess().Write<FVelocity>();
+    auto &WritePositionAgain = Scheduler.AddSystem<FRecordSystem>(4, Order, Cursor);
+    WritePositionAgain.GetMutableAccess().Write<FPosition>();
+    auto &Spawner = Scheduler.AddSystem<FRecordSystem>(5, Order, Cursor);
+    Spawner.GetMutableAccess().Exclusive();
+    auto &ReadVelocity = Scheduler.AddSystem<FRecordSystem>(6, Order, Cursor);
+    ReadVelocity.GetMutableAccess().Read<FVelocity>();
+
+    // 读者只依赖最近的写者, 彼此之间无依赖
+    EXPECT_EQ(Scheduler.GetPrerequisites(1), (std::vector<uint32>{ 0 }));
+    EXPECT_EQ(Scheduler.GetPrerequisites(2), (std::vector<uint32>{ 0 }));
+    // 与其他系统不冲突
+    EXPECT_TRUE(Scheduler.GetPrerequisites(3).empty());
+    // 写者依赖之前的写者和之后的所有读者
+    EXPECT_EQ(Scheduler.GetPrerequisites(4), (std::vector<uint32>{ 0, 1, 2 }));
+    // 独占系统依赖之前所有系统; 之后的系统依赖独占系统
+    EXPECT_EQ(Scheduler.GetPrerequisites(5), (std::vector<uint32>{ 0, 1, 2, 3, 4 }));
+    EXPECT_EQ(Scheduler.GetPrerequisites(6), (std::vector<uint32>{ 5 }));
+
+    FWorld World;
+    for (int Frame = 0; Frame < 50; ++Frame) {
+        Cursor = 0;
+        Scheduler.Update(World, 0.016f);
+        ASSERT_EQ(Cursor.load(), 7);
+
+        auto PositionOf = [&Order](int Id) {
+            return std::find(Order.begin(), Order.begin() + 7, Id) - Order.begin();
+        };
+        EXPECT_LT(PositionOf(0), PositionOf(1));
+        EXPECT_LT(PositionOf(0), PositionOf(2));
+        EXPECT_LT(PositionOf(1), PositionOf(4));
+        EXPECT_LT(PositionOf(2), PositionOf(4));
+        EXPECT_EQ(PositionOf(5), 5);
+        EXPECT_EQ(PositionOf(6), 6);
+    }
+}
+
+// 与串行执行的结果一致
+TEST(SystemSchedulerTest, MatchesSerialExecution) {
+    FWorld World;
+    for (int Index = 0; Index < 20000; ++Index) {
+        World.CreateEntity(FPosition{}, FVelocity{ 1 }, FMass{ float(1 + Index % 4) });
+    }
+    for (int Index = 0; Index < 3000; ++Index) {
+        World.CreateEntity(FPosition{}, FVelocity{ 2 });
+    }
+
+    FSystemScheduler Scheduler;
+    Scheduler.AddSystem<FAccelerateSystem>();
+    Scheduler.AddSystem<FMoveSystem>();
+    FMassStatsSystem &Stats = Scheduler.AddSystem<FMassStatsSystem>();
+
+    constexpr int Frames = 10;
+    for (int Frame = 0; Frame < Frames; ++Frame) {
+        Scheduler.Update(World, 1.0f);
+    }
+
+    // 逐帧模拟: v += 1/m, x += v
+    World.Each<FPosition, FVelocity>([&](FEntity Entity, const FPosition &Position,
+                                         const FVelocity &Velocity) {
+        const FMass *Mass     = World.GetComponent<FMass>(Entity);
+        float        Expected = 0;
+        float        Speed    = Mass ? 1.0f : 2.0f;
+        for (int Frame = 0; Frame < Frames; ++Frame) {
+            if (Mass) {
+                Speed += 1.0f / Mass->Value;
+            }
+            Expected += Speed;
+        }
+        EXPECT_FLOAT_EQ(Position.X, Expected);
+        EXPECT_FLOAT_EQ(Velocity.X, Speed);
+    });
+    EXPECT_FLOAT_EQ(Stats.TotalMass, 5000.0f * (1 + 2 + 3 + 4));
+}
+
+TEST(SystemSchedulerTest, ParallelForEachChunkVisitsEveryChunkOnce) {
+    FWorld World;
+    for (int Index = 0; Index < 50000; ++Index) {
+        World.CreateEntity(FPosition{ float(Index) });
+    }
+    FQuery Query;
+    Query.With<FPosition>();
+
+    std::atomic<uint32> Visited{ 0 };
+    std::atomic<double> Sum{ 0 };
+    ParallelForEachChunk(World, Query, [&](const FChunkView &View) {
+        const FPosition *Positions = View.Get<FPosition>();
+        double           Local     = 0;
+        for (uint32 Row = 0; Row < View.Num(); ++Row) {
+            Local += Positions[Row].X;
+        }
+        Visited.fetch_add(View.Num());
+        double Expected = Sum.load();
+        while (!Sum.compare_exchange_weak(Expected, Expected + Local)) {
+        }
+    });
+    EXPECT_EQ(Visited.load(), 50000u);
+    EXPECT_DOUBLE_EQ(Sum.load(), 50000.0 * 49999.0 / 2.0);
+}
@@ -0,0 +1,165 @@
+/******************************************************
+ * @file Terrain/NoiseKernel.inl
+ * @brief 噪声内核, 由 TerrainNoise.cpp 为每个指令集各包含一次
+ *****************************************************/
+
+// 包含方先在当前命名空间里定义 FVec: Lanes 个 int32 的向量, 支持 + - * & ^ (乘法取低 32 位,
+// 溢出按补码回绕), >> (算术右移), << 和 Srl (逻辑右移), 比较 < == 得到 FMask,
+// 以及 Set1 / Iota / Select / Store. 这里的代码对每个指令集逐字相同, 运算也全是整数,
+// 所以各条路径的结果逐位一致
+
+// 格点哈希: 坐标各乘一个大奇数 (来自 FastNoise) 后与种子异或, 再做两轮乘法与移位混合.
+// 相邻格点的乘积只差一个常数 ((C + 1) * P = C * P + P), 每个轴只需乘一次
+inline constexpr int32 PrimeX = 501125321;
+inline constexpr int32 PrimeY = 1136930381;
+inline constexpr int32 PrimeZ = 1720413743;
+
+inline FVec MixHash(FVec Hash) {
+    Hash = Hash * FVec::Set1(0x27D4EB2D);
+    Hash = Hash ^ FVec::Srl(Hash, 15);
+    Hash = Hash * FVec::Set1(0x165667B1);
+    // 高位混合得最充分, 取最高 4 位作为梯度编号
+    return FVec::Srl(Hash, 28);
+}
+
+// Perlin 改进噪声的 12 个棱方向梯度 (16 项, 其中 4 项重复) 与偏移的点积
+inline FVec Gradient3(FVec Hash, FVec X, FVec Y, FVec Z) {
+    const FVec U = FVec::Select(Hash < FVec::Set1(8), X, Y);
+    const FVec V = FVec::Select(Hash < FVec::Set1(4), Y,
+                                FVec::Select((Hash & FVec::Set1(13)) == FVec::Set1(12), X, Z));
+    // 最低两位决定 U/V 的符号: 全 1 掩码 S 下 (A ^ S) - S 即 -A
+    const FVec SignU = FVec::Set1(0) - (Hash & FVec::Set1(1));
+    const FVec SignV = FVec::Set1(0) - FVec::Srl(Hash & FVec::Set1(2), 1);
+    return ((U ^ SignU) - SignU) + ((V ^ SignV) - SignV);
+}
+
+// 4 个对角方向梯度
+inline FVec Gradient2(FVec Hash, FVec X, FVec Z) {
+    const FVec SignX = FVec::Set1(0) - (Hash & FVec::Set1(1));
+    const FVec SignZ = FVec::Set1(0) - FVec::Srl(Hash & FVec::Set1(2), 1);
+    return ((X ^ SignX) - SignX) + ((Z ^ SignZ) - SignZ);
+}
+
+// 6t^5 - 15t^4 + 10t^3 = t^3 * (t * (6t - 15) + 10), t ∈ [0, NoiseOne], 中间结果都在 2^28 以内
+inline FVec Fade(FVec T) {
+    const FVec A  = T * FVec::Set1(6) - FVec::Set1(15 * NoiseOne);
+    const FVec B  = ((T * A) >> NoiseFracBits) + FVec::Set1(10 * NoiseOne);
+    const FVec T2 = (T * T) >> NoiseFracBits;
+    const FVec T3 = (T2 * T) >> NoiseFracBits;
+    return (T3 * B) >> NoiseFracBits;
+}
+
+// 结果总在 A 与 B 之间
+inline FVec Lerp(FVec A, FVec B, FVec T) {
+    return A + (((B - A) * T) >> NoiseFracBits);
+}
+
+// 体素坐标拆成格点坐标与 Q12 小数部分, 格点间距 2^Shift 个体素 (Shift ∈ [1, NoiseFracBits])
+inline void SplitCoord(FVec Coord, int32 Shift, FVec &OutCell, FVec &OutFrac) {
+    OutCell = Coord >> Shift;
+    OutFrac = (Coord & FVec::Set1((1 << Shift) - 1)) << (NoiseFracBits - Shift);
+}
+
+inline FVec GradientNoise3(FVec Seed, FVec X, FVec Y, FVec Z, int32 Shift) {
+    FVec CellX, CellY, CellZ, FracX, FracY, FracZ;
+    SplitCoord(X, Shift, CellX, FracX);
+    SplitCoord(Y, Shift, CellY, FracY);
+    SplitCoord(Z, Shift, CellZ, FracZ);
+    const FVec Unit    = FVec::Set1(NoiseOne);
+    const FVec FracX1  = FracX - Unit;
+    const FVec FracY1  = FracY - Unit;
+    const FVec FracZ1  = FracZ - Unit;
+    const FVec HashX0  = CellX * FVec::Set1(PrimeX);
+    const FVec HashX1  = HashX0 + FVec::Set1(PrimeX);
+    const FVec HashY0  = CellY * FVec::Set1(PrimeY);
+    const FVec HashY1  = HashY0 + FVec::Set1(PrimeY);
+    const FVec ScaledZ = CellZ * FVec::Set1(PrimeZ);
+    const FVec HashZ0  = Seed ^ ScaledZ;
+    const FVec HashZ1  = Seed ^ (ScaledZ + FVec::Set1(PrimeZ));
+    const FVec Hash00  = HashY0 ^ HashZ0;
+    const FVec Hash10  = HashY1 ^ HashZ0;
+    const FVec Hash01  = HashY0 ^ HashZ1;
+    const FVec Hash11  = HashY1 ^ HashZ1;
+
+    const FVec N000 = Gradient3(MixHash(HashX0 ^ Hash00), FracX, FracY, FracZ);
+    const FVec N100 = Gradient3(MixHash(HashX1 ^ Hash00), FracX1, FracY, FracZ);
+    const FVec N010 = Gradient3(MixHash(HashX0 ^ Hash10), FracX, FracY1, FracZ);
+    const FVec N110 = Gradient3(MixHash(HashX1 ^ Hash10), FracX1, FracY1, FracZ);
+    const FVec N001 = Gradient3(MixHash(HashX0 ^ Hash01), FracX, FracY, FracZ1);
+    const FVec N101 = Gradient3(MixHash(HashX1 ^ Hash01), FracX1, FracY, FracZ1);
+    const FVec N011 = Gradient3(MixHash(HashX0 ^ Hash11), FracX, FracY1, FracZ1);
+    const FVec N111 = Gradient3(MixHash(HashX1 ^ Hash11), FracX1, FracY1, FracZ1);
+
+    const FVec U = Fade(FracX);
+    const FVec V = Fade(FracY);
+    const FVec W = Fade(FracZ);
+    return Lerp(Lerp(Lerp(N000, N100, U), Lerp(N010, N110, U), V),
+                Lerp(Lerp(N001, N101, U), Lerp(N011, N111, U), V), W);
+}
+
+inline FVec GradientNoise2(FVec Seed, FVec X, FVec Z, int32 Shift) {
+    FVec CellX, CellZ, FracX, FracZ;
+    SplitCoord(X, Shift, CellX, FracX);
+    SplitCoord(Z, Shift, CellZ, FracZ);
+    const FVec Unit   = FVec::Set1(NoiseOne);
+    const FVec FracX1 = FracX - Unit;
+    const FVec FracZ1 = FracZ - Unit;
+    // 2D 噪声相当于 3D 格点哈希中 Y 固定为 0
+    const FVec HashX0  = CellX * FVec::Set1(PrimeX);
+    const FVec HashX1  = HashX0 + FVec::Set1(PrimeX);
+    const FVec ScaledZ = CellZ * FVec::Set1(PrimeZ);
+    const FVec HashZ0  = Seed ^ ScaledZ;
+    const FVec HashZ1  = Seed ^ (ScaledZ + FVec::Set1(PrimeZ));
+
+    const FVec N00 = Gradient2(MixHash(HashX0 ^ HashZ0), FracX, FracZ);
+    const FVec N10 = Gradient2(MixHash(HashX1 ^ HashZ0), FracX1, FracZ);
+    const FVec N01 = Gradient2(MixHash(HashX0 ^ HashZ1), FracX, FracZ1);
+    const FVec N11 = Gradient2(MixHash(HashX1 ^ HashZ1), FracX1, FracZ1);
+    const FVec U   = Fade(FracX);
+    return Lerp(Lerp(N00, N10, U), Lerp(N01, N11, U), Fade(FracZ));
+}
+
+// 每个倍频换一个种子, 避免各倍频的格点在原点处对齐
+inline FVec GetOctaveSeed(const FNoiseOctaves &Octaves, int32 Octave) {
+    return FVec::Set1(int32(Octaves.Seed + uint32(Octave) * 0x9E3779B9u));
+}
+
+inline FVec Fbm3(const FNoiseOctaves &Octaves, int32 NumOctaves, FVec X, FVec Y, FVec Z) {
+    FVec Sum = FVec::Set1(0);
+    for (int32 Octave = 0; Octave < NumOctaves; ++Octave) {
+        const FVec Noise =
+            GradientNoise3(GetOctaveSeed(Octaves, Octave), X, Y, Z, Octaves.CellShift - Octave);
+        Sum = Sum + (Noise >> Octave);
+    }
+    return Sum;
+}
+
+inline FVec Fbm2(const FNoiseOctaves &Octaves, int32 NumOctaves, FVec X, FVec Z) {
+    FVec Sum = FVec::Set1(0);
+    for (int32 Octave = 0; Octave < NumOctaves; ++Octave) {
+        const FVec Noise =
+            GradientNoise2(GetOctaveSeed(Octaves, Octave), X, Z, Octaves.CellShift - Octave);
+        Sum = Sum + (Noise >> Octave);
+    }
+    return Sum;
+}
+
+// NumOctaves 已经截断到 CellShift 以内
+inline void EvaluateFbm3DRow(const FNoiseOctaves &Octaves, int32 NumOctaves, int32 X0, int32 Y,
+                             int32 Z, uint32 Count, int32 *Out) {
+    const FVec VY = FVec::Set1(Y);
+    const FVec VZ = FVec::Set1(Z);
+    for (uint32 Index = 0; Index < Count; Index += FVec::Lanes) {
+        const FVec VX = FVec::Set1(X0 + int32(Index)) + FVec::Iota();
+        Fbm3(Octaves, NumOctaves, VX, VY, VZ).Store(Out + Index, Count - Index);
+    }
+}
+
+inline void EvaluateFbm2DRow(const FNoiseOctaves &Octaves, int32 NumOctaves, int32 X0, int32 Z,
+                             uint32 Count, int32 *Out) {
+    const FVec VZ = FVec::Set1(Z);
+    for (uint32 Index = 0; Index < Count; Index += FVec::Lanes) {
+        const FVec VX = FVec::Set1(X0 + int32(Index)) + FVec::Iota();
+        Fbm2(Octaves, NumOctaves, VX, VZ).Store(Out + Index, Count - Index);
+    }
+}
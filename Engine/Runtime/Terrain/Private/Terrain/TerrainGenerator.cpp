@@ -0,0 +1,99 @@
+/******************************************************
+ * @file Terrain/TerrainGenerator.cpp
+ * @brief
+ *****************************************************/
+
+#include "Terrain/TerrainGenerator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace TE::Terrain {
+using namespace Voxel;
+
+FTerrainGenerator::FTerrainGenerator(const FTerrainSettings &InSettings) : Settings(InSettings) {
+    check(Settings.HeightAmplitude >= 0 && Settings.SoilDepth >= 0 && Settings.CaveMinDepth >= 0);
+    HeightNoise = { Settings.Seed, Settings.HeightCellShift, Settings.HeightOctaves };
+    // 洞穴换一个种子, 与高度图互不相关
+    CaveNoise = { Settings.Seed ^ 0x5BD1E995u, Settings.CaveCellShift, Settings.CaveOctaves };
+}
+
+void FTerrainGenerator::GenerateChunk(const FChunkCoord &Coord, FVoxelChunk &OutChunk) const {
+    const int32 BaseX = Coord.X * ChunkDim;
+    const int32 BaseY = Coord.Y * ChunkDim;
+    const int32 BaseZ = Coord.Z * ChunkDim;
+
+    // 高度图, 以及每一行 (固定 Z) 的最高点
+    int32 Heights[ChunkDim * ChunkDim];
+    int32 RowMaxHeights[ChunkDim];
+    int32 MinHeight = std::numeric_limits<int32>::max();
+    int32 MaxHeight = std::numeric_limits<int32>::min();
+    for (int32 Z = 0; Z < ChunkDim; ++Z) {
+        int32 *Row = Heights + Z * ChunkDim;
+        EvaluateFbm2D(HeightNoise, BaseX, BaseZ + Z, ChunkDim, Row);
+        RowMaxHeights[Z] = std::numeric_limits<int32>::min();
+        for (int32 X = 0; X < ChunkDim; ++X) {
+            Row[X]           = ToHeight(Row[X]);
+            RowMaxHeights[Z] = std::max(RowMaxHeights[Z], Row[X]);
+            MinHeight        = std::min(MinHeight, Row[X]);
+        }
+        MaxHeight = std::max(MaxHeight, RowMaxHeights[Z]);
+    }
+
+    const int32 TopY      = BaseY + ChunkDim - 1;
+    const bool  bHasCaves = Settings.CaveThreshold > 0;
+    if (BaseY > MaxHeight && BaseY > Settings.SeaLevel) {
+        OutChunk.Fill(AirVoxel);
+        return;
+    }
+    if (!bHasCaves && TopY <= MinHeight - Settings.SoilDepth) {
+        OutChunk.Fill(Settings.Stone);
+        return;
+    }
+
+    std::vector<FVoxel> Voxels(ChunkVolume);
+    int32               Caves[ChunkDim];
+    for (int32 Z = 0; Z < ChunkDim; ++Z) {
+        const int32 *Row = Heights + Z * ChunkDim;
+        for (int32 Y = 0; Y < ChunkDim; ++Y) {
+            const int32 WorldY = BaseY + Y;
+            // 只对这一行里可能挖洞的部分求 3D 噪声
+            const bool bCaveRow = bHasCaves && WorldY <= RowMaxHeights[Z] - Settings.CaveMinDepth;
+            if (bCaveRow) {
+                EvaluateFbm3D(CaveNoise, BaseX, WorldY, BaseZ + Z, ChunkDim, Caves);
+            }
+            FVoxel *Out = Voxels.data() + GetVoxelIndex(0, Y, Z);
+            for (int32 X = 0; X < ChunkDim; ++X) {
+                const int32 Height = Row[X];
+                const bool  bLand  = Height >= Settings.SeaLevel;
+                FVoxel      Voxel  = Settings.Stone;
+                if (WorldY > Height) {
+                    Voxel = WorldY <= Settings.SeaLevel ? Settings.Water : AirVoxel;
+                } else if (bCaveRow && WorldY <= Height - Settings.CaveMinDepth &&
+                           std::abs(Caves[X]) < Settings.CaveThreshold) {
+                    Voxel = AirVoxel;
+                } else if (WorldY == Height) {
+                    Voxel = bLand ? Settings.Grass : Settings.Sand;
+                } else if (WorldY > Height - Settings.SoilDepth) {
+                    Voxel = bLand ? Settings.Dirt : Settings.Sand;
+                }
+                Out[X] = Voxel;
+            }
+        }
+    }
+    OutChunk.Pack(Voxels.data());
+}
+
+Tasks::TTask<void> FTerrainGenerator::LaunchGenerateChunk(const FChunkCoord &Coord,
+                                                          FVoxelChunk       &OutChunk) const {
+    return Tasks::Launch(
+        TEXT("GenerateTerrain"), [this, Coord, &OutChunk] { GenerateChunk(Coord, OutChunk); },
+        Tasks::ETaskPriority::Background);
+}
+
+int32 FTerrainGenerator::GetSurfaceHeight(int32 X, int32 Z) const {
+    return ToHeight(EvaluateFbm2D(HeightNoise, X, Z));
+}
+} // namespace TE::Terrain
@@ -0,0 +1,290 @@
+/******************************************************
+ * @file Terrain/TerrainNoise.cpp
+ * @brief
+ *****************************************************/
+
+#include "Terrain/TerrainNoise.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+// SIMD 路径用 target 编译指示单独编译, 其余代码不要求 -msse4.1/-mavx2, 运行时再检查 CPU 是否支持
+// MSVC 暂时只有标量路径
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TE_TERRAIN_SIMD 1
+#include <immintrin.h>
+#else
+#define TE_TERRAIN_SIMD 0
+#endif
+
+namespace TE::Terrain {
+namespace {
+namespace Scalar {
+using FMask = bool;
+
+struct FVec {
+    static constexpr uint32 Lanes = 1;
+
+    int32 V;
+
+    static FVec Set1(int32 Value) { return { Value }; }
+    static FVec Iota() { return { 0 }; }
+    static FVec Select(FMask Mask, FVec A, FVec B) { return Mask ? A : B; }
+    static FVec Srl(FVec A, int32 Shift) { return { int32(uint32(A.V) >> Shift) }; }
+
+    void Store(int32 *Out, uint32) const { *Out = V; }
+};
+
+// 加减乘按无符号数做, 溢出时与 SIMD 一样按补码回绕
+inline FVec  operator+(FVec A, FVec B) { return { int32(uint32(A.V) + uint32(B.V)) }; }
+inline FVec  operator-(FVec A, FVec B) { return { int32(uint32(A.V) - uint32(B.V)) }; }
+inline FVec  operator*(FVec A, FVec B) { return { int32(uint32(A.V) * uint32(B.V)) }; }
+inline FVec  operator&(FVec A, FVec B) { return { A.V & B.V }; }
+inline FVec  operator^(FVec A, FVec B) { return { A.V ^ B.V }; }
+inline FVec  operator>>(FVec A, int32 Shift) { return { A.V >> Shift }; }
+inline FVec  operator<<(FVec A, int32 Shift) { return { int32(uint32(A.V) << Shift) }; }
+inline FMask operator<(FVec A, FVec B) { return A.V < B.V; }
+inline FMask operator==(FVec A, FVec B) { return A.V == B.V; }
+
+#include "NoiseKernel.inl"
+} // namespace Scalar
+
+#if TE_TERRAIN_SIMD
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+namespace Sse41 {
+using FMask = __m128i;
+
+struct FVec {
+    static constexpr uint32 Lanes = 4;
+
+    __m128i V;
+
+    static FVec Set1(int32 Value) { return { _mm_set1_epi32(Value) }; }
+    static FVec Iota() { return { _mm_setr_epi32(0, 1, 2, 3) }; }
+    static FVec Select(FMask Mask, FVec A, FVec B) { return { _mm_blendv_epi8(B.V, A.V, Mask) }; }
+    static FVec Srl(FVec A, int32 Shift) {
+        return { _mm_srl_epi32(A.V, _mm_cvtsi32_si128(Shift)) };
+    }
+
+    // 超出 Lanes 时只写前 Count 个
+    void Store(int32 *Out, uint32 Count) const {
+        if (Count >= Lanes) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(Out), V);
+            return;
+        }
+        int32 Buffer[Lanes];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(Buffer), V);
+        std::memcpy(Out, Buffer, Count * sizeof(int32));
+    }
+};
+
+inline FVec  operator+(FVec A, FVec B) { return { _mm_add_epi32(A.V, B.V) }; }
+inline FVec  operator-(FVec A, FVec B) { return { _mm_sub_epi32(A.V, B.V) }; }
+inline FVec  operator*(FVec A, FVec B) { return { _mm_mullo_epi32(A.V, B.V) }; }
+inline FVec  operator&(FVec A, FVec B) { return { _mm_and_si128(A.V, B.V) }; }
+inline FVec  operator^(FVec A, FVec B) { return { _mm_xor_si128(A.V, B.V) }; }
+inline FMask operator<(FVec A, FVec B) { return _mm_cmplt_epi32(A.V, B.V); }
+inline FMask operator==(FVec A, FVec B) { return _mm_cmpeq_epi32(A.V, B.V); }
+inline FVec  operator>>(FVec A, int32 Shift) {
+    return { _mm_sra_epi32(A.V, _mm_cvtsi32_si128(Shift)) };
+}
+inline FVec operator<<(FVec A, int32 Shift) {
+    return { _mm_sll_epi32(A.V, _mm_cvtsi32_si128(Shift)) };
+}
+
+#include "NoiseKernel.inl"
+} // namespace Sse41
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+namespace Avx2 {
+using FMask = __m256i;
+
+struct FVec {
+    static constexpr uint32 Lanes = 8;
+
+    __m256i V;
+
+    static FVec Set1(int32 Value) { return { _mm256_set1_epi32(Value) }; }
+    static FVec Iota() { return { _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7) }; }
+    static FVec Select(FMask Mask, FVec A, FVec B) {
+        return { _mm256_blendv_epi8(B.V, A.V, Mask) };
+    }
+    static FVec Srl(FVec A, int32 Shift) {
+        return { _mm256_srl_epi32(A.V, _mm_cvtsi32_si128(Shift)) };
+    }
+
+    // 超出 Lanes 时只写前 Count 个
+    void Store(int32 *Out, uint32 Count) const {
+        if (Count >= Lanes) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(Out), V);
+            return;
+        }
+        int32 Buffer[Lanes];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(Buffer), V);
+        std::memcpy(Out, Buffer, Count * sizeof(int32));
+    }
+};
+
+inline FVec  operator+(FVec A, FVec B) { return { _mm256_add_epi32(A.V, B.V) }; }
+inline FVec  operator-(FVec A, FVec B) { return { _mm256_sub_epi32(A.V, B.V) }; }
+inline FVec  operator*(FVec A, FVec B) { return { _mm256_mullo_epi32(A.V, B.V) }; }
+inline FVec  operator&(FVec A, FVec B) { return { _mm256_and_si256(A.V, B.V) }; }
+inline FVec  operator^(FVec A, FVec B) { return { _mm256_xor_si256(A.V, B.V) }; }
+inline FMask operator<(FVec A, FVec B) { return _mm256_cmpgt_epi32(B.V, A.V); }
+inline FMask operator==(FVec A, FVec B) { return _mm256_cmpeq_epi32(A.V, B.V); }
+inline FVec  operator>>(FVec A, int32 Shift) {
+    return { _mm256_sra_epi32(A.V, _mm_cvtsi32_si128(Shift)) };
+}
+inline FVec operator<<(FVec A, int32 Shift) {
+    return { _mm256_sll_epi32(A.V, _mm_cvtsi32_si128(Shift)) };
+}
+
+#include "NoiseKernel.inl"
+} // namespace Avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+namespace Avx512 {
+using FMask = __mmask16;
+
+struct FVec {
+    static constexpr uint32 Lanes = 16;
+
+    __m512i V;
+
+    static FVec Set1(int32 Value) { return { _mm512_set1_epi32(Value) }; }
+    static FVec Iota() {
+        return { _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15) };
+    }
+    static FVec Select(FMask Mask, FVec A, FVec B) {
+        return { _mm512_mask_blend_epi32(Mask, B.V, A.V) };
+    }
+    static FVec Srl(FVec A, int32 Shift) {
+        return { _mm512_maskz_srl_epi32(0xFFFF, A.V, _mm_cvtsi32_si128(Shift)) };
+    }
+
+    void Store(int32 *Out, uint32 Count) const {
+        const __mmask16 Mask = Count >= Lanes ? __mmask16(0xFFFF) : __mmask16((1u << Count) - 1);
+        _mm512_mask_storeu_epi32(Out, Mask, V);
+    }
+};
+
+inline FVec  operator+(FVec A, FVec B) { return { _mm512_add_epi32(A.V, B.V) }; }
+inline FVec  operator-(FVec A, FVec B) { return { _mm512_sub_epi32(A.V, B.V) }; }
+inline FVec  operator*(FVec A, FVec B) { return { _mm512_mullo_epi32(A.V, B.V) }; }
+inline FVec  operator&(FVec A, FVec B) { return { _mm512_and_si512(A.V, B.V) }; }
+inline FVec  operator^(FVec A, FVec B) { return { _mm512_xor_si512(A.V, B.V) }; }
+inline FMask operator<(FVec A, FVec B) { return _mm512_cmplt_epi32_mask(A.V, B.V); }
+inline FMask operator==(FVec A, FVec B) { return _mm512_cmpeq_epi32_mask(A.V, B.V); }
+inline FVec  operator>>(FVec A, int32 Shift) {
+    return { _mm512_maskz_sra_epi32(0xFFFF, A.V, _mm_cvtsi32_si128(Shift)) };
+}
+inline FVec operator<<(FVec A, int32 Shift) {
+    return { _mm512_maskz_sll_epi32(0xFFFF, A.V, _mm_cvtsi32_si128(Shift)) };
+}
+
+#include "NoiseKernel.inl"
+} // namespace Avx512
+#pragma GCC pop_options
+#endif
+
+ETerrainSimd DetectTerrainSimd() {
+#if TE_TERRAIN_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return ETerrainSimd::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return ETerrainSimd::Avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return ETerrainSimd::Sse41;
+    }
+#endif
+    return ETerrainSimd::Scalar;
+}
+
+std::atomic<ETerrainSimd> GTerrainSimd{ GetSupportedTerrainSimd() };
+
+// 间距缩到 1 个体素之后的倍频恒为 0, 直接略去
+int32 GetEffectiveOctaves(const FNoiseOctaves &Octaves) {
+    check(Octaves.CellShift >= 1 && Octaves.CellShift <= NoiseFracBits);
+    return std::clamp(Octaves.NumOctaves, 0, Octaves.CellShift);
+}
+} // namespace
+
+ETerrainSimd GetSupportedTerrainSimd() {
+    static const ETerrainSimd Supported = DetectTerrainSimd();
+    return Supported;
+}
+
+ETerrainSimd GetTerrainSimd() {
+    return GTerrainSimd.load(std::memory_order_relaxed);
+}
+
+void SetTerrainSimd(ETerrainSimd Simd) {
+    GTerrainSimd.store(Simd <= GetSupportedTerrainSimd() ? Simd : GetSupportedTerrainSimd(),
+                       std::memory_order_relaxed);
+}
+
+uint32 GetTerrainSimdLanes(ETerrainSimd Simd) {
+    switch (Simd) {
+    case ETerrainSimd::Sse41:
+        return 4;
+    case ETerrainSimd::Avx2:
+        return 8;
+    case ETerrainSimd::Avx512:
+        return 16;
+    default:
+        return 1;
+    }
+}
+
+void EvaluateFbm3D(const FNoiseOctaves &Octaves, int32 X0, int32 Y, int32 Z, uint32 Count,
+                   int32 *Out) {
+    const int32 NumOctaves = GetEffectiveOctaves(Octaves);
+#if TE_TERRAIN_SIMD
+    switch (GetTerrainSimd()) {
+    case ETerrainSimd::Avx512:
+        return Avx512::EvaluateFbm3DRow(Octaves, NumOctaves, X0, Y, Z, Count, Out);
+    case ETerrainSimd::Avx2:
+        return Avx2::EvaluateFbm3DRow(Octaves, NumOctaves, X0, Y, Z, Count, Out);
+    case ETerrainSimd::Sse41:
+        return Sse41::EvaluateFbm3DRow(Octaves, NumOctaves, X0, Y, Z, Count, Out);
+    default:
+        break;
+    }
+#endif
+    Scalar::EvaluateFbm3DRow(Octaves, NumOctaves, X0, Y, Z, Count, Out);
+}
+
+void EvaluateFbm2D(const FNoiseOctaves &Octaves, int32 X0, int32 Z, uint32 Count, int32 *Out) {
+    const int32 NumOctaves = GetEffectiveOctaves(Octaves);
+#if TE_TERRAIN_SIMD
+    switch (GetTerrainSimd()) {
+    case ETerrainSimd::Avx512:
+        return Avx512::EvaluateFbm2DRow(Octaves, NumOctaves, X0, Z, Count, Out);
+    case ETerrainSimd::Avx2:
+        return Avx2::EvaluateFbm2DRow(Octaves, NumOctaves, X0, Z, Count, Out);
+    case ETerrainSimd::Sse41:
+        return Sse41::EvaluateFbm2DRow(Octaves, NumOctaves, X0, Z, Count, Out);
+    default:
+        break;
+    }
+#endif
+    Scalar::EvaluateFbm2DRow(Octaves, NumOctaves, X0, Z, Count, Out);
+}
+
+int32 EvaluateFbm3D(const FNoiseOctaves &Octaves, int32 X, int32 Y, int32 Z) {
+    return Scalar::Fbm3(Octaves, GetEffectiveOctaves(Octaves), { X }, { Y }, { Z }).V;
+}
+
+int32 EvaluateFbm2D(const FNoiseOctaves &Octaves, int32 X, int32 Z) {
+    return Scalar::Fbm2(Octaves, GetEffectiveOctaves(Octaves), { X }, { Z }).V;
+}
+} // namespace TE::Terrain
@@ -0,0 +1,75 @@
+/******************************************************
+ * @file Terrain/TerrainGenerator.hpp
+ * @brief 基于 fBm 高度图与 3D 洞穴噪声的区块地形生成
+ *****************************************************/
+
+#pragma once
+
+#include "Tasks/Tasks.hpp"
+#include "Terrain/TerrainNoise.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelChunk.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+namespace TE::Terrain {
+struct FTerrainSettings {
+    uint32 Seed = 0;
+
+    // 地表高度 = BaseHeight + 2D fBm * HeightAmplitude / NoiseOne
+    int32 BaseHeight      = 0;
+    int32 HeightAmplitude = 64;
+    int32 HeightCellShift = 7;
+    int32 HeightOctaves   = 5;
+    // 地表低于 SeaLevel 的地方填水, 地表为沙子
+    int32 SeaLevel  = 0;
+    // 地表下 SoilDepth 层为泥土, 再往下是石头
+    int32 SoilDepth = 3;
+
+    // 3D fBm 的绝对值小于 CaveThreshold 处挖空, 形成连通的洞穴; <= 0 表示不生成洞穴.
+    // 距地表 CaveMinDepth 层以内不挖, 地表保持完整
+    int32 CaveCellShift = 5;
+    int32 CaveOctaves   = 3;
+    int32 CaveThreshold = NoiseOne / 12;
+    int32 CaveMinDepth  = 4;
+
+    Voxel::FVoxel Stone = 1;
+    Voxel::FVoxel Dirt  = 2;
+    Voxel::FVoxel Grass = 3;
+    Voxel::FVoxel Sand  = 4;
+    Voxel::FVoxel Water = 5;
+};
+
+// 区块地形生成
+//
+// 每个区块先用 2D 噪声算出 32x32 的高度图, 再对地表以下可能挖洞的每一行体素批量求 3D 洞穴噪声;
+// 天空中和 (无洞穴时) 深处的区块直接填充, 不求噪声. 噪声按 GetTerrainSimd 选择的指令集
+// 一次求 4/8/16 个体素, 结果与指令集无关, 同一种子在任何机器上生成同样的世界.
+//
+// GenerateChunk 是 const 的, 可以在多个任务里同时生成不同的区块: 作为 FChunkStreamingCallbacks
+// 的 Generate 回调时由流式加载为每个区块发起一个任务, 也可以用 LaunchGenerateChunk 自行发起
+class FTerrainGenerator {
+  public:
+    explicit FTerrainGenerator(const FTerrainSettings &InSettings = {});
+
+    const FTerrainSettings &GetSettings() const { return Settings; }
+
+    // 覆盖 OutChunk 的全部体素
+    void GenerateChunk(const Voxel::FChunkCoord &Coord, Voxel::FVoxelChunk &OutChunk) const;
+
+    // 为一个区块发起一个 Background 任务; 任务完成前 OutChunk 和生成器都要保持有效
+    Tasks::TTask<void> LaunchGenerateChunk(const Voxel::FChunkCoord &Coord,
+                                           Voxel::FVoxelChunk       &OutChunk) const;
+
+    // 世界坐标 (X, Z) 处地表 (最高的实心体素) 的 Y
+    int32 GetSurfaceHeight(int32 X, int32 Z) const;
+
+  private:
+    int32 ToHeight(int32 Noise) const {
+        return Settings.BaseHeight + ((Noise * Settings.HeightAmplitude) >> NoiseFracBits);
+    }
+
+    FTerrainSettings Settings;
+    FNoiseOctaves    HeightNoise;
+    FNoiseOctaves    CaveNoise;
+};
+} // namespace TE::Terrain
@@ -0,0 +1,61 @@
+/******************************************************
+ * @file Terrain/TerrainNoise.hpp
+ * @brief 定点梯度噪声与 fBm, 按行批量求值 (SSE4.1/AVX2/AVX-512 + 标量回退)
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "TypeUtils/CoreType.hpp"
+
+namespace TE::Terrain {
+// 噪声值与格点内的小数坐标都是 Q12 定点数: NoiseOne 表示 1.0
+//
+// 全程只用 32 位整数运算 (加减、低 32 位乘法、移位、按位运算), 不涉及浮点舍入和 FMA,
+// 因此任何指令集、任何编译选项下同一种子的结果都逐位一致, 存档里只需记种子
+inline constexpr int32 NoiseFracBits = 12;
+inline constexpr int32 NoiseOne      = 1 << NoiseFracBits;
+
+// 多个倍频叠加的梯度噪声 (fBm)
+//
+// 第 o 个倍频 (从 0 开始) 的格点间距为 2^(CellShift - o) 个体素, 振幅为 2^-o;
+// 间距缩到 1 个体素后的倍频恒为 0 (梯度噪声在格点上为 0), 因此实际倍频数不超过 CellShift
+struct FNoiseOctaves {
+    uint32 Seed       = 0;
+    int32  CellShift  = 6;
+    int32  NumOctaves = 4;
+};
+
+// 结果绝对值的严格上界: 单个倍频不超过 2 * NoiseOne, 振幅逐个减半, 叠加后不超过两倍.
+// 实际单个倍频很少超出 ±NoiseOne, 平均绝对值约为 NoiseOne / 4
+inline constexpr int32 FbmBound = 4 * NoiseOne;
+
+enum class ETerrainSimd : uint8 {
+    Scalar,
+    Sse41,
+    Avx2,
+    Avx512,
+};
+
+// 当前 CPU 与编译器支持的最高指令集
+ETerrainSimd GetSupportedTerrainSimd();
+
+// 实际使用的指令集, 默认为支持的最高一档; 设置时不会超过 GetSupportedTerrainSimd
+// 主要供测试与基准对比各条路径
+ETerrainSimd GetTerrainSimd();
+void         SetTerrainSimd(ETerrainSimd Simd);
+
+// 一次处理的体素数: 标量 1, SSE4.1 4, AVX2 8, AVX-512 16
+uint32 GetTerrainSimdLanes(ETerrainSimd Simd);
+
+// 对体素 (X0 + i, Y, Z), i ∈ [0, Count) 求 3D fBm, 写入 Out[i]
+void EvaluateFbm3D(const FNoiseOctaves &Octaves, int32 X0, int32 Y, int32 Z, uint32 Count,
+                   int32 *Out);
+
+// 对体素列 (X0 + i, Z), i ∈ [0, Count) 求 2D fBm (例如高度图), 写入 Out[i]
+void EvaluateFbm2D(const FNoiseOctaves &Octaves, int32 X0, int32 Z, uint32 Count, int32 *Out);
+
+// 单点版本, 与批量版本的结果完全一致
+int32 EvaluateFbm3D(const FNoiseOctaves &Octaves, int32 X, int32 Y, int32 Z);
+int32 EvaluateFbm2D(const FNoiseOctaves &Octaves, int32 X, int32 Z);
+} // namespace TE::Terrain
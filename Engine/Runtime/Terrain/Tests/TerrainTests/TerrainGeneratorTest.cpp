@@ -0,0 +1,127 @@
+/******************************************************
+ * @file TerrainTests/TerrainGeneratorTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Terrain/TerrainGenerator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace TE::Terrain;
+using namespace TE::Voxel;
+using namespace TE;
+
+namespace {
+std::vector<FVoxel> UnpackChunk(const FVoxelChunk &Chunk) {
+    std::vector<FVoxel> Voxels(ChunkVolume);
+    Chunk.Unpack(Voxels.data());
+    return Voxels;
+}
+
+// 地表附近、海平面以下、深处与天空的区块
+const FChunkCoord TestCoords[] = { { 0, 0, 0 },  { 3, -1, -2 }, { -5, 1, 7 },
+                                   { 1, -4, 1 }, { 2, 6, 0 },   { -9, -1, -9 } };
+} // namespace
+
+TEST(TerrainGeneratorTest, SameWorldOnEveryIsa) {
+    const ETerrainSimd      Saved = GetTerrainSimd();
+    const FTerrainGenerator Generator({ .Seed = 42 });
+
+    SetTerrainSimd(ETerrainSimd::Scalar);
+    std::vector<std::vector<FVoxel>> Expected;
+    for (const FChunkCoord &Coord: TestCoords) {
+        FVoxelChunk Chunk;
+        Generator.GenerateChunk(Coord, Chunk);
+        Expected.push_back(UnpackChunk(Chunk));
+    }
+    for (int32 Simd = 1; Simd <= int32(GetSupportedTerrainSimd()); ++Simd) {
+        SetTerrainSimd(ETerrainSimd(Simd));
+        for (std::size_t Index = 0; Index < std::size(TestCoords); ++Index) {
+            FVoxelChunk Chunk(7);
+            Generator.GenerateChunk(TestCoords[Index], Chunk);
+            EXPECT_EQ(UnpackChunk(Chunk), Expected[Index]);
+        }
+    }
+    SetTerrainSimd(Saved);
+
+    // 天空全是空气, 深处有石头也有洞穴
+    FVoxelChunk Chunk;
+    Generator.GenerateChunk({ 2, 6, 0 }, Chunk);
+    EXPECT_TRUE(Chunk.IsEmpty());
+    Generator.GenerateChunk({ 1, -4, 1 }, Chunk);
+    EXPECT_EQ(Chunk.NumDistinctVoxels(), 2u);
+    EXPECT_FALSE(Chunk.IsUniform());
+}
+
+TEST(TerrainGeneratorTest, SurfaceLayers) {
+    // 不挖洞时每一列都是 石头 / 泥土 / 草 (或海底的沙子) / 水 / 空气
+    FTerrainSettings Settings;
+    Settings.Seed          = 7;
+    Settings.CaveThreshold = 0;
+    const FTerrainGenerator Generator(Settings);
+
+    int32 NumLand  = 0;
+    int32 NumOcean = 0;
+    for (int32 ChunkX = -2; ChunkX < 2; ++ChunkX) {
+        for (int32 ChunkY = -3; ChunkY < 3; ++ChunkY) {
+            FVoxelChunk Chunk;
+            Generator.GenerateChunk({ ChunkX, ChunkY, 3 }, Chunk);
+            for (int32 Z = 0; Z < ChunkDim; Z += 7) {
+                for (int32 X = 0; X < ChunkDim; X += 5) {
+                    const int32 WorldX = ChunkX * ChunkDim + X;
+                    const int32 WorldZ = 3 * ChunkDim + Z;
+                    const int32 Height = Generator.GetSurfaceHeight(WorldX, WorldZ);
+                    const bool  bLand  = Height >= Settings.SeaLevel;
+                    NumLand += bLand && ChunkY == 0;
+                    NumOcean += !bLand && ChunkY == 0;
+                    for (int32 Y = 0; Y < ChunkDim; ++Y) {
+                        const int32 WorldY   = ChunkY * ChunkDim + Y;
+                        FVoxel      Expected = Settings.Stone;
+                        if (WorldY > Height) {
+                            Expected = WorldY <= Settings.SeaLevel ? Settings.Water : AirVoxel;
+                        } else if (WorldY > Height - Settings.SoilDepth) {
+                            Expected = !bLand                ? Settings.Sand
+                                       : WorldY == Height ? Settings.Grass
+                                                          : Settings.Dirt;
+                        }
+                        ASSERT_EQ(Chunk.Get(X, Y, Z), Expected);
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_GT(NumLand, 0);
+    EXPECT_GT(NumOcean, 0);
+
+    FVoxelChunk Deep;
+    Generator.GenerateChunk({ 0, -20, 0 }, Deep);
+    EXPECT_TRUE(Deep.IsUniform());
+    EXPECT_EQ(Deep.Get(0u), Settings.Stone);
+}
+
+TEST(TerrainGeneratorTest, OneTaskPerChunk) {
+    const FTerrainGenerator Generator({ .Seed = 99 });
+    std::vector<FChunkCoord> Coords;
+    for (int32 Z = -2; Z <= 2; ++Z) {
+        for (int32 Y = -2; Y <= 1; ++Y) {
+            for (int32 X = -2; X <= 2; ++X) {
+                Coords.push_back({ X, Y, Z });
+            }
+        }
+    }
+    std::vector<FVoxelChunk>        Chunks(Coords.size());
+    std::vector<Tasks::TTask<void>> Pending;
+    for (std::size_t Index = 0; Index < Coords.size(); ++Index) {
+        Pending.push_back(Generator.LaunchGenerateChunk(Coords[Index], Chunks[Index]));
+    }
+    Tasks::Wait(Pending);
+
+    for (std::size_t Index = 0; Index < Coords.size(); ++Index) {
+        FVoxelChunk Expected;
+        Generator.GenerateChunk(Coords[Index], Expected);
+        ASSERT_EQ(UnpackChunk(Chunks[Index]), UnpackChunk(Expected));
+        EXPECT_EQ(Chunks[Index].GetBrickMask(), Expected.GetBrickMask());
+    }
+}
@@ -0,0 +1,112 @@
+/******************************************************
+ * @file TerrainTests/TerrainNoiseTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Terrain/TerrainNoise.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace TE::Terrain;
+
+namespace {
+// 恢复默认指令集, 避免影响同进程里的其他测试
+struct FSimdGuard {
+    ETerrainSimd Saved = GetTerrainSimd();
+    ~FSimdGuard() { SetTerrainSimd(Saved); }
+};
+
+uint64 HashValues(const std::vector<int32> &Values) {
+    uint64 Hash = 1469598103934665603ull;
+    for (int32 Value: Values) {
+        Hash = (Hash ^ uint32(Value)) * 1099511628211ull;
+    }
+    return Hash;
+}
+} // namespace
+
+TEST(TerrainNoiseTest, EveryIsaMatchesScalar) {
+    FSimdGuard    Guard;
+    std::mt19937  Random(3);
+    FNoiseOctaves Octaves[] = { { 1, 6, 4 }, { 0xDEADBEEF, 12, 12 }, { 77, 3, 8 }, { 5, 1, 1 } };
+    for (int32 Simd = 0; Simd <= int32(GetSupportedTerrainSimd()); ++Simd) {
+        SetTerrainSimd(ETerrainSimd(Simd));
+        ASSERT_EQ(GetTerrainSimd(), ETerrainSimd(Simd));
+        for (const FNoiseOctaves &Octave: Octaves) {
+            for (int32 Round = 0; Round < 50; ++Round) {
+                // 包含负坐标与不足一组的尾部
+                const int32  X0    = int32(Random() % 4000) - 2000;
+                const int32  Y     = int32(Random() % 4000) - 2000;
+                const int32  Z     = int32(Random() % 4000) - 2000;
+                const uint32 Count = 1 + Random() % 37;
+                std::vector<int32> Row3(Count + 1, 12345);
+                std::vector<int32> Row2(Count + 1, 12345);
+                EvaluateFbm3D(Octave, X0, Y, Z, Count, Row3.data());
+                EvaluateFbm2D(Octave, X0, Z, Count, Row2.data());
+                for (uint32 Index = 0; Index < Count; ++Index) {
+                    ASSERT_EQ(Row3[Index], EvaluateFbm3D(Octave, X0 + int32(Index), Y, Z));
+                    ASSERT_EQ(Row2[Index], EvaluateFbm2D(Octave, X0 + int32(Index), Z));
+                }
+                // 不写越界
+                EXPECT_EQ(Row3[Count], 12345);
+                EXPECT_EQ(Row2[Count], 12345);
+            }
+        }
+    }
+    EXPECT_GE(GetTerrainSimdLanes(GetSupportedTerrainSimd()), 1u);
+}
+
+TEST(TerrainNoiseTest, StableAcrossBuilds) {
+    // 同一种子在任何平台、任何版本上都必须生成同样的世界; 改动噪声算法需要同时更新这里
+    const FNoiseOctaves Octaves = { 2024, 7, 5 };
+    std::vector<int32>  Values;
+    for (int32 Z = -40; Z < 40; Z += 3) {
+        for (int32 Y = -40; Y < 40; Y += 7) {
+            std::vector<int32> Row(96);
+            EvaluateFbm3D(Octaves, -48, Y, Z, 96, Row.data());
+            Values.insert(Values.end(), Row.begin(), Row.end());
+        }
+        std::vector<int32> Row(96);
+        EvaluateFbm2D(Octaves, -48, Z, 96, Row.data());
+        Values.insert(Values.end(), Row.begin(), Row.end());
+    }
+    EXPECT_EQ(HashValues(Values), 1793407664237623276ull);
+}
+
+TEST(TerrainNoiseTest, RangeAndContinuity) {
+    const FNoiseOctaves Single = { 9, 4, 1 };
+    // 梯度噪声在格点上为 0
+    EXPECT_EQ(EvaluateFbm3D(Single, 16, -32, 48), 0);
+    EXPECT_EQ(EvaluateFbm2D(Single, -16, 32), 0);
+
+    const FNoiseOctaves Octaves = { 9, 5, 4 };
+    int32               MaxAbs  = 0;
+    int32               MaxStep = 0;
+    int64               Sum     = 0;
+    for (int32 Z = 0; Z < 256; Z += 5) {
+        for (int32 Y = 0; Y < 256; Y += 5) {
+            int32 Row[256];
+            EvaluateFbm3D(Octaves, -128, Y, Z, 256, Row);
+            for (int32 Index = 0; Index < 256; ++Index) {
+                MaxAbs = std::max(MaxAbs, std::abs(Row[Index]));
+                Sum += Row[Index];
+                if (Index > 0) {
+                    MaxStep = std::max(MaxStep, std::abs(Row[Index] - Row[Index - 1]));
+                }
+            }
+        }
+    }
+    EXPECT_LE(MaxAbs, FbmBound);
+    EXPECT_GT(MaxAbs, NoiseOne / 4);
+    // 相邻体素之间平滑过渡; 整体均值接近 0
+    EXPECT_LT(MaxStep, NoiseOne / 4);
+    EXPECT_LT(std::abs(Sum / (52 * 52 * 256)), NoiseOne / 16);
+
+    // 不同种子得到不同的噪声
+    EXPECT_NE(EvaluateFbm3D({ 1, 8, 6 }, 100, 37, 5), EvaluateFbm3D({ 2, 8, 6 }, 100, 37, 5));
+}
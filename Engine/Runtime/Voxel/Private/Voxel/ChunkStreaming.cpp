@@ -0,0 +1,406 @@
+/******************************************************
+ * @file Voxel/ChunkStreaming.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/ChunkStreaming.hpp"
+
+#include <algorithm>
+
+namespace TE::Voxel {
+namespace {
+const TCHAR *const StageDebugNames[ChunkStreamingStageCount] = {
+    TEXT("StreamLoadChunk"),
+    TEXT("StreamGenerateChunk"),
+    TEXT("StreamLightChunk"),
+    TEXT("StreamMeshChunk"),
+};
+
+uint32 ToIndex(EChunkStreamingStage Stage) {
+    return uint32(Stage);
+}
+} // namespace
+
+FChunkStreamer::FChunkStreamer(FVoxelMap &InMap, FChunkStreamingCallbacks InCallbacks,
+                               const FChunkStreamingSettings &InSettings)
+    : Map(InMap), Callbacks(std::move(InCallbacks)), Settings(InSettings) {
+    check(Callbacks.Generate);
+    for (uint32 Stage = 0; Stage < ChunkStreamingStageCount; ++Stage) {
+        check(Settings.MaxInFlight[Stage] > 0);
+    }
+}
+
+FChunkStreamer::~FChunkStreamer() {
+    // 任务引用着请求和回调, 必须在析构前全部完成
+    for (const std::vector<FRequest *> &Stage: InFlight) {
+        for (FRequest *Request: Stage) {
+            Request->Task.Wait();
+        }
+    }
+}
+
+void FChunkStreamer::Update(const FChunkCoord &InPlayerChunk) {
+    CollectCompleted();
+    if (!bHasPlayerChunk || !(InPlayerChunk == PlayerChunk)) {
+        PlayerChunk     = InPlayerChunk;
+        bHasPlayerChunk = true;
+        OnPlayerMoved();
+    }
+    if (bResidentChanged) {
+        bResidentChanged = false;
+        for (FRequest *Request: WaitingForNeighbours) {
+            Enqueue(*Request);
+        }
+        WaitingForNeighbours.clear();
+    }
+    Dispatch();
+}
+
+void FChunkStreamer::RequestRemesh(const FChunkCoord &Coord) {
+    if (!Resident.contains(Coord) || !IsInMeshRange(Coord)) {
+        return;
+    }
+    auto It = Requests.find(Coord);
+    if (It == Requests.end()) {
+        AddRequest(Coord, EChunkStreamingStage::Mesh);
+    } else if (It->second->State == ERequestState::InFlight) {
+        // 执行中的任务用的是旧数据
+        It->second->bRemeshAgain = true;
+    }
+    // 排队中的请求会在分发时读取最新数据, 不需要处理
+}
+
+void FChunkStreamer::Flush() {
+    for (const std::vector<FRequest *> &Stage: InFlight) {
+        for (FRequest *Request: Stage) {
+            Request->Task.Wait();
+        }
+    }
+    CollectCompleted();
+}
+
+bool FChunkStreamer::IsIdle() const {
+    return Requests.empty();
+}
+
+FChunkStreamingStats FChunkStreamer::GetStats() const {
+    FChunkStreamingStats Stats;
+    for (const auto &[Coord, Request]: Requests) {
+        const uint32 Stage = ToIndex(Request->Stage);
+        switch (Request->State) {
+        case ERequestState::Queued:
+            ++Stats.NumQueued[Stage];
+            break;
+        case ERequestState::WaitingForNeighbours:
+            ++Stats.NumWaitingForNeighbours;
+            break;
+        case ERequestState::InFlight:
+            ++Stats.NumInFlight[Stage];
+            break;
+        }
+    }
+    Stats.NumResident      = uint32(Resident.size());
+    Stats.NumPendingMeshes = uint32(ReadyMeshes.size());
+    Stats.NumCancelled     = NumCancelled;
+    return Stats;
+}
+
+int32 FChunkStreamer::GetDistance(const FChunkCoord &Coord) const {
+    const int32 DX = Coord.X - PlayerChunk.X;
+    const int32 DY = Coord.Y - PlayerChunk.Y;
+    const int32 DZ = Coord.Z - PlayerChunk.Z;
+    return DX * DX + DY * DY + DZ * DZ;
+}
+
+bool FChunkStreamer::IsInRange(const FChunkCoord &Coord, int32 Radius,
+                               int32 VerticalRadius) const {
+    const int32 DX = Coord.X - PlayerChunk.X;
+    const int32 DY = Coord.Y - PlayerChunk.Y;
+    const int32 DZ = Coord.Z - PlayerChunk.Z;
+    return DX * DX + DZ * DZ <= Radius * Radius && DY >= -VerticalRadius && DY <= VerticalRadius;
+}
+
+bool FChunkStreamer::IsInLoadRange(const FChunkCoord &Coord) const {
+    return IsInRange(Coord, Settings.ViewRadius + 1, Settings.VerticalRadius + 1);
+}
+
+bool FChunkStreamer::IsInMeshRange(const FChunkCoord &Coord) const {
+    return IsInRange(Coord, Settings.ViewRadius, Settings.VerticalRadius);
+}
+
+bool FChunkStreamer::IsWanted(const FRequest &Request) const {
+    return Request.Stage == EChunkStreamingStage::Mesh ? IsInMeshRange(Request.Coord)
+                                                       : IsInLoadRange(Request.Coord);
+}
+
+FChunkStreamer::FRequest &FChunkStreamer::AddRequest(const FChunkCoord &Coord,
+                                                     EChunkStreamingStage Stage) {
+    std::unique_ptr<FRequest> &Request = Requests[Coord];
+    check(!Request);
+    Request        = std::make_unique<FRequest>();
+    Request->Coord = Coord;
+    Request->Stage = Stage;
+    Enqueue(*Request);
+    return *Request;
+}
+
+void FChunkStreamer::Enqueue(FRequest &Request) {
+    Request.State = ERequestState::Queued;
+    std::vector<FQueueEntry> &Queue = Queues[ToIndex(Request.Stage)];
+    Queue.push_back({ GetDistance(Request.Coord), Request.Coord });
+    std::push_heap(Queue.begin(), Queue.end());
+}
+
+EChunkStreamingStage FChunkStreamer::GetNextStage(EChunkStreamingStage Stage) const {
+    switch (Stage) {
+    case EChunkStreamingStage::Load:
+        return EChunkStreamingStage::Generate;
+    case EChunkStreamingStage::Generate:
+        return Callbacks.Light ? EChunkStreamingStage::Light : EChunkStreamingStage::Mesh;
+    default:
+        return EChunkStreamingStage::Mesh;
+    }
+}
+
+void FChunkStreamer::CollectCompleted() {
+    for (std::vector<FRequest *> &Stage: InFlight) {
+        for (std::size_t Index = 0; Index < Stage.size();) {
+            FRequest *Request = Stage[Index];
+            if (!Request->Task.IsCompleted()) {
+                ++Index;
+                continue;
+            }
+            Stage[Index] = Stage.back();
+            Stage.pop_back();
+            OnStageCompleted(*Request);
+        }
+    }
+}
+
+void FChunkStreamer::OnStageCompleted(FRequest &Request) {
+    // 请求可能在本函数中被移除, 先拷贝坐标
+    const FChunkCoord Coord = Request.Coord;
+    Request.Task            = {};
+    if (!IsWanted(Request)) {
+        ++NumCancelled;
+        Requests.erase(Coord);
+        return;
+    }
+
+    switch (Request.Stage) {
+    case EChunkStreamingStage::Load:
+        // 从存档读到的区块跳过生成
+        Request.Stage = GetNextStage(Request.bLoaded ? EChunkStreamingStage::Generate
+                                                     : EChunkStreamingStage::Load);
+        break;
+    case EChunkStreamingStage::Generate:
+    case EChunkStreamingStage::Light:
+        Request.Stage = GetNextStage(Request.Stage);
+        break;
+    case EChunkStreamingStage::Mesh:
+        if (Request.bRemeshAgain) {
+            Request.bRemeshAgain = false;
+            Request.Chunk.reset();
+            Enqueue(Request);
+            return;
+        }
+        Meshed.insert(Coord);
+        ReadyMeshes.emplace_back(Coord, std::move(Request.Mesh));
+        Requests.erase(Coord);
+        return;
+    default:
+        break;
+    }
+
+    if (Request.Stage != EChunkStreamingStage::Mesh) {
+        Enqueue(Request);
+        return;
+    }
+    MakeResident(Request);
+    if (IsInMeshRange(Coord)) {
+        Enqueue(Request);
+    } else {
+        // 加载范围最外一圈只提供邻居数据, 不生成网格
+        Requests.erase(Coord);
+    }
+}
+
+void FChunkStreamer::MakeResident(FRequest &Request) {
+    // 全空气的区块不占用 Map
+    if (!Request.Chunk->IsEmpty()) {
+        Map.FindOrAddChunk(Request.Coord) = std::move(*Request.Chunk);
+    }
+    Request.Chunk.reset();
+    Resident.insert(Request.Coord);
+    bResidentChanged = true;
+}
+
+void FChunkStreamer::OnPlayerMoved() {
+    // 排队或等待中、已不在范围内的请求直接丢弃; 执行中的在完成时检查
+    WaitingForNeighbours.clear();
+    for (std::vector<FQueueEntry> &Queue: Queues) {
+        Queue.clear();
+    }
+    for (auto It = Requests.begin(); It != Requests.end();) {
+        if (It->second->State != ERequestState::InFlight && !IsWanted(*It->second)) {
+            ++NumCancelled;
+            It = Requests.erase(It);
+        } else {
+            ++It;
+        }
+    }
+
+    const int32 UnloadRadius   = Settings.ViewRadius + 1 + Settings.UnloadMargin;
+    const int32 UnloadVertical = Settings.VerticalRadius + 1 + Settings.UnloadMargin;
+    std::vector<FChunkCoord> ToUnload;
+    for (const FChunkCoord &Coord: Resident) {
+        if (!IsInRange(Coord, UnloadRadius, UnloadVertical)) {
+            ToUnload.push_back(Coord);
+        }
+    }
+    for (const FChunkCoord &Coord: ToUnload) {
+        UnloadChunk(Coord);
+    }
+
+    // 为新进入范围的区块发起请求
+    const int32                Radius   = Settings.ViewRadius + 1;
+    const int32                Vertical = Settings.VerticalRadius + 1;
+    const EChunkStreamingStage First =
+        Callbacks.Load ? EChunkStreamingStage::Load : EChunkStreamingStage::Generate;
+    for (int32 DY = -Vertical; DY <= Vertical; ++DY) {
+        for (int32 DZ = -Radius; DZ <= Radius; ++DZ) {
+            for (int32 DX = -Radius; DX <= Radius; ++DX) {
+                const FChunkCoord Coord = { PlayerChunk.X + DX, PlayerChunk.Y + DY,
+                                            PlayerChunk.Z + DZ };
+                if (!IsInLoadRange(Coord) || Requests.contains(Coord)) {
+                    continue;
+                }
+                EChunkStreamingStage Stage = First;
+                if (Resident.contains(Coord)) {
+                    if (!IsInMeshRange(Coord) || Meshed.contains(Coord)) {
+                        continue;
+                    }
+                    Stage = EChunkStreamingStage::Mesh;
+                }
+                // 下面统一入队
+                std::unique_ptr<FRequest> &Request = Requests[Coord];
+                Request                            = std::make_unique<FRequest>();
+                Request->Coord                     = Coord;
+                Request->Stage                     = Stage;
+            }
+        }
+    }
+
+    // 以新位置重新计算所有排队请求的优先级
+    for (auto &[Coord, Request]: Requests) {
+        if (Request->State != ERequestState::InFlight) {
+            Queues[ToIndex(Request->Stage)].push_back({ GetDistance(Coord), Coord });
+            Request->State = ERequestState::Queued;
+        }
+    }
+    for (std::vector<FQueueEntry> &Queue: Queues) {
+        std::make_heap(Queue.begin(), Queue.end());
+    }
+}
+
+void FChunkStreamer::UnloadChunk(const FChunkCoord &Coord) {
+    if (Callbacks.Unload) {
+        const FVoxelChunk *Chunk = Map.FindChunk(Coord);
+        Callbacks.Unload(Coord, Chunk ? *Chunk : FVoxelChunk());
+    }
+    Map.RemoveChunk(Coord);
+    Resident.erase(Coord);
+    Meshed.erase(Coord);
+    std::erase_if(ReadyMeshes, [&](const auto &Ready) { return Ready.first == Coord; });
+}
+
+bool FChunkStreamer::AreNeighboursResident(const FChunkCoord &Coord) const {
+    const FChunkCoord Neighbours[6] = {
+        { Coord.X + 1, Coord.Y, Coord.Z }, { Coord.X - 1, Coord.Y, Coord.Z },
+        { Coord.X, Coord.Y + 1, Coord.Z }, { Coord.X, Coord.Y - 1, Coord.Z },
+        { Coord.X, Coord.Y, Coord.Z + 1 }, { Coord.X, Coord.Y, Coord.Z - 1 },
+    };
+    return std::all_of(
+        std::begin(Neighbours), std::end(Neighbours),
+        [this](const FChunkCoord &Neighbour) { return Resident.contains(Neighbour); });
+}
+
+void FChunkStreamer::Dispatch() {
+    for (uint32 Stage = 0; Stage < ChunkStreamingStageCount; ++Stage) {
+        std::vector<FQueueEntry> &Queue = Queues[Stage];
+        const bool bMesh = Stage == ToIndex(EChunkStreamingStage::Mesh);
+        while (!Queue.empty() && InFlight[Stage].size() < Settings.MaxInFlight[Stage]) {
+            if (bMesh && ReadyMeshes.size() + InFlight[Stage].size() >= Settings.MaxPendingMeshes) {
+                break;
+            }
+            std::pop_heap(Queue.begin(), Queue.end());
+            const FChunkCoord Coord = Queue.back().Coord;
+            Queue.pop_back();
+
+            // 请求可能已被丢弃后又重新发起, 堆中会残留过期的项
+            auto It = Requests.find(Coord);
+            if (It == Requests.end() || ToIndex(It->second->Stage) != Stage ||
+                It->second->State != ERequestState::Queued) {
+                continue;
+            }
+            FRequest &Request = *It->second;
+            if (!bMesh) {
+                Launch(Request);
+                continue;
+            }
+
+            if (!AreNeighboursResident(Coord)) {
+                Request.State = ERequestState::WaitingForNeighbours;
+                WaitingForNeighbours.push_back(&Request);
+                continue;
+            }
+            const FVoxelChunk *Chunk = Map.FindChunk(Coord);
+            if (!Chunk || Chunk->IsEmpty()) {
+                // 不需要任务; 之前交出过网格时交出一个空网格, 让渲染端清掉旧的
+                if (!Meshed.insert(Coord).second) {
+                    ReadyMeshes.emplace_back(Coord, std::make_unique<FVoxelMesh>());
+                }
+                Requests.erase(It);
+                continue;
+            }
+            // 拷贝区块和邻居边界, 任务执行期间游戏线程可以继续修改 Map
+            Request.Chunk = std::make_unique<FVoxelChunk>(*Chunk);
+            GatherChunkBorders(Map, Coord, Request.Borders);
+            Launch(Request);
+        }
+    }
+}
+
+void FChunkStreamer::Launch(FRequest &Request) {
+    Request.State = ERequestState::InFlight;
+    InFlight[ToIndex(Request.Stage)].push_back(&Request);
+
+    FRequest *Target = &Request;
+    auto      Body   = [this, Target] {
+        switch (Target->Stage) {
+        case EChunkStreamingStage::Load:
+            Target->bLoaded = Callbacks.Load(Target->Coord, *Target->Chunk);
+            break;
+        case EChunkStreamingStage::Generate:
+            Target->Chunk->Fill(AirVoxel);
+            Callbacks.Generate(Target->Coord, *Target->Chunk);
+            break;
+        case EChunkStreamingStage::Light:
+            Callbacks.Light(Target->Coord, *Target->Chunk);
+            break;
+        case EChunkStreamingStage::Mesh:
+            GenerateChunkMesh(*Target->Chunk, Target->Borders, *Target->Mesh);
+            break;
+        default:
+            break;
+        }
+    };
+    if (Request.Stage == EChunkStreamingStage::Mesh) {
+        Request.Mesh = std::make_unique<FVoxelMesh>();
+    } else if (!Request.Chunk) {
+        Request.Chunk = std::make_unique<FVoxelChunk>();
+    }
+    Request.Task = Tasks::Launch(StageDebugNames[ToIndex(Request.Stage)], std::move(Body),
+                                 Tasks::ETaskPriority::Background);
+}
+} // namespace TE::Voxel
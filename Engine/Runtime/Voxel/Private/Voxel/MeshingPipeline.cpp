@@ -0,0 +1,56 @@
+/******************************************************
+ * @file Voxel/MeshingPipeline.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/MeshingPipeline.hpp"
+
+#include <algorithm>
+
+namespace TE::Voxel {
+void FMeshingPipeline::MarkVoxelDirty(int32 X, int32 Y, int32 Z) {
+    const FChunkCoord Coord = GetChunkCoord(X, Y, Z);
+    MarkChunkDirty(Coord);
+    const int32 Local[3] = { X & ChunkMask, Y & ChunkMask, Z & ChunkMask };
+    for (int32 Axis = 0; Axis < 3; ++Axis) {
+        int32 Offset[3] = { 0, 0, 0 };
+        if (Local[Axis] == 0) {
+            Offset[Axis] = -1;
+        } else if (Local[Axis] == ChunkMask) {
+            Offset[Axis] = 1;
+        } else {
+            continue;
+        }
+        MarkChunkDirty({ Coord.X + Offset[0], Coord.Y + Offset[1], Coord.Z + Offset[2] });
+    }
+}
+
+void FMeshingPipeline::Kick() {
+    Wait();
+    InFlight.reserve(DirtyChunks.size());
+    for (const FChunkCoord &Coord: DirtyChunks) {
+        if (!Map.FindChunk(Coord)) {
+            Meshes.erase(Coord);
+            continue;
+        }
+        std::unique_ptr<FVoxelMesh> &Mesh = Meshes[Coord];
+        if (!Mesh) {
+            Mesh = std::make_unique<FVoxelMesh>();
+        }
+        InFlight.push_back(Tasks::Launch(
+            TEXT("MeshChunk"),
+            [this, Coord, Target = Mesh.get()] { GenerateChunkMesh(Map, Coord, *Target); }));
+    }
+    DirtyChunks.clear();
+}
+
+void FMeshingPipeline::Wait() {
+    Tasks::Wait(InFlight);
+    InFlight.clear();
+}
+
+bool FMeshingPipeline::IsIdle() const {
+    return std::all_of(InFlight.begin(), InFlight.end(),
+                       [](const Tasks::TTask<void> &Task) { return Task.IsCompleted(); });
+}
+} // namespace TE::Voxel
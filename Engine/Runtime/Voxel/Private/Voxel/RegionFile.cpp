@@ -0,0 +1,475 @@
+/******************************************************
+ * @file Voxel/RegionFile.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/RegionFile.hpp"
+#include "Async/UniqueLock.hpp"
+#include "Compression/LzCompression.hpp"
+#include "FileSystem/MappedFile.hpp"
+
+#include <bit>
+#include <cstring>
+#include <vector>
+
+namespace TE::Voxel {
+static_assert(std::endian::native == std::endian::little, "Region files are stored little-endian");
+
+namespace {
+using TE::Compression::LzCompress;
+using TE::Compression::LzDecompress;
+
+constexpr uint32 RegionMagic   = 0x47524554; // "TERG"
+constexpr uint32 RegionVersion = 2;
+constexpr uint64 FooterMagic   = 0x544F4F4647524554ull; // "TERGFOOT"
+
+// 超过该大小且垃圾过半时自动整理
+constexpr uint64 AutoCompactMinSize = 1 << 20;
+
+struct FFileHeader {
+    uint32 Magic;
+    uint32 Version;
+};
+
+// 追加在每份列表之后
+struct FFooter {
+    uint64 Magic;
+    uint64 TableHash;
+};
+
+// 列数据开头的目录, 偏移相对列数据起点, Size 为 0 表示该 section 不存在
+struct FColumnDirectory {
+    uint32 SectionOffsets[SectionsPerColumn];
+    uint32 SectionSizes[SectionsPerColumn];
+};
+
+enum ESectionFlags : uint8 {
+    SectionCompressed = 1 << 0,
+};
+
+// section 记录头, 之后紧跟调色板和 (可能压缩的) 下标数组
+struct FSectionHeader {
+    // 记录中 Hash 之后全部字节的校验和
+    uint64 Hash;
+    uint8  BitsPerIndex;
+    uint8  Flags;
+    // 调色板大小 - 1, 16 位下标时调色板最多 65536 项
+    uint16 PaletteSizeMinusOne;
+    uint32 DataSize;
+};
+
+using FColumnEntry = FRegionFile::FColumnEntry;
+using FColumnTable = FRegionFile::FColumnTable;
+
+static_assert(sizeof(FColumnEntry) == 16 && sizeof(FFooter) == 16);
+static_assert(sizeof(FColumnDirectory) % 8 == 0 && sizeof(FSectionHeader) % 8 == 0);
+
+constexpr uint64 TableBytes  = sizeof(FColumnTable);
+constexpr uint64 HeaderBytes = sizeof(FFileHeader) + TableBytes;
+
+constexpr uint64 AlignUp(uint64 Value) {
+    return (Value + 7) & ~uint64(7);
+}
+
+// 每次处理 8 字节的乘法混合哈希, 只用于发现损坏, 不要求抗碰撞
+uint64 HashBytes(const uint8 *Bytes, std::size_t Size) {
+    constexpr uint64 Prime = 0x9E3779B97F4A7C15ull;
+    uint64           Hash  = Size * Prime;
+    for (; Size >= 8; Bytes += 8, Size -= 8) {
+        uint64 Word;
+        std::memcpy(&Word, Bytes, 8);
+        Hash = std::rotl(Hash ^ (Word * Prime), 29) * 0xBF58476D1CE4E5B9ull;
+    }
+    uint64 Tail = 0;
+    std::memcpy(&Tail, Bytes, Size);
+    Hash ^= Tail * Prime;
+    Hash ^= Hash >> 31;
+    Hash *= 0x94D049BB133111EBull;
+    return Hash ^ (Hash >> 29);
+}
+
+template <typename T> void AppendBytes(std::vector<uint8> &Out, const T &Value) {
+    const uint8 *Bytes = reinterpret_cast<const uint8 *>(&Value);
+    Out.insert(Out.end(), Bytes, Bytes + sizeof(T));
+}
+
+void PadTo8(std::vector<uint8> &Out) {
+    Out.resize(AlignUp(Out.size()), 0);
+}
+
+int32 GetColumnIndex(const FChunkCoord &Coord) {
+    return (Coord.X & (RegionDim - 1)) | ((Coord.Z & (RegionDim - 1)) << RegionShift);
+}
+
+int32 GetSectionIndex(const FChunkCoord &Coord) {
+    return Coord.Y - MinSectionY;
+}
+
+// 把区块编码为一条 section 记录追加到 Out
+void EncodeSection(const FVoxelChunk &Chunk, std::vector<uint8> &Out) {
+    const FPackedChunk Packed = Chunk.GetPacked();
+    const std::size_t  Start  = Out.size();
+
+    FSectionHeader Header      = {};
+    Header.BitsPerIndex        = uint8(Packed.BitsPerIndex);
+    Header.PaletteSizeMinusOne = uint16(Packed.Palette.size() - 1);
+    AppendBytes(Out, Header);
+    const uint8 *Palette = reinterpret_cast<const uint8 *>(Packed.Palette.data());
+    Out.insert(Out.end(), Palette, Palette + Packed.Palette.size_bytes());
+
+    const std::size_t RawSize = Packed.Data.size_bytes();
+    if (RawSize > 0) {
+        // 输出容量比原始数据小一字节, 压缩失败即表示没有收益, 改存原始字节
+        const std::size_t DataStart = Out.size();
+        Out.resize(DataStart + RawSize);
+        std::size_t DataSize =
+            LzCompress(Packed.Data.data(), RawSize, Out.data() + DataStart, RawSize - 1);
+        if (DataSize != 0) {
+            Header.Flags |= SectionCompressed;
+        } else {
+            std::memcpy(Out.data() + DataStart, Packed.Data.data(), RawSize);
+            DataSize = RawSize;
+        }
+        Out.resize(DataStart + DataSize);
+        Header.DataSize = uint32(DataSize);
+    }
+    std::memcpy(Out.data() + Start, &Header, sizeof(Header));
+    Header.Hash = HashBytes(Out.data() + Start + sizeof(Header.Hash),
+                            Out.size() - Start - sizeof(Header.Hash));
+    std::memcpy(Out.data() + Start, &Header.Hash, sizeof(Header.Hash));
+}
+
+// 从映射中的 section 记录直接解码到区块
+bool DecodeSection(const uint8 *Record, std::size_t Size, FVoxelChunk &OutChunk) {
+    FSectionHeader Header;
+    if (Size < sizeof(Header)) {
+        return false;
+    }
+    std::memcpy(&Header, Record, sizeof(Header));
+    const std::size_t PaletteSize = std::size_t(Header.PaletteSizeMinusOne) + 1;
+    if (sizeof(Header) + PaletteSize * sizeof(FVoxel) + Header.DataSize != Size ||
+        HashBytes(Record + sizeof(Header.Hash), Size - sizeof(Header.Hash)) != Header.Hash) {
+        return false;
+    }
+
+    // 记录在文件中 8 字节对齐, 映射按页对齐, 调色板可以原地引用
+    const uint8 *Palette = Record + sizeof(Header);
+    const uint8 *Data    = Palette + PaletteSize * sizeof(FVoxel);
+    FPackedChunk Packed;
+    Packed.BitsPerIndex = Header.BitsPerIndex;
+    Packed.Palette      = { reinterpret_cast<const FVoxel *>(Palette), PaletteSize };
+    return OutChunk.LoadPacked(Packed, [&](uint64 *Words, std::size_t NumWords) {
+        const std::size_t RawSize = NumWords * sizeof(uint64);
+        if (Header.Flags & SectionCompressed) {
+            return LzDecompress(Data, Header.DataSize, Words, RawSize);
+        }
+        if (Header.DataSize != RawSize) {
+            return false;
+        }
+        std::memcpy(Words, Data, RawSize);
+        return true;
+    });
+}
+
+// 校验列表项并返回列数据及其目录; 列不存在或损坏时返回 nullptr
+const uint8 *FindColumn(const FMappedFile &Mapping, const FColumnEntry &Entry,
+                        FColumnDirectory &OutDirectory) {
+    if (Entry.Size < sizeof(FColumnDirectory) || Entry.Offset > Mapping.GetSize() ||
+        Mapping.GetSize() - Entry.Offset < Entry.Size) {
+        return nullptr;
+    }
+    const uint8 *Column = Mapping.GetData() + Entry.Offset;
+    if (uint32(HashBytes(Column, sizeof(FColumnDirectory))) != Entry.Hash) {
+        return nullptr;
+    }
+    std::memcpy(&OutDirectory, Column, sizeof(OutDirectory));
+    return Column;
+}
+
+bool IsSectionInColumn(const FColumnDirectory &Directory, const FColumnEntry &Entry,
+                       int32 Section) {
+    const uint32 Offset = Directory.SectionOffsets[Section];
+    const uint32 Size   = Directory.SectionSizes[Section];
+    return Size != 0 && Offset >= sizeof(FColumnDirectory) && Offset <= Entry.Size &&
+           Entry.Size - Offset >= Size;
+}
+
+// 找到文件中最新的有效列表: 优先最后一个尾记录, 末尾写坏时向前查找, 都没有则使用头部列表
+bool ReadLatestTable(const FMappedFile &Mapping, FColumnTable &OutTable) {
+    const uint8 *Bytes = Mapping.GetData();
+    const uint64 Size  = Mapping.GetSize();
+    FFileHeader  Header;
+    if (Size < HeaderBytes) {
+        return false;
+    }
+    std::memcpy(&Header, Bytes, sizeof(Header));
+    if (Header.Magic != RegionMagic || Header.Version != RegionVersion) {
+        return false;
+    }
+
+    for (uint64 Footer = (Size - sizeof(FFooter)) & ~uint64(7); Footer >= HeaderBytes + TableBytes;
+         Footer -= 8) {
+        uint64 Magic;
+        std::memcpy(&Magic, Bytes + Footer, sizeof(Magic));
+        if (Magic != FooterMagic) {
+            continue;
+        }
+        FFooter Candidate;
+        std::memcpy(&Candidate, Bytes + Footer, sizeof(Candidate));
+        const uint8 *Table = Bytes + Footer - TableBytes;
+        if (HashBytes(Table, TableBytes) == Candidate.TableHash) {
+            std::memcpy(OutTable.data(), Table, TableBytes);
+            return true;
+        }
+    }
+    std::memcpy(OutTable.data(), Bytes + sizeof(FFileHeader), TableBytes);
+    return true;
+}
+} // namespace
+
+std::string GetRegionFileName(const FRegionCoord &Region) {
+    return "r." + std::to_string(Region.X) + "." + std::to_string(Region.Z) + ".region";
+}
+
+std::unique_ptr<FRegionFile> FRegionFile::Open(const std::string &Path,
+                                               const FRegionCoord &Region) {
+    std::unique_ptr<FRegionFile> File(new FRegionFile());
+    File->Path   = Path;
+    File->Region = Region;
+    File->Writer = FWritableFile::Open(Path, false);
+    if (!File->Writer) {
+        return nullptr;
+    }
+
+    FColumnTable Table = {};
+    const uint64 Size  = File->Writer->GetSize();
+    if (Size == 0) {
+        std::vector<uint8> Header;
+        AppendBytes(Header, FFileHeader{ RegionMagic, RegionVersion });
+        AppendBytes(Header, Table);
+        if (!File->Writer->Write(0, Header.data(), Header.size())) {
+            return nullptr;
+        }
+        File->EndOffset = HeaderBytes;
+    } else {
+        // 不认识的文件不覆盖
+        std::unique_ptr<FMappedFile> Mapping = FMappedFile::Map(Path);
+        if (!Mapping || !ReadLatestTable(*Mapping, Table)) {
+            return nullptr;
+        }
+        // 写坏的末尾留作垃圾, 新数据总是追加在其后, 以免末尾残留的旧尾记录被误认为最新
+        File->EndOffset = AlignUp(Size);
+    }
+    if (!File->Publish(Table)) {
+        return nullptr;
+    }
+    return File;
+}
+
+FRegionFile::~FRegionFile() = default;
+
+bool FRegionFile::LoadChunk(const FChunkCoord &Coord, FVoxelChunk &OutChunk) const {
+    const int32 Section = GetSectionIndex(Coord);
+    if (GetRegionCoord(Coord) != Region || Section < 0 || Section >= SectionsPerColumn) {
+        OutChunk.Fill(AirVoxel);
+        return false;
+    }
+    const std::shared_ptr<const FSnapshot> Current = GetSnapshot();
+    const FColumnEntry &Entry = Current->Table[GetColumnIndex(Coord)];
+    FColumnDirectory    Directory;
+    const uint8        *Column = FindColumn(*Current->Mapping, Entry, Directory);
+    if (!Column || !IsSectionInColumn(Directory, Entry, Section)) {
+        OutChunk.Fill(AirVoxel);
+        return false;
+    }
+    return DecodeSection(Column + Directory.SectionOffsets[Section],
+                         Directory.SectionSizes[Section], OutChunk);
+}
+
+bool FRegionFile::HasChunk(const FChunkCoord &Coord) const {
+    const int32 Section = GetSectionIndex(Coord);
+    if (GetRegionCoord(Coord) != Region || Section < 0 || Section >= SectionsPerColumn) {
+        return false;
+    }
+    const std::shared_ptr<const FSnapshot> Current = GetSnapshot();
+    const FColumnEntry &Entry = Current->Table[GetColumnIndex(Coord)];
+    FColumnDirectory    Directory;
+    return FindColumn(*Current->Mapping, Entry, Directory) &&
+           IsSectionInColumn(Directory, Entry, Section);
+}
+
+bool FRegionFile::SaveChunks(std::span<const FRegionChunkWrite> Writes) {
+    // 按列归并, 同一区块写多次以最后一次为准
+    struct FPendingColumn {
+        int32              Column = 0;
+        bool               bTouched[SectionsPerColumn] = {};
+        const FVoxelChunk *Chunks[SectionsPerColumn]   = {};
+    };
+    std::vector<FPendingColumn>         Pending;
+    std::array<int32, ColumnsPerRegion> PendingIndex;
+    PendingIndex.fill(-1);
+    for (const FRegionChunkWrite &Write: Writes) {
+        const int32 Section = GetSectionIndex(Write.Coord);
+        if (GetRegionCoord(Write.Coord) != Region || Section < 0 || Section >= SectionsPerColumn) {
+            return false;
+        }
+        int32 &Index = PendingIndex[GetColumnIndex(Write.Coord)];
+        if (Index < 0) {
+            Index = int32(Pending.size());
+            Pending.push_back({ GetColumnIndex(Write.Coord) });
+        }
+        Pending[Index].bTouched[Section] = true;
+        Pending[Index].Chunks[Section]   = Write.Chunk;
+    }
+    if (Pending.empty()) {
+        return true;
+    }
+
+    TUniqueLock                            Lock(WriteMutex);
+    const std::shared_ptr<const FSnapshot> Current = GetSnapshot();
+    FColumnTable                           Table   = Current->Table;
+
+    // 改动的列整列重写, 未改动的 section 直接复制旧记录的字节
+    std::vector<uint8> Blob;
+    for (const FPendingColumn &Column: Pending) {
+        FColumnDirectory OldDirectory;
+        const uint8     *OldColumn =
+            FindColumn(*Current->Mapping, Table[Column.Column], OldDirectory);
+
+        const std::size_t Start     = Blob.size();
+        FColumnDirectory  Directory = {};
+        Blob.resize(Start + sizeof(Directory));
+        for (int32 Section = 0; Section < SectionsPerColumn; ++Section) {
+            const std::size_t RecordStart = Blob.size();
+            if (Column.bTouched[Section]) {
+                if (!Column.Chunks[Section]) {
+                    continue;
+                }
+                EncodeSection(*Column.Chunks[Section], Blob);
+            } else if (OldColumn &&
+                       IsSectionInColumn(OldDirectory, Table[Column.Column], Section)) {
+                const uint8 *Record = OldColumn + OldDirectory.SectionOffsets[Section];
+                Blob.insert(Blob.end(), Record, Record + OldDirectory.SectionSizes[Section]);
+            } else {
+                continue;
+            }
+            Directory.SectionOffsets[Section] = uint32(RecordStart - Start);
+            Directory.SectionSizes[Section]   = uint32(Blob.size() - RecordStart);
+            PadTo8(Blob);
+        }
+
+        if (Blob.size() == Start + sizeof(Directory)) {
+            // 整列已无区块
+            Blob.resize(Start);
+            Table[Column.Column] = {};
+            continue;
+        }
+        std::memcpy(Blob.data() + Start, &Directory, sizeof(Directory));
+        Table[Column.Column] = { EndOffset + Start, uint32(Blob.size() - Start),
+                                uint32(HashBytes(Blob.data() + Start, sizeof(Directory))) };
+    }
+
+    // 列表和尾记录最后追加; 尾记录之前的内容写坏只会让本批次不可见.
+    // 不在每批之后 fsync: 断电时尾记录可能先于列数据落盘, 此时 section 校验和失败, 区块按缺失处理
+    AppendBytes(Blob, Table);
+    AppendBytes(Blob, FFooter{ FooterMagic, HashBytes(Blob.data() + Blob.size() - TableBytes,
+                                                      TableBytes) });
+    if (!Writer->Write(EndOffset, Blob.data(), Blob.size())) {
+        return false;
+    }
+    EndOffset += Blob.size();
+    if (!Publish(Table)) {
+        return false;
+    }
+
+    const FRegionFileStats Stats = GetStats();
+    if (Stats.FileSize > AutoCompactMinSize && Stats.LiveBytes * 2 < Stats.FileSize) {
+        // 整理失败 (例如 Windows 上仍有读者映射着原文件) 不影响本次写入, 下次再试
+        CompactLocked();
+    }
+    return true;
+}
+
+bool FRegionFile::Compact() {
+    TUniqueLock Lock(WriteMutex);
+    return CompactLocked();
+}
+
+bool FRegionFile::CompactLocked() {
+    const std::shared_ptr<const FSnapshot> Current  = GetSnapshot();
+    const std::string                      TempPath = Path + ".compact";
+
+    // 存活的列按原样复制到新文件, 列表写在头部, 不需要尾记录.
+    // Temp 在替换后直接作为新的写入句柄: 替换后再按路径打开可能失败, 那时旧句柄已指向被删除的文件
+    FColumnTable                   NewTable = {};
+    std::unique_ptr<FWritableFile> Temp     = FWritableFile::Open(TempPath, true);
+    if (!Temp) {
+        return false;
+    }
+    uint64 Offset = HeaderBytes;
+    bool   bOk    = true;
+    for (int32 Column = 0; Column < ColumnsPerRegion && bOk; ++Column) {
+        const FColumnEntry &Entry = Current->Table[Column];
+        FColumnDirectory    Directory;
+        const uint8        *Data = FindColumn(*Current->Mapping, Entry, Directory);
+        if (!Data) {
+            continue;
+        }
+        bOk              = Temp->Write(Offset, Data, Entry.Size);
+        NewTable[Column] = { Offset, Entry.Size, Entry.Hash };
+        Offset           = AlignUp(Offset + Entry.Size);
+    }
+    std::vector<uint8> Header;
+    AppendBytes(Header, FFileHeader{ RegionMagic, RegionVersion });
+    AppendBytes(Header, NewTable);
+    if (!bOk || !Temp->Write(0, Header.data(), Header.size()) || !Temp->Flush() ||
+        !AtomicReplaceFile(TempPath, Path)) {
+        Temp.reset();
+        RemoveFile(TempPath);
+        return false;
+    }
+
+    // 旧映射仍指向被替换掉的文件, 读者持有的快照继续有效
+    Writer    = std::move(Temp);
+    EndOffset = AlignUp(Writer->GetSize());
+    return Publish(NewTable);
+}
+
+FRegionFileStats FRegionFile::GetStats() const {
+    const std::shared_ptr<const FSnapshot> Current = GetSnapshot();
+    FRegionFileStats                       Stats;
+    Stats.FileSize  = Current->Mapping->GetSize();
+    Stats.LiveBytes = HeaderBytes;
+    for (const FColumnEntry &Entry: Current->Table) {
+        if (Entry.Size != 0) {
+            Stats.LiveBytes += AlignUp(Entry.Size);
+            ++Stats.NumColumns;
+        }
+    }
+    return Stats;
+}
+
+std::shared_ptr<const FRegionFile::FSnapshot> FRegionFile::GetSnapshot() const {
+    TUniqueLock Lock(SnapshotMutex);
+    return Snapshot;
+}
+
+bool FRegionFile::Publish(const FColumnTable &Table) {
+    std::shared_ptr<FMappedFile> Mapping = FMappedFile::Map(Path);
+    if (!Mapping) {
+        return false;
+    }
+    auto NewSnapshot     = std::make_shared<FSnapshot>();
+    NewSnapshot->Mapping = std::move(Mapping);
+    NewSnapshot->Table   = Table;
+
+    std::shared_ptr<const FSnapshot> Old;
+    {
+        TUniqueLock Lock(SnapshotMutex);
+        Old      = std::move(Snapshot);
+        Snapshot = std::move(NewSnapshot);
+    }
+    // 旧快照在锁外释放, 解除映射的系统调用不阻塞读者
+    return true;
+}
+} // namespace TE::Voxel
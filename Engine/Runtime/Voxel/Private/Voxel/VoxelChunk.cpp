@@ -0,0 +1,308 @@
+/******************************************************
+ * @file Voxel/VoxelChunk.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelChunk.hpp"
+
+#include <algorithm>
+
+namespace TE::Voxel {
+namespace {
+constexpr uint32 BrickVolume = BrickDim * BrickDim * BrickDim;
+
+// 容纳 Count 种取值所需的位宽, 取 2 的幂以保证下标不跨 uint64
+uint32 GetBitsForPaletteSize(uint32 Count) {
+    uint32 Bits = 1;
+    while ((1u << Bits) < Count) {
+        Bits *= 2;
+    }
+    return Bits;
+}
+} // namespace
+
+void FLightNibbles::Set(uint32 Index, uint32 Level) {
+    check(Index < ChunkVolume && Level <= MaxLevel);
+    if (Nibbles.empty()) {
+        if (Level == UniformLevel) {
+            return;
+        }
+        Nibbles.assign(ChunkVolume / 2, uint8(UniformLevel * 0x11));
+    }
+    uint8       &Byte  = Nibbles[Index >> 1];
+    const uint32 Shift = (Index & 1) * 4;
+    Byte               = uint8((Byte & ~(MaxLevel << Shift)) | (Level << Shift));
+}
+
+void FLightNibbles::Compact() {
+    if (Nibbles.empty()) {
+        return;
+    }
+    const uint8 First = Nibbles[0];
+    if ((First >> 4) == (First & MaxLevel) &&
+        std::all_of(Nibbles.begin(), Nibbles.end(),
+                    [First](uint8 Byte) { return Byte == First; })) {
+        Fill(First & MaxLevel);
+    }
+}
+
+FVoxelChunk::FVoxelChunk(FVoxel Fill) {
+    this->Fill(Fill);
+}
+
+void FVoxelChunk::Set(uint32 Index, FVoxel Voxel) {
+    check(Index < ChunkVolume);
+    const FVoxel Old = Get(Index);
+    if (Old == Voxel) {
+        return;
+    }
+
+    if ((Old == AirVoxel) != (Voxel == AirVoxel)) {
+        const uint32 Brick = GetBrickIndexOfVoxel(Index);
+        if (Voxel == AirVoxel) {
+            if (--BrickCounts[Brick] == 0) {
+                BrickMask &= ~(uint64(1) << Brick);
+            }
+        } else if (BrickCounts[Brick]++ == 0) {
+            BrickMask |= uint64(1) << Brick;
+        }
+    }
+
+    if (BitsPerIndex == 0) {
+        // 均匀区块展开为 1 位下标: 0 为原来的值, 1 为新值
+        Palette        = { Old, Voxel };
+        PaletteRefs    = { ChunkVolume - 1, 1 };
+        NumUsedEntries = 2;
+        BitsPerIndex   = 1;
+        IndexMask      = 1;
+        Data.assign(ChunkVolume / 64, 0);
+        WriteIndex(Index, 1);
+        return;
+    }
+
+    const uint32 OldEntry = ReadIndex(Index);
+    const uint32 NewEntry = FindOrAddPaletteEntry(Voxel);
+    WriteIndex(Index, NewEntry);
+    ++PaletteRefs[NewEntry];
+    if (--PaletteRefs[OldEntry] == 0 && --NumUsedEntries == 1) {
+        // 只剩刚写入的这一种方块
+        SetUniform(Voxel);
+    }
+}
+
+void FVoxelChunk::Fill(FVoxel Voxel) {
+    SetUniform(Voxel);
+    std::fill(std::begin(BrickCounts), std::end(BrickCounts),
+              uint16(Voxel == AirVoxel ? 0 : BrickVolume));
+    BrickMask = Voxel == AirVoxel ? 0 : ~uint64(0);
+}
+
+void FVoxelChunk::Unpack(FVoxel *Out) const {
+    if (BitsPerIndex == 0) {
+        std::fill(Out, Out + ChunkVolume, Palette[0]);
+        return;
+    }
+    // 逐个 uint64 解码, 每个字包含 64 / BitsPerIndex 个下标
+    const uint32 PerWord = 64 / BitsPerIndex;
+    for (uint64 Word: Data) {
+        for (uint32 Slot = 0; Slot < PerWord; ++Slot) {
+            *Out++ = Palette[uint32(Word) & IndexMask];
+            Word >>= BitsPerIndex;
+        }
+    }
+}
+
+void FVoxelChunk::Pack(const FVoxel *Voxels) {
+    // 第一遍: 建调色板并统计引用数与砖块计数. 相邻体素大多相同, 先和上一个比较
+    std::vector<uint16> Indices(ChunkVolume);
+    std::vector<FVoxel> NewPalette;
+    std::vector<uint32> NewRefs;
+    FVoxel              Last      = Voxels[0];
+    uint32              LastEntry = 0;
+    NewPalette.push_back(Last);
+    NewRefs.push_back(0);
+    uint16 NewBrickCounts[NumBricks] = {};
+    for (uint32 Index = 0; Index < ChunkVolume; ++Index) {
+        const FVoxel Voxel = Voxels[Index];
+        if (Voxel != Last) {
+            const auto It = std::find(NewPalette.begin(), NewPalette.end(), Voxel);
+            LastEntry     = uint32(It - NewPalette.begin());
+            if (It == NewPalette.end()) {
+                NewPalette.push_back(Voxel);
+                NewRefs.push_back(0);
+            }
+            Last = Voxel;
+        }
+        Indices[Index] = uint16(LastEntry);
+        ++NewRefs[LastEntry];
+        NewBrickCounts[GetBrickIndexOfVoxel(Index)] += Voxel != AirVoxel;
+    }
+
+    BrickMask = 0;
+    for (uint32 Brick = 0; Brick < NumBricks; ++Brick) {
+        BrickCounts[Brick] = NewBrickCounts[Brick];
+        BrickMask |= uint64(NewBrickCounts[Brick] != 0) << Brick;
+    }
+    if (NewPalette.size() == 1) {
+        SetUniform(NewPalette[0]);
+        return;
+    }
+
+    // 第二遍: 按最小位宽打包下标
+    NumUsedEntries = uint32(NewPalette.size());
+    BitsPerIndex   = GetBitsForPaletteSize(NumUsedEntries);
+    IndexMask      = (1u << BitsPerIndex) - 1;
+    Palette        = std::move(NewPalette);
+    PaletteRefs    = std::move(NewRefs);
+    Data.assign(std::size_t(ChunkVolume) * BitsPerIndex / 64, 0);
+    const uint32 PerWord = 64 / BitsPerIndex;
+    uint32       Index   = 0;
+    for (uint64 &Word: Data) {
+        for (uint32 Slot = 0; Slot < PerWord; ++Slot, ++Index) {
+            Word |= uint64(Indices[Index]) << (Slot * BitsPerIndex);
+        }
+    }
+}
+
+void FVoxelChunk::Compact() {
+    if (BitsPerIndex == 0) {
+        return;
+    }
+    if (NumUsedEntries == 1) {
+        const auto It = std::find_if(PaletteRefs.begin(), PaletteRefs.end(),
+                                     [](uint32 Refs) { return Refs != 0; });
+        SetUniform(Palette[It - PaletteRefs.begin()]);
+        return;
+    }
+
+    std::vector<uint16> Remap(Palette.size(), 0);
+    std::vector<FVoxel> NewPalette;
+    std::vector<uint32> NewRefs;
+    NewPalette.reserve(NumUsedEntries);
+    NewRefs.reserve(NumUsedEntries);
+    for (uint32 Entry = 0; Entry < Palette.size(); ++Entry) {
+        if (PaletteRefs[Entry] != 0) {
+            Remap[Entry] = uint16(NewPalette.size());
+            NewPalette.push_back(Palette[Entry]);
+            NewRefs.push_back(PaletteRefs[Entry]);
+        }
+    }
+    Repack(GetBitsForPaletteSize(NumUsedEntries), Remap);
+    Palette     = std::move(NewPalette);
+    PaletteRefs = std::move(NewRefs);
+}
+
+std::size_t FVoxelChunk::GetMemoryUsage() const {
+    return sizeof(*this) + Data.capacity() * sizeof(uint64) + Palette.capacity() * sizeof(FVoxel) +
+           PaletteRefs.capacity() * sizeof(uint32) + BlockLight.GetMemoryUsage() +
+           SkyLight.GetMemoryUsage();
+}
+
+bool FVoxelChunk::ResetPacked(const FPackedChunk &Packed) {
+    const uint32 Bits = Packed.BitsPerIndex;
+    if (Bits > 16 || (Bits & (Bits - 1)) != 0 || Packed.Palette.empty() ||
+        Packed.Palette.size() > (std::size_t(1) << Bits)) {
+        return false;
+    }
+    if (Bits == 0) {
+        Fill(Packed.Palette[0]);
+        return true;
+    }
+
+    // 8 位及以下把调色板补满 1 << Bits 项, 这样任何下标都落在调色板内, 解码时不必逐个检查
+    Palette.assign(Packed.Palette.begin(), Packed.Palette.end());
+    if (Bits <= 8) {
+        Palette.resize(std::size_t(1) << Bits, AirVoxel);
+    }
+    PaletteRefs.assign(Palette.size(), 0);
+    Data.assign(std::size_t(ChunkVolume) * Bits / 64, 0);
+    BitsPerIndex = Bits;
+    IndexMask    = (1u << Bits) - 1;
+    return true;
+}
+
+bool FVoxelChunk::RecountPaletteRefs() {
+    // 砖块计数也从下标重新统计, 不依赖调用方提供, 否则计数与体素不符时会跳过实心砖块
+    const uint32 PerWord                   = 64 / BitsPerIndex;
+    const uint32 PaletteSize               = uint32(Palette.size());
+    uint16       NewBrickCounts[NumBricks] = {};
+    uint32       Index                     = 0;
+    for (uint64 Word: Data) {
+        for (uint32 Slot = 0; Slot < PerWord; ++Slot, ++Index) {
+            const uint32 Entry = uint32(Word) & IndexMask;
+            if (Entry >= PaletteSize) {
+                return false;
+            }
+            ++PaletteRefs[Entry];
+            NewBrickCounts[GetBrickIndexOfVoxel(Index)] += Palette[Entry] != AirVoxel;
+            Word >>= BitsPerIndex;
+        }
+    }
+    BrickMask = 0;
+    for (uint32 Brick = 0; Brick < NumBricks; ++Brick) {
+        BrickCounts[Brick] = NewBrickCounts[Brick];
+        BrickMask |= uint64(NewBrickCounts[Brick] != 0) << Brick;
+    }
+    NumUsedEntries = uint32(std::count_if(PaletteRefs.begin(), PaletteRefs.end(),
+                                          [](uint32 Refs) { return Refs != 0; }));
+    if (NumUsedEntries == 1) {
+        // 保持 "只有一种方块即为均匀区块" 的约定
+        Compact();
+    }
+    return true;
+}
+
+uint32 FVoxelChunk::FindOrAddPaletteEntry(FVoxel Voxel) {
+    // 调色板通常只有个位数的项, 线性查找即可
+    uint32 FreeEntry = ~0u;
+    for (uint32 Entry = 0; Entry < Palette.size(); ++Entry) {
+        if (PaletteRefs[Entry] == 0) {
+            FreeEntry = std::min(FreeEntry, Entry);
+        } else if (Palette[Entry] == Voxel) {
+            return Entry;
+        }
+    }
+    ++NumUsedEntries;
+    if (FreeEntry != ~0u) {
+        Palette[FreeEntry] = Voxel;
+        return FreeEntry;
+    }
+
+    Palette.push_back(Voxel);
+    PaletteRefs.push_back(0);
+    if (Palette.size() > (std::size_t(1) << BitsPerIndex)) {
+        Repack(BitsPerIndex * 2, {});
+    }
+    return uint32(Palette.size() - 1);
+}
+
+void FVoxelChunk::Repack(uint32 NewBits, const std::vector<uint16> &Remap) {
+    check(NewBits >= 1 && NewBits <= 16);
+    std::vector<uint64> NewData(std::size_t(ChunkVolume) * NewBits / 64, 0);
+    const uint32        PerWord = 64 / NewBits;
+    uint32              Index   = 0;
+    for (uint64 &Word: NewData) {
+        for (uint32 Slot = 0; Slot < PerWord; ++Slot, ++Index) {
+            uint32 Entry = ReadIndex(Index);
+            if (!Remap.empty()) {
+                Entry = Remap[Entry];
+            }
+            Word |= uint64(Entry) << (Slot * NewBits);
+        }
+    }
+    Data         = std::move(NewData);
+    BitsPerIndex = NewBits;
+    IndexMask    = (1u << NewBits) - 1;
+}
+
+void FVoxelChunk::SetUniform(FVoxel Voxel) {
+    std::vector<uint64>().swap(Data);
+    Palette.assign(1, Voxel);
+    Palette.shrink_to_fit();
+    PaletteRefs.assign(1, ChunkVolume);
+    PaletteRefs.shrink_to_fit();
+    NumUsedEntries = 1;
+    BitsPerIndex   = 0;
+    IndexMask      = 0;
+}
+} // namespace TE::Voxel
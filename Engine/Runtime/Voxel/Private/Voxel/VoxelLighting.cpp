@@ -0,0 +1,460 @@
+/******************************************************
+ * @file Voxel/VoxelLighting.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelLighting.hpp"
+
+#include "Tasks/Tasks.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+
+namespace TE::Voxel {
+namespace {
+constexpr uint32 MaxLevel  = FLightNibbles::MaxLevel;
+constexpr int32  RegionDim = 3 * ChunkDim;
+constexpr uint32 NumColors = 27;
+
+// 方向 Dir 的坐标轴为 Dir / 2, 奇数为负方向
+constexpr int32  DirOffsets[6][3] = { { 1, 0, 0 },  { -1, 0, 0 }, { 0, 1, 0 },
+                                      { 0, -1, 0 }, { 0, 0, 1 },  { 0, 0, -1 } };
+constexpr uint32 DownDir          = 3;
+
+// 邻域内的局部坐标, 每轴 [0, RegionDim), 打包为 X | Y << 8 | Z << 16
+uint32 PackLocal(int32 X, int32 Y, int32 Z) {
+    return uint32(X) | uint32(Y) << 8 | uint32(Z) << 16;
+}
+
+int32 GetLocalAxis(uint32 Pos, uint32 Axis) {
+    return int32((Pos >> (Axis * 8)) & 0xFF);
+}
+
+// 走到相邻格子, 越出邻域时返回 false
+bool StepLocal(uint32 Pos, uint32 Dir, uint32 &OutPos) {
+    const uint32 Shift = (Dir >> 1) * 8;
+    const int32  Coord = GetLocalAxis(Pos, Dir >> 1);
+    if (Dir & 1) {
+        if (Coord == 0) {
+            return false;
+        }
+        OutPos = Pos - (1u << Shift);
+    } else {
+        if (Coord == RegionDim - 1) {
+            return false;
+        }
+        OutPos = Pos + (1u << Shift);
+    }
+    return true;
+}
+
+uint32 GetChunkSlot(uint32 Pos) {
+    return (GetLocalAxis(Pos, 0) >> ChunkShift) + 3 * (GetLocalAxis(Pos, 1) >> ChunkShift) +
+           9 * (GetLocalAxis(Pos, 2) >> ChunkShift);
+}
+
+uint32 GetIndexInChunk(uint32 Pos) {
+    return GetVoxelIndex(GetLocalAxis(Pos, 0) & ChunkMask, GetLocalAxis(Pos, 1) & ChunkMask,
+                         GetLocalAxis(Pos, 2) & ChunkMask);
+}
+
+// 坐标模 3 相同的区块, 3x3x3 邻域互不重叠
+uint32 GetColor(const FChunkCoord &Coord) {
+    const auto Mod3 = [](int32 Value) { return uint32((Value % 3 + 3) % 3); };
+    return Mod3(Coord.X) + 3 * Mod3(Coord.Y) + 9 * Mod3(Coord.Z);
+}
+} // namespace
+
+// 以一个区块为中心的 3x3x3 邻域, 独占地处理该区块登记的起点
+struct FVoxelLighting::FRegionTask {
+    struct FLightNode {
+        uint32 Pos;
+        uint32 Level;
+    };
+
+    // 越出邻域的节点, 交给 Target 区块在下一轮处理
+    struct FSpill {
+        FChunkCoord Target;
+        uint32      Channel;
+        bool        bRemoval;
+        uint32      Dir;
+        FLightSeed  Seed;
+    };
+
+    FRegionTask(FVoxelMap &Map, const FVoxelLighting &InLighting, const FChunkCoord &InCenter,
+                const FChunkLightWork &InWork)
+        : Lighting(InLighting), Center(InCenter), Work(InWork) {
+        for (int32 Z = 0; Z < 3; ++Z) {
+            for (int32 Y = 0; Y < 3; ++Y) {
+                for (int32 X = 0; X < 3; ++X) {
+                    Chunks[X + 3 * Y + 9 * Z] =
+                        Map.FindChunk({ Center.X + X - 1, Center.Y + Y - 1, Center.Z + Z - 1 });
+                }
+            }
+        }
+    }
+
+    void Run() {
+        for (uint32 Channel = 0; Channel < NumChannels; ++Channel) {
+            Removals.clear();
+            Additions.clear();
+            for (const FLightSeed &Seed: Work.Removals[Channel]) {
+                Removals.push_back({ ToLocal(Seed), Seed.Level });
+            }
+            for (const FLightSeed &Seed: Work.Additions[Channel]) {
+                Additions.push_back(ToLocal(Seed));
+            }
+            Remove(Channel);
+            Propagate(Channel);
+        }
+        for (uint32 Slot = 0; Slot < 27; ++Slot) {
+            if (bChanged[Slot]) {
+                Chunks[Slot]->GetBlockLight().Compact();
+                Chunks[Slot]->GetSkyLight().Compact();
+            }
+        }
+    }
+
+    // 撤销: 比来源暗的邻居 (以及天空光 15 的正下方) 是从这里得到的光, 置 0 后继续扩散;
+    // 其余亮着的邻居可能照回被撤销的区域, 交给传播阶段
+    void Remove(uint32 Channel) {
+        for (std::size_t Head = 0; Head < Removals.size(); ++Head) {
+            const FLightNode Node = Removals[Head];
+            ++NumVisited;
+            for (uint32 Dir = 0; Dir < 6; ++Dir) {
+                uint32 Next;
+                if (!StepLocal(Node.Pos, Dir, Next)) {
+                    Spill(Channel, true, Node.Pos, Node.Level, Dir);
+                    continue;
+                }
+                const uint32 Slot  = GetChunkSlot(Next);
+                FVoxelChunk *Chunk = Chunks[Slot];
+                if (!Chunk) {
+                    // 缺失的区块天空光恒为 15, 照回来
+                    if (Channel == SkyChannel) {
+                        Additions.push_back(Next);
+                    }
+                    continue;
+                }
+                FLightNibbles &Light = GetLight(*Chunk, Channel);
+                const uint32   Index = GetIndexInChunk(Next);
+                const uint32   Level = Light.Get(Index);
+                if (Level == 0) {
+                    continue;
+                }
+                const bool bSkyColumn = Channel == SkyChannel && Dir == DownDir &&
+                                        Node.Level == MaxLevel && Level == MaxLevel;
+                if (Level >= Node.Level && !bSkyColumn) {
+                    Additions.push_back(Next);
+                    continue;
+                }
+                Light.Set(Index, 0);
+                bChanged[Slot] = true;
+                Removals.push_back({ Next, Level });
+                // 发光方块自己的光不会被撤销
+                const uint32 Emission =
+                    Channel == BlockChannel ? Lighting.GetLightInfo(Chunk->Get(Index)).Emission : 0;
+                if (Emission > 0) {
+                    Light.Set(Index, Emission);
+                    Additions.push_back(Next);
+                }
+            }
+        }
+    }
+
+    // 传播: 按等级从亮到暗处理, 格子第一次被照亮时就是最终等级, 不会被反复覆盖
+    void Propagate(uint32 Channel) {
+        for (const uint32 Pos: Additions) {
+            const uint32 Level = GetLevel(Channel, Pos);
+            if (Level > 1) {
+                Buckets[Level].push_back(Pos);
+            }
+        }
+        for (uint32 Level = MaxLevel; Level > 1; --Level) {
+            // 天空光向下不衰减, 15 级的桶在处理时还会增长
+            for (std::size_t Head = 0; Head < Buckets[Level].size(); ++Head) {
+                const uint32 Pos = Buckets[Level][Head];
+                ++NumVisited;
+                // 之后被更亮的光覆盖过, 已经从更高的桶传播
+                if (GetLevel(Channel, Pos) == Level) {
+                    PropagateFrom(Channel, Pos, Level);
+                }
+            }
+            Buckets[Level].clear();
+        }
+    }
+
+    void PropagateFrom(uint32 Channel, uint32 Pos, uint32 Level) {
+        for (uint32 Dir = 0; Dir < 6; ++Dir) {
+            uint32 Next;
+            if (!StepLocal(Pos, Dir, Next)) {
+                Spill(Channel, false, Pos, 0, Dir);
+                continue;
+            }
+            const uint32 Slot  = GetChunkSlot(Next);
+            FVoxelChunk *Chunk = Chunks[Slot];
+            if (!Chunk) {
+                continue;
+            }
+            const uint32          Index = GetIndexInChunk(Next);
+            const FVoxelLightInfo Info  = Lighting.GetLightInfo(Chunk->Get(Index));
+            if (Info.Opacity >= MaxLevel) {
+                continue;
+            }
+            uint32 NewLevel = MaxLevel;
+            if (Channel != SkyChannel || Dir != DownDir || Level != MaxLevel ||
+                Info.Opacity != 0) {
+                const uint32 Attenuation = std::max<uint32>(Info.Opacity, 1);
+                if (Level <= Attenuation) {
+                    continue;
+                }
+                NewLevel = Level - Attenuation;
+            }
+            FLightNibbles &Light = GetLight(*Chunk, Channel);
+            if (NewLevel > Light.Get(Index)) {
+                Light.Set(Index, NewLevel);
+                bChanged[Slot] = true;
+                if (NewLevel > 1) {
+                    Buckets[NewLevel].push_back(Next);
+                }
+            }
+        }
+    }
+
+    void Spill(uint32 Channel, bool bRemoval, uint32 Pos, uint32 Level, uint32 Dir) {
+        const int32 X = (Center.X - 1) * ChunkDim + GetLocalAxis(Pos, 0);
+        const int32 Y = (Center.Y - 1) * ChunkDim + GetLocalAxis(Pos, 1);
+        const int32 Z = (Center.Z - 1) * ChunkDim + GetLocalAxis(Pos, 2);
+        const FChunkCoord Target =
+            GetChunkCoord(X + DirOffsets[Dir][0], Y + DirOffsets[Dir][1], Z + DirOffsets[Dir][2]);
+        Spills.push_back({ Target, Channel, bRemoval, Dir, { X, Y, Z, Level } });
+    }
+
+    uint32 ToLocal(const FLightSeed &Seed) const {
+        const int32 X = Seed.X - (Center.X - 1) * ChunkDim;
+        const int32 Y = Seed.Y - (Center.Y - 1) * ChunkDim;
+        const int32 Z = Seed.Z - (Center.Z - 1) * ChunkDim;
+        check(X >= 0 && X < RegionDim && Y >= 0 && Y < RegionDim && Z >= 0 && Z < RegionDim);
+        return PackLocal(X, Y, Z);
+    }
+
+    // 缺失的区块天空光为 15, 方块光为 0
+    uint32 GetLevel(uint32 Channel, uint32 Pos) const {
+        const FVoxelChunk *Chunk = Chunks[GetChunkSlot(Pos)];
+        if (!Chunk) {
+            return Channel == SkyChannel ? MaxLevel : 0;
+        }
+        return GetLight(*Chunk, Channel).Get(GetIndexInChunk(Pos));
+    }
+
+    static FLightNibbles &GetLight(FVoxelChunk &Chunk, uint32 Channel) {
+        return Channel == SkyChannel ? Chunk.GetSkyLight() : Chunk.GetBlockLight();
+    }
+
+    static const FLightNibbles &GetLight(const FVoxelChunk &Chunk, uint32 Channel) {
+        return Channel == SkyChannel ? Chunk.GetSkyLight() : Chunk.GetBlockLight();
+    }
+
+    const FVoxelLighting  &Lighting;
+    FChunkCoord            Center;
+    const FChunkLightWork &Work;
+
+    FVoxelChunk *Chunks[27];
+    bool         bChanged[27] = {};
+
+    std::vector<FLightNode> Removals;
+    std::vector<uint32>     Additions;
+    std::vector<uint32>     Buckets[MaxLevel + 1];
+    std::vector<FSpill>     Spills;
+    uint64                  NumVisited = 0;
+};
+
+FVoxelLighting::FVoxelLighting(FVoxelMap &InMap, FLightingSettings InSettings)
+    : Map(InMap), Settings(std::move(InSettings)) {
+    for (const FVoxelLightInfo &Info: Settings.Voxels) {
+        check(Info.Emission <= MaxLevel);
+    }
+}
+
+void FVoxelLighting::SetVoxel(int32 X, int32 Y, int32 Z, FVoxel Voxel) {
+    if (Map.GetVoxel(X, Y, Z) == Voxel) {
+        return;
+    }
+    const FChunkCoord Coord    = GetChunkCoord(X, Y, Z);
+    const bool        bCreated = Map.FindChunk(Coord) == nullptr;
+    Map.SetVoxel(X, Y, Z, Voxel);
+    if (bCreated) {
+        // 新建的区块之前按露天空气处理, 与整块加入相同
+        OnChunkAdded(Coord);
+        return;
+    }
+    FVoxelChunk *Chunk = Map.FindChunk(Coord);
+
+    const uint32     Index = GetLocalVoxelIndex(X, Y, Z);
+    FChunkLightWork &Work  = GetWork(Coord);
+    for (uint32 Channel = 0; Channel < NumChannels; ++Channel) {
+        FLightNibbles &Light =
+            Channel == SkyChannel ? Chunk->GetSkyLight() : Chunk->GetBlockLight();
+        const uint32 Level = Light.Get(Index);
+        if (Level > 0) {
+            Light.Set(Index, 0);
+            Work.Removals[Channel].push_back({ X, Y, Z, Level });
+        }
+        // 周围的光重新照进这一格 (挖掉方块或换成更透明的方块时)
+        for (const int32 *Offset: DirOffsets) {
+            Work.Additions[Channel].push_back({ X + Offset[0], Y + Offset[1], Z + Offset[2], 0 });
+        }
+    }
+    const uint32 Emission = GetLightInfo(Voxel).Emission;
+    if (Emission > 0) {
+        Chunk->GetBlockLight().Set(Index, Emission);
+        Work.Additions[BlockChannel].push_back({ X, Y, Z, 0 });
+    }
+}
+
+void FVoxelLighting::OnChunkAdded(const FChunkCoord &Coord) {
+    FVoxelChunk *Chunk = Map.FindChunk(Coord);
+    check(Chunk != nullptr);
+    Chunk->GetBlockLight().Fill(0);
+    Chunk->GetSkyLight().Fill(0);
+
+    FChunkLightWork &Work    = GetWork(Coord);
+    const int32      Base[3] = { Coord.X * ChunkDim, Coord.Y * ChunkDim, Coord.Z * ChunkDim };
+    for (int32 Axis = 0; Axis < 3; ++Axis) {
+        for (const int32 Side: { -1, 1 }) {
+            int32 Offset[3] = { 0, 0, 0 };
+            Offset[Axis]    = Side;
+            FVoxelChunk *Neighbor =
+                Map.FindChunk({ Coord.X + Offset[0], Coord.Y + Offset[1], Coord.Z + Offset[2] });
+            const bool bBelow = Axis == 1 && Side < 0;
+            for (int32 V = 0; V < ChunkDim; ++V) {
+                for (int32 U = 0; U < ChunkDim; ++U) {
+                    // 区块外紧挨着这一面的格子, 它的光会照进区块
+                    int32 Pos[3];
+                    Pos[Axis]           = Base[Axis] + (Side < 0 ? -1 : ChunkDim);
+                    Pos[(Axis + 1) % 3] = Base[(Axis + 1) % 3] + U;
+                    Pos[(Axis + 2) % 3] = Base[(Axis + 2) % 3] + V;
+                    for (uint32 Channel = 0; Channel < NumChannels; ++Channel) {
+                        Work.Additions[Channel].push_back({ Pos[0], Pos[1], Pos[2], 0 });
+                    }
+                    if (!Neighbor) {
+                        continue;
+                    }
+                    // 区块之前的光照未知 (缺失时天空光为 15, 替换时可能有发光方块), 邻居的光
+                    // 只要可能是从这里得到的就撤销: 方块光保留自身发光, 天空光保留侧面和上方的 15
+                    const uint32 Index = GetLocalVoxelIndex(Pos[0], Pos[1], Pos[2]);
+                    for (uint32 Channel = 0; Channel < NumChannels; ++Channel) {
+                        FLightNibbles &Light = Channel == SkyChannel ? Neighbor->GetSkyLight()
+                                                                     : Neighbor->GetBlockLight();
+                        const uint32   Level = Light.Get(Index);
+                        const uint32   Keep  = Channel == BlockChannel
+                                                   ? GetLightInfo(Neighbor->Get(Index)).Emission
+                                               : Level == MaxLevel && !bBelow ? MaxLevel
+                                                                              : 0;
+                        if (Level > Keep) {
+                            Light.Set(Index, Keep);
+                            Work.Removals[Channel].push_back({ Pos[0], Pos[1], Pos[2], Level });
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // 调色板里没有发光方块时不必逐个检查
+    const FPackedChunk Packed = Chunk->GetPacked();
+    if (std::none_of(Packed.Palette.begin(), Packed.Palette.end(),
+                     [this](FVoxel Voxel) { return GetLightInfo(Voxel).Emission > 0; })) {
+        return;
+    }
+    std::vector<FVoxel> Voxels(ChunkVolume);
+    Chunk->Unpack(Voxels.data());
+    for (uint32 Index = 0; Index < ChunkVolume; ++Index) {
+        const uint32 Emission = GetLightInfo(Voxels[Index]).Emission;
+        if (Emission > 0) {
+            Chunk->GetBlockLight().Set(Index, Emission);
+            const int32 X = Base[0] + int32(Index & ChunkMask);
+            const int32 Y = Base[1] + int32((Index >> ChunkShift) & ChunkMask);
+            const int32 Z = Base[2] + int32(Index >> (2 * ChunkShift));
+            Work.Additions[BlockChannel].push_back({ X, Y, Z, 0 });
+        }
+    }
+}
+
+std::vector<FChunkCoord> FVoxelLighting::Update() {
+    Stats = {};
+    std::vector<FChunkCoord> Changed;
+    while (!Pending.empty()) {
+        const std::unordered_map<FChunkCoord, FChunkLightWork> Round = std::move(Pending);
+        Pending.clear();
+        ++Stats.NumRounds;
+
+        std::vector<std::unique_ptr<FRegionTask>> Phases[NumColors];
+        for (const auto &[Coord, Work]: Round) {
+            Phases[GetColor(Coord)].push_back(
+                std::make_unique<FRegionTask>(Map, *this, Coord, Work));
+        }
+        for (std::vector<std::unique_ptr<FRegionTask>> &Phase: Phases) {
+            if (Phase.size() == 1) {
+                Phase[0]->Run();
+            } else if (!Phase.empty()) {
+                std::vector<Tasks::TTask<void>> Running;
+                Running.reserve(Phase.size());
+                for (std::unique_ptr<FRegionTask> &Region: Phase) {
+                    Running.push_back(Tasks::Launch(TEXT("PropagateLight"),
+                                                    [Target = Region.get()] { Target->Run(); }));
+                }
+                Tasks::Wait(Running);
+            }
+
+            for (const std::unique_ptr<FRegionTask> &Region: Phase) {
+                ++Stats.NumRegions;
+                Stats.NumVisited += Region->NumVisited;
+                for (uint32 Slot = 0; Slot < 27; ++Slot) {
+                    if (Region->bChanged[Slot]) {
+                        Changed.push_back({ Region->Center.X + int32(Slot % 3) - 1,
+                                            Region->Center.Y + int32(Slot / 3 % 3) - 1,
+                                            Region->Center.Z + int32(Slot / 9) - 1 });
+                    }
+                }
+                for (const FRegionTask::FSpill &Spill: Region->Spills) {
+                    if (Map.FindChunk(Spill.Target)) {
+                        FChunkLightWork &Work = GetWork(Spill.Target);
+                        (Spill.bRemoval ? Work.Removals : Work.Additions)[Spill.Channel].push_back(
+                            Spill.Seed);
+                        continue;
+                    }
+                    // 目标区块不存在时它的光照不会变, 不必再跑一轮; 但被撤销了天空光的格子
+                    // 要从那里重新照亮, 起点落在该格子所在区块的邻域内
+                    if (Spill.bRemoval && Spill.Channel == SkyChannel) {
+                        const FLightSeed &Seed   = Spill.Seed;
+                        const int32      *Offset = DirOffsets[Spill.Dir];
+                        GetWork(GetChunkCoord(Seed.X, Seed.Y, Seed.Z))
+                            .Additions[SkyChannel]
+                            .push_back({ Seed.X + Offset[0], Seed.Y + Offset[1],
+                                         Seed.Z + Offset[2], 0 });
+                    }
+                }
+            }
+        }
+    }
+
+    const auto Less = [](const FChunkCoord &A, const FChunkCoord &B) {
+        return std::tie(A.X, A.Y, A.Z) < std::tie(B.X, B.Y, B.Z);
+    };
+    std::sort(Changed.begin(), Changed.end(), Less);
+    Changed.erase(std::unique(Changed.begin(), Changed.end()), Changed.end());
+    return Changed;
+}
+
+uint32 FVoxelLighting::GetBlockLight(int32 X, int32 Y, int32 Z) const {
+    const FVoxelChunk *Chunk = Map.FindChunk(GetChunkCoord(X, Y, Z));
+    return Chunk ? Chunk->GetBlockLight().Get(GetLocalVoxelIndex(X, Y, Z)) : 0;
+}
+
+uint32 FVoxelLighting::GetSkyLight(int32 X, int32 Y, int32 Z) const {
+    const FVoxelChunk *Chunk = Map.FindChunk(GetChunkCoord(X, Y, Z));
+    return Chunk ? Chunk->GetSkyLight().Get(GetLocalVoxelIndex(X, Y, Z)) : MaxLevel;
+}
+} // namespace TE::Voxel
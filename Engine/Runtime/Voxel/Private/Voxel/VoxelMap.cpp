@@ -0,0 +1,35 @@
+/******************************************************
+ * @file Voxel/VoxelMap.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelMap.hpp"
+
+namespace TE::Voxel {
+FVoxelChunk &FVoxelMap::FindOrAddChunk(const FChunkCoord &Coord) {
+    std::unique_ptr<FVoxelChunk> &Chunk = Chunks[Coord];
+    if (!Chunk) {
+        Chunk = std::make_unique<FVoxelChunk>();
+    }
+    return *Chunk;
+}
+
+void FVoxelMap::SetVoxel(int32 X, int32 Y, int32 Z, FVoxel Voxel) {
+    const FChunkCoord Coord = GetChunkCoord(X, Y, Z);
+    if (Voxel == AirVoxel) {
+        if (FVoxelChunk *Chunk = FindChunk(Coord)) {
+            Chunk->Set(GetLocalVoxelIndex(X, Y, Z), Voxel);
+        }
+        return;
+    }
+    FindOrAddChunk(Coord).Set(GetLocalVoxelIndex(X, Y, Z), Voxel);
+}
+
+std::size_t FVoxelMap::GetMemoryUsage() const {
+    std::size_t Bytes = 0;
+    for (const auto &[Coord, Chunk]: Chunks) {
+        Bytes += Chunk->GetMemoryUsage();
+    }
+    return Bytes;
+}
+} // namespace TE::Voxel
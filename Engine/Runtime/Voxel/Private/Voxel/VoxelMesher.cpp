@@ -0,0 +1,209 @@
+/******************************************************
+ * @file Voxel/VoxelMesher.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelMesher.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace TE::Voxel {
+namespace {
+constexpr uint32 ColumnsPerAxis = ChunkDim * ChunkDim;
+
+// 每个线程一份, 约 112 KB, 首次使用时分配后一直复用
+struct FMeshScratch {
+    FVoxel Voxels[ChunkVolume];
+    // [轴][V * 32 + U] 的第 D + 1 位: 该列第 D 个体素是否实心; 第 0 / 33 位为邻居
+    uint64 Columns[3][ColumnsPerAxis];
+    // [面][深度][V] 的第 U 位: 该位置有可见面
+    uint32 Planes[6][ChunkDim][ChunkDim];
+};
+
+FMeshScratch &GetScratch() {
+    static thread_local std::vector<FMeshScratch> Scratch(1);
+    return Scratch[0];
+}
+
+// 轴 Axis 上的切面坐标系: U = (Axis + 1) % 3, V = (Axis + 2) % 3, U x V 指向 +Axis
+uint32 GetVoxelIndexOnAxis(uint32 Axis, int32 D, int32 U, int32 V) {
+    int32 P[3];
+    P[Axis]           = D;
+    P[(Axis + 1) % 3] = U;
+    P[(Axis + 2) % 3] = V;
+    return GetVoxelIndex(P[0], P[1], P[2]);
+}
+
+void BuildColumns(const FChunkBorders &Borders, FMeshScratch &Scratch) {
+    std::memset(Scratch.Columns, 0, sizeof(Scratch.Columns));
+    for (int32 Z = 0; Z < ChunkDim; ++Z) {
+        for (int32 Y = 0; Y < ChunkDim; ++Y) {
+            for (int32 X = 0; X < ChunkDim; ++X) {
+                if (Scratch.Voxels[GetVoxelIndex(X, Y, Z)] == AirVoxel) {
+                    continue;
+                }
+                Scratch.Columns[0][Z * ChunkDim + Y] |= uint64(1) << (X + 1);
+                Scratch.Columns[1][X * ChunkDim + Z] |= uint64(1) << (Y + 1);
+                Scratch.Columns[2][Y * ChunkDim + X] |= uint64(1) << (Z + 1);
+            }
+        }
+    }
+
+    // 两侧邻居的边界层写入第 0 / 33 位
+    for (uint32 Axis = 0; Axis < 3; ++Axis) {
+        for (int32 Side = 0; Side < 2; ++Side) {
+            const uint32(&Rows)[ChunkDim] = Borders.Faces[Axis * 2 + (Side == 0 ? 1 : 0)];
+            const uint64 Bit = uint64(1) << (Side == 0 ? 0 : ChunkDim + 1);
+            for (int32 V = 0; V < ChunkDim; ++V) {
+                for (uint32 Row = Rows[V]; Row != 0; Row &= Row - 1) {
+                    Scratch.Columns[Axis][V * ChunkDim + std::countr_zero(Row)] |= Bit;
+                }
+            }
+        }
+    }
+}
+
+void BuildFacePlanes(FMeshScratch &Scratch) {
+    std::memset(Scratch.Planes, 0, sizeof(Scratch.Planes));
+    for (uint32 Axis = 0; Axis < 3; ++Axis) {
+        for (uint32 Column = 0; Column < ColumnsPerAxis; ++Column) {
+            const uint64 Solid = Scratch.Columns[Axis][Column];
+            if (Solid == 0) {
+                continue;
+            }
+            // 正向面: 自己实心而下一格为空; 反向面: 自己实心而上一格为空. 去掉两端的邻居位
+            const uint64 Faces[2] = { (Solid & ~(Solid >> 1)) >> 1, (Solid & ~(Solid << 1)) >> 1 };
+            const uint32 U        = Column % ChunkDim;
+            const uint32 V        = Column / ChunkDim;
+            for (uint32 Side = 0; Side < 2; ++Side) {
+                for (uint32 Bits = uint32(Faces[Side]); Bits != 0; Bits &= Bits - 1) {
+                    const int D = std::countr_zero(Bits);
+                    Scratch.Planes[Axis * 2 + Side][D][V] |= 1u << U;
+                }
+            }
+        }
+    }
+}
+
+void EmitQuad(FVoxelMesh &Mesh, uint32 Face, int32 D, int32 U, int32 V, int32 Width,
+              int32 Height, FVoxel Voxel) {
+    const uint32 Axis      = Face / 2;
+    const bool   bPositive = (Face & 1) == 0;
+    // 正向面位于体素的远端
+    const int32  Depth = bPositive ? D + 1 : D;
+    const int32  Corners[4][2] = { { U, V },
+                                   { U + Width, V },
+                                   { U + Width, V + Height },
+                                   { U, V + Height } };
+    for (int32 Corner = 0; Corner < 4; ++Corner) {
+        // 反向面把顶点顺序反过来, 保持从外侧看为逆时针
+        const int32 *UV = Corners[bPositive ? Corner : 3 - Corner];
+        uint32       P[3];
+        P[Axis]           = uint32(Depth);
+        P[(Axis + 1) % 3] = uint32(UV[0]);
+        P[(Axis + 2) % 3] = uint32(UV[1]);
+        Mesh.Vertices.push_back(FVoxelVertex::Pack(P[0], P[1], P[2], EVoxelFace(Face), Voxel));
+    }
+}
+
+void MergeFaces(FMeshScratch &Scratch, FVoxelMesh &Mesh) {
+    for (uint32 Face = 0; Face < 6; ++Face) {
+        const uint32 Axis = Face / 2;
+        for (int32 D = 0; D < ChunkDim; ++D) {
+            uint32(&Rows)[ChunkDim] = Scratch.Planes[Face][D];
+            auto VoxelAt = [&](int32 U, int32 V) {
+                return Scratch.Voxels[GetVoxelIndexOnAxis(Axis, D, U, V)];
+            };
+            for (int32 V = 0; V < ChunkDim; ++V) {
+                while (Rows[V] != 0) {
+                    const int32  U     = std::countr_zero(Rows[V]);
+                    const FVoxel Voxel = VoxelAt(U, V);
+
+                    // 沿 U 扩展: 连续置位且类型相同
+                    int32 Width = 1;
+                    while (U + Width < ChunkDim && (Rows[V] >> (U + Width) & 1) &&
+                           VoxelAt(U + Width, V) == Voxel) {
+                        ++Width;
+                    }
+                    const uint32 RunMask = uint32(((uint64(1) << Width) - 1) << U);
+
+                    // 沿 V 扩展: 下一行同一段全部置位且类型相同
+                    int32 Height = 1;
+                    for (; V + Height < ChunkDim; ++Height) {
+                        if ((Rows[V + Height] & RunMask) != RunMask) {
+                            break;
+                        }
+                        bool bSameVoxel = true;
+                        for (int32 I = 0; I < Width && bSameVoxel; ++I) {
+                            bSameVoxel = VoxelAt(U + I, V + Height) == Voxel;
+                        }
+                        if (!bSameVoxel) {
+                            break;
+                        }
+                        Rows[V + Height] &= ~RunMask;
+                    }
+                    Rows[V] &= ~RunMask;
+                    EmitQuad(Mesh, Face, D, U, V, Width, Height, Voxel);
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+void GatherChunkBorders(const FVoxelMap &Map, const FChunkCoord &Coord,
+                        FChunkBorders &OutBorders) {
+    for (uint32 Face = 0; Face < 6; ++Face) {
+        const uint32 Axis      = Face / 2;
+        const bool   bNegative = (Face & 1) != 0;
+        int32        Offset[3] = { 0, 0, 0 };
+        Offset[Axis]           = bNegative ? -1 : 1;
+        const FVoxelChunk *Neighbour =
+            Map.FindChunk({ Coord.X + Offset[0], Coord.Y + Offset[1], Coord.Z + Offset[2] });
+        uint32(&Rows)[ChunkDim] = OutBorders.Faces[Face];
+        if (!Neighbour || Neighbour->IsEmpty()) {
+            std::fill(std::begin(Rows), std::end(Rows), 0u);
+            continue;
+        }
+        if (Neighbour->IsUniform()) {
+            std::fill(std::begin(Rows), std::end(Rows), ~0u);
+            continue;
+        }
+        // 负方向的邻居取其最大一层, 正方向取最小一层
+        const int32 D = bNegative ? ChunkDim - 1 : 0;
+        for (int32 V = 0; V < ChunkDim; ++V) {
+            uint32 Row = 0;
+            for (int32 U = 0; U < ChunkDim; ++U) {
+                Row |= uint32(Neighbour->Get(GetVoxelIndexOnAxis(Axis, D, U, V)) != AirVoxel) << U;
+            }
+            Rows[V] = Row;
+        }
+    }
+}
+
+void GenerateChunkMesh(const FVoxelChunk &Chunk, const FChunkBorders &Borders,
+                       FVoxelMesh &OutMesh) {
+    OutMesh.Vertices.clear();
+    if (Chunk.IsEmpty()) {
+        return;
+    }
+    FMeshScratch &Scratch = GetScratch();
+    Chunk.Unpack(Scratch.Voxels);
+    BuildColumns(Borders, Scratch);
+    BuildFacePlanes(Scratch);
+    MergeFaces(Scratch, OutMesh);
+}
+
+void GenerateChunkMesh(const FVoxelMap &Map, const FChunkCoord &Coord, FVoxelMesh &OutMesh) {
+    const FVoxelChunk *Chunk = Map.FindChunk(Coord);
+    if (!Chunk || Chunk->IsEmpty()) {
+        OutMesh.Vertices.clear();
+        return;
+    }
+    FChunkBorders Borders;
+    GatherChunkBorders(Map, Coord, Borders);
+    GenerateChunkMesh(*Chunk, Borders, OutMesh);
+}
+} // namespace TE::Voxel
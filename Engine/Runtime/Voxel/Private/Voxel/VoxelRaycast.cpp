@@ -0,0 +1,197 @@
+/******************************************************
+ * @file Voxel/VoxelRaycast.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelRaycast.hpp"
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "Tasks/Tasks.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace TE::Voxel {
+namespace {
+// 直接映射的区块查找缓存, 也缓存 "区块不存在". 只在一个任务内使用
+class FChunkLookupCache {
+  public:
+    explicit FChunkLookupCache(const FVoxelMap &InMap) : Map(InMap) {}
+
+    const FVoxelChunk *Find(const FChunkCoord &Coord) {
+        const uint32 Hash  = uint32(Coord.X) * 73856093u ^ uint32(Coord.Y) * 19349663u ^
+                             uint32(Coord.Z) * 83492791u;
+        const uint32 Slot  = Hash & (NumEntries - 1);
+        FEntry      &Entry = Entries[Slot];
+        if (!Entry.bValid || !(Entry.Coord == Coord)) {
+            Entry = { Coord, Map.FindChunk(Coord), true };
+        }
+        return Entry.Chunk;
+    }
+
+  private:
+    static constexpr uint32 NumEntries = 32;
+
+    struct FEntry {
+        FChunkCoord        Coord;
+        const FVoxelChunk *Chunk  = nullptr;
+        bool               bValid = false;
+    };
+
+    const FVoxelMap &Map;
+    FEntry           Entries[NumEntries];
+};
+
+// 射线在体素网格上的位置
+//
+// 穿过格面的时刻总是由起点直接算出 (不累加增量), 逐格前进和跳出整块用的是同一个公式,
+// 同一时刻穿过多个格面时轴下标小的先走, 因此跳跃的落点与逐格走到的格子完全相同
+class FRayWalker {
+  public:
+    // 方向为零向量时返回 false
+    bool Init(const FVoxelRay &Ray) {
+        const float *D      = Ray.Direction;
+        const float  Length = std::sqrt(D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
+        if (!(Length > 0.0f)) {
+            return false;
+        }
+        for (int32 Axis = 0; Axis < 3; ++Axis) {
+            Origin[Axis]       = Ray.Origin[Axis];
+            Cell[Axis]         = int32(std::floor(Origin[Axis]));
+            const float Dir    = D[Axis] / Length;
+            Step[Axis]         = Dir > 0.0f ? 1 : Dir < 0.0f ? -1 : 0;
+            InvDirection[Axis] = Step[Axis] != 0 ? 1.0f / Dir : 0.0f;
+        }
+        return true;
+    }
+
+    // 走出当前格子所在的、边长为 Size 的对齐块; Size = 1 即前进一格
+    void Advance(int32 Size) {
+        int32 ExitAxis = -1;
+        float ExitT    = std::numeric_limits<float>::infinity();
+        for (int32 Axis = 0; Axis < 3; ++Axis) {
+            if (Step[Axis] == 0) {
+                continue;
+            }
+            const int32 Low = Cell[Axis] & ~(Size - 1);
+            const float T   = GetBoundaryT(Axis, Step[Axis] > 0 ? Low + Size : Low);
+            if (T < ExitT) {
+                ExitT    = T;
+                ExitAxis = Axis;
+            }
+        }
+        check(ExitAxis >= 0);
+
+        // 其余轴上在离开块之前 (同一时刻时轴下标更小) 穿过的格面
+        for (int32 Axis = 0; Size > 1 && Axis < 3; ++Axis) {
+            if (Axis == ExitAxis || Step[Axis] == 0) {
+                continue;
+            }
+            const auto Crossed = [&](int32 Boundary) {
+                const float T = GetBoundaryT(Axis, Boundary);
+                return T < ExitT || (T == ExitT && Axis < ExitAxis);
+            };
+            const int32 Low = Cell[Axis] & ~(Size - 1);
+            if (Step[Axis] > 0) {
+                while (Cell[Axis] < Low + Size - 1 && Crossed(Cell[Axis] + 1)) {
+                    ++Cell[Axis];
+                }
+            } else {
+                while (Cell[Axis] > Low && Crossed(Cell[Axis])) {
+                    --Cell[Axis];
+                }
+            }
+        }
+
+        const int32 Low = Cell[ExitAxis] & ~(Size - 1);
+        Cell[ExitAxis]  = Step[ExitAxis] > 0 ? Low + Size : Low - 1;
+        T               = std::max(T, ExitT);
+        // 沿正方向前进时从负方向的面进入
+        Face            = EVoxelFace(ExitAxis * 2 + (Step[ExitAxis] > 0 ? 1 : 0));
+    }
+
+    int32      Cell[3] = {};
+    float      T       = 0.0f;
+    EVoxelFace Face    = EVoxelFace::PosX;
+
+  private:
+    float GetBoundaryT(int32 Axis, int32 Boundary) const {
+        return (float(Boundary) - Origin[Axis]) * InvDirection[Axis];
+    }
+
+    float Origin[3]       = {};
+    float InvDirection[3] = {};
+    int32 Step[3]         = {};
+};
+
+void TraceRay(const FVoxelRay &Ray, FChunkLookupCache &Cache, FRaycastHits &OutHits,
+              uint32 Index) {
+    OutHits.Voxels[Index] = AirVoxel;
+    FRayWalker Walker;
+    if (!Walker.Init(Ray)) {
+        return;
+    }
+    check(std::isfinite(Ray.MaxDistance));
+
+    FChunkCoord        Coord = GetChunkCoord(Walker.Cell[0], Walker.Cell[1], Walker.Cell[2]);
+    const FVoxelChunk *Chunk = Cache.Find(Coord);
+    while (Walker.T <= Ray.MaxDistance) {
+        const int32      *Cell    = Walker.Cell;
+        const FChunkCoord Current = GetChunkCoord(Cell[0], Cell[1], Cell[2]);
+        if (!(Current == Coord)) {
+            Coord = Current;
+            Chunk = Cache.Find(Coord);
+        }
+        if (!Chunk || Chunk->IsEmpty()) {
+            Walker.Advance(ChunkDim);
+            continue;
+        }
+        const int32 X = Cell[0] & ChunkMask;
+        const int32 Y = Cell[1] & ChunkMask;
+        const int32 Z = Cell[2] & ChunkMask;
+        if (((Chunk->GetBrickMask() >> GetBrickIndex(X, Y, Z)) & 1) == 0) {
+            Walker.Advance(BrickDim);
+            continue;
+        }
+        const FVoxel Voxel = Chunk->Get(X, Y, Z);
+        if (Voxel != AirVoxel) {
+            OutHits.Voxels[Index]    = Voxel;
+            OutHits.X[Index]         = Cell[0];
+            OutHits.Y[Index]         = Cell[1];
+            OutHits.Z[Index]         = Cell[2];
+            OutHits.Distances[Index] = Walker.T;
+            OutHits.Faces[Index]     = Walker.Face;
+            return;
+        }
+        Walker.Advance(1);
+    }
+}
+} // namespace
+
+void FVoxelRaycaster::Raycast(std::span<const FVoxelRay> Rays, FRaycastHits &OutHits) const {
+    check(RaysPerTask > 0);
+    const uint32 NumRays = uint32(Rays.size());
+    OutHits.Resize(NumRays);
+
+    // 每个切片写结果数组中互不重叠的一段
+    const auto TraceSlice = [this, Rays, &OutHits](uint32 Begin, uint32 End) {
+        FChunkLookupCache Cache(Map);
+        for (uint32 Index = Begin; Index < End; ++Index) {
+            TraceRay(Rays[Index], Cache, OutHits, Index);
+        }
+    };
+    if (NumRays <= RaysPerTask) {
+        TraceSlice(0, NumRays);
+        return;
+    }
+    std::vector<Tasks::TTask<void>> Running;
+    Running.reserve((NumRays + RaysPerTask - 1) / RaysPerTask);
+    for (uint32 Begin = 0; Begin < NumRays; Begin += RaysPerTask) {
+        const uint32 End = std::min(Begin + RaysPerTask, NumRays);
+        Running.push_back(Tasks::Launch(TEXT("RaycastVoxels"),
+                                        [&TraceSlice, Begin, End] { TraceSlice(Begin, End); }));
+    }
+    Tasks::Wait(Running);
+}
+} // namespace TE::Voxel
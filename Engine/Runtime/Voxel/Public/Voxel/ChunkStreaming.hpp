@@ -0,0 +1,177 @@
+/******************************************************
+ * @file Voxel/ChunkStreaming.hpp
+ * @brief 区块流式加载: 加载 -> 生成 -> 光照 -> 网格化, 分阶段限流
+ *****************************************************/
+
+#pragma once
+
+#include "Tasks/Tasks.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "TypeUtils/UniqueFunction.hpp"
+#include "Voxel/VoxelMap.hpp"
+#include "Voxel/VoxelMesher.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace TE::Voxel {
+enum class EChunkStreamingStage : uint8 { Load, Generate, Light, Mesh, Count };
+
+inline constexpr uint32 ChunkStreamingStageCount = uint32(EChunkStreamingStage::Count);
+
+// 除 Unload 外都在工作线程上调用, 且可能同时处理多个区块, 需要自行保证线程安全
+struct FChunkStreamingCallbacks {
+    // 从存档读取, 不存在时返回 false 转入 Generate; 为空表示总是生成
+    TUniqueFunction<bool(const FChunkCoord &, FVoxelChunk &)> Load;
+    // 生成地形, Chunk 初始为全空气
+    TUniqueFunction<void(const FChunkCoord &, FVoxelChunk &)> Generate;
+    // 可以为空
+    TUniqueFunction<void(const FChunkCoord &, FVoxelChunk &)> Light;
+    // 游戏线程调用: 区块即将离开驻留集合 (例如写回存档, 释放渲染端网格).
+    // 区块从未写入 Map (全空气) 时传入一个空区块
+    TUniqueFunction<void(const FChunkCoord &, const FVoxelChunk &)> Unload;
+};
+
+struct FChunkStreamingSettings {
+    // 只为水平距离 <= ViewRadius 且垂直距离 <= VerticalRadius 的区块生成网格 (单位: 区块).
+    // 体素数据多加载一圈, 保证可见范围边缘的区块也有邻居
+    int32 ViewRadius     = 8;
+    int32 VerticalRadius = 4;
+    // 驻留区块超出加载范围 UnloadMargin 圈后才卸载, 避免在边界来回移动时反复加载
+    int32 UnloadMargin = 2;
+    // 每个阶段同时在执行的任务数上限
+    uint32 MaxInFlight[ChunkStreamingStageCount] = { 8, 8, 4, 8 };
+    // 已完成但尚未被 ConsumeReadyMeshes 取走的网格上限, 渲染端跟不上时网格化阶段暂停
+    uint32 MaxPendingMeshes = 64;
+};
+
+struct FChunkStreamingStats {
+    uint32 NumQueued[ChunkStreamingStageCount]   = {};
+    uint32 NumInFlight[ChunkStreamingStageCount] = {};
+    // 等待邻居驻留后才能网格化的区块
+    uint32 NumWaitingForNeighbours = 0;
+    uint32 NumResident             = 0;
+    uint32 NumPendingMeshes        = 0;
+    // 因玩家离开而丢弃的请求总数 (排队中的直接丢弃, 执行中的在完成后丢弃结果)
+    uint64 NumCancelled = 0;
+};
+
+// 区块流式加载
+//
+// 每个区块依次经过 加载/生成 -> 光照 -> (写入 Map) -> 网格化, 每个阶段是任务系统上的一个
+// Background 任务; 游戏线程的 Update 只负责收取结果和分发任务, 从不等待.
+// - 限流: 每个阶段的在途任务数有上限, 排队中的请求按与玩家的距离排序, 近处优先
+// - 取消: 玩家换区块后, 排队中超出范围的请求直接丢弃, 执行中的请求完成后丢弃结果
+// - 网格化: 在游戏线程上把区块和六个邻居的边界层拷贝一份交给任务, 任务不访问 Map,
+//   因此游戏线程可以在任务执行期间修改 Map. 只有六个邻居都已驻留后才网格化,
+//   避免边界出现多余的面
+//
+// 非线程安全: 所有成员函数都在游戏线程上调用
+class FChunkStreamer {
+  public:
+    FChunkStreamer(FVoxelMap &InMap, FChunkStreamingCallbacks InCallbacks,
+                   const FChunkStreamingSettings &InSettings = {});
+    ~FChunkStreamer();
+
+    FChunkStreamer(const FChunkStreamer &)            = delete;
+    FChunkStreamer &operator=(const FChunkStreamer &) = delete;
+
+    void Update(const FChunkCoord &PlayerChunk);
+
+    // 按完成顺序把网格交给 Func(const FChunkCoord &, FVoxelMesh &&), 最多 MaxCount 个,
+    // 返回交出的个数
+    template <typename FuncType> uint32 ConsumeReadyMeshes(uint32 MaxCount, FuncType &&Func) {
+        uint32 Count = 0;
+        for (; Count < MaxCount && Count < ReadyMeshes.size(); ++Count) {
+            Func(ReadyMeshes[Count].first, std::move(*ReadyMeshes[Count].second));
+        }
+        ReadyMeshes.erase(ReadyMeshes.begin(), ReadyMeshes.begin() + Count);
+        return Count;
+    }
+
+    // 游戏修改了驻留区块后调用, 重新网格化该区块; 区块不在可见范围内时忽略
+    void RequestRemesh(const FChunkCoord &Coord);
+
+    // 等待在途任务完成并收取结果, 不发起新任务
+    void Flush();
+
+    // 没有排队、等待或执行中的请求
+    bool IsIdle() const;
+
+    bool IsResident(const FChunkCoord &Coord) const { return Resident.contains(Coord); }
+
+    FChunkStreamingStats GetStats() const;
+
+  private:
+    enum class ERequestState : uint8 { Queued, WaitingForNeighbours, InFlight };
+
+    struct FRequest {
+        FChunkCoord          Coord;
+        EChunkStreamingStage Stage = EChunkStreamingStage::Load;
+        ERequestState        State = ERequestState::Queued;
+        // 网格化期间区块又被修改, 完成后需要再来一次
+        bool bRemeshAgain = false;
+        // Load 阶段的结果
+        bool bLoaded = false;
+        // 网格化之前由请求独占; 网格化时为区块的拷贝
+        std::unique_ptr<FVoxelChunk> Chunk;
+        std::unique_ptr<FVoxelMesh>  Mesh;
+        FChunkBorders                Borders;
+        Tasks::TTask<void>           Task;
+    };
+
+    struct FQueueEntry {
+        int32       Distance;
+        FChunkCoord Coord;
+
+        // 配合 std::push_heap 构成小顶堆
+        bool operator<(const FQueueEntry &Other) const { return Distance > Other.Distance; }
+    };
+
+    int32 GetDistance(const FChunkCoord &Coord) const;
+    bool  IsInRange(const FChunkCoord &Coord, int32 Radius, int32 VerticalRadius) const;
+    bool  IsInLoadRange(const FChunkCoord &Coord) const;
+    bool  IsInMeshRange(const FChunkCoord &Coord) const;
+    // 请求当前阶段的结果是否仍然需要
+    bool  IsWanted(const FRequest &Request) const;
+
+    FRequest &AddRequest(const FChunkCoord &Coord, EChunkStreamingStage Stage);
+    void      Enqueue(FRequest &Request);
+    // 跳过未设置回调的阶段
+    EChunkStreamingStage GetNextStage(EChunkStreamingStage Stage) const;
+
+    void CollectCompleted();
+    void OnStageCompleted(FRequest &Request);
+    void MakeResident(FRequest &Request);
+    void OnPlayerMoved();
+    void UnloadChunk(const FChunkCoord &Coord);
+    bool AreNeighboursResident(const FChunkCoord &Coord) const;
+    void Dispatch();
+    void Launch(FRequest &Request);
+
+    FVoxelMap               &Map;
+    FChunkStreamingCallbacks Callbacks;
+    FChunkStreamingSettings  Settings;
+
+    FChunkCoord PlayerChunk;
+    bool        bHasPlayerChunk = false;
+
+    std::unordered_map<FChunkCoord, std::unique_ptr<FRequest>> Requests;
+    std::vector<FQueueEntry> Queues[ChunkStreamingStageCount];
+    std::vector<FRequest *>  InFlight[ChunkStreamingStageCount];
+    // 邻居尚未驻留的网格化请求; 有新区块驻留后放回队列
+    std::vector<FRequest *> WaitingForNeighbours;
+    bool                    bResidentChanged = false;
+
+    // 已完成光照的区块 (全空气的区块不写入 Map, 但同样算驻留)
+    std::unordered_set<FChunkCoord> Resident;
+    // 已交出过网格的区块
+    std::unordered_set<FChunkCoord>                                 Meshed;
+    std::vector<std::pair<FChunkCoord, std::unique_ptr<FVoxelMesh>>> ReadyMeshes;
+    uint64                                                           NumCancelled = 0;
+};
+} // namespace TE::Voxel
@@ -0,0 +1,60 @@
+/******************************************************
+ * @file Voxel/MeshingPipeline.hpp
+ * @brief 把脏区块的网格化分发到任务系统
+ *****************************************************/
+
+#pragma once
+
+#include "Tasks/Tasks.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelMap.hpp"
+#include "Voxel/VoxelMesher.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace TE::Voxel {
+// 记录被修改的区块, Kick 时为每个脏区块发起一个网格化任务
+//
+// 主线程只负责收集脏区块和发起任务, 网格化本身全部在工作线程上完成.
+// 任务运行期间 (Kick 之后到 Wait 返回之前) 不能修改 Map, 也不能读取网格.
+class FMeshingPipeline {
+  public:
+    explicit FMeshingPipeline(const FVoxelMap &InMap) : Map(InMap) {}
+    ~FMeshingPipeline() { Wait(); }
+
+    FMeshingPipeline(const FMeshingPipeline &)            = delete;
+    FMeshingPipeline &operator=(const FMeshingPipeline &) = delete;
+
+    void MarkChunkDirty(const FChunkCoord &Coord) { DirtyChunks.insert(Coord); }
+
+    // 修改了一个体素: 标记所在区块, 位于区块边界时连同相邻区块一起标记
+    void MarkVoxelDirty(int32 X, int32 Y, int32 Z);
+
+    // 为每个脏区块发起一个任务后立即返回; 上一批任务未完成时先等待
+    void Kick();
+
+    void Wait();
+
+    bool IsIdle() const;
+
+    uint32 NumDirtyChunks() const { return uint32(DirtyChunks.size()); }
+
+    // 区块没有网格 (从未网格化, 或区块已被移除) 时返回 nullptr
+    const FVoxelMesh *FindMesh(const FChunkCoord &Coord) const {
+        auto It = Meshes.find(Coord);
+        return It != Meshes.end() ? It->second.get() : nullptr;
+    }
+
+  private:
+    const FVoxelMap &Map;
+
+    std::unordered_set<FChunkCoord> DirtyChunks;
+    // 网格对象在区块存在期间一直复用, 其顶点缓冲的容量因此得以保留
+    std::unordered_map<FChunkCoord, std::unique_ptr<FVoxelMesh>> Meshes;
+    std::vector<Tasks::TTask<void>>                              InFlight;
+};
+} // namespace TE::Voxel
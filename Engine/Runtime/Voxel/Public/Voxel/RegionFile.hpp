@@ -0,0 +1,133 @@
+/******************************************************
+ * @file Voxel/RegionFile.hpp
+ * @brief 区块持久化: 每个文件保存 32x32 个区块列, 内存映射只读
+ *****************************************************/
+
+#pragma once
+
+#include "Async/Mutex.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelChunk.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace TE {
+class FMappedFile;
+class FWritableFile;
+} // namespace TE
+
+namespace TE::Voxel {
+// 一个区域文件覆盖 XZ 平面上 32x32 个区块列, 每列保存 Y 方向 16 个区块 (section)
+inline constexpr int32 RegionShift       = 5;
+inline constexpr int32 RegionDim         = 1 << RegionShift;
+inline constexpr int32 ColumnsPerRegion  = RegionDim * RegionDim;
+inline constexpr int32 SectionsPerColumn = 16;
+// 可保存的区块 Y 坐标范围为 [MinSectionY, MinSectionY + SectionsPerColumn)
+inline constexpr int32 MinSectionY = -8;
+
+struct FRegionCoord {
+    int32 X = 0;
+    int32 Z = 0;
+
+    bool operator==(const FRegionCoord &) const = default;
+};
+
+constexpr FRegionCoord GetRegionCoord(const FChunkCoord &Coord) {
+    return { Coord.X >> RegionShift, Coord.Z >> RegionShift };
+}
+
+// 例如 "r.-1.3.region"
+std::string GetRegionFileName(const FRegionCoord &Region);
+
+// 一次写入: Chunk 为 nullptr 表示删除该区块
+struct FRegionChunkWrite {
+    FChunkCoord        Coord;
+    const FVoxelChunk *Chunk = nullptr;
+};
+
+struct FRegionFileStats {
+    // 文件总大小与其中仍被引用的字节数, 两者之差为追加写入留下的垃圾
+    uint64 FileSize   = 0;
+    uint64 LiveBytes  = 0;
+    uint32 NumColumns = 0;
+};
+
+// 区域文件
+//
+// 文件布局 (小端, 所有记录 8 字节对齐):
+//   [头部: Magic, 版本, 1024 项列表 {Offset, Size, Hash}]
+//   [列数据...] [列表 + 尾记录] [列数据...] [列表 + 尾记录] ...
+// 列数据 = 列目录 (16 个 section 的偏移/大小) + 各 section 记录;
+// section 记录 = 头 (校验和、位宽、是否压缩、调色板大小、数据大小) + 调色板 + 下标数组,
+// 即区块内存中的调色板编码, 下标数组再做一次 LZ 压缩 (压缩无收益时保存原始字节).
+// 砖块计数不保存, 载入时由下标重新统计.
+//
+// 写入只追加: 改动的列整列重写到文件末尾 (未改动的 section 原样复制), 然后追加一份完整列表和
+// 指向它的尾记录. 打开时使用最后一个有效的尾记录, 末尾写坏时向前找上一个, 都没有则用头部列表.
+// 已写入的字节永不修改, 所以读者持有的旧映射始终有效.
+// 垃圾超过一半时 Compact 把存活的列重写到临时文件, 再原子替换原文件.
+//
+// 线程安全: LoadChunk / HasChunk 可与 SaveChunks / Compact 并发. 读者只在拷贝快照指针时
+// 短暂持锁, 读取本身不做系统调用, 直接从映射解压到区块; 写入之间互斥
+class FRegionFile {
+  public:
+    // 文件不存在时创建; 无法打开或创建时返回 nullptr
+    static std::unique_ptr<FRegionFile> Open(const std::string &Path, const FRegionCoord &Region);
+
+    ~FRegionFile();
+
+    const FRegionCoord &GetRegion() const { return Region; }
+
+    // 区块不在本区域、不存在或数据损坏时返回 false, OutChunk 此时为全空气
+    bool LoadChunk(const FChunkCoord &Coord, FVoxelChunk &OutChunk) const;
+
+    bool HasChunk(const FChunkCoord &Coord) const;
+
+    // 所有区块必须属于本区域且 Y 在可保存范围内, 否则整批不写入并返回 false.
+    // 一批写入对读者原子可见
+    bool SaveChunks(std::span<const FRegionChunkWrite> Writes);
+
+    // 立即整理文件, 去掉追加写入留下的垃圾
+    bool Compact();
+
+    FRegionFileStats GetStats() const;
+
+    struct FColumnEntry {
+        uint64 Offset = 0;
+        uint32 Size   = 0;
+        // 列目录的校验和
+        uint32 Hash = 0;
+    };
+    using FColumnTable = std::array<FColumnEntry, ColumnsPerRegion>;
+
+  private:
+    // 一个映射及其对应的列表; 发布后不再修改
+    struct FSnapshot {
+        std::shared_ptr<const FMappedFile> Mapping;
+        FColumnTable                       Table;
+    };
+
+    FRegionFile() = default;
+
+    std::shared_ptr<const FSnapshot> GetSnapshot() const;
+    // 重新映射文件并发布新快照; 只在持有 WriteMutex 时调用
+    bool                             Publish(const FColumnTable &Table);
+    bool                             CompactLocked();
+
+    std::string  Path;
+    FRegionCoord Region;
+
+    mutable FMutex                   SnapshotMutex;
+    std::shared_ptr<const FSnapshot> Snapshot;
+
+    // 以下只在持有 WriteMutex 时访问
+    FMutex                         WriteMutex;
+    std::unique_ptr<FWritableFile> Writer;
+    uint64                         EndOffset = 0;
+};
+} // namespace TE::Voxel
@@ -0,0 +1,187 @@
+/******************************************************
+ * @file Voxel/VoxelChunk.hpp
+ * @brief 调色板压缩的 32^3 体素区块
+ *****************************************************/
+
+#pragma once
+
+#include "DebugUtils/CoreDebug.hpp"
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace TE::Voxel {
+// 区块的调色板编码原始数据, 供持久化整块读写而不经过逐体素编解码
+struct FPackedChunk {
+    // 0 表示均匀区块, 此时 Palette 只有一项且 Data 为空
+    uint32                  BitsPerIndex = 0;
+    // 可能包含已不被引用的空闲项
+    std::span<const FVoxel> Palette;
+    // ChunkVolume * BitsPerIndex / 64 个字
+    std::span<const uint64> Data;
+};
+
+// 每个体素 4 位的光照等级 (0~15), 两个体素共用一个字节. 整个区块同一等级时
+// (例如天空中全是 15, 地下深处全是 0) 不分配数组
+class FLightNibbles {
+  public:
+    static constexpr uint32 MaxLevel = 15;
+
+    explicit FLightNibbles(uint32 Level = 0) : UniformLevel(uint8(Level)) {}
+
+    uint32 Get(uint32 Index) const {
+        check(Index < ChunkVolume);
+        if (Nibbles.empty()) {
+            return UniformLevel;
+        }
+        return (Nibbles[Index >> 1] >> ((Index & 1) * 4)) & MaxLevel;
+    }
+
+    void Set(uint32 Index, uint32 Level);
+
+    // 整个区块设为同一等级并释放数组
+    void Fill(uint32 Level) {
+        check(Level <= MaxLevel);
+        std::vector<uint8>().swap(Nibbles);
+        UniformLevel = uint8(Level);
+    }
+
+    // 所有体素等级相同时释放数组
+    void Compact();
+
+    bool IsUniform() const { return Nibbles.empty(); }
+
+    std::size_t GetMemoryUsage() const { return Nibbles.capacity(); }
+
+  private:
+    // ChunkVolume / 2 字节, 偶数下标在低 4 位; 为空表示全部为 UniformLevel
+    std::vector<uint8> Nibbles;
+    uint8              UniformLevel = 0;
+};
+
+// 32^3 体素区块
+//
+// 体素不直接存 FVoxel, 而是存调色板下标: 区块内只出现 N 种方块时, 每个体素只需
+// ceil(log2 N) 位 (向上取到 1/2/4/8/16, 保证下标不跨 uint64). 只有一种方块时
+// 收缩为 "均匀区块", 不分配下标数组, 整个区块只占调色板里的一个值.
+// 原始 64 KB 的区块, 地表附近通常 2~4 位即可, 地下/天空则几乎全部是均匀区块.
+//
+// 另外维护每个 8^3 砖块的非空气体素计数和 64 位占用掩码, 供网格化、射线检测跳过空砖块.
+//
+// 调色板旁边存放方块光与天空光 (各 4 位, 见 FLightNibbles), 由 FVoxelLighting 维护;
+// 修改方块本身不会更新光照.
+//
+// 非线程安全; 并发读是安全的, 读写之间需要外部同步
+class FVoxelChunk {
+  public:
+    explicit FVoxelChunk(FVoxel Fill = AirVoxel);
+
+    FVoxel Get(int32 X, int32 Y, int32 Z) const { return Get(GetVoxelIndex(X, Y, Z)); }
+
+    FVoxel Get(uint32 Index) const {
+        check(Index < ChunkVolume);
+        if (BitsPerIndex == 0) {
+            return Palette[0];
+        }
+        const uint32 Bit = Index * BitsPerIndex;
+        return Palette[(Data[Bit >> 6] >> (Bit & 63)) & IndexMask];
+    }
+
+    void Set(int32 X, int32 Y, int32 Z, FVoxel Voxel) { Set(GetVoxelIndex(X, Y, Z), Voxel); }
+
+    void Set(uint32 Index, FVoxel Voxel);
+
+    // 整个区块填成同一种方块, 直接变为均匀区块
+    void Fill(FVoxel Voxel);
+
+    // 解码到 ChunkVolume 大小的数组, 供需要随机访问全部体素的算法 (例如网格化) 使用
+    void Unpack(FVoxel *Out) const;
+
+    // Unpack 的逆操作: 用 ChunkVolume 大小的数组整体重建区块, 调色板按首次出现的顺序排列,
+    // 位宽取最小. 批量生成 (例如地形) 时比逐个 Set 快得多
+    void Pack(const FVoxel *Voxels);
+
+    // 去掉不再使用的调色板项并把位宽降到最小; 批量写入 (例如地形生成) 之后调用
+    void Compact();
+
+    bool IsUniform() const { return BitsPerIndex == 0; }
+
+    // 整个区块都是空气
+    bool IsEmpty() const { return BrickMask == 0; }
+
+    // 第 i 位表示第 i 个 8^3 砖块 (下标见 GetBrickIndex) 中存在非空气体素
+    uint64 GetBrickMask() const { return BrickMask; }
+
+    uint32 GetBitsPerIndex() const { return BitsPerIndex; }
+
+    // 调色板中仍在使用的方块种类数
+    uint32 NumDistinctVoxels() const { return NumUsedEntries; }
+
+    FLightNibbles       &GetBlockLight() { return BlockLight; }
+    const FLightNibbles &GetBlockLight() const { return BlockLight; }
+    FLightNibbles       &GetSkyLight() { return SkyLight; }
+    const FLightNibbles &GetSkyLight() const { return SkyLight; }
+
+    // 区块占用的堆内存 + 对象本身大小
+    std::size_t GetMemoryUsage() const;
+
+    // 返回的视图在下一次修改区块前有效
+    FPackedChunk GetPacked() const {
+        return { BitsPerIndex, Palette, Data };
+    }
+
+    // 用 Packed 中的位宽和调色板重建区块 (忽略 Packed.Data), 再由
+    // FillData(uint64 *Words, std::size_t NumWords) 直接写入下标数组, 例如从文件映射解压到其中.
+    // 数据不合法或 FillData 返回 false 时区块变为全空气并返回 false
+    template <typename FuncType> bool LoadPacked(const FPackedChunk &Packed, FuncType &&FillData) {
+        if (!ResetPacked(Packed) ||
+            (BitsPerIndex != 0 && (!FillData(Data.data(), Data.size()) || !RecountPaletteRefs()))) {
+            Fill(AirVoxel);
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    // LoadPacked 的两个阶段: 校验并设置调色板, 下标写入后重新统计引用数和砖块计数
+    bool ResetPacked(const FPackedChunk &Packed);
+    bool RecountPaletteRefs();
+
+    uint32 FindOrAddPaletteEntry(FVoxel Voxel);
+
+    // 把下标数组重新打包成 NewBits 位, Remap 为旧下标到新下标的映射 (为空表示不变)
+    void Repack(uint32 NewBits, const std::vector<uint16> &Remap);
+
+    void SetUniform(FVoxel Voxel);
+
+    void WriteIndex(uint32 Index, uint32 PaletteIndex) {
+        const uint32 Bit   = Index * BitsPerIndex;
+        uint64      &Word  = Data[Bit >> 6];
+        const uint32 Shift = Bit & 63;
+        Word = (Word & ~(uint64(IndexMask) << Shift)) | (uint64(PaletteIndex) << Shift);
+    }
+
+    uint32 ReadIndex(uint32 Index) const {
+        const uint32 Bit = Index * BitsPerIndex;
+        return uint32(Data[Bit >> 6] >> (Bit & 63)) & IndexMask;
+    }
+
+    // 下标数组, BitsPerIndex 为 0 时为空
+    std::vector<uint64> Data;
+    // 调色板与每项被引用的次数; 引用为 0 的项可被复用
+    std::vector<FVoxel> Palette;
+    std::vector<uint32> PaletteRefs;
+    uint32              NumUsedEntries = 1;
+    uint32              BitsPerIndex   = 0;
+    uint32              IndexMask      = 0;
+
+    uint16 BrickCounts[NumBricks] = {};
+    uint64 BrickMask              = 0;
+
+    FLightNibbles BlockLight;
+    FLightNibbles SkyLight;
+};
+} // namespace TE::Voxel
@@ -0,0 +1,110 @@
+/******************************************************
+ * @file Voxel/VoxelLighting.hpp
+ * @brief 增量体素光照: 方块光与天空光的 BFS 传播与撤销, 按区块区域并行
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelChunk.hpp"
+#include "Voxel/VoxelMap.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace TE::Voxel {
+struct FVoxelLightInfo {
+    // 方块自身发出的方块光等级
+    uint8 Emission = 0;
+    // 光进入该方块时衰减的等级 (至少按 1 计); >= 15 为不透明.
+    // 为 0 时天空光可以不衰减地向下穿过
+    uint8 Opacity = FLightNibbles::MaxLevel;
+};
+
+struct FLightingSettings {
+    // 以 FVoxel 为下标; 超出表长的方块不发光且不透明. 空气总是完全透明且不发光
+    std::vector<FVoxelLightInfo> Voxels;
+};
+
+struct FLightingStats {
+    // 上一次 Update: 因天空光跨出区域而多跑的轮数 (至少 1), 处理的区域数, 出队的节点数
+    uint32 NumRounds  = 0;
+    uint32 NumRegions = 0;
+    uint64 NumVisited = 0;
+};
+
+// 增量光照
+//
+// 光照存放在每个区块的 FLightNibbles 中. 方块光从发光方块出发, 每格衰减; 天空光为 15 的
+// 格子向下经过完全透明的方块时不衰减, 其余方向与方块光相同. 不在 Map 中的区块视为露天空气:
+// 天空光恒为 15, 方块光为 0 且不会被写入.
+//
+// 修改方块时只登记 BFS 的起点: 先撤销 (光照置 0 并沿等级递减的方向扩散, 遇到更亮的格子
+// 则改为从它重新传播), 再传播. 光照最多传 15 格, 小于区块边长, 因此每个起点只会影响
+// 所在区块及其 26 个邻居. Update 把待处理的区块按坐标模 3 分成 27 组, 同组区块的 3x3x3
+// 邻域互不重叠, 组内每个区块在线程池上作为一个任务独占地读写整个邻域, 组与组之间依次执行.
+// 竖直的天空光可以穿出邻域, 越界的节点交给目标区块在下一轮继续处理 (halo 交换).
+//
+// 卸载区块不会更新邻居的光照. 光照不随区块持久化, 加载后由 OnChunkAdded 重新计算.
+//
+// 非线程安全: 所有成员函数都在同一线程调用, Update 期间不能修改 Map
+class FVoxelLighting {
+  public:
+    explicit FVoxelLighting(FVoxelMap &InMap, FLightingSettings InSettings = {});
+
+    FVoxelLighting(const FVoxelLighting &)            = delete;
+    FVoxelLighting &operator=(const FVoxelLighting &) = delete;
+
+    // 修改体素并登记光照更新, 光照在下一次 Update 时传播
+    void SetVoxel(int32 X, int32 Y, int32 Z, FVoxel Voxel);
+
+    // 区块整块写入 Map 后 (加载、生成或替换) 调用: 重置区块光照, 撤销邻居之前从这里
+    // 得到的光, 并从区块内的发光方块和邻居边界重新传播
+    void OnChunkAdded(const FChunkCoord &Coord);
+
+    // 传播所有登记的更新, 返回光照有变化的区块 (按坐标排序), 供重新网格化
+    std::vector<FChunkCoord> Update();
+
+    bool HasPendingUpdates() const { return !Pending.empty(); }
+
+    uint32 GetBlockLight(int32 X, int32 Y, int32 Z) const;
+    uint32 GetSkyLight(int32 X, int32 Y, int32 Z) const;
+
+    FVoxelLightInfo GetLightInfo(FVoxel Voxel) const {
+        if (Voxel == AirVoxel) {
+            return { 0, 0 };
+        }
+        return Voxel < Settings.Voxels.size() ? Settings.Voxels[Voxel] : FVoxelLightInfo{};
+    }
+
+    const FLightingStats &GetStats() const { return Stats; }
+
+  private:
+    enum ELightChannel : uint32 { BlockChannel, SkyChannel, NumChannels };
+
+    // 世界坐标下的 BFS 起点; 撤销时 Level 为撤销前的等级, 传播时不使用
+    struct FLightSeed {
+        int32  X;
+        int32  Y;
+        int32  Z;
+        uint32 Level;
+    };
+
+    // 一个区块待处理的起点, 都位于该区块的 3x3x3 邻域内
+    struct FChunkLightWork {
+        std::vector<FLightSeed> Removals[NumChannels];
+        std::vector<FLightSeed> Additions[NumChannels];
+    };
+
+    struct FRegionTask;
+
+    FChunkLightWork &GetWork(const FChunkCoord &Coord) { return Pending[Coord]; }
+
+    FVoxelMap        &Map;
+    FLightingSettings Settings;
+
+    std::unordered_map<FChunkCoord, FChunkLightWork> Pending;
+    FLightingStats                                   Stats;
+};
+} // namespace TE::Voxel
@@ -0,0 +1,70 @@
+/******************************************************
+ * @file Voxel/VoxelMap.hpp
+ * @brief 稀疏区块表: 以区块坐标哈希索引已加载的区块
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelChunk.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+namespace TE::Voxel {
+// 只保存已加载的区块, 世界坐标 -> 区块为一次移位加一次哈希查找.
+// 不存在的区块一律视为空气; 写入时按需创建.
+// 区块对象地址在移除前保持不变, 可以长期持有 FVoxelChunk 指针.
+//
+// 非线程安全: 增删区块需要外部同步
+class FVoxelMap {
+  public:
+    FVoxelChunk *FindChunk(const FChunkCoord &Coord) {
+        auto It = Chunks.find(Coord);
+        return It != Chunks.end() ? It->second.get() : nullptr;
+    }
+
+    const FVoxelChunk *FindChunk(const FChunkCoord &Coord) const {
+        auto It = Chunks.find(Coord);
+        return It != Chunks.end() ? It->second.get() : nullptr;
+    }
+
+    // 区块不存在时创建一个全空气的区块
+    FVoxelChunk &FindOrAddChunk(const FChunkCoord &Coord);
+
+    // 返回是否确实移除了区块
+    bool RemoveChunk(const FChunkCoord &Coord) { return Chunks.erase(Coord) != 0; }
+
+    FVoxel GetVoxel(int32 X, int32 Y, int32 Z) const {
+        const FVoxelChunk *Chunk = FindChunk(GetChunkCoord(X, Y, Z));
+        return Chunk ? Chunk->Get(GetLocalVoxelIndex(X, Y, Z)) : AirVoxel;
+    }
+
+    // 向不存在的区块写入空气不会创建区块
+    void SetVoxel(int32 X, int32 Y, int32 Z, FVoxel Voxel);
+
+    // Func(const FChunkCoord &, FVoxelChunk &), 顺序不确定
+    template <typename FuncType> void ForEachChunk(FuncType &&Func) {
+        for (auto &[Coord, Chunk]: Chunks) {
+            Func(Coord, *Chunk);
+        }
+    }
+
+    // Func(const FChunkCoord &, const FVoxelChunk &)
+    template <typename FuncType> void ForEachChunk(FuncType &&Func) const {
+        for (const auto &[Coord, Chunk]: Chunks) {
+            Func(Coord, static_cast<const FVoxelChunk &>(*Chunk));
+        }
+    }
+
+    uint32 NumChunks() const { return uint32(Chunks.size()); }
+
+    // 所有区块的内存占用之和, 不含哈希表本身
+    std::size_t GetMemoryUsage() const;
+
+  private:
+    std::unordered_map<FChunkCoord, std::unique_ptr<FVoxelChunk>> Chunks;
+};
+} // namespace TE::Voxel
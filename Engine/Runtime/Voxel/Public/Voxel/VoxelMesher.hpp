@@ -0,0 +1,65 @@
+/******************************************************
+ * @file Voxel/VoxelMesher.hpp
+ * @brief 基于位掩码的贪心网格化
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelMap.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <vector>
+
+namespace TE::Voxel {
+// 面朝向, 轴 = Face / 2
+enum class EVoxelFace : uint8 { PosX, NegX, PosY, NegY, PosZ, NegZ };
+
+// 打包顶点, 8 字节
+// PositionAndFace: X | Y << 6 | Z << 12 | Face << 18, 坐标为区块内 [0, 32] 的格点
+// 每 4 个顶点构成一个逆时针的四边形, 渲染端用共享的 (0,1,2, 0,2,3) 索引缓冲绘制,
+// 纹理坐标可由位置和朝向推出, 因此不再单独存储
+struct FVoxelVertex {
+    uint32 PositionAndFace = 0;
+    uint32 Voxel           = 0;
+
+    static FVoxelVertex Pack(uint32 X, uint32 Y, uint32 Z, EVoxelFace Face, FVoxel Voxel) {
+        return { X | (Y << 6) | (Z << 12) | (uint32(Face) << 18), Voxel };
+    }
+
+    uint32     GetX() const { return PositionAndFace & 63; }
+    uint32     GetY() const { return (PositionAndFace >> 6) & 63; }
+    uint32     GetZ() const { return (PositionAndFace >> 12) & 63; }
+    EVoxelFace GetFace() const { return EVoxelFace((PositionAndFace >> 18) & 7); }
+};
+
+// 一个区块的网格; 重新网格化时复用 Vertices 的容量, 不重新分配
+struct FVoxelMesh {
+    std::vector<FVoxelVertex> Vertices;
+
+    uint32 NumQuads() const { return uint32(Vertices.size() / 4); }
+};
+
+// 六个相邻区块贴着边界的一层的占用, 按 EVoxelFace 排列.
+// Faces[Face][V] 的第 U 位表示该面外侧 (U, V) 处为实心, U = (Axis + 1) % 3, V = (Axis + 2) % 3
+struct FChunkBorders {
+    uint32 Faces[6][ChunkDim] = {};
+};
+
+// 从 Map 中读取 Coord 的六个邻居的边界层, 不存在的邻居视为空气
+void GatherChunkBorders(const FVoxelMap &Map, const FChunkCoord &Coord, FChunkBorders &OutBorders);
+
+// 与下面的版本相同, 但邻居只通过 Borders 给出, 不访问 FVoxelMap.
+// 用于在区块表之外 (例如流式加载的工作线程上) 网格化
+void GenerateChunkMesh(const FVoxelChunk &Chunk, const FChunkBorders &Borders,
+                       FVoxelMesh &OutMesh);
+
+// 生成区块 Coord 的网格, 写入 OutMesh (原有内容被清空)
+//
+// 非空气即视为不透明. 相邻区块只读取贴着边界的一层, 不存在的邻居视为空气.
+// 做法: 沿每个轴为每一列体素建立 34 位 (含两侧邻居) 的占用掩码, 一次移位与运算
+// 即得到整列的可见面; 再按切面把可见面写成 32x32 的位平面, 用 ctz 逐行找出
+// 同类型的最长连续段并向下扩展, 合并为尽可能大的四边形.
+// 临时数据放在线程局部的缓冲里, 可以在多个工作线程上同时调用
+void GenerateChunkMesh(const FVoxelMap &Map, const FChunkCoord &Coord, FVoxelMesh &OutMesh);
+} // namespace TE::Voxel
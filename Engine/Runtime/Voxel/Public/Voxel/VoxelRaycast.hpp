@@ -0,0 +1,77 @@
+/******************************************************
+ * @file Voxel/VoxelRaycast.hpp
+ * @brief 批量体素射线检测: 分层 3D-DDA, 跳过空区块与空砖块
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+#include "Voxel/VoxelMap.hpp"
+#include "Voxel/VoxelMesher.hpp"
+#include "Voxel/VoxelTypes.hpp"
+
+#include <span>
+#include <vector>
+
+namespace TE::Voxel {
+// 世界坐标以体素为单位, 体素 (X, Y, Z) 占据 [X, X + 1) x [Y, Y + 1) x [Z, Z + 1).
+// Direction 不必归一化, 为零向量时视为未命中; MaxDistance 为沿射线的长度, 须为有限值
+struct FVoxelRay {
+    float Origin[3]    = {};
+    float Direction[3] = {};
+    float MaxDistance  = 0.0f;
+};
+
+// 批量检测的结果, 按字段分开存放, 第 i 项对应第 i 条射线
+struct FRaycastHits {
+    // 命中的方块, 未命中为 AirVoxel (此时其余字段无意义)
+    std::vector<FVoxel>     Voxels;
+    // 命中体素的世界坐标
+    std::vector<int32>      X;
+    std::vector<int32>      Y;
+    std::vector<int32>      Z;
+    // 起点到射线进入命中体素处的距离; 起点就在实心体素内时为 0
+    std::vector<float>      Distances;
+    // 射线进入命中体素时穿过的面, 即命中点的法线; 起点就在实心体素内时无意义
+    std::vector<EVoxelFace> Faces;
+
+    void Resize(uint32 Count) {
+        Voxels.resize(Count);
+        X.resize(Count);
+        Y.resize(Count);
+        Z.resize(Count);
+        Distances.resize(Count);
+        Faces.resize(Count);
+    }
+
+    uint32 Num() const { return uint32(Voxels.size()); }
+    bool   IsHit(uint32 Index) const { return Voxels[Index] != AirVoxel; }
+};
+
+// 批量射线检测
+//
+// 每条射线在体素网格上做 3D-DDA, 只在非空砖块里逐格前进: 所在区块不存在或全是空气时
+// 一步走出整个区块, 所在砖块为空 (砖块占用掩码) 时一步走出整个砖块. 跳跃落点与逐格
+// 前进时完全一致, 结果与不跳跃时相同.
+//
+// 一批射线按 RaysPerTask 切片, 每片在线程池上作为一个任务执行, 片内共用一个小的区块
+// 查找缓存, 相邻射线经过同一批区块时不必反复查哈希表. 调用方按帧收集查询后一次提交,
+// 比零散的单次查询更能摊薄区块查找的开销.
+//
+// Raycast 期间不能修改 Map; 可以在多个线程上同时调用
+class FVoxelRaycaster {
+  public:
+    static constexpr uint32 DefaultRaysPerTask = 256;
+
+    explicit FVoxelRaycaster(const FVoxelMap &InMap, uint32 InRaysPerTask = DefaultRaysPerTask)
+        : Map(InMap), RaysPerTask(InRaysPerTask) {}
+
+    // 结果写入 OutHits (大小调整为射线数); 等待所有任务完成后返回.
+    // 射线数不超过 RaysPerTask 时直接在调用线程上执行
+    void Raycast(std::span<const FVoxelRay> Rays, FRaycastHits &OutHits) const;
+
+  private:
+    const FVoxelMap &Map;
+    uint32           RaysPerTask;
+};
+} // namespace TE::Voxel
@@ -0,0 +1,80 @@
+/******************************************************
+ * @file Voxel/VoxelTypes.hpp
+ * @brief 体素基础类型: 体素值、区块坐标与坐标换算
+ *****************************************************/
+
+#pragma once
+
+#include "TypeUtils/CoreType.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace TE::Voxel {
+// 体素值即方块类型 ID, 0 表示空气
+using FVoxel = uint16;
+
+inline constexpr FVoxel AirVoxel = 0;
+
+// 区块边长 32, 体素下标 = X | Y << 5 | Z << 10, X 变化最快
+inline constexpr int32  ChunkShift  = 5;
+inline constexpr int32  ChunkDim    = 1 << ChunkShift;
+inline constexpr int32  ChunkMask   = ChunkDim - 1;
+inline constexpr uint32 ChunkVolume = ChunkDim * ChunkDim * ChunkDim;
+
+// 区块再划分为 4x4x4 个 8^3 的砖块, 每个砖块在占用掩码中占一位
+inline constexpr int32  BrickShift    = 3;
+inline constexpr int32  BrickDim      = 1 << BrickShift;
+inline constexpr int32  BricksPerAxis = ChunkDim / BrickDim;
+inline constexpr uint32 NumBricks     = BricksPerAxis * BricksPerAxis * BricksPerAxis;
+static_assert(NumBricks == 64, "Brick occupancy must fit in one uint64");
+
+constexpr uint32 GetVoxelIndex(int32 X, int32 Y, int32 Z) {
+    return uint32(X) | (uint32(Y) << ChunkShift) | (uint32(Z) << (2 * ChunkShift));
+}
+
+constexpr uint32 GetBrickIndex(int32 X, int32 Y, int32 Z) {
+    return uint32(X >> BrickShift) | (uint32(Y >> BrickShift) << 2) |
+           (uint32(Z >> BrickShift) << 4);
+}
+
+// 体素下标 -> 所在砖块
+constexpr uint32 GetBrickIndexOfVoxel(uint32 VoxelIndex) {
+    return GetBrickIndex(int32(VoxelIndex & ChunkMask),
+                         int32((VoxelIndex >> ChunkShift) & ChunkMask),
+                         int32(VoxelIndex >> (2 * ChunkShift)));
+}
+
+struct FChunkCoord {
+    int32 X = 0;
+    int32 Y = 0;
+    int32 Z = 0;
+
+    bool operator==(const FChunkCoord &) const = default;
+};
+
+// 世界体素坐标 -> 区块坐标; 算术右移即向下取整, 负坐标同样正确
+constexpr FChunkCoord GetChunkCoord(int32 X, int32 Y, int32 Z) {
+    return { X >> ChunkShift, Y >> ChunkShift, Z >> ChunkShift };
+}
+
+// 世界体素坐标 -> 区块内下标
+constexpr uint32 GetLocalVoxelIndex(int32 X, int32 Y, int32 Z) {
+    return GetVoxelIndex(X & ChunkMask, Y & ChunkMask, Z & ChunkMask);
+}
+} // namespace TE::Voxel
+
+template <> struct std::hash<TE::Voxel::FChunkCoord> {
+    // 每个分量取低 21 位拼成 64 位后做一次混合 (splitmix64 的终结步骤)
+    std::size_t operator()(const TE::Voxel::FChunkCoord &Coord) const noexcept {
+        uint64 Key = (uint64(uint32(Coord.X)) & 0x1FFFFF) |
+                     ((uint64(uint32(Coord.Y)) & 0x1FFFFF) << 21) |
+                     ((uint64(uint32(Coord.Z)) & 0x1FFFFF) << 42);
+        Key ^= Key >> 30;
+        Key *= 0xBF58476D1CE4E5B9ull;
+        Key ^= Key >> 27;
+        Key *= 0x94D049BB133111EBull;
+        Key ^= Key >> 31;
+        return std::size_t(Key);
+    }
+};
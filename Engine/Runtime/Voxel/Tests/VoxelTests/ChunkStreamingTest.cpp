@@ -0,0 +1,238 @@
+/******************************************************
+ * @file VoxelTests/ChunkStreamingTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/ChunkStreaming.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace TE::Voxel;
+
+namespace {
+// 记录每个阶段同时执行的回调数的峰值
+struct FStageProbe {
+    std::atomic<int32> Active{ 0 };
+    std::atomic<int32> Peak{ 0 };
+    std::atomic<int32> Calls{ 0 };
+
+    void Enter() {
+        const int32 Now = Active.fetch_add(1) + 1;
+        int32       Old = Peak.load();
+        while (Old < Now && !Peak.compare_exchange_weak(Old, Now)) {
+        }
+        Calls.fetch_add(1);
+        // 让任务有机会重叠
+        std::this_thread::yield();
+    }
+    void Leave() { Active.fetch_sub(1); }
+};
+
+// 世界 Y < 0 为石头; Y = 0 的区块里按区块坐标放一根柱子
+void GenerateTerrain(const FChunkCoord &Coord, FVoxelChunk &Chunk) {
+    if (Coord.Y < 0) {
+        Chunk.Fill(1);
+        return;
+    }
+    if (Coord.Y == 0) {
+        const int32 X = Coord.X & 15;
+        const int32 Z = (Coord.Z * 7) & 31;
+        for (int32 Y = 0; Y < 4 + (Coord.X & 7); ++Y) {
+            Chunk.Set(X, Y, Z, FVoxel(2 + (Coord.Z & 3)));
+        }
+    }
+}
+
+auto CoordKey(const FChunkCoord &Coord) {
+    return std::make_tuple(Coord.X, Coord.Y, Coord.Z);
+}
+
+struct FStreamingFixture {
+    FVoxelMap                                             Map;
+    FStageProbe                                           Probes[3];
+    std::mutex                                            Mutex;
+    std::vector<FChunkCoord>                              LoadOrder;
+    std::vector<FChunkCoord>                              Unloaded;
+    std::map<std::tuple<int32, int32, int32>, FVoxelMesh> Meshes;
+
+    FChunkStreamingCallbacks MakeCallbacks() {
+        FChunkStreamingCallbacks Callbacks;
+        Callbacks.Load = [this](const FChunkCoord &Coord, FVoxelChunk &Chunk) {
+            Probes[0].Enter();
+            {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                LoadOrder.push_back(Coord);
+            }
+            // X < 0 的一半世界 "存档" 里有, 存的是全石头
+            const bool bSaved = Coord.X < 0 && Coord.Y == 1;
+            if (bSaved) {
+                Chunk.Fill(9);
+            }
+            Probes[0].Leave();
+            return bSaved;
+        };
+        Callbacks.Generate = [this](const FChunkCoord &Coord, FVoxelChunk &Chunk) {
+            Probes[1].Enter();
+            GenerateTerrain(Coord, Chunk);
+            Probes[1].Leave();
+        };
+        Callbacks.Light = [this](const FChunkCoord &, FVoxelChunk &) {
+            Probes[2].Enter();
+            Probes[2].Leave();
+        };
+        Callbacks.Unload = [this](const FChunkCoord &Coord, const FVoxelChunk &) {
+            Unloaded.push_back(Coord);
+        };
+        return Callbacks;
+    }
+
+    void Pump(FChunkStreamer &Streamer, const FChunkCoord &Player) {
+        Streamer.Update(Player);
+        Streamer.ConsumeReadyMeshes(~0u, [this](const FChunkCoord &Coord, FVoxelMesh &&Mesh) {
+            Meshes[CoordKey(Coord)] = std::move(Mesh);
+        });
+    }
+
+    void RunUntilIdle(FChunkStreamer &Streamer, const FChunkCoord &Player) {
+        Pump(Streamer, Player);
+        for (int32 Iteration = 0; Iteration < 1000000 && !Streamer.IsIdle(); ++Iteration) {
+            std::this_thread::yield();
+            Pump(Streamer, Player);
+        }
+        ASSERT_TRUE(Streamer.IsIdle());
+    }
+};
+
+bool IsInRange(const FChunkCoord &Coord, const FChunkCoord &Player, int32 Radius,
+               int32 Vertical) {
+    const int32 DX = Coord.X - Player.X;
+    const int32 DZ = Coord.Z - Player.Z;
+    return DX * DX + DZ * DZ <= Radius * Radius && std::abs(Coord.Y - Player.Y) <= Vertical;
+}
+} // namespace
+
+TEST(ChunkStreamingTest, StreamsAroundPlayer) {
+    FStreamingFixture       Fixture;
+    FChunkStreamingSettings Settings;
+    Settings.ViewRadius       = 3;
+    Settings.VerticalRadius   = 1;
+    Settings.UnloadMargin     = 1;
+    Settings.MaxInFlight[0]   = 1;
+    Settings.MaxInFlight[1]   = 2;
+    Settings.MaxInFlight[2]   = 1;
+    Settings.MaxInFlight[3]   = 2;
+    Settings.MaxPendingMeshes = 4;
+    FChunkStreamer Streamer(Fixture.Map, Fixture.MakeCallbacks(), Settings);
+
+    const FChunkCoord Player = { 0, 0, 0 };
+    Fixture.RunUntilIdle(Streamer, Player);
+
+    // 离玩家最近的区块最先加载
+    ASSERT_FALSE(Fixture.LoadOrder.empty());
+    EXPECT_EQ(Fixture.LoadOrder[0], Player);
+    EXPECT_LE(Fixture.Probes[0].Peak.load(), 1);
+    EXPECT_LE(Fixture.Probes[1].Peak.load(), 2);
+    EXPECT_LE(Fixture.Probes[2].Peak.load(), 1);
+
+    // 加载范围内全部驻留; 存档中的区块不再生成
+    int32 NumLoadRange = 0;
+    int32 NumSaved     = 0;
+    for (int32 Y = -2; Y <= 2; ++Y) {
+        for (int32 Z = -4; Z <= 4; ++Z) {
+            for (int32 X = -4; X <= 4; ++X) {
+                const FChunkCoord Coord = { X, Y, Z };
+                if (!IsInRange(Coord, Player, 4, 2)) {
+                    EXPECT_FALSE(Streamer.IsResident(Coord));
+                    continue;
+                }
+                ++NumLoadRange;
+                NumSaved += X < 0 && Y == 1;
+                EXPECT_TRUE(Streamer.IsResident(Coord));
+            }
+        }
+    }
+    EXPECT_EQ(Fixture.Probes[0].Calls.load(), NumLoadRange);
+    EXPECT_EQ(Fixture.Probes[1].Calls.load(), NumLoadRange - NumSaved);
+    EXPECT_EQ(Fixture.Probes[2].Calls.load(), NumLoadRange);
+    EXPECT_EQ(Fixture.Map.FindChunk({ -1, 1, 0 })->Get(0u), 9);
+
+    // 可见范围内每个非空区块都交出了网格, 且与直接网格化的结果一致
+    Fixture.Map.ForEachChunk([&](const FChunkCoord &Coord, const FVoxelChunk &) {
+        auto It = Fixture.Meshes.find(CoordKey(Coord));
+        if (!IsInRange(Coord, Player, 3, 1)) {
+            EXPECT_TRUE(It == Fixture.Meshes.end());
+            return;
+        }
+        ASSERT_TRUE(It != Fixture.Meshes.end());
+        FVoxelMesh Expected;
+        GenerateChunkMesh(Fixture.Map, Coord, Expected);
+        EXPECT_EQ(It->second.Vertices.size(), Expected.Vertices.size());
+        EXPECT_TRUE(std::equal(Expected.Vertices.begin(), Expected.Vertices.end(),
+                               It->second.Vertices.begin(), It->second.Vertices.end(),
+                               [](const FVoxelVertex &A, const FVoxelVertex &B) {
+                                   return A.PositionAndFace == B.PositionAndFace &&
+                                          A.Voxel == B.Voxel;
+                               }));
+    });
+    // 地下的石头区块四周和下方都有邻居, 只有朝上的面
+    const FVoxelMesh &Underground = Fixture.Meshes.at(CoordKey({ 0, -1, 0 }));
+    EXPECT_GT(Underground.NumQuads(), 0u);
+    for (const FVoxelVertex &Vertex: Underground.Vertices) {
+        EXPECT_EQ(Vertex.GetFace(), EVoxelFace::PosY);
+    }
+    EXPECT_FALSE(Fixture.Meshes.at(CoordKey({ 0, 0, 0 })).Vertices.empty());
+}
+
+TEST(ChunkStreamingTest, CancelsStaleRequestsAndUnloads) {
+    FStreamingFixture       Fixture;
+    FChunkStreamingSettings Settings;
+    Settings.ViewRadius     = 3;
+    Settings.VerticalRadius = 1;
+    Settings.UnloadMargin   = 0;
+    FChunkStreamer Streamer(Fixture.Map, Fixture.MakeCallbacks(), Settings);
+
+    Fixture.RunUntilIdle(Streamer, { 0, 0, 0 });
+    const uint32 NumInitial = Streamer.GetStats().NumResident;
+
+    // 飞行: 每帧前进 4 个区块, 队列中落在身后的请求被取消
+    for (int32 Step = 1; Step < 20; ++Step) {
+        Fixture.Pump(Streamer, { Step * 4, 0, 0 });
+    }
+    EXPECT_GT(Streamer.GetStats().NumCancelled, 0u);
+
+    const FChunkCoord Player = { 100, 0, 0 };
+    Fixture.RunUntilIdle(Streamer, Player);
+    const FChunkStreamingStats Stats = Streamer.GetStats();
+    EXPECT_EQ(Stats.NumPendingMeshes, 0u);
+
+    // 只剩新位置附近的区块驻留, 其余都经过 Unload 回调
+    Fixture.Map.ForEachChunk([&](const FChunkCoord &Coord, const FVoxelChunk &) {
+        EXPECT_TRUE(IsInRange(Coord, Player, 4, 2));
+    });
+    EXPECT_FALSE(Fixture.Unloaded.empty());
+    for (const FChunkCoord &Coord: Fixture.Unloaded) {
+        EXPECT_FALSE(Streamer.IsResident(Coord));
+    }
+    EXPECT_GE(Fixture.Unloaded.size(), NumInitial);
+    // 加载次数远小于沿途所有区块的数量
+    EXPECT_LT(Fixture.Probes[0].Calls.load(), 10 * int32(Stats.NumResident));
+
+    // 修改驻留区块后重新网格化
+    const FChunkCoord Edited = { 101, 0, 1 };
+    Fixture.Map.FindOrAddChunk(Edited).Set(5, 5, 5, 7);
+    Fixture.Meshes.clear();
+    Streamer.RequestRemesh(Edited);
+    Fixture.RunUntilIdle(Streamer, Player);
+    ASSERT_EQ(Fixture.Meshes.size(), 1u);
+    FVoxelMesh Expected;
+    GenerateChunkMesh(Fixture.Map, Edited, Expected);
+    EXPECT_EQ(Fixture.Meshes.begin()->second.Vertices.size(), Expected.Vertices.size());
+}
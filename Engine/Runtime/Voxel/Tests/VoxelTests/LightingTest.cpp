@@ -0,0 +1,336 @@
+/******************************************************
+ * @file VoxelTests/LightingTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelLighting.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace TE::Voxel;
+using namespace TE;
+
+namespace {
+constexpr FVoxel Stone     = 1;
+constexpr FVoxel Glass     = 2;
+constexpr FVoxel Water     = 3;
+constexpr FVoxel Torch     = 4;
+constexpr FVoxel Glowstone = 5;
+
+FLightingSettings MakeSettings() {
+    FLightingSettings Settings;
+    Settings.Voxels = { {}, { 0, 15 }, { 0, 0 }, { 0, 2 }, { 14, 0 }, { 15, 15 } };
+    return Settings;
+}
+
+// 区块范围 [Min, Max] 内整体重新计算光照, 范围外和未加载的区块视为露天空气
+struct FReferenceLight {
+    FReferenceLight(const FVoxelMap &Map, const FVoxelLighting &Lighting, FChunkCoord InMin,
+                    FChunkCoord InMax)
+        : Min(InMin) {
+        // 四周多留一格, 代表范围外的空气
+        Dims[0] = (InMax.X - Min.X + 1) * ChunkDim + 2;
+        Dims[1] = (InMax.Y - Min.Y + 1) * ChunkDim + 2;
+        Dims[2] = (InMax.Z - Min.Z + 1) * ChunkDim + 2;
+        const std::size_t Size = std::size_t(Dims[0]) * Dims[1] * Dims[2];
+        Stored.assign(Size, false);
+        Infos.assign(Size, Lighting.GetLightInfo(AirVoxel));
+        Block.assign(Size, 0);
+        Sky.assign(Size, 0);
+
+        std::vector<int32> BlockQueue;
+        std::vector<int32> SkyQueue;
+        for (int32 Z = 0; Z < Dims[2]; ++Z) {
+            for (int32 Y = 0; Y < Dims[1]; ++Y) {
+                for (int32 X = 0; X < Dims[0]; ++X) {
+                    const int32 Cell  = ToCell(X, Y, Z);
+                    const int32 WX    = X - 1 + Min.X * ChunkDim;
+                    const int32 WY    = Y - 1 + Min.Y * ChunkDim;
+                    const int32 WZ    = Z - 1 + Min.Z * ChunkDim;
+                    const bool  bEdge = X == 0 || Y == 0 || Z == 0 || X == Dims[0] - 1 ||
+                                       Y == Dims[1] - 1 || Z == Dims[2] - 1;
+                    const FVoxelChunk *Chunk =
+                        bEdge ? nullptr : Map.FindChunk(GetChunkCoord(WX, WY, WZ));
+                    if (!Chunk) {
+                        Sky[Cell] = 15;
+                        SkyQueue.push_back(Cell);
+                        continue;
+                    }
+                    const FVoxel Voxel = Chunk->Get(GetLocalVoxelIndex(WX, WY, WZ));
+                    Stored[Cell]       = true;
+                    Infos[Cell]        = Lighting.GetLightInfo(Voxel);
+                    if (Infos[Cell].Emission > 0) {
+                        Block[Cell] = Infos[Cell].Emission;
+                        BlockQueue.push_back(Cell);
+                    }
+                }
+            }
+        }
+        Flood(Block, BlockQueue, false);
+        Flood(Sky, SkyQueue, true);
+    }
+
+    int32 ToCell(int32 X, int32 Y, int32 Z) const { return X + Dims[0] * (Y + Dims[1] * Z); }
+
+    void Flood(std::vector<uint8> &Light, std::vector<int32> &Queue, bool bSky) {
+        const int32 Steps[6] = { 1, -1, Dims[0], -Dims[0], Dims[0] * Dims[1], -Dims[0] * Dims[1] };
+        for (std::size_t Head = 0; Head < Queue.size(); ++Head) {
+            const int32 Cell  = Queue[Head];
+            const int32 Level = Light[Cell];
+            const int32 X     = Cell % Dims[0];
+            const int32 Y     = Cell / Dims[0] % Dims[1];
+            const int32 Z     = Cell / (Dims[0] * Dims[1]);
+            for (int32 Dir = 0; Dir < 6; ++Dir) {
+                const int32 Coord[3] = { X, Y, Z };
+                const int32 Next     = Coord[Dir / 2] + (Dir & 1 ? -1 : 1);
+                if (Next < 0 || Next >= Dims[Dir / 2]) {
+                    continue;
+                }
+                const int32 NextCell = Cell + Steps[Dir];
+                if (!Stored[NextCell] || Infos[NextCell].Opacity >= 15) {
+                    continue;
+                }
+                int32 NewLevel = Level - std::max<int32>(Infos[NextCell].Opacity, 1);
+                if (bSky && Dir == 3 && Level == 15 && Infos[NextCell].Opacity == 0) {
+                    NewLevel = 15;
+                }
+                if (NewLevel > Light[NextCell]) {
+                    Light[NextCell] = uint8(NewLevel);
+                    Queue.push_back(NextCell);
+                }
+            }
+        }
+    }
+
+    // 比较范围内所有已加载的体素
+    void Expect(const FVoxelLighting &Lighting) const {
+        int32 NumMismatches = 0;
+        for (int32 Z = 1; Z < Dims[2] - 1; ++Z) {
+            for (int32 Y = 1; Y < Dims[1] - 1; ++Y) {
+                for (int32 X = 1; X < Dims[0] - 1; ++X) {
+                    const int32 Cell = ToCell(X, Y, Z);
+                    if (!Stored[Cell]) {
+                        continue;
+                    }
+                    const int32 WX = X - 1 + Min.X * ChunkDim;
+                    const int32 WY = Y - 1 + Min.Y * ChunkDim;
+                    const int32 WZ = Z - 1 + Min.Z * ChunkDim;
+                    if ((Lighting.GetBlockLight(WX, WY, WZ) != Block[Cell] ||
+                         Lighting.GetSkyLight(WX, WY, WZ) != Sky[Cell]) &&
+                        NumMismatches++ < 5) {
+                        ADD_FAILURE() << "(" << WX << ", " << WY << ", " << WZ << ") block "
+                                      << Lighting.GetBlockLight(WX, WY, WZ) << " expected "
+                                      << int32(Block[Cell]) << ", sky "
+                                      << Lighting.GetSkyLight(WX, WY, WZ) << " expected "
+                                      << int32(Sky[Cell]);
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(NumMismatches, 0);
+    }
+
+    FChunkCoord                  Min;
+    int32                        Dims[3];
+    std::vector<bool>            Stored;
+    std::vector<FVoxelLightInfo> Infos;
+    std::vector<uint8>           Block;
+    std::vector<uint8>           Sky;
+};
+
+// 高低起伏的石头地面, 地下有随机的空洞
+void FillTerrain(FVoxelMap &Map, const FChunkCoord &Coord, std::mt19937 &Random) {
+    FVoxelChunk &Chunk = Map.FindOrAddChunk(Coord);
+    for (int32 Z = 0; Z < ChunkDim; ++Z) {
+        for (int32 Y = 0; Y < ChunkDim; ++Y) {
+            for (int32 X = 0; X < ChunkDim; ++X) {
+                const int32 WX     = Coord.X * ChunkDim + X;
+                const int32 WY     = Coord.Y * ChunkDim + Y;
+                const int32 WZ     = Coord.Z * ChunkDim + Z;
+                const int32 Height = 8 + (WX * 3 + WZ * 5) % 11;
+                if (WY < Height && Random() % 16 != 0) {
+                    Chunk.Set(X, Y, Z, Stone);
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+TEST(LightingTest, Nibbles) {
+    FLightNibbles Light(15);
+    EXPECT_TRUE(Light.IsUniform());
+    EXPECT_EQ(Light.Get(1234u), 15u);
+    EXPECT_EQ(Light.GetMemoryUsage(), 0u);
+
+    Light.Set(7, 3);
+    Light.Set(8, 0);
+    EXPECT_FALSE(Light.IsUniform());
+    EXPECT_EQ(Light.GetMemoryUsage(), ChunkVolume / 2);
+    EXPECT_EQ(Light.Get(6u), 15u);
+    EXPECT_EQ(Light.Get(7u), 3u);
+    EXPECT_EQ(Light.Get(8u), 0u);
+    EXPECT_EQ(Light.Get(9u), 15u);
+
+    // 改回同一等级后 Compact 释放数组
+    Light.Set(7, 15);
+    Light.Compact();
+    EXPECT_FALSE(Light.IsUniform());
+    Light.Set(8, 15);
+    Light.Compact();
+    EXPECT_TRUE(Light.IsUniform());
+    EXPECT_EQ(Light.Get(8u), 15u);
+
+    FVoxelChunk Chunk;
+    EXPECT_EQ(Chunk.GetSkyLight().Get(0u), 0u);
+    Chunk.GetBlockLight().Set(5, 9);
+    EXPECT_EQ(Chunk.GetBlockLight().Get(5u), 9u);
+    EXPECT_EQ(Chunk.GetSkyLight().Get(5u), 0u);
+}
+
+TEST(LightingTest, TorchStaysLocal) {
+    FVoxelMap Map;
+    for (int32 Z = -3; Z <= 3; ++Z) {
+        for (int32 Y = -3; Y <= 3; ++Y) {
+            for (int32 X = -3; X <= 3; ++X) {
+                Map.FindOrAddChunk({ X, Y, Z }).Fill(Y < 0 ? Stone : AirVoxel);
+            }
+        }
+    }
+    FVoxelLighting Lighting(Map, MakeSettings());
+    Map.ForEachChunk([&Lighting](const FChunkCoord &Coord, FVoxelChunk &) {
+        Lighting.OnChunkAdded(Coord);
+    });
+    Lighting.Update();
+    EXPECT_EQ(Lighting.GetSkyLight(5, 0, 5), 15u);
+    EXPECT_EQ(Lighting.GetSkyLight(5, -1, 5), 0u);
+    EXPECT_FALSE(Lighting.HasPendingUpdates());
+
+    // 地下挖一个洞放火把, 只影响所在区块和邻居
+    Lighting.SetVoxel(40, -20, 40, Torch);
+    Lighting.SetVoxel(41, -20, 40, AirVoxel);
+    Lighting.SetVoxel(42, -20, 40, AirVoxel);
+    const std::vector<FChunkCoord> Changed = Lighting.Update();
+    EXPECT_EQ(Changed, (std::vector<FChunkCoord>{ { 1, -1, 1 } }));
+    EXPECT_EQ(Lighting.GetStats().NumRounds, 1u);
+    EXPECT_EQ(Lighting.GetStats().NumRegions, 1u);
+    EXPECT_LT(Lighting.GetStats().NumVisited, 100u);
+    EXPECT_EQ(Lighting.GetBlockLight(40, -20, 40), 14u);
+    EXPECT_EQ(Lighting.GetBlockLight(42, -20, 40), 12u);
+    EXPECT_EQ(Lighting.GetBlockLight(43, -20, 40), 0u);
+    EXPECT_EQ(Lighting.GetSkyLight(42, -20, 40), 0u);
+
+    // 拿走火把后光全部撤销, 光照数组收缩回均匀
+    Lighting.SetVoxel(40, -20, 40, AirVoxel);
+    Lighting.Update();
+    EXPECT_EQ(Lighting.GetBlockLight(40, -20, 40), 0u);
+    EXPECT_EQ(Lighting.GetBlockLight(42, -20, 40), 0u);
+    EXPECT_TRUE(Map.FindChunk({ 1, -1, 1 })->GetBlockLight().IsUniform());
+}
+
+TEST(LightingTest, SkyShaftCrossesRegions) {
+    // 一根 6 个区块高的石柱, 从顶上往下打通
+    FVoxelMap Map;
+    for (int32 Y = -6; Y < 0; ++Y) {
+        Map.FindOrAddChunk({ 0, Y, 0 }).Fill(Stone);
+    }
+    FVoxelLighting Lighting(Map, MakeSettings());
+    for (int32 Y = -6; Y < 0; ++Y) {
+        Lighting.OnChunkAdded({ 0, Y, 0 });
+    }
+    Lighting.Update();
+    EXPECT_EQ(Lighting.GetSkyLight(16, -100, 16), 0u);
+
+    for (int32 Y = -1; Y >= -6 * ChunkDim; --Y) {
+        Lighting.SetVoxel(16, Y, 16, Y == -150 ? Glass : AirVoxel);
+    }
+    Lighting.SetVoxel(17, -100, 16, AirVoxel);
+    Lighting.Update();
+    EXPECT_EQ(Lighting.GetSkyLight(16, -6 * ChunkDim, 16), 15u);
+    EXPECT_EQ(Lighting.GetSkyLight(17, -100, 16), 14u);
+
+    // 在顶上盖一块水: 天空光不再直通, 每格水衰减 2 后逐格递减
+    Lighting.SetVoxel(16, -1, 16, Water);
+    Lighting.Update();
+    EXPECT_GT(Lighting.GetStats().NumRounds, 1u);
+    EXPECT_EQ(Lighting.GetSkyLight(16, -1, 16), 13u);
+    EXPECT_EQ(Lighting.GetSkyLight(16, -2, 16), 12u);
+    EXPECT_EQ(Lighting.GetSkyLight(16, -14, 16), 0u);
+    EXPECT_EQ(Lighting.GetSkyLight(16, -100, 16), 0u);
+    EXPECT_EQ(Lighting.GetSkyLight(17, -100, 16), 0u);
+    // 井底下面是未加载的区块, 按露天空气从下方照进来
+    EXPECT_EQ(Lighting.GetSkyLight(16, -6 * ChunkDim, 16), 14u);
+    EXPECT_EQ(Lighting.GetSkyLight(16, -6 * ChunkDim + 3, 16), 11u);
+}
+
+TEST(LightingTest, IncrementalMatchesFullRecompute) {
+    const FChunkCoord Min{ -1, -3, 0 };
+    const FChunkCoord Max{ 1, 1, 1 };
+    // 留下一个地下区块不加载, 作为露天空气的洞口
+    const FChunkCoord Missing{ 1, -2, 1 };
+
+    std::mt19937   Random(2024);
+    FVoxelMap      Map;
+    FVoxelLighting Lighting(Map, MakeSettings());
+    for (int32 Z = Min.Z; Z <= Max.Z; ++Z) {
+        for (int32 Y = Min.Y; Y <= Max.Y; ++Y) {
+            for (int32 X = Min.X; X <= Max.X; ++X) {
+                if (FChunkCoord{ X, Y, Z } != Missing) {
+                    FillTerrain(Map, { X, Y, Z }, Random);
+                    Lighting.OnChunkAdded({ X, Y, Z });
+                }
+            }
+        }
+    }
+    Lighting.Update();
+    FReferenceLight(Map, Lighting, Min, Max).Expect(Lighting);
+
+    const auto RandomIn = [&Random](int32 Low, int32 High) {
+        return Low + int32(Random() % uint32(High - Low + 1));
+    };
+    const FVoxel Kinds[] = { AirVoxel, AirVoxel, Stone, Stone, Glass, Water, Torch, Glowstone };
+    for (int32 Batch = 0; Batch < 12; ++Batch) {
+        SCOPED_TRACE(Batch);
+        // 在几处挖掘和放置, 不超出比较的范围
+        const int32 NumSites = RandomIn(1, 4);
+        for (int32 Site = 0; Site < NumSites; ++Site) {
+            const int32  CX    = RandomIn(Min.X * ChunkDim + 3, (Max.X + 1) * ChunkDim - 4);
+            const int32  CY    = RandomIn(Min.Y * ChunkDim + 3, (Max.Y + 1) * ChunkDim - 4);
+            const int32  CZ    = RandomIn(Min.Z * ChunkDim + 3, (Max.Z + 1) * ChunkDim - 4);
+            const FVoxel Voxel = Kinds[Random() % std::size(Kinds)];
+            const int32  Size  = RandomIn(0, 3);
+            for (int32 Z = CZ - Size; Z <= CZ + Size; ++Z) {
+                for (int32 Y = CY - Size; Y <= CY + Size; ++Y) {
+                    for (int32 X = CX - Size; X <= CX + Size; ++X) {
+                        Lighting.SetVoxel(X, Y, Z, Voxel);
+                    }
+                }
+            }
+        }
+        // 偶尔打通或封上一根竖井, 让天空光跨出邻域
+        if (Batch % 3 == 1) {
+            const int32  X     = RandomIn(Min.X * ChunkDim, (Max.X + 1) * ChunkDim - 1);
+            const int32  Z     = RandomIn(Min.Z * ChunkDim, (Max.Z + 1) * ChunkDim - 1);
+            const FVoxel Voxel = Batch % 2 ? AirVoxel : Stone;
+            for (int32 Y = (Max.Y + 1) * ChunkDim - 1; Y >= Min.Y * ChunkDim; --Y) {
+                Lighting.SetVoxel(X, Y, Z, Voxel);
+            }
+        }
+        Lighting.Update();
+        FReferenceLight(Map, Lighting, Min, Max).Expect(Lighting);
+    }
+
+    // 整块替换区块, 包括之前缺失的那个
+    FVoxelChunk &Replaced = Map.FindOrAddChunk(Missing);
+    Replaced.Fill(Stone);
+    Replaced.Set(3, 4, 5, Glowstone);
+    Lighting.OnChunkAdded(Missing);
+    Map.FindOrAddChunk({ 0, 1, 0 }).Fill(Glass);
+    Lighting.OnChunkAdded({ 0, 1, 0 });
+    Lighting.Update();
+    FReferenceLight(Map, Lighting, Min, Max).Expect(Lighting);
+}
@@ -0,0 +1,153 @@
+/******************************************************
+ * @file VoxelTests/MesherTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/MeshingPipeline.hpp"
+#include "Voxel/VoxelMesher.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <tuple>
+
+using namespace TE::Voxel;
+
+namespace {
+// (面, 体素 X, Y, Z): 一个可见的单位面
+using FUnitFace = std::tuple<uint32, int32, int32, int32>;
+
+// 把网格的每个四边形拆回单位面, 同时检查四边形内的类型一致
+std::set<FUnitFace> RasterizeMesh(const FVoxelMesh &Mesh, const FVoxelChunk &Chunk) {
+    std::set<FUnitFace> Faces;
+    for (uint32 Quad = 0; Quad < Mesh.NumQuads(); ++Quad) {
+        const FVoxelVertex *V      = &Mesh.Vertices[Quad * 4];
+        const uint32        Face   = uint32(V[0].GetFace());
+        const uint32        Axis   = Face / 2;
+        uint32              Min[3] = { 63, 63, 63 };
+        uint32              Max[3] = { 0, 0, 0 };
+        for (int32 Corner = 0; Corner < 4; ++Corner) {
+            const uint32 P[3] = { V[Corner].GetX(), V[Corner].GetY(), V[Corner].GetZ() };
+            for (int32 I = 0; I < 3; ++I) {
+                Min[I] = std::min(Min[I], P[I]);
+                Max[I] = std::max(Max[I], P[I]);
+            }
+        }
+        EXPECT_EQ(Min[Axis], Max[Axis]);
+        const int32 Depth = int32(Min[Axis]) - ((Face & 1) == 0 ? 1 : 0);
+        Max[Axis]         = Min[Axis] + 1;
+        for (uint32 X = Min[0]; X < Max[0]; ++X) {
+            for (uint32 Y = Min[1]; Y < Max[1]; ++Y) {
+                for (uint32 Z = Min[2]; Z < Max[2]; ++Z) {
+                    int32 P[3] = { int32(X), int32(Y), int32(Z) };
+                    P[Axis]    = Depth;
+                    EXPECT_EQ(Chunk.Get(P[0], P[1], P[2]), V[0].Voxel);
+                    EXPECT_TRUE(Faces.insert({ Face, P[0], P[1], P[2] }).second);
+                }
+            }
+        }
+    }
+    return Faces;
+}
+
+// 逐体素求可见面; 区块之外视为空气
+std::set<FUnitFace> BruteForceFaces(const FVoxelChunk &Chunk) {
+    static constexpr int32 Directions[6][3] = { { 1, 0, 0 },  { -1, 0, 0 }, { 0, 1, 0 },
+                                                { 0, -1, 0 }, { 0, 0, 1 },  { 0, 0, -1 } };
+    std::set<FUnitFace>    Faces;
+    auto                   IsSolid = [&Chunk](int32 X, int32 Y, int32 Z) {
+        if (X < 0 || Y < 0 || Z < 0 || X >= ChunkDim || Y >= ChunkDim || Z >= ChunkDim) {
+            return false;
+        }
+        return Chunk.Get(X, Y, Z) != AirVoxel;
+    };
+    for (int32 Z = 0; Z < ChunkDim; ++Z) {
+        for (int32 Y = 0; Y < ChunkDim; ++Y) {
+            for (int32 X = 0; X < ChunkDim; ++X) {
+                if (!IsSolid(X, Y, Z)) {
+                    continue;
+                }
+                for (uint32 Face = 0; Face < 6; ++Face) {
+                    const int32 *D = Directions[Face];
+                    if (!IsSolid(X + D[0], Y + D[1], Z + D[2])) {
+                        Faces.insert({ Face, X, Y, Z });
+                    }
+                }
+            }
+        }
+    }
+    return Faces;
+}
+} // namespace
+
+TEST(MesherTest, SingleVoxelAndFullChunk) {
+    FVoxelMap  Map;
+    FVoxelMesh Mesh;
+    GenerateChunkMesh(Map, { 0, 0, 0 }, Mesh);
+    EXPECT_EQ(Mesh.NumQuads(), 0u);
+
+    Map.SetVoxel(3, 4, 5, 7);
+    GenerateChunkMesh(Map, { 0, 0, 0 }, Mesh);
+    EXPECT_EQ(Mesh.NumQuads(), 6u);
+    EXPECT_EQ(Mesh.Vertices.size(), 24u);
+
+    // 实心区块每个面合并成一个四边形; 贴着实心邻居的一面被剔除
+    Map.FindOrAddChunk({ 0, 0, 0 }).Fill(1);
+    GenerateChunkMesh(Map, { 0, 0, 0 }, Mesh);
+    EXPECT_EQ(Mesh.NumQuads(), 6u);
+    Map.FindOrAddChunk({ 1, 0, 0 }).Fill(2);
+    GenerateChunkMesh(Map, { 0, 0, 0 }, Mesh);
+    EXPECT_EQ(Mesh.NumQuads(), 5u);
+    for (const FVoxelVertex &Vertex: Mesh.Vertices) {
+        EXPECT_NE(Vertex.GetFace(), EVoxelFace::PosX);
+    }
+}
+
+TEST(MesherTest, MatchesBruteForce) {
+    std::mt19937 Random(7);
+    for (int32 Density: { 5, 50, 95 }) {
+        FVoxelMap    Map;
+        FVoxelChunk &Chunk = Map.FindOrAddChunk({ 0, 0, 0 });
+        for (uint32 Index = 0; Index < ChunkVolume; ++Index) {
+            if (int32(Random() % 100) < Density) {
+                Chunk.Set(Index, FVoxel(1 + Random() % 3));
+            }
+        }
+        FVoxelMesh Mesh;
+        GenerateChunkMesh(Map, { 0, 0, 0 }, Mesh);
+        EXPECT_EQ(RasterizeMesh(Mesh, Chunk), BruteForceFaces(Chunk));
+    }
+}
+
+TEST(MesherTest, PipelineRemeshesNeighbours) {
+    FVoxelMap Map;
+    Map.FindOrAddChunk({ 0, 0, 0 }).Fill(1);
+    Map.FindOrAddChunk({ 1, 0, 0 });
+
+    FMeshingPipeline Pipeline(Map);
+    Pipeline.MarkChunkDirty({ 0, 0, 0 });
+    Pipeline.MarkChunkDirty({ 1, 0, 0 });
+    Pipeline.Kick();
+    Pipeline.Wait();
+    EXPECT_TRUE(Pipeline.IsIdle());
+    ASSERT_NE(Pipeline.FindMesh({ 0, 0, 0 }), nullptr);
+    EXPECT_EQ(Pipeline.FindMesh({ 0, 0, 0 })->NumQuads(), 6u);
+    EXPECT_EQ(Pipeline.FindMesh({ 1, 0, 0 })->NumQuads(), 0u);
+
+    // 边界上的修改同时让两侧区块变脏
+    Map.SetVoxel(32, 0, 0, 2);
+    Pipeline.MarkVoxelDirty(32, 0, 0);
+    EXPECT_EQ(Pipeline.NumDirtyChunks(), 4u); // 自身, -X, -Y, -Z
+    Pipeline.Kick();
+    Pipeline.Wait();
+    EXPECT_EQ(Pipeline.FindMesh({ 1, 0, 0 })->NumQuads(), 5u);
+    EXPECT_EQ(Pipeline.FindMesh({ 0, 0, 0 })->NumQuads(), 7u);
+
+    Map.RemoveChunk({ 1, 0, 0 });
+    Pipeline.MarkChunkDirty({ 1, 0, 0 });
+    Pipeline.Kick();
+    Pipeline.Wait();
+    EXPECT_EQ(Pipeline.FindMesh({ 1, 0, 0 }), nullptr);
+}
@@ -0,0 +1,185 @@
+/******************************************************
+ * @file VoxelTests/RaycastTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelRaycast.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace TE::Voxel;
+using namespace TE;
+
+namespace {
+struct FReferenceHit {
+    FVoxel     Voxel = AirVoxel;
+    int32      Cell[3];
+    float      Distance;
+    EVoxelFace Face;
+};
+
+// 不跳过任何区块或砖块, 每一格都用 Map.GetVoxel 检查
+FReferenceHit TraceReference(const FVoxelMap &Map, const FVoxelRay &Ray) {
+    FReferenceHit Hit;
+    const float  *D      = Ray.Direction;
+    const float   Length = std::sqrt(D[0] * D[0] + D[1] * D[1] + D[2] * D[2]);
+    if (!(Length > 0.0f)) {
+        return Hit;
+    }
+    int32 Cell[3];
+    int32 Step[3];
+    float InvDirection[3];
+    for (int32 Axis = 0; Axis < 3; ++Axis) {
+        const float Dir    = D[Axis] / Length;
+        Cell[Axis]         = int32(std::floor(Ray.Origin[Axis]));
+        Step[Axis]         = Dir > 0.0f ? 1 : Dir < 0.0f ? -1 : 0;
+        InvDirection[Axis] = Step[Axis] != 0 ? 1.0f / Dir : 0.0f;
+    }
+    float      T    = 0.0f;
+    EVoxelFace Face = EVoxelFace::PosX;
+    while (T <= Ray.MaxDistance) {
+        const FVoxel Voxel = Map.GetVoxel(Cell[0], Cell[1], Cell[2]);
+        if (Voxel != AirVoxel) {
+            Hit = { Voxel, { Cell[0], Cell[1], Cell[2] }, T, Face };
+            return Hit;
+        }
+        int32 Axis  = -1;
+        float NextT = INFINITY;
+        for (int32 A = 0; A < 3; ++A) {
+            if (Step[A] != 0) {
+                const float Boundary = float(Cell[A] + (Step[A] > 0 ? 1 : 0));
+                const float CrossT   = (Boundary - Ray.Origin[A]) * InvDirection[A];
+                if (CrossT < NextT) {
+                    NextT = CrossT;
+                    Axis  = A;
+                }
+            }
+        }
+        Cell[Axis] += Step[Axis];
+        T    = std::max(T, NextT);
+        Face = EVoxelFace(Axis * 2 + (Step[Axis] > 0 ? 1 : 0));
+    }
+    return Hit;
+}
+} // namespace
+
+TEST(RaycastTest, SingleBlock) {
+    FVoxelMap Map;
+    Map.SetVoxel(10, 0, 0, 7);
+    Map.SetVoxel(-40, -3, 5, 9);
+    const FVoxelRaycaster Raycaster(Map);
+
+    const std::vector<FVoxelRay> Rays = {
+        { { 0.5f, 0.5f, 0.5f }, { 2.0f, 0.0f, 0.0f }, 100.0f },
+        { { 0.5f, 0.5f, 0.5f }, { 1.0f, 0.0f, 0.0f }, 9.0f },
+        { { 10.5f, 0.5f, 0.5f }, { 0.0f, 1.0f, 0.0f }, 5.0f },
+        { { 0.5f, 0.5f, 0.5f }, { 0.0f, 0.0f, 0.0f }, 5.0f },
+        // 跨过空区块和不存在的区块, 在负坐标处从上方命中
+        { { -39.5f, 60.0f, 5.5f }, { 0.0f, -1.0f, 0.0f }, 100.0f },
+    };
+    FRaycastHits Hits;
+    Raycaster.Raycast(Rays, Hits);
+    ASSERT_EQ(Hits.Num(), Rays.size());
+
+    EXPECT_TRUE(Hits.IsHit(0));
+    EXPECT_EQ(Hits.Voxels[0], 7);
+    EXPECT_EQ(Hits.X[0], 10);
+    EXPECT_EQ(Hits.Y[0], 0);
+    EXPECT_EQ(Hits.Z[0], 0);
+    EXPECT_FLOAT_EQ(Hits.Distances[0], 9.5f);
+    EXPECT_EQ(Hits.Faces[0], EVoxelFace::NegX);
+
+    // 太短, 以及起点就在方块里
+    EXPECT_FALSE(Hits.IsHit(1));
+    EXPECT_TRUE(Hits.IsHit(2));
+    EXPECT_EQ(Hits.Distances[2], 0.0f);
+    EXPECT_FALSE(Hits.IsHit(3));
+
+    EXPECT_EQ(Hits.Voxels[4], 9);
+    EXPECT_EQ(Hits.X[4], -40);
+    EXPECT_EQ(Hits.Y[4], -3);
+    EXPECT_FLOAT_EQ(Hits.Distances[4], 62.0f);
+    EXPECT_EQ(Hits.Faces[4], EVoxelFace::PosY);
+}
+
+TEST(RaycastTest, MatchesVoxelByVoxelReference) {
+    // 稀疏的世界: 少数区块里有零散的方块和一片地面, 其余区块为空或不存在
+    std::mt19937 Random(31);
+    FVoxelMap    Map;
+    for (int32 Z = -2; Z < 2; ++Z) {
+        for (int32 Y = -2; Y < 2; ++Y) {
+            for (int32 X = -2; X < 2; ++X) {
+                const uint32 Kind = Random() % 4;
+                if (Kind == 0) {
+                    continue;
+                }
+                FVoxelChunk &Chunk = Map.FindOrAddChunk({ X, Y, Z });
+                if (Kind == 1) {
+                    continue;
+                }
+                const int32 NumBlocks = Kind == 2 ? 8 : 200;
+                for (int32 Block = 0; Block < NumBlocks; ++Block) {
+                    Chunk.Set(Random() % ChunkVolume, FVoxel(1 + Random() % 5));
+                }
+                if (Kind == 3 && Y == -1) {
+                    for (int32 Index = 0; Index < ChunkDim * ChunkDim; ++Index) {
+                        Chunk.Set(Index % ChunkDim, 3, Index / ChunkDim, 6);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<FVoxelRay> Rays;
+    const auto             Uniform = [&Random](float Low, float High) {
+        return std::uniform_real_distribution<float>(Low, High)(Random);
+    };
+    for (int32 Index = 0; Index < 4000; ++Index) {
+        FVoxelRay Ray;
+        for (int32 Axis = 0; Axis < 3; ++Axis) {
+            Ray.Origin[Axis]    = Uniform(-80.0f, 80.0f);
+            Ray.Direction[Axis] = Uniform(-1.0f, 1.0f);
+        }
+        // 一部分射线沿坐标轴或对角线, 从格点出发, 覆盖同时穿过多个格面的情况
+        if (Index % 4 == 0) {
+            for (int32 Axis = 0; Axis < 3; ++Axis) {
+                Ray.Origin[Axis]    = std::floor(Ray.Origin[Axis]);
+                Ray.Direction[Axis] = float(int32(Random() % 3) - 1);
+            }
+        }
+        Ray.MaxDistance = Uniform(1.0f, 250.0f);
+        Rays.push_back(Ray);
+    }
+
+    FRaycastHits Hits;
+    FVoxelRaycaster(Map, 64).Raycast(Rays, Hits);
+    ASSERT_EQ(Hits.Num(), Rays.size());
+    int32 NumHits = 0;
+    for (uint32 Index = 0; Index < Hits.Num(); ++Index) {
+        const FReferenceHit Expected = TraceReference(Map, Rays[Index]);
+        ASSERT_EQ(Hits.Voxels[Index], Expected.Voxel) << Index;
+        if (Expected.Voxel == AirVoxel) {
+            continue;
+        }
+        ++NumHits;
+        EXPECT_EQ(Hits.X[Index], Expected.Cell[0]) << Index;
+        EXPECT_EQ(Hits.Y[Index], Expected.Cell[1]) << Index;
+        EXPECT_EQ(Hits.Z[Index], Expected.Cell[2]) << Index;
+        EXPECT_EQ(Hits.Distances[Index], Expected.Distance) << Index;
+        if (Expected.Distance > 0.0f) {
+            EXPECT_EQ(Hits.Faces[Index], Expected.Face) << Index;
+        }
+    }
+    EXPECT_GT(NumHits, 200);
+    EXPECT_LT(NumHits, 3900);
+
+    // 整批在调用线程上执行时结果相同
+    FRaycastHits Inline;
+    FVoxelRaycaster(Map, uint32(Rays.size())).Raycast(Rays, Inline);
+    EXPECT_EQ(Inline.Voxels, Hits.Voxels);
+    EXPECT_EQ(Inline.Distances, Hits.Distances);
+}
@@ -0,0 +1,231 @@
+/******************************************************
+ * @file VoxelTests/RegionFileTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "FileSystem/MappedFile.hpp"
+#include "Voxel/RegionFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace TE::Voxel;
+
+namespace {
+std::string TempRegionPath(const char *Name) {
+    const std::string Path = (std::filesystem::temp_directory_path() / Name).string();
+    TE::RemoveFile(Path);
+    return Path;
+}
+
+// 区块内随机放置 NumTypes 种方块, 其余为空气
+FVoxelChunk MakeChunk(uint32 Seed, uint32 NumTypes, uint32 NumVoxels) {
+    std::mt19937 Rng(Seed);
+    FVoxelChunk  Chunk;
+    for (uint32 Count = 0; Count < NumVoxels; ++Count) {
+        Chunk.Set(uint32(Rng() % ChunkVolume), FVoxel(1 + Rng() % NumTypes));
+    }
+    return Chunk;
+}
+
+void ExpectSameVoxels(const FVoxelChunk &A, const FVoxelChunk &B) {
+    std::vector<FVoxel> VoxelsA(ChunkVolume);
+    std::vector<FVoxel> VoxelsB(ChunkVolume);
+    A.Unpack(VoxelsA.data());
+    B.Unpack(VoxelsB.data());
+    EXPECT_EQ(VoxelsA, VoxelsB);
+    EXPECT_EQ(A.GetBrickMask(), B.GetBrickMask());
+    EXPECT_EQ(A.NumDistinctVoxels(), B.NumDistinctVoxels());
+}
+} // namespace
+
+TEST(RegionFileTest, SaveLoadReopen) {
+    const std::string  Path   = TempRegionPath("TE_RegionFileTest_Basic.region");
+    const FRegionCoord Region = { -1, 2 };
+    EXPECT_EQ(GetRegionCoord({ -1, 0, 64 }), Region);
+    EXPECT_EQ(GetRegionFileName(Region), "r.-1.2.region");
+
+    // 均匀区块, 1/2/4/8/16 位下标
+    std::vector<FVoxelChunk> Chunks;
+    Chunks.emplace_back(AirVoxel);
+    Chunks.emplace_back(7);
+    Chunks.push_back(MakeChunk(1, 1, 300));
+    Chunks.push_back(MakeChunk(2, 3, 5000));
+    Chunks.push_back(MakeChunk(3, 12, 20000));
+    Chunks.push_back(MakeChunk(4, 200, 20000));
+    Chunks.push_back(MakeChunk(5, 2000, 30000));
+    std::vector<FChunkCoord>       Coords;
+    std::vector<FRegionChunkWrite> Writes;
+    for (int32 Index = 0; Index < int32(Chunks.size()); ++Index) {
+        Coords.push_back({ -32 + Index * 5, MinSectionY + Index * 2, 64 + Index });
+        Writes.push_back({ Coords.back(), &Chunks[Index] });
+    }
+    EXPECT_EQ(Chunks[6].GetBitsPerIndex(), 16u);
+
+    {
+        auto File = FRegionFile::Open(Path, Region);
+        ASSERT_NE(File, nullptr);
+        EXPECT_TRUE(File->SaveChunks(Writes));
+        for (std::size_t Index = 0; Index < Chunks.size(); ++Index) {
+            FVoxelChunk Loaded(99);
+            EXPECT_TRUE(File->HasChunk(Coords[Index]));
+            ASSERT_TRUE(File->LoadChunk(Coords[Index], Loaded));
+            ExpectSameVoxels(Loaded, Chunks[Index]);
+        }
+
+        // 不在本区域或 Y 超出范围
+        FVoxelChunk Loaded;
+        EXPECT_FALSE(File->HasChunk({ 0, 0, 64 }));
+        EXPECT_FALSE(File->LoadChunk({ -32, 0, 0 }, Loaded));
+        const FRegionChunkWrite Outside[] = { { { -32, SectionsPerColumn, 64 }, &Chunks[0] } };
+        EXPECT_FALSE(File->SaveChunks(Outside));
+        EXPECT_FALSE(File->HasChunk({ -32, 0, 65 }));
+
+        // 删除一个区块, 同列其他区块保留
+        const FRegionChunkWrite Remove[] = { { Coords[1], nullptr } };
+        Coords.push_back({ Coords[2].X, Coords[2].Y + 1, Coords[2].Z });
+        const FRegionChunkWrite Add[] = { { Coords.back(), &Chunks[5] } };
+        EXPECT_TRUE(File->SaveChunks(Remove));
+        EXPECT_TRUE(File->SaveChunks(Add));
+        EXPECT_FALSE(File->HasChunk(Coords[1]));
+    }
+
+    // 重新打开后看到最后一次写入
+    auto File = FRegionFile::Open(Path, Region);
+    ASSERT_NE(File, nullptr);
+    // 删除区块 1 后它所在的列为空, 新增的区块与区块 2 同列
+    EXPECT_EQ(File->GetStats().NumColumns, Chunks.size() - 1);
+    for (std::size_t Index = 0; Index < Coords.size(); ++Index) {
+        FVoxelChunk Loaded;
+        if (Index == 1) {
+            EXPECT_FALSE(File->LoadChunk(Coords[Index], Loaded));
+            continue;
+        }
+        ASSERT_TRUE(File->LoadChunk(Coords[Index], Loaded));
+        ExpectSameVoxels(Loaded, Chunks[Index < Chunks.size() ? Index : 5]);
+    }
+    File.reset();
+    TE::RemoveFile(Path);
+}
+
+TEST(RegionFileTest, CompactionAndRecovery) {
+    const std::string  Path   = TempRegionPath("TE_RegionFileTest_Compact.region");
+    const FRegionCoord Region = { 0, 0 };
+    auto               File   = FRegionFile::Open(Path, Region);
+    ASSERT_NE(File, nullptr);
+
+    // 反复覆盖同一批区块, 垃圾超过一半后自动整理
+    const FVoxelChunk Chunk = MakeChunk(9, 3000, 32000);
+    for (int32 Round = 0; Round < 40; ++Round) {
+        std::vector<FRegionChunkWrite> Writes;
+        for (int32 Z = 0; Z < 4; ++Z) {
+            Writes.push_back({ { Round % 2, 0, Z }, &Chunk });
+        }
+        ASSERT_TRUE(File->SaveChunks(Writes));
+        const FRegionFileStats Stats = File->GetStats();
+        EXPECT_LE(Stats.FileSize, std::max<uint64>(Stats.LiveBytes * 2, (1 << 20) + 300000));
+    }
+    ASSERT_TRUE(File->Compact());
+    FRegionFileStats Stats = File->GetStats();
+    EXPECT_EQ(Stats.FileSize, Stats.LiveBytes);
+    EXPECT_EQ(Stats.NumColumns, 8u);
+
+    const FVoxelChunk Small = MakeChunk(10, 2, 100);
+    const FRegionChunkWrite Write[] = { { { 5, 1, 5 }, &Small } };
+    ASSERT_TRUE(File->SaveChunks(Write));
+    File.reset();
+
+    // 末尾写坏: 忽略残缺的批次, 回退到上一份列表
+    {
+        auto Raw = TE::FWritableFile::Open(Path, false);
+        ASSERT_NE(Raw, nullptr);
+        const std::vector<uint8> Garbage(5000, 0xAB);
+        ASSERT_TRUE(Raw->Write(Raw->GetSize(), Garbage.data(), Garbage.size()));
+    }
+    File = FRegionFile::Open(Path, Region);
+    ASSERT_NE(File, nullptr);
+    FVoxelChunk Loaded;
+    ASSERT_TRUE(File->LoadChunk({ 5, 1, 5 }, Loaded));
+    ExpectSameVoxels(Loaded, Small);
+    ASSERT_TRUE(File->LoadChunk({ 1, 0, 3 }, Loaded));
+    ExpectSameVoxels(Loaded, Chunk);
+
+    // 翻转 section 中的一个字节: 校验失败, 区块按缺失处理
+    const uint64 Size = File->GetStats().FileSize;
+    File.reset();
+    {
+        auto Raw = TE::FWritableFile::Open(Path, false);
+        const uint8 Flip = 0x5A;
+        // 整理后第一列紧跟头部, 跳过列目录后落在该列唯一的 section 记录中
+        ASSERT_TRUE(Raw->Write(8 + 16 * ColumnsPerRegion + 128 + 400, &Flip, 1));
+        EXPECT_EQ(Raw->GetSize(), Size);
+    }
+    File = FRegionFile::Open(Path, Region);
+    int32 NumCorrupt = 0;
+    for (int32 X = 0; X < 2; ++X) {
+        for (int32 Z = 0; Z < 4; ++Z) {
+            NumCorrupt += !File->LoadChunk({ X, 0, Z }, Loaded);
+        }
+    }
+    EXPECT_EQ(NumCorrupt, 1);
+    EXPECT_TRUE(Loaded.IsEmpty() || Loaded.NumDistinctVoxels() > 1);
+    File.reset();
+    TE::RemoveFile(Path);
+}
+
+TEST(RegionFileTest, ReadersNeverSeeTornWrites) {
+    const std::string Path = TempRegionPath("TE_RegionFileTest_Concurrent.region");
+    auto              File = FRegionFile::Open(Path, { 0, 0 });
+    ASSERT_NE(File, nullptr);
+
+    // 版本 V 为除下标 V 处是空气外全部填 V 的区块, 读者看到的必须是某个完整版本
+    std::atomic<bool>  bStop{ false };
+    std::atomic<int32> NumLoads{ 0 };
+    auto               Reader = [&] {
+        FVoxelChunk Chunk;
+        while (!bStop.load(std::memory_order_relaxed)) {
+            for (int32 Z = 0; Z < 8; ++Z) {
+                if (File->LoadChunk({ 3, 0, Z }, Chunk)) {
+                    const FVoxel Version = Chunk.Get(0u);
+                    EXPECT_EQ(Chunk.Get(uint32(Version)), AirVoxel);
+                    EXPECT_EQ(Chunk.NumDistinctVoxels(), 2u);
+                    NumLoads.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+    std::vector<std::thread> Readers;
+    for (int32 Index = 0; Index < 3; ++Index) {
+        Readers.emplace_back(Reader);
+    }
+
+    for (int32 Version = 1; Version < 300; ++Version) {
+        FVoxelChunk Chunk{ FVoxel(Version) };
+        Chunk.Set(uint32(Version), AirVoxel);
+        std::vector<FRegionChunkWrite> Writes;
+        for (int32 Z = 0; Z < 8; ++Z) {
+            Writes.push_back({ { 3, 0, Z }, &Chunk });
+        }
+        ASSERT_TRUE(File->SaveChunks(Writes));
+        if (Version % 100 == 0) {
+            ASSERT_TRUE(File->Compact());
+        }
+    }
+    bStop = true;
+    for (std::thread &Thread: Readers) {
+        Thread.join();
+    }
+    EXPECT_GT(NumLoads.load(), 0);
+
+    FVoxelChunk Last;
+    ASSERT_TRUE(File->LoadChunk({ 3, 0, 7 }, Last));
+    EXPECT_EQ(Last.Get(0u), 299);
+    EXPECT_EQ(Last.Get(299u), AirVoxel);
+    File.reset();
+    TE::RemoveFile(Path);
+}
@@ -0,0 +1,202 @@
+/******************************************************
+ * @file VoxelTests/VoxelTest.cpp
+ * @brief
+ *****************************************************/
+
+#include "Voxel/VoxelChunk.hpp"
+#include "Voxel/VoxelMap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace TE::Voxel;
+
+TEST(VoxelTest, Coordinates) {
+    EXPECT_EQ(GetChunkCoord(0, 31, 32), (FChunkCoord{ 0, 0, 1 }));
+    EXPECT_EQ(GetChunkCoord(-1, -32, -33), (FChunkCoord{ -1, -1, -2 }));
+    EXPECT_EQ(GetLocalVoxelIndex(-1, 0, 0), GetVoxelIndex(31, 0, 0));
+    EXPECT_EQ(GetBrickIndexOfVoxel(GetVoxelIndex(31, 8, 17)), GetBrickIndex(31, 8, 17));
+    EXPECT_NE(std::hash<FChunkCoord>()({ 1, 0, 0 }), std::hash<FChunkCoord>()({ 0, 1, 0 }));
+}
+
+TEST(VoxelTest, UniformChunk) {
+    FVoxelChunk Chunk;
+    EXPECT_TRUE(Chunk.IsUniform());
+    EXPECT_TRUE(Chunk.IsEmpty());
+    EXPECT_EQ(Chunk.Get(5, 6, 7), AirVoxel);
+    EXPECT_LT(Chunk.GetMemoryUsage(), 512u);
+
+    Chunk.Fill(3);
+    EXPECT_TRUE(Chunk.IsUniform());
+    EXPECT_EQ(Chunk.GetBrickMask(), ~uint64(0));
+
+    // 写入第二种方块后展开, 删回去后重新收缩
+    Chunk.Set(1, 2, 3, 4);
+    EXPECT_FALSE(Chunk.IsUniform());
+    EXPECT_EQ(Chunk.GetBitsPerIndex(), 1u);
+    EXPECT_EQ(Chunk.Get(1, 2, 3), 4);
+    EXPECT_EQ(Chunk.Get(1, 2, 4), 3);
+    Chunk.Set(1, 2, 3, 3);
+    EXPECT_TRUE(Chunk.IsUniform());
+    EXPECT_EQ(Chunk.Get(1, 2, 3), 3);
+}
+
+TEST(VoxelTest, PaletteGrowthMatchesReference) {
+    FVoxelChunk         Chunk;
+    std::vector<FVoxel> Reference(ChunkVolume, AirVoxel);
+    std::mt19937        Random(42);
+
+    // 方块种类逐步增多, 覆盖 1/2/4/8/16 位的所有位宽
+    for (uint32 Kinds: { 2u, 4u, 16u, 200u, 3000u }) {
+        for (int Step = 0; Step < 20000; ++Step) {
+            const uint32 Index = Random() % ChunkVolume;
+            const FVoxel Voxel = FVoxel(Random() % Kinds);
+            Chunk.Set(Index, Voxel);
+            Reference[Index] = Voxel;
+        }
+        for (uint32 Index = 0; Index < ChunkVolume; ++Index) {
+            ASSERT_EQ(Chunk.Get(Index), Reference[Index]);
+        }
+    }
+    EXPECT_EQ(Chunk.GetBitsPerIndex(), 16u);
+
+    std::vector<FVoxel> Unpacked(ChunkVolume);
+    Chunk.Unpack(Unpacked.data());
+    EXPECT_EQ(Unpacked, Reference);
+
+    for (int32 Brick = 0; Brick < int32(NumBricks); ++Brick) {
+        bool bHasSolid = false;
+        for (uint32 Index = 0; Index < ChunkVolume; ++Index) {
+            bHasSolid |= GetBrickIndexOfVoxel(Index) == uint32(Brick) && Reference[Index] != 0;
+        }
+        EXPECT_EQ(((Chunk.GetBrickMask() >> Brick) & 1) != 0, bHasSolid);
+    }
+}
+
+TEST(VoxelTest, CompactShrinksTerrainChunk) {
+    // 典型地表区块: 下半部分石头, 一层泥土和草, 上面是空气
+    FVoxelChunk Chunk;
+    for (int32 Z = 0; Z < ChunkDim; ++Z) {
+        for (int32 Y = 0; Y < ChunkDim; ++Y) {
+            for (int32 X = 0; X < ChunkDim; ++X) {
+                const int32 Height = 14 + (X + Z) % 4;
+                FVoxel      Voxel  = AirVoxel;
+                if (Y < Height - 2) {
+                    Voxel = 1;
+                } else if (Y < Height) {
+                    Voxel = 2;
+                } else if (Y == Height) {
+                    Voxel = 3;
+                }
+                // 中途短暂出现的方块会让位宽变大
+                Chunk.Set(X, Y, Z, FVoxel(100 + X));
+                Chunk.Set(X, Y, Z, Voxel);
+            }
+        }
+    }
+    EXPECT_GT(Chunk.GetBitsPerIndex(), 2u);
+    Chunk.Compact();
+    EXPECT_EQ(Chunk.GetBitsPerIndex(), 2u);
+    EXPECT_EQ(Chunk.NumDistinctVoxels(), 4u);
+    EXPECT_EQ(Chunk.Get(0, 0, 0), 1);
+    EXPECT_EQ(Chunk.Get(0, 14, 0), 3);
+    EXPECT_EQ(Chunk.Get(0, 31, 0), AirVoxel);
+    EXPECT_LT(Chunk.GetMemoryUsage(), 9u * 1024u);
+    // 最上层的砖块全是空气, 其余砖块都有方块
+    uint64 TopBricks = 0;
+    for (int32 Z = 0; Z < ChunkDim; Z += BrickDim) {
+        for (int32 X = 0; X < ChunkDim; X += BrickDim) {
+            TopBricks |= uint64(1) << GetBrickIndex(X, ChunkDim - 1, Z);
+        }
+    }
+    EXPECT_EQ(Chunk.GetBrickMask(), ~TopBricks);
+
+    // 只剩一种方块时 Compact 收缩为均匀区块
+    for (uint32 Index = 0; Index < ChunkVolume; ++Index) {
+        if (Chunk.Get(Index) != 1) {
+            Chunk.Set(Index, 1);
+        }
+    }
+    EXPECT_TRUE(Chunk.IsUniform());
+}
+
+TEST(VoxelTest, PackMatchesSet) {
+    std::mt19937 Random(7);
+    for (uint32 Kinds: { 1u, 3u, 40u, 1000u }) {
+        // 下半部分随机方块, 上半部分空气
+        std::vector<FVoxel> Voxels(ChunkVolume, AirVoxel);
+        FVoxelChunk         Expected;
+        for (uint32 Index = 0; Index < ChunkVolume / 2; ++Index) {
+            Voxels[Index] = FVoxel(1 + Random() % Kinds);
+            Expected.Set(Index, Voxels[Index]);
+        }
+        FVoxelChunk Chunk(5);
+        Chunk.Pack(Voxels.data());
+        std::vector<FVoxel> Unpacked(ChunkVolume);
+        Chunk.Unpack(Unpacked.data());
+        EXPECT_EQ(Unpacked, Voxels);
+        EXPECT_EQ(Chunk.GetBrickMask(), Expected.GetBrickMask());
+        EXPECT_EQ(Chunk.NumDistinctVoxels(), Kinds + 1);
+        // 之后照常逐个修改
+        Chunk.Set(ChunkVolume - 1, 2);
+        Expected.Set(ChunkVolume - 1, 2);
+        EXPECT_EQ(Chunk.Get(ChunkVolume - 1), 2);
+        EXPECT_EQ(Chunk.GetBrickMask(), Expected.GetBrickMask());
+    }
+
+    const std::vector<FVoxel> Stone(ChunkVolume, 4);
+    FVoxelChunk               Chunk;
+    Chunk.Pack(Stone.data());
+    EXPECT_TRUE(Chunk.IsUniform());
+    EXPECT_EQ(Chunk.Get(123u), 4);
+    EXPECT_EQ(Chunk.GetBrickMask(), ~uint64(0));
+}
+
+// 砖块计数由载入的下标重新统计
+TEST(VoxelTest, LoadPackedRecountsBricks) {
+    FVoxelChunk Source;
+    Source.Set(0u, 3);
+    Source.Set(ChunkVolume - 1, 4);
+    const FPackedChunk Packed = Source.GetPacked();
+
+    FVoxelChunk Chunk(7);
+    ASSERT_TRUE(Chunk.LoadPacked(Packed, [&](uint64 *Words, std::size_t NumWords) {
+        std::copy(Packed.Data.begin(), Packed.Data.begin() + NumWords, Words);
+        return true;
+    }));
+    EXPECT_EQ(Chunk.GetBrickMask(), Source.GetBrickMask());
+    Chunk.Set(0u, AirVoxel);
+    Chunk.Set(ChunkVolume - 1, AirVoxel);
+    EXPECT_TRUE(Chunk.IsEmpty());
+}
+
+TEST(VoxelTest, SparseMap) {
+    FVoxelMap Map;
+    EXPECT_EQ(Map.GetVoxel(100, -5, 7), AirVoxel);
+    Map.SetVoxel(100, -5, 7, AirVoxel);
+    EXPECT_EQ(Map.NumChunks(), 0u);
+
+    Map.SetVoxel(100, -5, 7, 9);
+    Map.SetVoxel(-1, -1, -1, 8);
+    EXPECT_EQ(Map.NumChunks(), 2u);
+    EXPECT_EQ(Map.GetVoxel(100, -5, 7), 9);
+    EXPECT_EQ(Map.GetVoxel(-1, -1, -1), 8);
+    EXPECT_EQ(Map.GetVoxel(-1, -1, 0), AirVoxel);
+
+    FVoxelChunk *Chunk = Map.FindChunk({ -1, -1, -1 });
+    ASSERT_NE(Chunk, nullptr);
+    EXPECT_EQ(Chunk->Get(31, 31, 31), 8);
+    EXPECT_EQ(&Map.FindOrAddChunk({ -1, -1, -1 }), Chunk);
+
+    uint32 Visited = 0;
+    Map.ForEachChunk([&Visited](const FChunkCoord &, FVoxelChunk &) { ++Visited; });
+    EXPECT_EQ(Visited, 2u);
+
+    EXPECT_TRUE(Map.RemoveChunk({ -1, -1, -1 }));
+    EXPECT_FALSE(Map.RemoveChunk({ -1, -1, -1 }));
+    EXPECT_EQ(Map.GetVoxel(-1, -1, -1), AirVoxel);
+    EXPECT_EQ(Map.NumChunks(), 1u);
+}
@@ -5,7 +5,7 @@ This module provides simplified interfaces for creating engine libraries and tes
 standardized compilation settings and include path handling across platforms.
 """
 
-load("@rules_cc//cc:defs.bzl", "cc_library", "cc_test")
+load("@rules_cc//cc:defs.bzl", "cc_binary", "cc_library", "cc_test")
 
 ##############################################
 # 1. 内部函数：_engine_cc_library_impl
@@ -229,3 +229,47 @@ def engine_plib(
         strip_include_prefix = strip_include_prefix,
         include_prefix = include_prefix,
     )
+
+##############################################
+# 6. 对外宏：engine_bench
+#    构建基准测试目标 (Google Benchmark)
+##############################################
+def engine_bench(
+        name,
+        srcs = [],
+        deps = [],
+        visibility = None,
+        copts = [],
+        linkopts = [],
+        include_dirs = [],
+        target_compatible_with = []):
+    """构建引擎基准测试目标。
+
+    自动链接 Google Benchmark 及其 main, 并打上 "benchmark" 标签,
+    避免被 bazel test //... 当作普通测试执行。以 cc_binary 形式运行:
+    bazel run -c opt //Runtime/Core:TasksBench -- \
+        --benchmark_out=TasksBench.json --benchmark_out_format=json
+    输出的 JSON 可以用 Google Benchmark 自带的 tools/compare.py 在两次提交之间对比。
+    """
+    base_copts = [
+        "-std=c++23",
+        "-O3",
+    ]
+    for inc in include_dirs:
+        base_copts.append("-I" + inc)
+    final_copts = base_copts + copts
+
+    cc_binary(
+        name = name,
+        srcs = srcs,
+        deps = deps + [
+            "@google_benchmark//:benchmark",
+            "@google_benchmark//:benchmark_main",
+        ],
+        visibility = visibility if visibility else ["//visibility:private"],
+        copts = final_copts,
+        linkopts = linkopts,
+        tags = ["benchmark"],
+        testonly = True,
+        target_compatible_with = target_compatible_with,
+    )